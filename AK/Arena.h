@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// A bump allocator for data that is built up piece by piece and then thrown away all at once, like the syntax tree
+// of a parser. Allocating is little more than bumping a pointer, and memory is only given back when the arena is reset
+// or destroyed. Objects created with make() have their destructors run at that point, in reverse order of creation.
+class Arena {
+    AK_MAKE_NONCOPYABLE(Arena);
+    AK_MAKE_NONMOVABLE(Arena);
+
+public:
+    static constexpr size_t default_chunk_size = 16 * KiB;
+
+    explicit Arena(size_t chunk_size = default_chunk_size)
+        : m_chunk_size(chunk_size)
+    {
+        VERIFY(chunk_size > sizeof(Chunk));
+    }
+
+    ~Arena()
+    {
+        reset();
+        if (m_chunks)
+            free_chunk(m_chunks);
+    }
+
+    [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(void*))
+    {
+        VERIFY(alignment && (alignment & (alignment - 1)) == 0);
+        auto address = (m_current + alignment - 1) & ~(alignment - 1);
+        if (address + size > m_end || address < m_current) [[unlikely]]
+            return allocate_slow(size, alignment);
+        m_current = address + size;
+        return reinterpret_cast<void*>(address);
+    }
+
+    // Gives back the space of the most recent allocation, so that short-lived scratch buffers don't pile up.
+    // Anything else stays allocated until the arena is reset.
+    void deallocate(void* pointer, size_t size)
+    {
+        if (reinterpret_cast<FlatPtr>(pointer) + size == m_current)
+            m_current = reinterpret_cast<FlatPtr>(pointer);
+    }
+
+    // Extends the most recent allocation, if the current chunk has room for it. This lets a growing Vector keep
+    // its buffer instead of leaving the old one behind.
+    [[nodiscard]] bool try_grow_in_place(void* pointer, size_t old_size, size_t new_size)
+    {
+        auto address = reinterpret_cast<FlatPtr>(pointer);
+        if (address + old_size != m_current || new_size > m_end - address)
+            return false;
+        m_current = address + new_size;
+        return true;
+    }
+
+    template<typename T, typename... Args>
+    T& make(Args&&... args)
+    {
+        auto* object = new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+        if constexpr (!IsTriviallyDestructible<T>) {
+            auto* finalizer = new (allocate(sizeof(Finalizer), alignof(Finalizer))) Finalizer;
+            finalizer->destroy = [](void* object) { static_cast<T*>(object)->~T(); };
+            finalizer->object = object;
+            finalizer->next = m_finalizers;
+            m_finalizers = finalizer;
+        }
+        return *object;
+    }
+
+    // Destroys all objects created with make(), and frees all memory except for one chunk, which is kept for reuse.
+    void reset()
+    {
+        for (auto* finalizer = m_finalizers; finalizer; finalizer = finalizer->next)
+            finalizer->destroy(finalizer->object);
+        m_finalizers = nullptr;
+
+        // Keep the oldest regular sized chunk, so that an arena which is reset over and over keeps reusing the same memory.
+        Chunk* kept_chunk = nullptr;
+        for (auto* chunk = m_chunks; chunk;) {
+            auto* previous = chunk->previous;
+            if (chunk->size == m_chunk_size) {
+                if (kept_chunk)
+                    free_chunk(kept_chunk);
+                kept_chunk = chunk;
+            } else {
+                free_chunk(chunk);
+            }
+            chunk = previous;
+        }
+
+        m_chunks = kept_chunk;
+        m_current = 0;
+        m_end = 0;
+        if (kept_chunk) {
+            kept_chunk->previous = nullptr;
+            m_current = kept_chunk->data();
+            m_end = kept_chunk->end();
+        }
+    }
+
+private:
+    struct Chunk {
+        Chunk* previous;
+        size_t size;
+
+        FlatPtr data() const { return reinterpret_cast<FlatPtr>(this) + sizeof(Chunk); }
+        FlatPtr end() const { return reinterpret_cast<FlatPtr>(this) + size; }
+    };
+
+    struct Finalizer {
+        void (*destroy)(void*);
+        void* object;
+        Finalizer* next;
+    };
+
+    NEVER_INLINE void* allocate_slow(size_t size, size_t alignment)
+    {
+        size_t needed_size = sizeof(Chunk) + size + alignment - 1;
+        VERIFY(needed_size > size);
+
+        // Large allocations get a chunk of their own. It goes behind the current chunk, so that we can keep bumping in that one.
+        if (needed_size > m_chunk_size / 4 && m_chunks) {
+            auto* chunk = allocate_chunk(needed_size);
+            chunk->previous = m_chunks->previous;
+            m_chunks->previous = chunk;
+            return reinterpret_cast<void*>((chunk->data() + alignment - 1) & ~(alignment - 1));
+        }
+
+        auto* chunk = allocate_chunk(max(needed_size, m_chunk_size));
+        chunk->previous = m_chunks;
+        m_chunks = chunk;
+        m_current = chunk->data();
+        m_end = chunk->end();
+        return allocate(size, alignment);
+    }
+
+    static Chunk* allocate_chunk(size_t size)
+    {
+        auto* chunk = static_cast<Chunk*>(kmalloc(size));
+        VERIFY(chunk);
+        chunk->previous = nullptr;
+        chunk->size = size;
+        return chunk;
+    }
+
+    static void free_chunk(Chunk* chunk)
+    {
+        kfree_sized(chunk, chunk->size);
+    }
+
+    size_t m_chunk_size { 0 };
+    FlatPtr m_current { 0 };
+    FlatPtr m_end { 0 };
+    Chunk* m_chunks { nullptr };
+    Finalizer* m_finalizers { nullptr };
+};
+
+// Lets a Vector keep its elements in an Arena: Vector<T, 0, ArenaAllocator> vector { ArenaAllocator { arena } };
+// The arena has to outlive the vector.
+class ArenaAllocator {
+public:
+    ArenaAllocator() = default;
+    ArenaAllocator(Arena& arena)
+        : m_arena(&arena)
+    {
+    }
+
+    void* allocate(size_t size, size_t alignment)
+    {
+        VERIFY(m_arena);
+        return m_arena->allocate(size, alignment);
+    }
+
+    void deallocate(void* pointer, size_t size) { m_arena->deallocate(pointer, size); }
+    bool try_grow_in_place(void* pointer, size_t old_size, size_t new_size) { return m_arena->try_grow_in_place(pointer, old_size, new_size); }
+    size_t good_size(size_t size) const { return size; }
+
+    Arena* arena() const { return m_arena; }
+
+private:
+    Arena* m_arena { nullptr };
+};
+
+}
+
+using AK::Arena;
+using AK::ArenaAllocator;
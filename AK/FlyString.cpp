@@ -5,12 +5,12 @@
  */
 
 #include <AK/FlyString.h>
-#include <AK/HashTable.h>
 #include <AK/Optional.h>
 #include <AK/Singleton.h>
 #include <AK/String.h>
 #include <AK/StringUtils.h>
 #include <AK/StringView.h>
+#include <AK/SwissHashTable.h>
 
 namespace AK {
 
@@ -24,9 +24,9 @@ struct FlyStringImplTraits : public Traits<StringImpl*> {
     }
 };
 
-static AK::Singleton<HashTable<StringImpl*, FlyStringImplTraits>> s_table;
+static AK::Singleton<SwissHashTable<StringImpl*, FlyStringImplTraits>> s_table;
 
-static HashTable<StringImpl*, FlyStringImplTraits>& fly_impls()
+static SwissHashTable<StringImpl*, FlyStringImplTraits>& fly_impls()
 {
     return *s_table;
 }
@@ -59,11 +59,13 @@ FlyString::FlyString(StringView const& string)
 {
     if (string.is_null())
         return;
-    auto it = fly_impls().find(string.hash(), [&](auto& candidate) {
+    auto hash = string.hash();
+    auto it = fly_impls().find(hash, [&](auto& candidate) {
         return string == candidate;
     });
     if (it == fly_impls().end()) {
         auto new_string = string.to_string();
+        new_string.impl()->set_hash({}, hash);
         fly_impls().set(new_string.impl());
         new_string.impl()->set_fly({}, true);
         m_impl = new_string.impl();
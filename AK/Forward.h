@@ -75,12 +75,18 @@ class HashTable;
 template<typename T, typename TraitsForT = Traits<T>>
 using OrderedHashTable = HashTable<T, TraitsForT, true>;
 
-template<typename K, typename V, typename KeyTraits = Traits<K>, bool IsOrdered = false>
+template<typename T, typename TraitsForT = Traits<T>>
+class SwissHashTable;
+
+template<typename K, typename V, typename KeyTraits = Traits<K>, bool IsOrdered = false, bool UsesSwissTable = false>
 class HashMap;
 
 template<typename K, typename V, typename KeyTraits = Traits<K>>
 using OrderedHashMap = HashMap<K, V, KeyTraits, true>;
 
+template<typename K, typename V, typename KeyTraits = Traits<K>>
+using SwissHashMap = HashMap<K, V, KeyTraits, false, true>;
+
 template<typename T>
 class Badge;
 
@@ -120,7 +126,9 @@ class OwnPtr;
 template<typename T>
 class WeakPtr;
 
-template<typename T, size_t inline_capacity = 0>
+struct KmallocAllocator;
+
+template<typename T, size_t inline_capacity = 0, typename Allocator = KmallocAllocator>
 requires(!IsRvalueReference<T>) class Vector;
 
 }
@@ -19,8 +19,11 @@
 
 namespace AK {
 
-template<typename K, typename V, typename KeyTraits, bool IsOrdered>
+// NOTE: SwissHashMap (with UsesSwissTable) needs <AK/SwissHashTable.h> to be included.
+template<typename K, typename V, typename KeyTraits, bool IsOrdered, bool UsesSwissTable>
 class HashMap {
+    static_assert(!IsOrdered || !UsesSwissTable, "SwissHashTable does not support keeping insertion order");
+
 private:
     struct Entry {
         K key;
@@ -68,7 +71,7 @@ public:
     }
     void remove_one_randomly() { m_table.remove(m_table.begin()); }
 
-    using HashTableType = HashTable<Entry, EntryTraits, IsOrdered>;
+    using HashTableType = Conditional<UsesSwissTable, SwissHashTable<Entry, EntryTraits>, HashTable<Entry, EntryTraits, IsOrdered>>;
     using IteratorType = typename HashTableType::Iterator;
     using ConstIteratorType = typename HashTableType::ConstIterator;
 
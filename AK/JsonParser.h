@@ -6,33 +6,27 @@
 
 #pragma once
 
-#include <AK/GenericLexer.h>
+#include <AK/JsonPullParser.h>
 #include <AK/JsonValue.h>
 
 namespace AK {
 
-class JsonParser : private GenericLexer {
+// Builds a JsonValue tree out of the events of a JsonPullParser.
+class JsonParser {
 public:
     explicit JsonParser(const StringView& input)
-        : GenericLexer(input)
+        : m_parser(input)
     {
     }
 
     Optional<JsonValue> parse();
 
 private:
-    Optional<JsonValue> parse_helper();
-
-    String consume_and_unescape_string();
+    Optional<JsonValue> parse_value(JsonPullParser::Event);
     Optional<JsonValue> parse_array();
     Optional<JsonValue> parse_object();
-    Optional<JsonValue> parse_number();
-    Optional<JsonValue> parse_string();
-    Optional<JsonValue> parse_false();
-    Optional<JsonValue> parse_true();
-    Optional<JsonValue> parse_null();
 
-    String m_last_string_starting_with_character[256];
+    JsonPullParser m_parser;
 };
 
 }
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/JsonPullParser.h>
+#include <AK/NumericLimits.h>
+#include <AK/StringBuilder.h>
+
+namespace AK {
+
+constexpr bool is_space(int ch)
+{
+    return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+}
+
+JsonPullParser::Event JsonPullParser::next()
+{
+    if (m_event == Event::EndOfInput || m_event == Event::Error)
+        return m_event;
+
+    ignore_while(is_space);
+
+    if (m_stack.is_empty()) {
+        if (m_consumed_root)
+            return is_eof() ? m_event = Event::EndOfInput : fail();
+        m_consumed_root = true;
+        return m_event = consume_value();
+    }
+
+    // NOTE: consume_value() may push onto m_stack, so the state has to be updated before calling it.
+    switch (m_stack.last()) {
+    case State::ObjectStart:
+        if (consume_specific('}'))
+            return end_container(Event::ObjectEnd);
+        return consume_key();
+    case State::ObjectValue:
+        m_stack.last() = State::ObjectNext;
+        return m_event = consume_value();
+    case State::ObjectNext:
+        if (consume_specific('}'))
+            return end_container(Event::ObjectEnd);
+        if (!consume_specific(','))
+            return fail();
+        ignore_while(is_space);
+        return consume_key();
+    case State::ArrayStart:
+        if (consume_specific(']'))
+            return end_container(Event::ArrayEnd);
+        m_stack.last() = State::ArrayNext;
+        return m_event = consume_value();
+    case State::ArrayNext:
+        if (consume_specific(']'))
+            return end_container(Event::ArrayEnd);
+        if (!consume_specific(','))
+            return fail();
+        ignore_while(is_space);
+        return m_event = consume_value();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+bool JsonPullParser::skip_value()
+{
+    if (m_event != Event::ObjectStart && m_event != Event::ArrayStart)
+        return m_event != Event::Error;
+
+    auto depth = m_stack.size();
+    while (m_stack.size() >= depth) {
+        if (next() == Event::Error)
+            return false;
+    }
+    return true;
+}
+
+String JsonPullParser::string() const
+{
+    if (!m_string_has_escapes)
+        return m_string;
+    return unescape_string(m_string);
+}
+
+JsonPullParser::Event JsonPullParser::consume_key()
+{
+    if (!consume_string())
+        return fail();
+    ignore_while(is_space);
+    if (!consume_specific(':'))
+        return fail();
+    m_stack.last() = State::ObjectValue;
+    return m_event = Event::Key;
+}
+
+JsonPullParser::Event JsonPullParser::end_container(Event event)
+{
+    m_stack.take_last();
+    return m_event = event;
+}
+
+JsonPullParser::Event JsonPullParser::consume_value()
+{
+    switch (peek()) {
+    case '{':
+        ignore();
+        m_stack.append(State::ObjectStart);
+        return Event::ObjectStart;
+    case '[':
+        ignore();
+        m_stack.append(State::ArrayStart);
+        return Event::ArrayStart;
+    case '"':
+        return consume_string() ? Event::String : fail();
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        return consume_number() ? Event::Number : fail();
+    case 't':
+        return consume_specific("true") ? Event::True : fail();
+    case 'f':
+        return consume_specific("false") ? Event::False : fail();
+    case 'n':
+        return consume_specific("null") ? Event::Null : fail();
+    }
+    return fail();
+}
+
+// Escape sequences are validated here, so unescape_string() can't fail later on.
+bool JsonPullParser::consume_string()
+{
+    if (!consume_specific('"'))
+        return false;
+
+    size_t start = m_index;
+    m_string_has_escapes = false;
+    for (;;) {
+        if (is_eof())
+            return false;
+        char ch = m_input[m_index];
+        if (ch == '"')
+            break;
+        if (is_ascii_c0_control(ch))
+            return false;
+        ++m_index;
+        if (ch != '\\')
+            continue;
+
+        m_string_has_escapes = true;
+        if (is_eof())
+            return false;
+        switch (consume()) {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+            break;
+        case 'u':
+            for (size_t i = 0; i < 4; ++i) {
+                if (!is_ascii_hex_digit(peek()))
+                    return false;
+                ignore();
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+
+    m_string = m_input.substring_view(start, m_index - start);
+    ignore();
+    return true;
+}
+
+String JsonPullParser::unescape_string(StringView raw_string)
+{
+    StringBuilder builder(raw_string.length());
+    size_t index = 0;
+    while (index < raw_string.length()) {
+        size_t run_start = index;
+        while (index < raw_string.length() && raw_string[index] != '\\')
+            ++index;
+        builder.append(raw_string.substring_view(run_start, index - run_start));
+        if (index == raw_string.length())
+            break;
+
+        ++index;
+        switch (raw_string[index++]) {
+        case 'b':
+            builder.append('\b');
+            break;
+        case 'f':
+            builder.append('\f');
+            break;
+        case 'n':
+            builder.append('\n');
+            break;
+        case 'r':
+            builder.append('\r');
+            break;
+        case 't':
+            builder.append('\t');
+            break;
+        case 'u':
+            builder.append_code_point(StringUtils::convert_to_uint_from_hex(raw_string.substring_view(index, 4)).value());
+            index += 4;
+            break;
+        default:
+            builder.append(raw_string[index - 1]);
+            break;
+        }
+    }
+    return builder.to_string();
+}
+
+#ifndef KERNEL
+static double power_of_ten(size_t exponent)
+{
+    // Every power of ten up to 10^22 is exactly representable as a double.
+    static constexpr double exact_powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    constexpr size_t largest_exact_exponent = array_size(exact_powers_of_ten) - 1;
+
+    double result = 1;
+    for (; exponent > largest_exact_exponent; exponent -= largest_exact_exponent) {
+        result *= exact_powers_of_ten[largest_exact_exponent];
+        if (result == __builtin_huge_val())
+            return result;
+    }
+    return result * exact_powers_of_ten[exponent];
+}
+#endif
+
+// Numbers are accumulated into an integer mantissa and a decimal exponent as they are scanned,
+// instead of being copied out and reparsed. Integers pick the same JsonValue types as before:
+// u32 if possible, then i32 for negative values, then i64, then u64.
+bool JsonPullParser::consume_number()
+{
+    bool negative = consume_specific('-');
+    if (!is_ascii_digit(peek()))
+        return false;
+
+    u64 mantissa = 0;
+    i64 exponent = 0;
+    bool mantissa_is_exact = true;
+    auto accumulate_digit = [&](char digit) {
+        constexpr u64 max_before_last_digit = NumericLimits<u64>::max() / 10;
+        u64 digit_value = digit - '0';
+        if (mantissa < max_before_last_digit || (mantissa == max_before_last_digit && digit_value <= NumericLimits<u64>::max() % 10)) {
+            mantissa = mantissa * 10 + digit_value;
+            return true;
+        }
+        mantissa_is_exact = false;
+        return false;
+    };
+
+    // Leading zeros aren't allowed, so the integer part is either a single zero or starts with a nonzero digit.
+    if (consume_specific('0')) {
+        if (is_ascii_digit(peek()))
+            return false;
+    } else {
+        while (is_ascii_digit(peek())) {
+            if (!accumulate_digit(consume()))
+                ++exponent;
+        }
+    }
+
+    bool is_double = false;
+    if (consume_specific('.')) {
+        is_double = true;
+        if (!is_ascii_digit(peek()))
+            return false;
+        while (is_ascii_digit(peek())) {
+            if (accumulate_digit(consume()))
+                --exponent;
+        }
+    }
+
+    if (next_is('e') || next_is('E')) {
+        ignore();
+        is_double = true;
+        bool exponent_is_negative = false;
+        if (!consume_specific('+'))
+            exponent_is_negative = consume_specific('-');
+        if (!is_ascii_digit(peek()))
+            return false;
+        i64 explicit_exponent = 0;
+        while (is_ascii_digit(peek())) {
+            char digit = consume();
+            // Anything this large over- or underflows a double anyway.
+            if (explicit_exponent < 100000)
+                explicit_exponent = explicit_exponent * 10 + (digit - '0');
+        }
+        exponent += exponent_is_negative ? -explicit_exponent : explicit_exponent;
+    }
+
+    if (!is_double && mantissa_is_exact) {
+        if (!negative) {
+            if (mantissa <= NumericLimits<u32>::max())
+                m_number = JsonValue(static_cast<u32>(mantissa));
+            else if (mantissa <= static_cast<u64>(NumericLimits<i64>::max()))
+                m_number = JsonValue(static_cast<i64>(mantissa));
+            else
+                m_number = JsonValue(mantissa);
+            return true;
+        }
+        if (mantissa <= static_cast<u64>(NumericLimits<i32>::max()) + 1) {
+            m_number = JsonValue(static_cast<i32>(-static_cast<i64>(mantissa)));
+            return true;
+        }
+        if (mantissa <= static_cast<u64>(NumericLimits<i64>::max()) + 1) {
+            m_number = JsonValue(static_cast<i64>(0 - mantissa));
+            return true;
+        }
+    }
+
+#ifdef KERNEL
+    return false;
+#else
+    // If both the mantissa and the power of ten are exactly representable, a single multiplication or
+    // division is correctly rounded. Everything else is close, but may be off in the last bit.
+    double value = static_cast<double>(mantissa);
+    if (mantissa != 0) {
+        if (exponent < 0)
+            value /= power_of_ten(-exponent);
+        else
+            value *= power_of_ten(exponent);
+    }
+    m_number = JsonValue(negative ? -value : value);
+    return true;
+#endif
+}
+
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/GenericLexer.h>
+#include <AK/JsonValue.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A pull parser that walks a JSON document one event at a time, without building a JsonValue tree.
+// Keys and strings are handed out as views into the input, so the input must outlive the parser.
+// Nothing is allocated unless the document nests deeper than the inline capacity of the state stack,
+// or the caller asks for an unescaped copy of a string.
+class JsonPullParser : private GenericLexer {
+public:
+    enum class Event : u8 {
+        ObjectStart,
+        ObjectEnd,
+        ArrayStart,
+        ArrayEnd,
+        Key,
+        String,
+        Number,
+        True,
+        False,
+        Null,
+        EndOfInput,
+        Error,
+    };
+
+    explicit JsonPullParser(StringView const& input)
+        : GenericLexer(input)
+    {
+    }
+
+    // Once EndOfInput or Error has been returned, every further call returns the same event.
+    Event next();
+
+    // Skips over the rest of the value started by the last event. For ObjectStart and ArrayStart,
+    // this consumes everything up to and including the matching end event.
+    bool skip_value();
+
+    // The contents of the last Key or String, between the quotes and with any escape sequences intact.
+    StringView raw_string() const { return m_string; }
+    bool string_has_escapes() const { return m_string_has_escapes; }
+    // The contents of the last Key or String, with escape sequences resolved.
+    String string() const;
+
+    // The last Number, typed the same way as JsonParser would type it.
+    JsonValue const& number() const { return m_number; }
+
+    size_t depth() const { return m_stack.size(); }
+
+    static String unescape_string(StringView raw_string);
+
+private:
+    enum class State : u8 {
+        ObjectStart,
+        ObjectValue,
+        ObjectNext,
+        ArrayStart,
+        ArrayNext,
+    };
+
+    Event consume_value();
+    Event consume_key();
+    Event end_container(Event);
+    Event fail() { return m_event = Event::Error; }
+
+    bool consume_string();
+    bool consume_number();
+
+    Vector<State, 32> m_stack;
+    Event m_event { Event::Null };
+    bool m_consumed_root { false };
+
+    StringView m_string;
+    bool m_string_has_escapes { false };
+    JsonValue m_number;
+};
+
+}
+
+using AK::JsonPullParser;
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/QuickSort.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+namespace Detail {
+
+// Runs of this many elements are insertion sorted before merging starts.
+constexpr size_t merge_sort_run_size = 24;
+
+// Merges the sorted runs [begin, middle) and [middle, end). `buffer` is scratch space that can be reused between calls.
+template<typename Collection, typename LessThan, typename Buffer>
+void merge_sorted_runs(Collection& collection, size_t begin, size_t middle, size_t end, LessThan& less_than, Buffer& buffer)
+{
+    if (begin == middle || middle == end || !less_than(collection[middle], collection[middle - 1]))
+        return;
+
+    // Elements at the start of the left run that aren't greater than the first element of the right run are already in place.
+    while (!less_than(collection[middle], collection[begin]))
+        ++begin;
+
+    buffer.clear_with_capacity();
+    buffer.ensure_capacity(middle - begin);
+    for (size_t i = begin; i < middle; ++i)
+        buffer.unchecked_append(move(collection[i]));
+
+    size_t left = 0;
+    size_t right = middle;
+    size_t output = begin;
+    while (left < buffer.size() && right < end) {
+        // Only take from the right run if it's strictly smaller, so that equal elements keep their order.
+        if (less_than(collection[right], buffer[left]))
+            collection[output++] = move(collection[right++]);
+        else
+            collection[output++] = move(buffer[left++]);
+    }
+    while (left < buffer.size())
+        collection[output++] = move(buffer[left++]);
+}
+
+}
+
+/* A stable, bottom-up merge sort: runs of a few elements are insertion sorted, and then
+ * merged pairwise. Runs that are already in order are not touched, so sorted input
+ * takes linear time. Needs scratch space for half of the elements.
+ */
+template<typename Collection, typename LessThan>
+void merge_sort(Collection& collection, size_t begin, size_t end, LessThan less_than)
+{
+    if (begin >= end || end - begin < 2)
+        return;
+
+    for (size_t run_begin = begin; run_begin < end; run_begin += Detail::merge_sort_run_size)
+        Detail::insertion_sort(collection, run_begin, min(run_begin + Detail::merge_sort_run_size, end), less_than);
+
+    Vector<RemoveCVReference<decltype(collection[begin])>> buffer;
+    for (size_t width = Detail::merge_sort_run_size; width < end - begin; width *= 2) {
+        for (size_t run_begin = begin; run_begin < end && end - run_begin > width; run_begin += 2 * width)
+            Detail::merge_sorted_runs(collection, run_begin, run_begin + width, min(run_begin + 2 * width, end), less_than, buffer);
+    }
+}
+
+template<typename Collection, typename LessThan>
+void merge_sort(Collection& collection, LessThan less_than)
+{
+    merge_sort(collection, 0, collection.size(), move(less_than));
+}
+
+template<typename Collection>
+void merge_sort(Collection& collection)
+{
+    merge_sort(collection, 0, collection.size(), [](auto& a, auto& b) { return a < b; });
+}
+
+}
+
+using AK::merge_sort;
@@ -7,13 +7,13 @@
 #pragma once
 
 #include <AK/StdLibExtras.h>
+#include <AK/Types.h>
 
 namespace AK {
 
 /* This is a dual pivot quick sort. It is quite a bit faster than the single
- * pivot quick_sort below. The other quick_sort below should only be used when
- * you are stuck with simple iterators to a container and you don't have access
- * to the container itself.
+ * pivot quick_sort below, but both have been superseded by the pattern-defeating
+ * quick sort further down, which is what quick_sort() uses.
  */
 template<typename Collection, typename LessThan>
 void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than)
@@ -124,28 +124,413 @@ void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
     }
 }
 
+namespace Detail {
+
+// Lets the index based sorts work on a pair of random access iterators.
 template<typename Iterator>
-void quick_sort(Iterator start, Iterator end)
+class IteratorSlice {
+public:
+    explicit IteratorSlice(Iterator start)
+        : m_start(start)
+    {
+    }
+
+    decltype(auto) operator[](size_t index) { return *(m_start + static_cast<ptrdiff_t>(index)); }
+
+private:
+    Iterator m_start;
+};
+
+// Moves the element at `index` into place in the sorted range [begin, index), and returns how far it moved.
+// Elements only move past strictly greater ones, so this is stable.
+template<typename Collection, typename LessThan>
+size_t insert_into_sorted_range(Collection& collection, size_t begin, size_t index, LessThan& less_than)
+{
+    if (!less_than(collection[index], collection[index - 1]))
+        return 0;
+
+    size_t position = index;
+    if constexpr (IsLvalueReference<decltype(collection[index])>) {
+        auto value = move(collection[index]);
+        do {
+            collection[position] = move(collection[position - 1]);
+            --position;
+        } while (position > begin && less_than(value, collection[position - 1]));
+        collection[position] = move(value);
+    } else {
+        // The collection hands out proxies (like LibC's qsort does), so all we can do is swap.
+        do {
+            swap(collection[position], collection[position - 1]);
+            --position;
+        } while (position > begin && less_than(collection[position], collection[position - 1]));
+    }
+    return index - position;
+}
+
+template<typename Collection, typename LessThan>
+void insertion_sort(Collection& collection, size_t begin, size_t end, LessThan& less_than)
+{
+    for (size_t i = begin + 1; i < end; ++i)
+        insert_into_sorted_range(collection, begin, i, less_than);
+}
+
+}
+
+namespace Detail::PatternDefeatingQuickSort {
+
+// Partitions smaller than this are insertion sorted.
+constexpr size_t insertion_sort_threshold = 24;
+// Partitions larger than this pick their pivot with Tukey's ninther instead of a median of three.
+constexpr size_t ninther_threshold = 128;
+// The optimistic insertion sort for (nearly) sorted partitions gives up after moving this many elements.
+constexpr size_t partial_insertion_sort_limit = 8;
+// Number of elements that are classified at once by the block partitioning.
+constexpr size_t block_size = 64;
+
+struct PartitionResult {
+    size_t pivot_position;
+    bool was_already_partitioned;
+};
+
+template<typename Collection, typename LessThan>
+bool partial_insertion_sort(Collection& collection, size_t begin, size_t end, LessThan& less_than)
+{
+    size_t moved_count = 0;
+    for (size_t i = begin + 1; i < end; ++i) {
+        moved_count += insert_into_sorted_range(collection, begin, i, less_than);
+        if (moved_count > partial_insertion_sort_limit)
+            return false;
+    }
+    return true;
+}
+
+template<typename Collection, typename LessThan>
+void sort2(Collection& collection, size_t a, size_t b, LessThan& less_than)
+{
+    if (less_than(collection[b], collection[a]))
+        swap(collection[a], collection[b]);
+}
+
+template<typename Collection, typename LessThan>
+void sort3(Collection& collection, size_t a, size_t b, size_t c, LessThan& less_than)
+{
+    sort2(collection, a, b, less_than);
+    sort2(collection, b, c, less_than);
+    sort2(collection, a, b, less_than);
+}
+
+template<typename Collection, typename LessThan>
+void sift_down(Collection& collection, size_t begin, size_t root, size_t size, LessThan& less_than)
+{
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= size)
+            return;
+        if (child + 1 < size && less_than(collection[begin + child], collection[begin + child + 1]))
+            ++child;
+        if (!less_than(collection[begin + root], collection[begin + child]))
+            return;
+        swap(collection[begin + root], collection[begin + child]);
+        root = child;
+    }
+}
+
+template<typename Collection, typename LessThan>
+void heap_sort(Collection& collection, size_t begin, size_t end, LessThan& less_than)
 {
-    single_pivot_quick_sort(start, end, [](auto& a, auto& b) { return a < b; });
+    size_t size = end - begin;
+    for (size_t i = size / 2; i-- > 0;)
+        sift_down(collection, begin, i, size, less_than);
+    for (size_t i = size - 1; i > 0; --i) {
+        swap(collection[begin], collection[begin + i]);
+        sift_down(collection, begin, 0, i, less_than);
+    }
+}
+
+// Partitions [begin, end) around the pivot at `begin`: elements less than the pivot end up on its left, the others on its right.
+// NOTE: The scans that are not bounded by an element we've already compared against the pivot are bounds checked, so that
+//       a comparator which isn't a strict weak ordering leaves the collection unsorted instead of running off its end.
+template<typename Collection, typename LessThan>
+PartitionResult partition_right(Collection& collection, size_t begin, size_t end, LessThan& less_than)
+{
+    auto&& pivot = collection[begin];
+    size_t first = begin;
+    size_t last = end;
+
+    while (++first < end && less_than(collection[first], pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !less_than(collection[--last], pivot)) {
+        }
+    } else {
+        while (!less_than(collection[--last], pivot)) {
+        }
+    }
+
+    // If the first pair of misplaced elements already crossed, there was nothing to swap.
+    bool was_already_partitioned = first >= last;
+    while (first < last) {
+        swap(collection[first], collection[last]);
+        while (less_than(collection[++first], pivot)) {
+        }
+        while (!less_than(collection[--last], pivot)) {
+        }
+    }
+
+    size_t pivot_position = first - 1;
+    if (pivot_position != begin)
+        swap(collection[begin], collection[pivot_position]);
+    return { pivot_position, was_already_partitioned };
+}
+
+// Same as partition_right(), but with the block partitioning from "BlockQuicksort: How Branch Mispredictions don't affect
+// Quicksort" (Edelkamp and Weiß, 2016): comparisons only fill buffers with the offsets of misplaced elements, and these are
+// swapped in a separate pass. This avoids a hard to predict branch per element, which pays off for cheap comparisons.
+template<typename Collection, typename LessThan>
+PartitionResult partition_right_branchless(Collection& collection, size_t begin, size_t end, LessThan& less_than)
+{
+    auto pivot = collection[begin];
+    size_t first = begin;
+    size_t last = end;
+
+    while (++first < end && less_than(collection[first], pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !less_than(collection[--last], pivot)) {
+        }
+    } else {
+        while (!less_than(collection[--last], pivot)) {
+        }
+    }
+
+    bool was_already_partitioned = first >= last;
+    if (!was_already_partitioned) {
+        swap(collection[first], collection[last]);
+        ++first;
+
+        u8 left_offsets[block_size];
+        u8 right_offsets[block_size];
+        size_t left_base = first;
+        size_t right_base = last;
+        size_t left_count = 0;
+        size_t right_count = 0;
+        size_t left_start = 0;
+        size_t right_start = 0;
+
+        while (first < last) {
+            // Only refill the buffers that have run empty, and split the remaining elements between them.
+            size_t unknown_count = last - first;
+            size_t left_split = left_count == 0 ? (right_count == 0 ? unknown_count / 2 : unknown_count) : 0;
+            size_t right_split = right_count == 0 ? unknown_count - left_split : 0;
+
+            size_t left_scan_count = min(left_split, block_size);
+            for (size_t i = 0; i < left_scan_count; ++i) {
+                left_offsets[left_count] = i;
+                left_count += !less_than(collection[first], pivot);
+                ++first;
+            }
+            size_t right_scan_count = min(right_split, block_size);
+            for (size_t i = 0; i < right_scan_count;) {
+                right_offsets[right_count] = ++i;
+                right_count += less_than(collection[--last], pivot);
+            }
+
+            size_t swap_count = min(left_count, right_count);
+            for (size_t i = 0; i < swap_count; ++i)
+                swap(collection[left_base + left_offsets[left_start + i]], collection[right_base - right_offsets[right_start + i]]);
+            left_count -= swap_count;
+            right_count -= swap_count;
+            left_start += swap_count;
+            right_start += swap_count;
+
+            if (left_count == 0) {
+                left_start = 0;
+                left_base = first;
+            }
+            if (right_count == 0) {
+                right_start = 0;
+                right_base = last;
+            }
+        }
+
+        // Everything has been classified, but one of the buffers may still hold misplaced elements.
+        if (left_count) {
+            while (left_count--)
+                swap(collection[left_base + left_offsets[left_start + left_count]], collection[--last]);
+            first = last;
+        }
+        if (right_count) {
+            while (right_count--)
+                swap(collection[right_base - right_offsets[right_start + right_count]], collection[first++]);
+        }
+    }
+
+    size_t pivot_position = first - 1;
+    if (pivot_position != begin)
+        swap(collection[begin], collection[pivot_position]);
+    return { pivot_position, was_already_partitioned };
+}
+
+// Partitions [begin, end) around the pivot at `begin`, putting elements equal to the pivot on its left.
+// This is used when the pivot is known to be the smallest element, so that runs of equal elements are done in one go.
+template<typename Collection, typename LessThan>
+size_t partition_left(Collection& collection, size_t begin, size_t end, LessThan& less_than)
+{
+    auto&& pivot = collection[begin];
+    size_t first = begin;
+    size_t last = end;
+
+    while (--last > begin && less_than(pivot, collection[last])) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !less_than(pivot, collection[++first])) {
+        }
+    } else {
+        while (!less_than(pivot, collection[++first])) {
+        }
+    }
+
+    while (first < last) {
+        swap(collection[first], collection[last]);
+        while (less_than(pivot, collection[--last])) {
+        }
+        while (!less_than(pivot, collection[++first])) {
+        }
+    }
+
+    if (last != begin)
+        swap(collection[begin], collection[last]);
+    return last;
+}
+
+template<typename Collection, typename LessThan>
+void sort_loop(Collection& collection, size_t begin, size_t end, LessThan& less_than, size_t bad_partitions_allowed, bool is_leftmost)
+{
+    using Element = RemoveCVReference<decltype(collection[begin])>;
+    constexpr bool use_block_partition = IsLvalueReference<decltype(collection[begin])> && (IsArithmetic<Element> || IsPointer<Element>);
+
+    for (;;) {
+        size_t size = end - begin;
+        if (size < insertion_sort_threshold) {
+            insertion_sort(collection, begin, end, less_than);
+            return;
+        }
+
+        // Move the pivot to `begin`: the median of three elements, or the pseudo-median of nine for larger partitions.
+        size_t half = size / 2;
+        if (size > ninther_threshold) {
+            sort3(collection, begin, begin + half, end - 1, less_than);
+            sort3(collection, begin + 1, begin + half - 1, end - 2, less_than);
+            sort3(collection, begin + 2, begin + half + 1, end - 3, less_than);
+            sort3(collection, begin + half - 1, begin + half, begin + half + 1, less_than);
+            swap(collection[begin], collection[begin + half]);
+        } else {
+            sort3(collection, begin + half, begin, end - 1, less_than);
+        }
+
+        // The element before this partition was a pivot, so nothing in here is less than it. If it's not less than our pivot
+        // either, the two are equal: gather all elements equal to the pivot on the left, where they don't need any more sorting.
+        if (!is_leftmost && !less_than(collection[begin - 1], collection[begin])) {
+            begin = partition_left(collection, begin, end, less_than) + 1;
+            continue;
+        }
+
+        PartitionResult result;
+        if constexpr (use_block_partition)
+            result = partition_right_branchless(collection, begin, end, less_than);
+        else
+            result = partition_right(collection, begin, end, less_than);
+        size_t pivot_position = result.pivot_position;
+
+        size_t left_size = pivot_position - begin;
+        size_t right_size = end - (pivot_position + 1);
+        if (left_size < size / 8 || right_size < size / 8) {
+            // After too many bad pivots, fall back to heap sort, which guarantees O(n log n).
+            if (--bad_partitions_allowed == 0) {
+                heap_sort(collection, begin, end, less_than);
+                return;
+            }
+
+            // Otherwise, shuffle some elements around to break up whatever pattern led to the bad pivot.
+            if (left_size >= insertion_sort_threshold) {
+                swap(collection[begin], collection[begin + left_size / 4]);
+                swap(collection[pivot_position - 1], collection[pivot_position - left_size / 4]);
+                if (left_size > ninther_threshold) {
+                    swap(collection[begin + 1], collection[begin + left_size / 4 + 1]);
+                    swap(collection[begin + 2], collection[begin + left_size / 4 + 2]);
+                    swap(collection[pivot_position - 2], collection[pivot_position - left_size / 4 - 1]);
+                    swap(collection[pivot_position - 3], collection[pivot_position - left_size / 4 - 2]);
+                }
+            }
+            if (right_size >= insertion_sort_threshold) {
+                swap(collection[pivot_position + 1], collection[pivot_position + 1 + right_size / 4]);
+                swap(collection[end - 1], collection[end - right_size / 4]);
+                if (right_size > ninther_threshold) {
+                    swap(collection[pivot_position + 2], collection[pivot_position + 2 + right_size / 4]);
+                    swap(collection[pivot_position + 3], collection[pivot_position + 3 + right_size / 4]);
+                    swap(collection[end - 2], collection[end - 1 - right_size / 4]);
+                    swap(collection[end - 3], collection[end - 2 - right_size / 4]);
+                }
+            }
+        } else if (result.was_already_partitioned
+            && partial_insertion_sort(collection, begin, pivot_position, less_than)
+            && partial_insertion_sort(collection, pivot_position + 1, end, less_than)) {
+            // Nothing had to be swapped and both sides were (nearly) sorted, which is common for sorted input.
+            return;
+        }
+
+        // Recurse into the left side, and keep looping on the right one.
+        sort_loop(collection, begin, pivot_position, less_than, bad_partitions_allowed, is_leftmost);
+        begin = pivot_position + 1;
+        is_leftmost = false;
+    }
+}
+
+}
+
+/* This is Orson Peters' pattern-defeating quicksort (pdqsort), an introsort that
+ * detects and takes advantage of common input patterns: sorted and reverse sorted
+ * runs finish in linear time, as do runs of equal elements, and a series of bad
+ * pivots makes it fall back to heap sort, so the worst case is O(n log n).
+ * Sorts [begin, end) of anything that can be indexed, and is not stable.
+ */
+template<typename Collection, typename LessThan>
+void pattern_defeating_quick_sort(Collection& collection, size_t begin, size_t end, LessThan less_than)
+{
+    if (begin >= end || end - begin < 2)
+        return;
+
+    size_t bad_partitions_allowed = 0;
+    for (size_t size = end - begin; size > 1; size >>= 1)
+        ++bad_partitions_allowed;
+    Detail::PatternDefeatingQuickSort::sort_loop(collection, begin, end, less_than, bad_partitions_allowed, true);
 }
 
 template<typename Iterator, typename LessThan>
 void quick_sort(Iterator start, Iterator end, LessThan less_than)
 {
-    single_pivot_quick_sort(start, end, move(less_than));
+    if (!(start < end))
+        return;
+    Detail::IteratorSlice slice { start };
+    pattern_defeating_quick_sort(slice, 0, end - start, move(less_than));
+}
+
+template<typename Iterator>
+void quick_sort(Iterator start, Iterator end)
+{
+    quick_sort(start, end, [](auto& a, auto& b) { return a < b; });
 }
 
 template<typename Collection, typename LessThan>
 void quick_sort(Collection& collection, LessThan less_than)
 {
-    dual_pivot_quick_sort(collection, 0, collection.size() - 1, move(less_than));
+    pattern_defeating_quick_sort(collection, 0, collection.size(), move(less_than));
 }
 
 template<typename Collection>
 void quick_sort(Collection& collection)
 {
-    dual_pivot_quick_sort(collection, 0, collection.size() - 1,
+    pattern_defeating_quick_sort(collection, 0, collection.size(),
         [](auto& a, auto& b) { return a < b; });
 }
 
@@ -6,22 +6,106 @@
 
 #pragma once
 
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
 namespace AK {
 
+namespace Detail {
+
+// A word-at-a-time hash in the spirit of wyhash: the input is consumed 16 bytes at a time, and each
+// pair of 64-bit words is mixed with a single folded 64x64->128 bit multiplication.
+static constexpr u64 string_hash_secret[3] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull };
+
+constexpr u64 string_hash_mix(u64 a, u64 b)
+{
+#ifdef __SIZEOF_INT128__
+    auto product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#else
+    u64 a_low = a & 0xffffffff, a_high = a >> 32;
+    u64 b_low = b & 0xffffffff, b_high = b >> 32;
+    u64 low_low = a_low * b_low;
+    u64 high_low = a_high * b_low;
+    u64 low_high = a_low * b_high;
+    u64 high_high = a_high * b_high;
+    u64 cross = (low_low >> 32) + (high_low & 0xffffffff) + low_high;
+    u64 low = (cross << 32) | (low_low & 0xffffffff);
+    u64 high = high_high + (high_low >> 32) + (cross >> 32);
+    return low ^ high;
+#endif
+}
+
+template<typename T>
+constexpr T string_hash_read(char const* characters)
+{
+    if (!is_constant_evaluated()) {
+        T value;
+        __builtin_memcpy(&value, characters, sizeof(value));
+        return value;
+    }
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+        value |= static_cast<T>(static_cast<u8>(characters[i])) << (i * 8);
+    return value;
+}
+
+}
+
 constexpr u32 string_hash(char const* characters, size_t length)
 {
+    using namespace Detail;
+
+    if (length == 0)
+        return 0;
+
+    u64 hash = string_hash_secret[0] ^ length;
+    size_t remaining = length;
+    for (; remaining > 16; remaining -= 16, characters += 16) {
+        auto a = string_hash_read<u64>(characters);
+        auto b = string_hash_read<u64>(characters + 8);
+        hash = string_hash_mix(a ^ string_hash_secret[1], b ^ hash);
+    }
+
+    // The last 1-16 bytes are read with (possibly overlapping) loads from both ends.
+    u64 a = 0;
+    u64 b = 0;
+    if (remaining >= 8) {
+        a = string_hash_read<u64>(characters);
+        b = string_hash_read<u64>(characters + remaining - 8);
+    } else if (remaining >= 4) {
+        a = string_hash_read<u32>(characters);
+        b = string_hash_read<u32>(characters + remaining - 4);
+    } else {
+        a = (static_cast<u64>(static_cast<u8>(characters[0])) << 16)
+            | (static_cast<u64>(static_cast<u8>(characters[remaining / 2])) << 8)
+            | static_cast<u8>(characters[remaining - 1]);
+    }
+    hash = string_hash_mix(a ^ string_hash_secret[1], b ^ hash);
+    hash = string_hash_mix(hash ^ string_hash_secret[2], length ^ string_hash_secret[1]);
+    return static_cast<u32>(hash ^ (hash >> 32));
+}
+
+// Hashes the string as if it were lowercased, without creating a lowercased copy of it.
+constexpr u32 case_insensitive_string_hash(char const* characters, size_t length)
+{
+    constexpr size_t buffer_size = 64;
     u32 hash = 0;
-    for (size_t i = 0; i < length; ++i) {
-        hash += (u32)characters[i];
-        hash += (hash << 10);
-        hash ^= (hash >> 6);
+    while (length) {
+        char buffer[buffer_size] = {};
+        size_t chunk_length = min(length, buffer_size);
+        for (size_t i = 0; i < chunk_length; ++i) {
+            char ch = characters[i];
+            buffer[i] = ch >= 'A' && ch <= 'Z' ? ch + ('a' - 'A') : ch;
+        }
+        hash = hash * 31 + string_hash(buffer, chunk_length);
+        characters += chunk_length;
+        length -= chunk_length;
     }
-    hash += hash << 3;
-    hash ^= hash >> 11;
-    hash += hash << 15;
     return hash;
 }
 
 }
 
+using AK::case_insensitive_string_hash;
 using AK::string_hash;
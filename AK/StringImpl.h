@@ -60,6 +60,9 @@ public:
     {
         if (length() != other.length())
             return false;
+        // Strings that have been hashed before can usually be told apart without looking at them.
+        if (m_has_hash && other.m_has_hash && m_hash != other.m_hash)
+            return false;
         return !__builtin_memcmp(characters(), other.characters(), length());
     }
 
@@ -78,6 +81,14 @@ public:
     bool is_fly() const { return m_fly; }
     void set_fly(Badge<FlyString>, bool fly) const { m_fly = fly; }
 
+    // Lets FlyString reuse the hash it already computed while looking for an existing string.
+    void set_hash(Badge<FlyString>, unsigned hash) const
+    {
+        VERIFY(!m_has_hash || m_hash == hash);
+        m_hash = hash;
+        m_has_hash = true;
+    }
+
 private:
     enum ConstructTheEmptyStringImplTag {
         ConstructTheEmptyStringImpl
@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Forward.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
+
+// An open-addressing hash table in the style of Abseil's "Swiss tables", with the same API as
+// HashTable. Instead of storing the state of each bucket next to its value, it keeps a separate
+// array of one control byte per slot: either a marker (empty, deleted, end of table) or the low
+// 7 bits of the hash of the value in that slot. Lookups probe a whole group of control bytes at
+// once (16 with SSE2, 8 otherwise) and only touch slots whose 7-bit tag matches, so misses rarely
+// look at a value at all and a lookup usually touches at most two cache lines.
+//
+// Removing a value only leaves a tombstone if a probe sequence could have passed through its
+// slot while the group was full, so erase-heavy workloads don't slowly fill up with them.
+
+namespace AK {
+
+namespace Detail {
+
+enum SwissControlByte : i8 {
+    Empty = -128,   // 0b10000000
+    Deleted = -2,   // 0b11111110
+    Sentinel = -1,  // 0b11111111
+    // Full slots store a 7-bit hash tag: 0b0xxxxxxx
+};
+
+static_assert(sizeof(SwissControlByte) == 1);
+
+inline bool swiss_is_full(i8 control) { return control >= 0; }
+inline bool swiss_is_empty_or_deleted(i8 control) { return control < SwissControlByte::Sentinel; }
+
+// A set of matching positions within a group, iterated from the lowest position up.
+template<typename T, size_t Shift>
+class SwissBitMask {
+public:
+    explicit SwissBitMask(T mask)
+        : m_mask(mask)
+    {
+    }
+
+    explicit operator bool() const { return m_mask != 0; }
+    size_t lowest() const { return trailing_zeros(); }
+    void clear_lowest() { m_mask &= m_mask - 1; }
+
+    size_t trailing_zeros() const
+    {
+        if constexpr (sizeof(T) == 8)
+            return __builtin_ctzll(m_mask) >> Shift;
+        else
+            return __builtin_ctz(m_mask) >> Shift;
+    }
+
+    // The mask is assumed to be non-zero.
+    size_t leading_zeros(size_t group_width) const
+    {
+        if constexpr (sizeof(T) == 8)
+            return __builtin_clzll(m_mask) >> Shift;
+        else
+            return (__builtin_clz(m_mask) - (32 - group_width)) >> Shift;
+    }
+
+private:
+    T m_mask { 0 };
+};
+
+#ifdef __SSE2__
+
+class SwissGroup {
+public:
+    static constexpr size_t width = 16;
+    using BitMask = SwissBitMask<u32, 0>;
+
+    explicit SwissGroup(const i8* control)
+        : m_control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control)))
+    {
+    }
+
+    BitMask match(i8 tag) const { return BitMask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), m_control))); }
+    BitMask match_empty() const { return match(SwissControlByte::Empty); }
+    BitMask match_empty_or_deleted() const
+    {
+        return BitMask(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(SwissControlByte::Sentinel), m_control)));
+    }
+
+private:
+    __m128i m_control;
+};
+
+#else
+
+// Matches eight control bytes at a time using ordinary 64-bit arithmetic. This is what the kernel
+// uses, since it can't touch the vector registers.
+class SwissGroup {
+public:
+    static constexpr size_t width = 8;
+    using BitMask = SwissBitMask<u64, 3>;
+
+    explicit SwissGroup(const i8* control)
+    {
+        __builtin_memcpy(&m_control, control, sizeof(m_control));
+    }
+
+    // NOTE: This may report a false positive for a full slot next to a real match; callers
+    //       compare the actual values anyway.
+    BitMask match(i8 tag) const
+    {
+        auto x = m_control ^ (least_significant_bits * static_cast<u8>(tag));
+        return BitMask((x - least_significant_bits) & ~x & most_significant_bits);
+    }
+
+    BitMask match_empty() const { return BitMask(m_control & (~m_control << 6) & most_significant_bits); }
+    BitMask match_empty_or_deleted() const { return BitMask(m_control & (~m_control << 7) & most_significant_bits); }
+
+private:
+    static constexpr u64 least_significant_bits = 0x0101010101010101;
+    static constexpr u64 most_significant_bits = 0x8080808080808080;
+
+    u64 m_control { 0 };
+};
+
+#endif
+
+}
+
+template<typename HashTableType, typename T>
+class SwissHashTableIterator {
+    friend HashTableType;
+
+public:
+    bool operator==(const SwissHashTableIterator& other) const { return m_slot == other.m_slot; }
+    bool operator!=(const SwissHashTableIterator& other) const { return m_slot != other.m_slot; }
+    T& operator*() { return *m_slot; }
+    T* operator->() { return m_slot; }
+    void operator++()
+    {
+        ++m_control;
+        ++m_slot;
+        skip_to_full_slot();
+    }
+
+private:
+    SwissHashTableIterator(const i8* control, T* slot)
+        : m_control(control)
+        , m_slot(slot)
+    {
+        skip_to_full_slot();
+    }
+
+    void skip_to_full_slot()
+    {
+        if (!m_slot)
+            return;
+        while (Detail::swiss_is_empty_or_deleted(*m_control)) {
+            ++m_control;
+            ++m_slot;
+        }
+        if (*m_control == Detail::SwissControlByte::Sentinel)
+            m_slot = nullptr;
+    }
+
+    const i8* m_control { nullptr };
+    T* m_slot { nullptr };
+};
+
+template<typename T, typename TraitsForT>
+class SwissHashTable {
+    using Group = Detail::SwissGroup;
+    using ControlByte = Detail::SwissControlByte;
+
+    // The number of control bytes mirrored after the sentinel, so that a group starting at
+    // any slot can be loaded without wrapping around.
+    static constexpr size_t cloned_control_bytes = Group::width - 1;
+
+public:
+    SwissHashTable() = default;
+    explicit SwissHashTable(size_t capacity) { ensure_capacity(capacity); }
+
+    ~SwissHashTable()
+    {
+        if (!m_control)
+            return;
+
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (Detail::swiss_is_full(m_control[i]))
+                m_slots[i].~T();
+        }
+
+        kfree_sized(m_control, size_in_bytes(m_capacity));
+    }
+
+    SwissHashTable(const SwissHashTable& other)
+    {
+        ensure_capacity(other.size());
+        for (auto& it : other)
+            set(it);
+    }
+
+    SwissHashTable& operator=(const SwissHashTable& other)
+    {
+        SwissHashTable temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    SwissHashTable(SwissHashTable&& other) noexcept
+        : m_control(exchange(other.m_control, nullptr))
+        , m_slots(exchange(other.m_slots, nullptr))
+        , m_size(exchange(other.m_size, 0))
+        , m_capacity(exchange(other.m_capacity, 0))
+        , m_growth_left(exchange(other.m_growth_left, 0))
+    {
+    }
+
+    SwissHashTable& operator=(SwissHashTable&& other) noexcept
+    {
+        SwissHashTable temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(SwissHashTable& a, SwissHashTable& b) noexcept
+    {
+        swap(a.m_control, b.m_control);
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_size, b.m_size);
+        swap(a.m_capacity, b.m_capacity);
+        swap(a.m_growth_left, b.m_growth_left);
+    }
+
+    [[nodiscard]] bool is_empty() const { return !m_size; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    template<typename U, size_t N>
+    void set_from(U (&from_array)[N])
+    {
+        for (size_t i = 0; i < N; ++i) {
+            set(from_array[i]);
+        }
+    }
+
+    void ensure_capacity(size_t capacity)
+    {
+        VERIFY(capacity >= size());
+        if (capacity <= m_size + m_growth_left)
+            return;
+        rehash(capacity_for_size(capacity));
+    }
+
+    bool contains(const T& value) const
+    {
+        return find(value) != end();
+    }
+
+    using Iterator = SwissHashTableIterator<SwissHashTable, T>;
+    using ConstIterator = SwissHashTableIterator<const SwissHashTable, const T>;
+
+    Iterator begin() { return m_size ? Iterator(m_control, m_slots) : end(); }
+    Iterator end() { return Iterator(nullptr, nullptr); }
+    ConstIterator begin() const { return m_size ? ConstIterator(m_control, m_slots) : end(); }
+    ConstIterator end() const { return ConstIterator(nullptr, nullptr); }
+
+    void clear()
+    {
+        *this = SwissHashTable();
+    }
+
+    template<typename U = T>
+    HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behaviour = HashSetExistingEntryBehavior::Replace)
+    {
+        auto hash = TraitsForT::hash(value);
+        if (auto* slot = lookup_with_hash(hash, [&](auto& entry) { return TraitsForT::equals(entry, value); })) {
+            if (existing_entry_behaviour == HashSetExistingEntryBehavior::Keep)
+                return HashSetResult::KeptExistingEntry;
+            *slot = forward<U>(value);
+            return HashSetResult::ReplacedExistingEntry;
+        }
+
+        if (!m_control) [[unlikely]]
+            rehash(minimum_capacity);
+
+        auto index = find_first_non_full(hash);
+        if (m_growth_left == 0 && m_control[index] != ControlByte::Deleted) [[unlikely]] {
+            grow_or_drop_tombstones();
+            index = find_first_non_full(hash);
+        }
+        if (m_control[index] == ControlByte::Empty)
+            --m_growth_left;
+
+        new (&m_slots[index]) T(forward<U>(value));
+        set_control(index, tag_from_hash(hash));
+        ++m_size;
+        return HashSetResult::InsertedNewEntry;
+    }
+
+    template<typename Finder>
+    Iterator find(unsigned hash, Finder finder)
+    {
+        auto* slot = lookup_with_hash(hash, move(finder));
+        return slot ? Iterator(&m_control[slot - m_slots], slot) : end();
+    }
+
+    Iterator find(const T& value)
+    {
+        return find(TraitsForT::hash(value), [&](auto& other) { return TraitsForT::equals(value, other); });
+    }
+
+    template<typename Finder>
+    ConstIterator find(unsigned hash, Finder finder) const
+    {
+        auto* slot = lookup_with_hash(hash, move(finder));
+        return slot ? ConstIterator(&m_control[slot - m_slots], slot) : end();
+    }
+
+    ConstIterator find(const T& value) const
+    {
+        return find(TraitsForT::hash(value), [&](auto& other) { return TraitsForT::equals(value, other); });
+    }
+
+    bool remove(const T& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    void remove(Iterator iterator)
+    {
+        VERIFY(iterator.m_slot);
+        size_t index = iterator.m_slot - m_slots;
+        VERIFY(Detail::swiss_is_full(m_control[index]));
+
+        m_slots[index].~T();
+        --m_size;
+
+        // If there's an empty slot on both sides of this one within a single group's reach,
+        // no probe sequence can ever have skipped over this slot, so it can become empty again.
+        auto index_before = (index - Group::width) & m_capacity;
+        auto empty_before = Group(&m_control[index_before]).match_empty();
+        auto empty_after = Group(&m_control[index]).match_empty();
+        bool was_never_full = empty_before && empty_after
+            && empty_after.trailing_zeros() + empty_before.leading_zeros(Group::width) < Group::width;
+
+        if (was_never_full) {
+            set_control(index, ControlByte::Empty);
+            ++m_growth_left;
+        } else {
+            set_control(index, ControlByte::Deleted);
+        }
+    }
+
+private:
+    static size_t hash_position(unsigned hash) { return hash >> 7; }
+    static i8 tag_from_hash(unsigned hash) { return static_cast<i8>(hash & 0x7f); }
+
+    // Keep the load factor at or below 7/8. This always leaves at least one empty slot, which
+    // is what terminates probe sequences.
+    static size_t capacity_to_growth(size_t capacity) { return capacity * 7 / 8; }
+
+    static size_t capacity_for_size(size_t size)
+    {
+        // Capacities are always of the form 2^n - 1, so they can be used as a mask.
+        size_t capacity = minimum_capacity;
+        while (capacity_to_growth(capacity) < size)
+            capacity = capacity * 2 + 1;
+        return capacity;
+    }
+
+    static constexpr size_t minimum_capacity = 7;
+
+    static size_t slots_offset(size_t capacity)
+    {
+        size_t control_bytes = capacity + 1 + cloned_control_bytes;
+        return (control_bytes + alignof(T) - 1) & ~(alignof(T) - 1);
+    }
+
+    static size_t size_in_bytes(size_t capacity)
+    {
+        return slots_offset(capacity) + capacity * sizeof(T);
+    }
+
+    // Also updates the mirrored copy of the control byte after the sentinel, if there is one.
+    void set_control(size_t index, i8 value)
+    {
+        m_control[index] = value;
+        m_control[((index - cloned_control_bytes) & m_capacity) + (cloned_control_bytes & m_capacity)] = value;
+    }
+
+    template<typename Finder>
+    T* lookup_with_hash(unsigned hash, Finder finder) const
+    {
+        if (is_empty())
+            return nullptr;
+
+        auto tag = tag_from_hash(hash);
+        auto position = hash_position(hash) & m_capacity;
+        for (size_t stride = Group::width;; stride += Group::width) {
+            Group group(&m_control[position]);
+            for (auto matches = group.match(tag); matches; matches.clear_lowest()) {
+                auto index = (position + matches.lowest()) & m_capacity;
+                if (finder(m_slots[index]))
+                    return &m_slots[index];
+            }
+            if (group.match_empty())
+                return nullptr;
+            position = (position + stride) & m_capacity;
+        }
+    }
+
+    size_t find_first_non_full(unsigned hash) const
+    {
+        auto position = hash_position(hash) & m_capacity;
+        for (size_t stride = Group::width;; stride += Group::width) {
+            if (auto available = Group(&m_control[position]).match_empty_or_deleted())
+                return (position + available.lowest()) & m_capacity;
+            position = (position + stride) & m_capacity;
+        }
+    }
+
+    void grow_or_drop_tombstones()
+    {
+        // If at least a quarter of the table is tombstones, reclaim them without growing.
+        if (m_capacity && m_size * 4 <= capacity_to_growth(m_capacity) * 3)
+            rehash(m_capacity);
+        else
+            rehash(m_capacity ? m_capacity * 2 + 1 : minimum_capacity);
+    }
+
+    void rehash(size_t new_capacity)
+    {
+        auto* old_control = m_control;
+        auto* old_slots = m_slots;
+        auto old_capacity = m_capacity;
+
+        m_control = static_cast<i8*>(kmalloc(size_in_bytes(new_capacity)));
+        VERIFY(m_control);
+        m_slots = reinterpret_cast<T*>(reinterpret_cast<u8*>(m_control) + slots_offset(new_capacity));
+        m_capacity = new_capacity;
+        __builtin_memset(m_control, ControlByte::Empty, new_capacity + 1 + cloned_control_bytes);
+        m_control[new_capacity] = ControlByte::Sentinel;
+        m_growth_left = capacity_to_growth(new_capacity) - m_size;
+
+        if (!old_control)
+            return;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (!Detail::swiss_is_full(old_control[i]))
+                continue;
+            auto hash = TraitsForT::hash(old_slots[i]);
+            auto index = find_first_non_full(hash);
+            new (&m_slots[index]) T(move(old_slots[i]));
+            set_control(index, tag_from_hash(hash));
+            old_slots[i].~T();
+        }
+
+        kfree_sized(old_control, size_in_bytes(old_capacity));
+    }
+
+    i8* m_control { nullptr };
+    T* m_slots { nullptr };
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+    size_t m_growth_left { 0 };
+};
+
+}
+
+using AK::SwissHashMap;
+using AK::SwissHashTable;
@@ -49,7 +49,7 @@ struct CanBePlacedInsideVectorHelper<StorageType, false> {
 };
 }
 
-template<typename T, size_t inline_capacity>
+template<typename T, size_t inline_capacity, typename Allocator>
 requires(!IsRvalueReference<T>) class Vector {
 private:
     static constexpr bool contains_reference = IsLvalueReference<T>;
@@ -65,6 +65,12 @@ public:
     {
     }
 
+    explicit Vector(Allocator allocator)
+        : m_capacity(inline_capacity)
+        , m_allocator(move(allocator))
+    {
+    }
+
 #ifndef SERENITY_LIBC_BUILD
     Vector(std::initializer_list<T> list) requires(!IsLvalueReference<T>)
     {
@@ -78,6 +84,7 @@ public:
         : m_size(other.m_size)
         , m_capacity(other.m_capacity)
         , m_outline_buffer(other.m_outline_buffer)
+        , m_allocator(move(other.m_allocator))
     {
         if constexpr (inline_capacity > 0) {
             if (!m_outline_buffer) {
@@ -93,14 +100,15 @@ public:
     }
 
     Vector(Vector const& other)
+        : m_allocator(other.m_allocator)
     {
         ensure_capacity(other.size());
         TypedTransfer<StorageType>::copy(data(), other.data(), other.size());
         m_size = other.size();
     }
 
-    template<size_t other_inline_capacity>
-    Vector(Vector<T, other_inline_capacity> const& other)
+    template<size_t other_inline_capacity, typename OtherAllocator>
+    Vector(Vector<T, other_inline_capacity, OtherAllocator> const& other)
     {
         ensure_capacity(other.size());
         TypedTransfer<StorageType>::copy(data(), other.data(), other.size());
@@ -122,6 +130,8 @@ public:
     ALWAYS_INLINE size_t size() const { return m_size; }
     size_t capacity() const { return m_capacity; }
 
+    Allocator const& allocator() const { return m_allocator; }
+
     StorageType* data()
     {
         if constexpr (inline_capacity > 0)
@@ -306,6 +316,7 @@ public:
             m_size = other.m_size;
             m_capacity = other.m_capacity;
             m_outline_buffer = other.m_outline_buffer;
+            m_allocator = move(other.m_allocator);
             if constexpr (inline_capacity > 0) {
                 if (!m_outline_buffer) {
                     for (size_t i = 0; i < m_size; ++i) {
@@ -332,8 +343,8 @@ public:
         return *this;
     }
 
-    template<size_t other_inline_capacity>
-    Vector& operator=(Vector<T, other_inline_capacity> const& other)
+    template<size_t other_inline_capacity, typename OtherAllocator>
+    Vector& operator=(Vector<T, other_inline_capacity, OtherAllocator> const& other)
     {
         clear();
         ensure_capacity(other.size());
@@ -346,7 +357,7 @@ public:
     {
         clear_with_capacity();
         if (m_outline_buffer) {
-            kfree_sized(m_outline_buffer, m_capacity * sizeof(StorageType));
+            m_allocator.deallocate(m_outline_buffer, m_capacity * sizeof(StorageType));
             m_outline_buffer = nullptr;
         }
         reset_capacity();
@@ -622,8 +633,12 @@ public:
     {
         if (m_capacity >= needed_capacity)
             return true;
-        size_t new_capacity = kmalloc_good_size(needed_capacity * sizeof(StorageType)) / sizeof(StorageType);
-        auto* new_buffer = (StorageType*)kmalloc(new_capacity * sizeof(StorageType));
+        size_t new_capacity = m_allocator.good_size(needed_capacity * sizeof(StorageType)) / sizeof(StorageType);
+        if (m_outline_buffer && m_allocator.try_grow_in_place(m_outline_buffer, m_capacity * sizeof(StorageType), new_capacity * sizeof(StorageType))) {
+            m_capacity = new_capacity;
+            return true;
+        }
+        auto* new_buffer = (StorageType*)m_allocator.allocate(new_capacity * sizeof(StorageType), alignof(StorageType));
         if (new_buffer == nullptr)
             return false;
 
@@ -636,7 +651,7 @@ public:
             }
         }
         if (m_outline_buffer)
-            kfree_sized(m_outline_buffer, m_capacity * sizeof(StorageType));
+            m_allocator.deallocate(m_outline_buffer, m_capacity * sizeof(StorageType));
         m_outline_buffer = new_buffer;
         m_capacity = new_capacity;
         return true;
@@ -780,6 +795,7 @@ private:
 
     alignas(StorageType) unsigned char m_inline_buffer_storage[sizeof(StorageType) * inline_capacity];
     StorageType* m_outline_buffer { nullptr };
+    [[no_unique_address]] Allocator m_allocator;
 };
 
 }
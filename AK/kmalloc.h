@@ -47,3 +47,19 @@ inline size_t malloc_good_size(size_t size) { return size; }
 #endif
 
 using std::nothrow;
+
+namespace AK {
+
+// The allocator that Vector uses unless it's given another one. Allocators hand out raw memory, and are told
+// the size (and, for allocate(), the alignment) of every block. good_size() may round a request up to a size
+// that wastes less memory. try_grow_in_place() may extend a block without moving it.
+struct KmallocAllocator {
+    void* allocate(size_t size, size_t) { return kmalloc(size); }
+    void deallocate(void* pointer, size_t size) { kfree_sized(pointer, size); }
+    bool try_grow_in_place(void*, size_t, size_t) { return false; }
+    size_t good_size(size_t size) const { return kmalloc_good_size(size); }
+};
+
+}
+
+using AK::KmallocAllocator;
@@ -336,7 +336,10 @@ void page_fault_handler(TrapFrame* trap)
     }
 
     PageFault fault { regs.exception_code, VirtualAddress { fault_address } };
+    u64 fault_start_tsc = read_tsc();
     auto response = MM.handle_page_fault(fault);
+    if (current_thread)
+        current_thread->record_page_fault_latency(response, read_tsc() - fault_start_tsc);
 
     if (response == PageFaultResponse::ShouldCrash || response == PageFaultResponse::OutOfMemory) {
         if (faulted_in_kernel && handle_safe_access_fault(regs, fault_address)) {
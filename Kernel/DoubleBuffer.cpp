@@ -5,73 +5,82 @@
  */
 
 #include <AK/StringView.h>
-#include <Kernel/Arch/x86/InterruptDisabler.h>
 #include <Kernel/DoubleBuffer.h>
 
 namespace Kernel {
 
-inline void DoubleBuffer::compute_lockfree_metadata()
-{
-    InterruptDisabler disabler;
-    m_empty = m_read_buffer_index >= m_read_buffer->size && m_write_buffer->size == 0;
-    m_space_for_writing = m_capacity - m_write_buffer->size;
-}
-
+// NOTE: The ring is twice the given capacity, since that's how much data the old pair of buffers
+//       could hold: a full buffer waiting to be read, plus a full one being written.
 DoubleBuffer::DoubleBuffer(size_t capacity)
-    : m_write_buffer(&m_buffer1)
-    , m_read_buffer(&m_buffer2)
-    , m_storage(KBuffer::create_with_size(capacity * 2, Region::Access::Read | Region::Access::Write, "DoubleBuffer"))
-    , m_capacity(capacity)
+    : m_storage(KBuffer::create_with_size(capacity * 2, Region::Access::Read | Region::Access::Write, "DoubleBuffer"))
+    , m_capacity(capacity * 2)
 {
-    m_buffer1.data = m_storage.data();
-    m_buffer1.size = 0;
-    m_buffer2.data = m_storage.data() + capacity;
-    m_buffer2.size = 0;
-    m_space_for_writing = capacity;
-}
-
-void DoubleBuffer::flip()
-{
-    if (m_storage.is_null())
-        return;
-    VERIFY(m_read_buffer_index == m_read_buffer->size);
-    swap(m_read_buffer, m_write_buffer);
-    m_write_buffer->size = 0;
-    m_read_buffer_index = 0;
-    compute_lockfree_metadata();
+    // The read and write positions wrap around at 2^64, so the offsets they map to only stay
+    // continuous across that if the capacity is a power of two.
+    VERIFY(capacity && (capacity & (capacity - 1)) == 0);
 }
 
 KResultOr<size_t> DoubleBuffer::write(const UserOrKernelBuffer& data, size_t size)
 {
     if (!size || m_storage.is_null())
         return 0;
-    Locker locker(m_lock);
-    size_t bytes_to_write = min(size, m_space_for_writing);
-    u8* write_ptr = m_write_buffer->data + m_write_buffer->size;
-    if (!data.read(write_ptr, bytes_to_write))
+    Locker locker(m_write_lock);
+
+    // We're the only writer, so the write position can't change under us.
+    // The reader may concurrently free up more space, but never take any away.
+    size_t write_position = m_write_position.load(AK::MemoryOrder::memory_order_relaxed);
+    size_t bytes_to_write = min(size, space_for_writing());
+    if (!bytes_to_write)
+        return 0;
+
+    // The data may wrap around the end of the storage, in which case we copy it in two parts.
+    size_t offset_in_storage = write_position % m_capacity;
+    size_t first_chunk_size = min(bytes_to_write, m_capacity - offset_in_storage);
+    if (!data.read(m_storage.data() + offset_in_storage, 0, first_chunk_size))
         return EFAULT;
-    m_write_buffer->size += bytes_to_write;
-    compute_lockfree_metadata();
-    if (m_unblock_callback && !m_empty)
+    if (first_chunk_size < bytes_to_write) {
+        if (!data.read(m_storage.data(), first_chunk_size, bytes_to_write - first_chunk_size))
+            return EFAULT;
+    }
+
+    m_write_position.store(write_position + bytes_to_write, AK::MemoryOrder::memory_order_release);
+    if (m_unblock_callback)
         m_unblock_callback();
     return bytes_to_write;
 }
 
+KResultOr<size_t> DoubleBuffer::copy_out(UserOrKernelBuffer& data, size_t size, size_t& read_position)
+{
+    // We're the only reader, so the read position can't change under us.
+    // The writer may concurrently add more data, but never take any away.
+    read_position = m_read_position.load(AK::MemoryOrder::memory_order_relaxed);
+    size_t nread = min(used_size(), size);
+    if (!nread)
+        return 0;
+
+    size_t offset_in_storage = read_position % m_capacity;
+    size_t first_chunk_size = min(nread, m_capacity - offset_in_storage);
+    if (!data.write(m_storage.data() + offset_in_storage, 0, first_chunk_size))
+        return EFAULT;
+    if (first_chunk_size < nread) {
+        if (!data.write(m_storage.data(), first_chunk_size, nread - first_chunk_size))
+            return EFAULT;
+    }
+    return nread;
+}
+
 KResultOr<size_t> DoubleBuffer::read(UserOrKernelBuffer& data, size_t size)
 {
     if (!size || m_storage.is_null())
         return 0;
-    Locker locker(m_lock);
-    if (m_read_buffer_index >= m_read_buffer->size && m_write_buffer->size != 0)
-        flip();
-    if (m_read_buffer_index >= m_read_buffer->size)
-        return 0;
-    size_t nread = min(m_read_buffer->size - m_read_buffer_index, size);
-    if (!data.write(m_read_buffer->data + m_read_buffer_index, nread))
-        return EFAULT;
-    m_read_buffer_index += nread;
-    compute_lockfree_metadata();
-    if (m_unblock_callback && m_space_for_writing > 0)
+    Locker locker(m_read_lock);
+    size_t read_position = 0;
+    auto nread_or_error = copy_out(data, size, read_position);
+    if (nread_or_error.is_error() || nread_or_error.value() == 0)
+        return nread_or_error;
+    size_t nread = nread_or_error.value();
+    m_read_position.store(read_position + nread, AK::MemoryOrder::memory_order_release);
+    if (m_unblock_callback)
         m_unblock_callback();
     return nread;
 }
@@ -80,19 +89,9 @@ KResultOr<size_t> DoubleBuffer::peek(UserOrKernelBuffer& data, size_t size)
 {
     if (!size || m_storage.is_null())
         return 0;
-    Locker locker(m_lock);
-    if (m_read_buffer_index >= m_read_buffer->size && m_write_buffer->size != 0) {
-        flip();
-    }
-    if (m_read_buffer_index >= m_read_buffer->size)
-        return 0;
-    size_t nread = min(m_read_buffer->size - m_read_buffer_index, size);
-    if (!data.write(m_read_buffer->data + m_read_buffer_index, nread))
-        return EFAULT;
-    compute_lockfree_metadata();
-    if (m_unblock_callback && m_space_for_writing > 0)
-        m_unblock_callback();
-    return nread;
+    Locker locker(m_read_lock);
+    size_t read_position = 0;
+    return copy_out(data, size, read_position);
 }
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Types.h>
 #include <Kernel/KBuffer.h>
 #include <Kernel/Lock.h>
@@ -14,6 +15,11 @@
 
 namespace Kernel {
 
+// NOTE: Despite its name, this is a single ring buffer these days.
+//       Writers are serialized by one lock and readers by another, and the two sides only
+//       communicate through the atomic read/write positions. So a writer and a reader (e.g the
+//       two ends of a LocalSocket) don't contend with each other, and can copy data in and out of
+//       the buffer at the same time. Data is still copied in and out; nothing is remapped.
 class DoubleBuffer {
 public:
     explicit DoubleBuffer(size_t capacity = 65536);
@@ -36,9 +42,9 @@ public:
         return peek(buffer, size);
     }
 
-    bool is_empty() const { return m_empty; }
+    bool is_empty() const { return used_size() == 0; }
 
-    size_t space_for_writing() const { return m_space_for_writing; }
+    size_t space_for_writing() const { return m_capacity - used_size(); }
 
     void set_unblock_callback(Function<void()> callback)
     {
@@ -47,26 +53,26 @@ public:
     }
 
 private:
-    void flip();
-    void compute_lockfree_metadata();
-
-    struct InnerBuffer {
-        u8* data { nullptr };
-        size_t size;
-    };
+    size_t used_size() const
+    {
+        // NOTE: Load the read position first, so we never see it ahead of the write position.
+        size_t read_position = m_read_position.load(AK::MemoryOrder::memory_order_acquire);
+        size_t write_position = m_write_position.load(AK::MemoryOrder::memory_order_acquire);
+        return write_position - read_position;
+    }
 
-    InnerBuffer* m_write_buffer { nullptr };
-    InnerBuffer* m_read_buffer { nullptr };
-    InnerBuffer m_buffer1;
-    InnerBuffer m_buffer2;
+    KResultOr<size_t> copy_out(UserOrKernelBuffer&, size_t size, size_t& read_position);
 
     KBuffer m_storage;
     Function<void()> m_unblock_callback;
     size_t m_capacity { 0 };
-    size_t m_read_buffer_index { 0 };
-    size_t m_space_for_writing { 0 };
-    bool m_empty { true };
-    mutable Lock m_lock { "DoubleBuffer" };
+
+    // These only ever increase; the offset into the storage is the position modulo the capacity.
+    Atomic<size_t> m_read_position { 0 };
+    Atomic<size_t> m_write_position { 0 };
+
+    mutable Lock m_read_lock { "DoubleBuffer read" };
+    mutable Lock m_write_lock { "DoubleBuffer write" };
 };
 
 }
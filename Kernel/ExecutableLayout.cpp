@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/ExecutableLayout.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/VM/MemoryManager.h>
+#include <Kernel/VM/Region.h>
+#include <Kernel/VM/SharedInodeVMObject.h>
+#include <LibELF/Image.h>
+
+namespace Kernel {
+
+KResultOr<NonnullRefPtr<ExecutableLayout>> ExecutableLayout::get_or_create(Inode& inode)
+{
+    auto metadata = inode.metadata();
+    if (auto layout = inode.executable_layout(); layout && layout->is_up_to_date(metadata.size, metadata.mtime))
+        return layout.release_nonnull();
+
+    auto layout_or_error = try_parse(inode, metadata.size, metadata.mtime);
+    if (layout_or_error.is_error())
+        return layout_or_error.error();
+    inode.set_executable_layout(layout_or_error.value());
+    return layout_or_error.release_value();
+}
+
+KResultOr<NonnullRefPtr<ExecutableLayout>> ExecutableLayout::try_parse(Inode& inode, u64 size, time_t mtime)
+{
+    auto vmobject = SharedInodeVMObject::try_create_with_inode(inode);
+    if (!vmobject) {
+        dbgln("ExecutableLayout: Unable to allocate SharedInodeVMObject");
+        return ENOMEM;
+    }
+
+    auto region = MM.allocate_kernel_region_with_vmobject(*vmobject, page_round_up(size), "ELF layout parsing", Region::Access::Read);
+    if (!region) {
+        dbgln("ExecutableLayout: Could not allocate memory for ELF parsing");
+        return ENOMEM;
+    }
+
+    auto elf_image = ELF::Image(region->vaddr().as_ptr(), size);
+    if (!elf_image.is_valid())
+        return ENOEXEC;
+
+    auto layout = adopt_ref_if_nonnull(new (nothrow) ExecutableLayout(size, mtime));
+    if (!layout)
+        return ENOMEM;
+
+    layout->m_entry = elf_image.entry();
+
+    if (!layout->m_program_headers.try_ensure_capacity(elf_image.program_header_count()))
+        return ENOMEM;
+
+    elf_image.for_each_program_header([&](const ELF::Image::ProgramHeader& program_header) {
+        layout->m_program_headers.unchecked_append({
+            .type = program_header.type(),
+            .flags = program_header.flags(),
+            .offset = program_header.offset(),
+            .vaddr = program_header.vaddr(),
+            .size_in_image = program_header.size_in_image(),
+            .size_in_memory = program_header.size_in_memory(),
+            .alignment = program_header.alignment(),
+        });
+
+        if (program_header.type() == PT_TLS || (program_header.type() == PT_LOAD && program_header.is_writable()))
+            layout->m_needs_image_data = true;
+
+        if (program_header.type() != PT_LOAD)
+            return;
+
+        auto region_start = program_header.vaddr().get();
+        auto region_end = region_start + program_header.size_in_memory();
+        if (layout->m_load_range_start == 0 || region_start < layout->m_load_range_start)
+            layout->m_load_range_start = region_start;
+        if (layout->m_load_range_end == 0 || region_end > layout->m_load_range_end)
+            layout->m_load_range_end = region_end;
+    });
+
+    return layout.release_nonnull();
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <Kernel/Forward.h>
+#include <Kernel/KResult.h>
+#include <Kernel/UnixTypes.h>
+#include <Kernel/VirtualAddress.h>
+#include <LibC/elf.h>
+
+namespace Kernel {
+
+// The program header layout of an executable, parsed and validated once and then cached on
+// its inode. Repeatedly exec'ing the same program (or interpreter) can then skip building an
+// ELF::Image, which validates the headers and walks the section header table, touching pages
+// at both ends of the file.
+//
+// A cached layout is tagged with the size and modification time of the inode it was parsed
+// from. Inodes also drop their layout when their contents are modified, so the tag is only a
+// safety net for file systems that don't report modifications.
+class ExecutableLayout : public RefCounted<ExecutableLayout> {
+public:
+    struct ProgramHeader {
+        u32 type { 0 };
+        u32 flags { 0 };
+        u32 offset { 0 };
+        VirtualAddress vaddr;
+        u32 size_in_image { 0 };
+        u32 size_in_memory { 0 };
+        u32 alignment { 0 };
+
+        bool is_readable() const { return flags & PF_R; }
+        bool is_writable() const { return flags & PF_W; }
+        bool is_executable() const { return flags & PF_X; }
+    };
+
+    static KResultOr<NonnullRefPtr<ExecutableLayout>> get_or_create(Inode&);
+
+    VirtualAddress entry() const { return m_entry; }
+    Vector<ProgramHeader> const& program_headers() const { return m_program_headers; }
+
+    // Whether loading needs the file contents (to copy TLS or writable PT_LOAD data out of it),
+    // as opposed to just mapping the inode.
+    bool needs_image_data() const { return m_needs_image_data; }
+
+    // The lowest and highest address covered by a PT_LOAD segment.
+    FlatPtr load_range_start() const { return m_load_range_start; }
+    FlatPtr load_range_end() const { return m_load_range_end; }
+
+private:
+    ExecutableLayout(u64 size, time_t mtime)
+        : m_size(size)
+        , m_mtime(mtime)
+    {
+    }
+
+    static KResultOr<NonnullRefPtr<ExecutableLayout>> try_parse(Inode&, u64 size, time_t mtime);
+    bool is_up_to_date(u64 size, time_t mtime) const { return m_size == size && m_mtime == mtime; }
+
+    u64 m_size { 0 };
+    time_t m_mtime { 0 };
+    VirtualAddress m_entry;
+    Vector<ProgramHeader> m_program_headers;
+    bool m_needs_image_data { false };
+    FlatPtr m_load_range_start { 0 };
+    FlatPtr m_load_range_end { 0 };
+};
+
+}
@@ -10,6 +10,7 @@
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <Kernel/API/InodeWatcherEvent.h>
+#include <Kernel/ExecutableLayout.h>
 #include <Kernel/FileSystem/Custody.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/FileSystem/InodeWatcher.h>
@@ -238,6 +239,7 @@ void Inode::did_remove_child(InodeIdentifier const&, String const& name)
 void Inode::did_modify_contents()
 {
     Locker locker(m_lock);
+    m_executable_layout = nullptr;
     for (auto& watcher : m_watchers) {
         watcher->notify_inode_event({}, identifier(), InodeWatcherEvent::Type::ContentModified);
     }
@@ -278,4 +280,16 @@ bool Inode::is_shared_vmobject(const SharedInodeVMObject& other) const
     return m_shared_vmobject.unsafe_ptr() == &other;
 }
 
+RefPtr<ExecutableLayout> Inode::executable_layout() const
+{
+    Locker locker(m_lock);
+    return m_executable_layout;
+}
+
+void Inode::set_executable_layout(ExecutableLayout& layout)
+{
+    Locker locker(m_lock);
+    m_executable_layout = layout;
+}
+
 }
@@ -90,6 +90,9 @@ public:
     RefPtr<SharedInodeVMObject> shared_vmobject() const;
     bool is_shared_vmobject(const SharedInodeVMObject&) const;
 
+    RefPtr<ExecutableLayout> executable_layout() const;
+    void set_executable_layout(ExecutableLayout&);
+
     static void sync();
 
     bool has_watchers() const { return !m_watchers.is_empty(); }
@@ -115,6 +118,7 @@ private:
     FileSystem& m_file_system;
     InodeIndex m_index { 0 };
     WeakPtr<SharedInodeVMObject> m_shared_vmobject;
+    RefPtr<ExecutableLayout> m_executable_layout;
     RefPtr<LocalSocket> m_socket;
     HashTable<InodeWatcher*> m_watchers;
     bool m_metadata_dirty { false };
@@ -20,6 +20,7 @@ class DevFSRootDirectoryInode;
 class Device;
 class DiskCache;
 class DoubleBuffer;
+class ExecutableLayout;
 class File;
 class FileDescription;
 class FileSystem;
@@ -36,20 +36,23 @@ u32 FutexQueue::wake_n_requeue(u32 wake_count, const Function<FutexQueue*()>& ge
     dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: wake_n_requeue({}, {})", this, wake_count, requeue_count);
 
     u32 did_wake = 0, did_requeue = 0;
-    do_unblock([&](Thread::Blocker& b, void* data, bool& stop_iterating) {
-        VERIFY(data);
-        VERIFY(b.blocker_type() == Thread::Blocker::Type::Futex);
-        auto& blocker = static_cast<Thread::FutexBlocker&>(b);
-
-        dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: wake_n_requeue unblocking {}", this, *static_cast<Thread*>(data));
-        VERIFY(did_wake < wake_count);
-        if (blocker.unblock()) {
-            if (++did_wake >= wake_count)
-                stop_iterating = true;
-            return true;
-        }
-        return false;
-    });
+    // A wake count of zero is valid, and means that waiters are only requeued.
+    if (wake_count > 0) {
+        do_unblock([&](Thread::Blocker& b, void* data, bool& stop_iterating) {
+            VERIFY(data);
+            VERIFY(b.blocker_type() == Thread::Blocker::Type::Futex);
+            auto& blocker = static_cast<Thread::FutexBlocker&>(b);
+
+            dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: wake_n_requeue unblocking {}", this, *static_cast<Thread*>(data));
+            VERIFY(did_wake < wake_count);
+            if (blocker.unblock()) {
+                if (++did_wake >= wake_count)
+                    stop_iterating = true;
+                return true;
+            }
+            return false;
+        });
+    }
     is_empty = is_empty_and_no_imminent_waits_locked();
     if (requeue_count > 0) {
         auto blockers_to_requeue = do_take_blockers(requeue_count);
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Atomic.h>
+#include <AK/HashMap.h>
 #include <AK/RefCounted.h>
 #include <Kernel/SpinLock.h>
 #include <Kernel/Thread.h>
@@ -53,8 +55,53 @@ private:
     const FlatPtr m_user_address_or_offset;
     WeakPtr<VMObject> m_vmobject;
     const bool m_is_global;
-    size_t m_imminent_waits { 1 }; // We only create this object if we're going to be waiting, so start out with 1
+    size_t m_imminent_waits { 0 };
     bool m_was_removed { false };
 };
 
+struct FutexKey {
+    // Private futexes are keyed by their user space address in the owning process,
+    // global futexes by the VMObject and the offset into it.
+    VMObject* vmobject { nullptr };
+    FlatPtr user_address_or_offset { 0 };
+
+    bool operator==(const FutexKey& other) const { return vmobject == other.vmobject && user_address_or_offset == other.user_address_or_offset; }
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Kernel::FutexKey> : public GenericTraits<Kernel::FutexKey> {
+    static unsigned hash(const Kernel::FutexKey& key) { return pair_int_hash(ptr_hash(key.vmobject), ptr_hash(key.user_address_or_offset)); }
+};
+
+}
+
+namespace Kernel {
+
+struct FutexBucket {
+    SpinLock<u8> lock;
+    HashMap<FutexKey, RefPtr<FutexQueue>> queues;
+};
+
+// A hash table of futex queues split into buckets with their own lock, so that
+// operations on unrelated futexes don't contend with each other.
+template<size_t bucket_count>
+class FutexTable {
+public:
+    FutexBucket& bucket_for(const FutexKey& key) { return m_buckets[Traits<FutexKey>::hash(key) % bucket_count]; }
+
+    template<typename Callback>
+    void for_each_bucket(Callback callback)
+    {
+        for (auto& bucket : m_buckets)
+            callback(bucket);
+    }
+
+private:
+    Array<FutexBucket, bucket_count> m_buckets;
+};
+
 }
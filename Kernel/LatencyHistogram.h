@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// A cheap, always-on latency histogram. Samples are TSC cycle counts, and bucket N
+// counts the samples whose value has its highest set bit at position N, i.e samples in
+// the range [2^N, 2^(N+1)). Everything that doesn't fit in the last bucket ends up there.
+//
+// A histogram is only ever updated by the thread that owns it, so there is no locking.
+// Readers (e.g ProcFS) may observe slightly inconsistent values, which is fine for statistics.
+class LatencyHistogram {
+public:
+    static constexpr size_t bucket_count = 40;
+
+    void record(u64 cycles)
+    {
+        ++m_count;
+        m_total_cycles += cycles;
+        if (cycles > m_max_cycles)
+            m_max_cycles = cycles;
+        ++m_buckets[bucket_for(cycles)];
+    }
+
+    u64 count() const { return m_count; }
+    u64 total_cycles() const { return m_total_cycles; }
+    u64 max_cycles() const { return m_max_cycles; }
+    u32 bucket(size_t index) const { return m_buckets[index]; }
+
+    template<typename Builder>
+    void serialize(JsonObjectSerializer<Builder>& object) const
+    {
+        object.add("count", m_count);
+        object.add("total_cycles", m_total_cycles);
+        object.add("max_cycles", m_max_cycles);
+        auto buckets = object.add_array("log2_buckets");
+        // Trailing empty buckets are omitted to keep the output small.
+        size_t used_bucket_count = bucket_count;
+        while (used_bucket_count > 0 && m_buckets[used_bucket_count - 1] == 0)
+            --used_bucket_count;
+        for (size_t i = 0; i < used_bucket_count; ++i)
+            buckets.add(m_buckets[i]);
+    }
+
+private:
+    static size_t bucket_for(u64 cycles)
+    {
+        if (cycles == 0)
+            return 0;
+        size_t highest_bit = 63 - __builtin_clzll(cycles);
+        return min(highest_bit, bucket_count - 1);
+    }
+
+    u64 m_count { 0 };
+    u64 m_total_cycles { 0 };
+    u64 m_max_cycles { 0 };
+    Array<u32, bucket_count> m_buckets {};
+};
+
+}
@@ -80,8 +80,6 @@ enum class VeilState {
     Locked,
 };
 
-typedef HashMap<FlatPtr, RefPtr<FutexQueue>> FutexQueues;
-
 struct LoadResult;
 
 class ProtectedProcessBase {
@@ -699,8 +697,7 @@ private:
 
     OwnPtr<PerformanceEventBuffer> m_perf_event_buffer;
 
-    FutexQueues m_futex_queues;
-    SpinLock<u8> m_futex_lock;
+    FutexTable<16> m_futex_table;
 
     // This member is used in the implementation of ptrace's PT_TRACEME flag.
     // If it is set to true, the process will stop at the next execve syscall
@@ -139,6 +139,7 @@ class ProcFSProcessDirectory final
     friend class ProcFSProcessCurrentWorkDirectory;
     friend class ProcFSProcessBinary;
     friend class ProcFSProcessStacks;
+    friend class ProcFSProcessLatencyStatistics;
 
 public:
     static NonnullRefPtr<ProcFSProcessDirectory> create(const Process&);
@@ -545,6 +545,121 @@ private:
     WeakPtr<ProcFSProcessDirectory> m_parent_process_directory;
 };
 
+static const char* blocker_type_to_string(Thread::Blocker::Type type)
+{
+    switch (type) {
+    case Thread::Blocker::Type::Unknown:
+        return "Unknown";
+    case Thread::Blocker::Type::File:
+        return "File";
+    case Thread::Blocker::Type::Futex:
+        return "Futex";
+    case Thread::Blocker::Type::Plan9FS:
+        return "Plan9FS";
+    case Thread::Blocker::Type::Join:
+        return "Join";
+    case Thread::Blocker::Type::Queue:
+        return "Queue";
+    case Thread::Blocker::Type::Routing:
+        return "Routing";
+    case Thread::Blocker::Type::Sleep:
+        return "Sleep";
+    case Thread::Blocker::Type::Wait:
+        return "Wait";
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static const char* page_fault_response_to_string(PageFaultResponse response)
+{
+    switch (response) {
+    case PageFaultResponse::ShouldCrash:
+        return "ShouldCrash";
+    case PageFaultResponse::OutOfMemory:
+        return "OutOfMemory";
+    case PageFaultResponse::Continue:
+        return "Continue";
+    }
+    VERIFY_NOT_REACHED();
+}
+
+class ProcFSProcessLatencyStatistics final : public ProcFSProcessInformation {
+public:
+    static NonnullRefPtr<ProcFSProcessLatencyStatistics> create(const ProcFSProcessDirectory& parent_folder)
+    {
+        return adopt_ref(*new (nothrow) ProcFSProcessLatencyStatistics(parent_folder));
+    }
+
+private:
+    explicit ProcFSProcessLatencyStatistics(const ProcFSProcessDirectory& parent_folder)
+        : ProcFSProcessInformation("latency"sv, parent_folder)
+    {
+    }
+    virtual bool output(KBufferBuilder& builder) override
+    {
+        auto parent_folder = m_parent_folder.strong_ref();
+        if (parent_folder.is_null())
+            return false;
+        auto process = parent_folder->m_associated_process;
+
+        // Serializing allocates and can take a while, so neither the thread list lock nor the
+        // statistics lock of a thread is held while doing it. The snapshot is too large for the stack.
+        auto snapshot = adopt_own_if_nonnull(new (nothrow) Thread::LatencyStatisticsSnapshot);
+        if (!snapshot)
+            return false;
+        NonnullRefPtrVector<Thread> threads;
+        process->for_each_thread([&](Thread& thread) {
+            threads.append(thread);
+        });
+
+        JsonArraySerializer array { builder };
+        for (auto& thread : threads) {
+            auto thread_object = array.add_object();
+            thread_object.add("tid", thread.tid().value());
+            thread_object.add("name", thread.name());
+
+            if (!thread.snapshot_latency_statistics(*snapshot))
+                continue;
+
+            auto syscalls_object = thread_object.add_object("syscalls");
+            for (size_t function = 0; function < snapshot->syscalls.size(); ++function) {
+                auto& histogram = snapshot->syscalls[function];
+                if (!histogram.count())
+                    continue;
+                auto histogram_object = syscalls_object.add_object(Syscall::to_string((Syscall::Function)function));
+                histogram.serialize(histogram_object);
+            }
+            syscalls_object.finish();
+
+            auto page_faults_object = thread_object.add_object("page_faults");
+            for (size_t response = 0; response < snapshot->page_faults.size(); ++response) {
+                auto& histogram = snapshot->page_faults[response];
+                if (!histogram.count())
+                    continue;
+                auto histogram_object = page_faults_object.add_object(page_fault_response_to_string((PageFaultResponse)response));
+                histogram.serialize(histogram_object);
+            }
+            page_faults_object.finish();
+
+            auto blockers_object = thread_object.add_object("blockers");
+            for (size_t type = 0; type < snapshot->blockers.size(); ++type) {
+                auto& histogram = snapshot->blockers[type];
+                if (!histogram.count())
+                    continue;
+                auto histogram_object = blockers_object.add_object(blocker_type_to_string((Thread::Blocker::Type)type));
+                histogram.serialize(histogram_object);
+            }
+            if (snapshot->lock_waits.count()) {
+                auto histogram_object = blockers_object.add_object("Lock");
+                snapshot->lock_waits.serialize(histogram_object);
+            }
+            blockers_object.finish();
+        }
+        array.finish();
+        return true;
+    }
+};
+
 void ProcFSProcessDirectory::on_attach()
 {
     VERIFY(m_components.size() == 0);
@@ -558,6 +673,7 @@ void ProcFSProcessDirectory::on_attach()
     m_components.append(ProcFSProcessCurrentWorkDirectory::create(*this));
     m_components.append(ProcFSProcessBinary::create(*this));
     m_components.append(ProcFSProcessStacks::create(*this));
+    m_components.append(ProcFSProcessLatencyStatistics::create(*this));
 }
 
 RefPtr<ProcFSExposedComponent> ProcFSProcessDirectory::lookup(StringView name)
@@ -247,7 +247,9 @@ NEVER_INLINE void syscall_handler(TrapFrame* trap)
     auto arg3 = regs.rbx;
 #endif
 
+    u64 syscall_start_tsc = read_tsc();
     auto result = Syscall::handle(regs, function, arg1, arg2, arg3);
+    current_thread->record_syscall_latency(function, read_tsc() - syscall_start_tsc);
     if (result.is_error()) {
 #if ARCH(I386)
         regs.eax = result.error();
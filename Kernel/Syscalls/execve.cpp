@@ -8,6 +8,7 @@
 #include <AK/TemporaryChange.h>
 #include <AK/WeakPtr.h>
 #include <Kernel/Debug.h>
+#include <Kernel/ExecutableLayout.h>
 #include <Kernel/FileSystem/Custody.h>
 #include <Kernel/FileSystem/FileDescription.h>
 #include <Kernel/Panic.h>
@@ -22,7 +23,6 @@
 #include <Kernel/VM/SharedInodeVMObject.h>
 #include <LibC/limits.h>
 #include <LibELF/AuxiliaryVector.h>
-#include <LibELF/Image.h>
 #include <LibELF/Validation.h>
 
 namespace Kernel {
@@ -161,39 +161,15 @@ struct RequiredLoadRange {
 
 static KResultOr<RequiredLoadRange> get_required_load_range(FileDescription& program_description)
 {
-    auto& inode = *(program_description.inode());
-    auto vmobject = SharedInodeVMObject::try_create_with_inode(inode);
-    if (!vmobject) {
-        dbgln("get_required_load_range: Unable to allocate SharedInodeVMObject");
-        return ENOMEM;
-    }
-
-    size_t executable_size = inode.size();
-
-    auto region = MM.allocate_kernel_region_with_vmobject(*vmobject, page_round_up(executable_size), "ELF memory range calculation", Region::Access::Read);
-    if (!region) {
-        dbgln("Could not allocate memory for ELF");
-        return ENOMEM;
-    }
-
-    auto elf_image = ELF::Image(region->vaddr().as_ptr(), executable_size);
-    if (!elf_image.is_valid()) {
-        return EINVAL;
+    auto layout_or_error = ExecutableLayout::get_or_create(*program_description.inode());
+    if (layout_or_error.is_error()) {
+        if (layout_or_error.error() == ENOEXEC)
+            return EINVAL;
+        return layout_or_error.error();
     }
 
-    RequiredLoadRange range {};
-    elf_image.for_each_program_header([&range](const auto& pheader) {
-        if (pheader.type() != PT_LOAD)
-            return;
-
-        auto region_start = (FlatPtr)pheader.vaddr().as_ptr();
-        auto region_end = region_start + pheader.size_in_memory();
-        if (range.start == 0 || region_start < range.start)
-            range.start = region_start;
-        if (range.end == 0 || region_end > range.end)
-            range.end = region_end;
-    });
-
+    auto& layout = *layout_or_error.value();
+    RequiredLoadRange range { layout.load_range_start(), layout.load_range_end() };
     VERIFY(range.end > range.start);
     return range;
 };
@@ -278,18 +254,29 @@ static KResultOr<LoadResult> load_elf_object(NonnullOwnPtr<Space> new_space, Fil
         return ETXTBSY;
     }
 
+    auto layout_or_error = ExecutableLayout::get_or_create(inode);
+    if (layout_or_error.is_error())
+        return layout_or_error.error();
+    auto& layout = *layout_or_error.value();
+
     size_t executable_size = inode.size();
 
-    auto executable_region = MM.allocate_kernel_region_with_vmobject(*vmobject, page_round_up(executable_size), "ELF loading", Region::Access::Read);
-    if (!executable_region) {
-        dbgln("Could not allocate memory for ELF loading");
-        return ENOMEM;
+    // Only map the executable into the kernel if we actually have to copy data out of it.
+    OwnPtr<Region> executable_region;
+    if (layout.needs_image_data()) {
+        executable_region = MM.allocate_kernel_region_with_vmobject(*vmobject, page_round_up(executable_size), "ELF loading", Region::Access::Read);
+        if (!executable_region) {
+            dbgln("Could not allocate memory for ELF loading");
+            return ENOMEM;
+        }
     }
 
-    auto elf_image = ELF::Image(executable_region->vaddr().as_ptr(), executable_size);
-
-    if (!elf_image.is_valid())
-        return ENOEXEC;
+    auto is_within_image = [&](auto& program_header) {
+        return (u64)program_header.offset + program_header.size_in_image <= executable_size;
+    };
+    auto raw_data = [&](auto& program_header) {
+        return executable_region->vaddr().offset(program_header.offset).as_ptr();
+    };
 
     Region* master_tls_region { nullptr };
     size_t master_tls_size = 0;
@@ -301,52 +288,43 @@ static KResultOr<LoadResult> load_elf_object(NonnullOwnPtr<Space> new_space, Fil
 
     MemoryManager::enter_space(*new_space);
 
-    KResult ph_load_result = KSuccess;
-    elf_image.for_each_program_header([&](const ELF::Image::ProgramHeader& program_header) {
-        if (program_header.type() == PT_TLS) {
+    auto load_program_header = [&](const ExecutableLayout::ProgramHeader& program_header) -> KResult {
+        if (program_header.type == PT_TLS) {
             VERIFY(should_allocate_tls == ShouldAllocateTls::Yes);
-            VERIFY(program_header.size_in_memory());
+            VERIFY(program_header.size_in_memory);
 
-            if (!elf_image.is_within_image(program_header.raw_data(), program_header.size_in_image())) {
+            if (!is_within_image(program_header)) {
                 dbgln("Shenanigans! ELF PT_TLS header sneaks outside of executable.");
-                ph_load_result = ENOEXEC;
-                return IterationDecision::Break;
+                return ENOEXEC;
             }
 
-            auto range = new_space->allocate_range({}, program_header.size_in_memory());
-            if (!range.has_value()) {
-                ph_load_result = ENOMEM;
-                return IterationDecision::Break;
-            }
+            auto range = new_space->allocate_range({}, program_header.size_in_memory);
+            if (!range.has_value())
+                return ENOMEM;
 
             auto region_or_error = new_space->allocate_region(range.value(), String::formatted("{} (master-tls)", elf_name), PROT_READ | PROT_WRITE, AllocationStrategy::Reserve);
-            if (region_or_error.is_error()) {
-                ph_load_result = region_or_error.error();
-                return IterationDecision::Break;
-            }
+            if (region_or_error.is_error())
+                return region_or_error.error();
 
             master_tls_region = region_or_error.value();
-            master_tls_size = program_header.size_in_memory();
-            master_tls_alignment = program_header.alignment();
+            master_tls_size = program_header.size_in_memory;
+            master_tls_alignment = program_header.alignment;
 
-            if (!copy_to_user(master_tls_region->vaddr().as_ptr(), program_header.raw_data(), program_header.size_in_image())) {
-                ph_load_result = EFAULT;
-                return IterationDecision::Break;
-            }
-            return IterationDecision::Continue;
+            if (!copy_to_user(master_tls_region->vaddr().as_ptr(), raw_data(program_header), program_header.size_in_image))
+                return EFAULT;
+            return KSuccess;
         }
-        if (program_header.type() != PT_LOAD)
-            return IterationDecision::Continue;
+        if (program_header.type != PT_LOAD)
+            return KSuccess;
 
         if (program_header.is_writable()) {
             // Writable section: create a copy in memory.
-            VERIFY(program_header.size_in_memory());
-            VERIFY(program_header.alignment() == PAGE_SIZE);
+            VERIFY(program_header.size_in_memory);
+            VERIFY(program_header.alignment == PAGE_SIZE);
 
-            if (!elf_image.is_within_image(program_header.raw_data(), program_header.size_in_image())) {
+            if (!is_within_image(program_header)) {
                 dbgln("Shenanigans! Writable ELF PT_LOAD header sneaks outside of executable.");
-                ph_load_result = ENOEXEC;
-                return IterationDecision::Break;
+                return ENOEXEC;
             }
 
             int prot = 0;
@@ -356,19 +334,15 @@ static KResultOr<LoadResult> load_elf_object(NonnullOwnPtr<Space> new_space, Fil
                 prot |= PROT_WRITE;
             auto region_name = String::formatted("{} (data-{}{})", elf_name, program_header.is_readable() ? "r" : "", program_header.is_writable() ? "w" : "");
 
-            auto range_base = VirtualAddress { page_round_down(program_header.vaddr().offset(load_offset).get()) };
-            auto range_end = VirtualAddress { page_round_up(program_header.vaddr().offset(load_offset).offset(program_header.size_in_memory()).get()) };
+            auto range_base = VirtualAddress { page_round_down(program_header.vaddr.offset(load_offset).get()) };
+            auto range_end = VirtualAddress { page_round_up(program_header.vaddr.offset(load_offset).offset(program_header.size_in_memory).get()) };
 
             auto range = new_space->allocate_range(range_base, range_end.get() - range_base.get());
-            if (!range.has_value()) {
-                ph_load_result = ENOMEM;
-                return IterationDecision::Break;
-            }
+            if (!range.has_value())
+                return ENOMEM;
             auto region_or_error = new_space->allocate_region(range.value(), region_name, prot, AllocationStrategy::Reserve);
-            if (region_or_error.is_error()) {
-                ph_load_result = region_or_error.error();
-                return IterationDecision::Break;
-            }
+            if (region_or_error.is_error())
+                return region_or_error.error();
 
             // It's not always the case with PIE executables (and very well shouldn't be) that the
             // virtual address in the program header matches the one we end up giving the process.
@@ -377,18 +351,16 @@ static KResultOr<LoadResult> load_elf_object(NonnullOwnPtr<Space> new_space, Fil
             // FIXME: There's an opportunity to munmap, or at least mprotect, the padding space between
             //     the .text and .data PT_LOAD sections of the executable.
             //     Accessing it would definitely be a bug.
-            auto page_offset = program_header.vaddr();
+            auto page_offset = program_header.vaddr;
             page_offset.mask(~PAGE_MASK);
-            if (!copy_to_user((u8*)region_or_error.value()->vaddr().as_ptr() + page_offset.get(), program_header.raw_data(), program_header.size_in_image())) {
-                ph_load_result = EFAULT;
-                return IterationDecision::Break;
-            }
-            return IterationDecision::Continue;
+            if (!copy_to_user((u8*)region_or_error.value()->vaddr().as_ptr() + page_offset.get(), raw_data(program_header), program_header.size_in_image))
+                return EFAULT;
+            return KSuccess;
         }
 
         // Non-writable section: map the executable itself in memory.
-        VERIFY(program_header.size_in_memory());
-        VERIFY(program_header.alignment() == PAGE_SIZE);
+        VERIFY(program_header.size_in_memory);
+        VERIFY(program_header.alignment == PAGE_SIZE);
         int prot = 0;
         if (program_header.is_readable())
             prot |= PROT_READ;
@@ -397,32 +369,30 @@ static KResultOr<LoadResult> load_elf_object(NonnullOwnPtr<Space> new_space, Fil
         if (program_header.is_executable())
             prot |= PROT_EXEC;
 
-        auto range_base = VirtualAddress { page_round_down(program_header.vaddr().offset(load_offset).get()) };
-        auto range_end = VirtualAddress { page_round_up(program_header.vaddr().offset(load_offset).offset(program_header.size_in_memory()).get()) };
+        auto range_base = VirtualAddress { page_round_down(program_header.vaddr.offset(load_offset).get()) };
+        auto range_end = VirtualAddress { page_round_up(program_header.vaddr.offset(load_offset).offset(program_header.size_in_memory).get()) };
         auto range = new_space->allocate_range(range_base, range_end.get() - range_base.get());
-        if (!range.has_value()) {
-            ph_load_result = ENOMEM;
-            return IterationDecision::Break;
-        }
-        auto region_or_error = new_space->allocate_region_with_vmobject(range.value(), *vmobject, program_header.offset(), elf_name, prot, true);
-        if (region_or_error.is_error()) {
-            ph_load_result = region_or_error.error();
-            return IterationDecision::Break;
-        }
+        if (!range.has_value())
+            return ENOMEM;
+        auto region_or_error = new_space->allocate_region_with_vmobject(range.value(), *vmobject, program_header.offset, elf_name, prot, true);
+        if (region_or_error.is_error())
+            return region_or_error.error();
         if (should_allow_syscalls == ShouldAllowSyscalls::Yes)
             region_or_error.value()->set_syscall_region(true);
-        if (program_header.offset() == 0)
+        if (program_header.offset == 0)
             load_base_address = (FlatPtr)region_or_error.value()->vaddr().as_ptr();
-        return IterationDecision::Continue;
-    });
+        return KSuccess;
+    };
 
-    if (ph_load_result.is_error()) {
-        dbgln("do_exec: Failure loading program ({})", ph_load_result.error());
-        return ph_load_result;
+    for (auto& program_header : layout.program_headers()) {
+        if (auto result = load_program_header(program_header); result.is_error()) {
+            dbgln("do_exec: Failure loading program ({})", result.error());
+            return result;
+        }
     }
 
-    if (!elf_image.entry().offset(load_offset).get()) {
-        dbgln("do_exec: Failure loading program, entry pointer is invalid! {})", elf_image.entry().offset(load_offset));
+    if (!layout.entry().offset(load_offset).get()) {
+        dbgln("do_exec: Failure loading program, entry pointer is invalid! {})", layout.entry().offset(load_offset));
         return ENOEXEC;
     }
 
@@ -441,7 +411,7 @@ static KResultOr<LoadResult> load_elf_object(NonnullOwnPtr<Space> new_space, Fil
     return LoadResult {
         move(new_space),
         load_base_address,
-        elf_image.entry().offset(load_offset).get(),
+        layout.entry().offset(load_offset).get(),
         executable_size,
         AK::try_make_weak_ptr(master_tls_region),
         master_tls_size,
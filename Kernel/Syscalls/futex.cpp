@@ -11,8 +11,7 @@
 
 namespace Kernel {
 
-static SpinLock<u8> g_global_futex_lock;
-static AK::Singleton<HashMap<VMObject*, FutexQueues>> g_global_futex_queues;
+static AK::Singleton<FutexTable<256>> s_global_futex_table;
 
 FutexQueue::FutexQueue(FlatPtr user_address_or_offset, VMObject* vmobject)
     : m_user_address_or_offset(user_address_or_offset)
@@ -56,8 +55,10 @@ void FutexQueue::vmobject_deleted(VMObject& vmobject)
     m_vmobject = nullptr; // Just to be safe...
 
     {
-        ScopedSpinLock lock(g_global_futex_lock);
-        g_global_futex_queues->remove(&vmobject);
+        FutexKey key { &vmobject, m_user_address_or_offset };
+        auto& bucket = s_global_futex_table->bucket_for(key);
+        ScopedSpinLock lock(bucket.lock);
+        bucket.queues.remove(key);
     }
 
     bool did_wake_all;
@@ -73,13 +74,15 @@ void FutexQueue::vmobject_deleted(VMObject& vmobject)
 
 void Process::clear_futex_queues_on_exec()
 {
-    ScopedSpinLock lock(m_futex_lock);
-    for (auto& it : m_futex_queues) {
-        bool did_wake_all;
-        it.value->wake_all(did_wake_all);
-        VERIFY(did_wake_all); // No one should be left behind...
-    }
-    m_futex_queues.clear();
+    m_futex_table.for_each_bucket([](auto& bucket) {
+        ScopedSpinLock lock(bucket.lock);
+        for (auto& it : bucket.queues) {
+            bool did_wake_all;
+            it.value->wake_all(did_wake_all);
+            VERIFY(did_wake_all); // No one should be left behind...
+        }
+        bucket.queues.clear();
+    });
 }
 
 KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*> user_params)
@@ -98,9 +101,7 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
 
     switch (cmd) {
     case FUTEX_WAIT:
-    case FUTEX_WAIT_BITSET:
-    case FUTEX_REQUEUE:
-    case FUTEX_CMP_REQUEUE: {
+    case FUTEX_WAIT_BITSET: {
         if (params.timeout) {
             auto timeout_time = copy_time_from_user(params.timeout);
             if (!timeout_time.has_value())
@@ -120,7 +121,6 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
     }
 
     bool is_private = (params.futex_op & FUTEX_PRIVATE_FLAG) != 0;
-    auto& queue_lock = is_private ? m_futex_lock : g_global_futex_lock;
     auto user_address_or_offset = FlatPtr(params.userspace_address);
     auto user_address_or_offset2 = FlatPtr(params.userspace_address2);
 
@@ -142,79 +142,64 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
             if (!region2)
                 return EFAULT;
             vmobject2 = region2->vmobject();
-            user_address_or_offset2 = region->offset_in_vmobject_from_vaddr(VirtualAddress(user_address_or_offset2));
+            user_address_or_offset2 = region2->offset_in_vmobject_from_vaddr(VirtualAddress(user_address_or_offset2));
             break;
         }
         }
     }
 
-    auto find_global_futex_queues = [&](VMObject& vmobject, bool create_if_not_found) -> FutexQueues* {
-        auto& global_queues = *g_global_futex_queues;
-        auto it = global_queues.find(&vmobject);
-        if (it != global_queues.end())
-            return &it->value;
-        if (create_if_not_found) {
-            // TODO: is there a better way than setting and finding it again?
-            auto result = global_queues.set(&vmobject, {});
-            VERIFY(result == AK::HashSetResult::InsertedNewEntry);
-            it = global_queues.find(&vmobject);
-            VERIFY(it != global_queues.end());
-            return &it->value;
-        }
-        return nullptr;
+    FutexKey futex_key { vmobject.ptr(), user_address_or_offset };
+    FutexKey futex_key2 { vmobject2.ptr(), user_address_or_offset2 };
+
+    auto bucket_for = [&](const FutexKey& key) -> FutexBucket& {
+        return is_private ? m_futex_table.bucket_for(key) : s_global_futex_table->bucket_for(key);
     };
 
-    auto find_futex_queue = [&](VMObject* vmobject, FlatPtr user_address_or_offset, bool create_if_not_found, bool* did_create = nullptr) -> RefPtr<FutexQueue> {
-        VERIFY(is_private || vmobject);
-        VERIFY(!create_if_not_found || did_create != nullptr);
-        auto* queues = is_private ? &m_futex_queues : find_global_futex_queues(*vmobject, create_if_not_found);
-        if (!queues)
-            return {};
-        auto it = queues->find(user_address_or_offset);
-        if (it != queues->end())
+    // NOTE: The caller must hold the bucket's lock.
+    auto find_futex_queue = [&](FutexBucket& bucket, const FutexKey& key, bool create_if_not_found) -> RefPtr<FutexQueue> {
+        VERIFY(bucket.lock.is_locked());
+        auto it = bucket.queues.find(key);
+        if (it != bucket.queues.end())
             return it->value;
         if (create_if_not_found) {
-            *did_create = true;
-            auto futex_queue = adopt_ref(*new FutexQueue(user_address_or_offset, vmobject));
-            auto result = queues->set(user_address_or_offset, futex_queue);
+            auto futex_queue = adopt_ref(*new FutexQueue(key.user_address_or_offset, key.vmobject));
+            auto result = bucket.queues.set(key, futex_queue);
             VERIFY(result == AK::HashSetResult::InsertedNewEntry);
             return futex_queue;
         }
         return {};
     };
 
-    auto remove_futex_queue = [&](VMObject* vmobject, FlatPtr user_address_or_offset) {
-        auto* queues = is_private ? &m_futex_queues : find_global_futex_queues(*vmobject, false);
-        if (queues) {
-            if (auto it = queues->find(user_address_or_offset); it != queues->end()) {
-                if (it->value->try_remove()) {
-                    it->value->did_remove();
-                    queues->remove(it);
-                }
+    // NOTE: The caller must hold the bucket's lock.
+    auto remove_futex_queue = [&](FutexBucket& bucket, const FutexKey& key) {
+        VERIFY(bucket.lock.is_locked());
+        if (auto it = bucket.queues.find(key); it != bucket.queues.end()) {
+            if (it->value->try_remove()) {
+                it->value->did_remove();
+                bucket.queues.remove(it);
             }
-            if (!is_private && queues->is_empty())
-                g_global_futex_queues->remove(vmobject);
         }
     };
 
-    auto do_wake = [&](VMObject* vmobject, FlatPtr user_address_or_offset, u32 count, Optional<u32> bitmask) -> int {
+    auto do_wake = [&](const FutexKey& key, u32 count, Optional<u32> bitmask) -> int {
         if (count == 0)
             return 0;
-        ScopedSpinLock lock(queue_lock);
-        auto futex_queue = find_futex_queue(vmobject, user_address_or_offset, false);
+        auto& bucket = bucket_for(key);
+        ScopedSpinLock lock(bucket.lock);
+        auto futex_queue = find_futex_queue(bucket, key, false);
         if (!futex_queue)
             return 0;
         bool is_empty;
         u32 woke_count = futex_queue->wake_n(count, bitmask, is_empty);
         if (is_empty) {
             // If there are no more waiters, we want to get rid of the futex!
-            remove_futex_queue(vmobject, user_address_or_offset);
+            remove_futex_queue(bucket, key);
         }
         return (int)woke_count;
     };
 
     auto do_wait = [&](u32 bitset) -> int {
-        bool did_create;
+        auto& bucket = bucket_for(futex_key);
         RefPtr<FutexQueue> futex_queue;
         do {
             auto user_value = user_atomic_load_relaxed(params.userspace_address);
@@ -226,23 +211,22 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
             }
             atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
 
-            ScopedSpinLock lock(queue_lock);
-            did_create = false;
-            futex_queue = find_futex_queue(vmobject.ptr(), user_address_or_offset, true, &did_create);
+            ScopedSpinLock lock(bucket.lock);
+            futex_queue = find_futex_queue(bucket, futex_key, true);
             VERIFY(futex_queue);
-            // We need to try again if we didn't create this queue and the existing queue
-            // was removed before we were able to queue an imminent wait.
-        } while (!did_create && !futex_queue->queue_imminent_wait());
+            // We need to try again if the existing queue was removed before we
+            // were able to queue an imminent wait.
+        } while (!futex_queue->queue_imminent_wait());
 
         // We must not hold the lock before blocking. But we have a reference
         // to the FutexQueue so that we can keep it alive.
 
         Thread::BlockResult block_result = futex_queue->wait_on(timeout, bitset);
 
-        ScopedSpinLock lock(queue_lock);
+        ScopedSpinLock lock(bucket.lock);
         if (futex_queue->is_empty_and_no_imminent_waits()) {
             // If there are no more waiters, we want to get rid of the futex!
-            remove_futex_queue(vmobject, user_address_or_offset);
+            remove_futex_queue(bucket, futex_key);
         }
         if (block_result == Thread::BlockResult::InterruptedByTimeout) {
             return ETIMEDOUT;
@@ -258,9 +242,21 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
             return EAGAIN;
         atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
 
+        // Both buckets stay locked while waiters are moved between them. They are always
+        // locked in the same order, so that requeues in opposite directions can't deadlock.
+        auto& bucket = bucket_for(futex_key);
+        auto& target_bucket = bucket_for(futex_key2);
+        auto* first_bucket = &bucket;
+        auto* second_bucket = &target_bucket;
+        if (second_bucket < first_bucket)
+            swap(first_bucket, second_bucket);
+        ScopedSpinLock first_lock(first_bucket->lock);
+        Optional<ScopedSpinLock<SpinLock<u8>>> second_lock;
+        if (second_bucket != first_bucket)
+            second_lock.emplace(second_bucket->lock);
+
         int woken_or_requeued = 0;
-        ScopedSpinLock lock(queue_lock);
-        if (auto futex_queue = find_futex_queue(vmobject.ptr(), user_address_or_offset, false)) {
+        if (auto futex_queue = find_futex_queue(bucket, futex_key, false)) {
             RefPtr<FutexQueue> target_futex_queue;
             bool is_empty, is_target_empty;
             woken_or_requeued = futex_queue->wake_n_requeue(
@@ -268,14 +264,14 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
                     // NOTE: futex_queue's lock is being held while this callback is called
                     // The reason we're doing this in a callback is that we don't want to always
                     // create a target queue, only if we actually have anything to move to it!
-                    target_futex_queue = find_futex_queue(vmobject2.ptr(), user_address_or_offset2, true);
+                    target_futex_queue = find_futex_queue(target_bucket, futex_key2, true);
                     return target_futex_queue.ptr();
                 },
                 params.val2, is_empty, is_target_empty);
             if (is_empty)
-                remove_futex_queue(vmobject, user_address_or_offset);
+                remove_futex_queue(bucket, futex_key);
             if (is_target_empty && target_futex_queue)
-                remove_futex_queue(vmobject2, user_address_or_offset2);
+                remove_futex_queue(target_bucket, futex_key2);
         }
         return woken_or_requeued;
     };
@@ -285,7 +281,7 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
         return do_wait(0);
 
     case FUTEX_WAKE:
-        return do_wake(vmobject.ptr(), user_address_or_offset, params.val, {});
+        return do_wake(futex_key, params.val, {});
 
     case FUTEX_WAKE_OP: {
         Optional<u32> oldval;
@@ -318,7 +314,7 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
         if (!oldval.has_value())
             return EFAULT;
         atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
-        int result = do_wake(vmobject.ptr(), user_address_or_offset, params.val, {});
+        int result = do_wake(futex_key, params.val, {});
         if (params.val2 > 0) {
             bool compare_result;
             switch (_FUTEX_CMP(params.val3)) {
@@ -344,7 +340,7 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
                 return EINVAL;
             }
             if (compare_result)
-                result += do_wake(vmobject2.ptr(), user_address_or_offset2, params.val2, {});
+                result += do_wake(futex_key2, params.val2, {});
         }
         return result;
     }
@@ -365,7 +361,7 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
         VERIFY(params.val3 != FUTEX_BITSET_MATCH_ANY); // we should have turned it into FUTEX_WAKE
         if (params.val3 == 0)
             return EINVAL;
-        return do_wake(vmobject.ptr(), user_address_or_offset, params.val, params.val3);
+        return do_wake(futex_key, params.val, params.val3);
     }
     return ENOSYS;
 }
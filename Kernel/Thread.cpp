@@ -211,6 +211,7 @@ void Thread::block(Kernel::Lock& lock, ScopedSpinLock<SpinLock<u8>>& lock_lock,
 
     dbgln_if(THREAD_DEBUG, "Thread {} blocking on Lock {}", *this, &lock);
 
+    u64 block_start_tsc = read_tsc();
     for (;;) {
         // Yield to the scheduler, and wait for us to resume unblocked.
         VERIFY(!g_scheduler_lock.own_lock());
@@ -231,9 +232,52 @@ void Thread::block(Kernel::Lock& lock, ScopedSpinLock<SpinLock<u8>>& lock_lock,
         break;
     }
 
+    record_lock_wait_latency(read_tsc() - block_start_tsc);
     lock_lock.lock();
 }
 
+void Thread::record_syscall_latency(FlatPtr function, u64 cycles)
+{
+    VERIFY(this == Thread::current());
+    if (function >= Syscall::Function::__Count)
+        return;
+
+    // NOTE: Only this thread ever allocates its statistics, but we take the lock when
+    //       publishing new allocations so that ProcFS can safely look at them.
+    if (!m_latency_statistics) {
+        auto statistics = adopt_own_if_nonnull(new (nothrow) LatencyStatistics);
+        if (!statistics)
+            return;
+        ScopedSpinLock lock(m_latency_statistics_lock);
+        m_latency_statistics = move(statistics);
+    }
+
+    auto& histogram = m_latency_statistics->syscalls[function];
+    if (!histogram) {
+        auto new_histogram = adopt_own_if_nonnull(new (nothrow) LatencyHistogram);
+        if (!new_histogram)
+            return;
+        ScopedSpinLock lock(m_latency_statistics_lock);
+        histogram = move(new_histogram);
+    }
+    histogram->record(cycles);
+}
+
+bool Thread::snapshot_latency_statistics(LatencyStatisticsSnapshot& snapshot) const
+{
+    ScopedSpinLock lock(m_latency_statistics_lock);
+    if (!m_latency_statistics)
+        return false;
+    for (size_t function = 0; function < snapshot.syscalls.size(); ++function) {
+        auto& histogram = m_latency_statistics->syscalls[function];
+        snapshot.syscalls[function] = histogram ? *histogram : LatencyHistogram {};
+    }
+    snapshot.page_faults = m_latency_statistics->page_faults;
+    snapshot.blockers = m_latency_statistics->blockers;
+    snapshot.lock_waits = m_latency_statistics->lock_waits;
+    return true;
+}
+
 u32 Thread::unblock_from_lock(Kernel::Lock& lock)
 {
     ScopedSpinLock block_lock(m_block_lock);
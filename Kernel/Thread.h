@@ -19,17 +19,20 @@
 #include <AK/Vector.h>
 #include <AK/WeakPtr.h>
 #include <AK/Weakable.h>
+#include <Kernel/API/Syscall.h>
 #include <Kernel/Arch/x86/RegisterState.h>
 #include <Kernel/Arch/x86/SafeMem.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/InodeIdentifier.h>
 #include <Kernel/Forward.h>
 #include <Kernel/KResult.h>
+#include <Kernel/LatencyHistogram.h>
 #include <Kernel/LockMode.h>
 #include <Kernel/Scheduler.h>
 #include <Kernel/ThreadTracer.h>
 #include <Kernel/TimerQueue.h>
 #include <Kernel/UnixTypes.h>
+#include <Kernel/VM/PageFaultResponse.h>
 #include <Kernel/VM/Range.h>
 #include <LibC/fd_set.h>
 #include <LibC/signal_numbers.h>
@@ -898,6 +901,7 @@ public:
         block_lock.unlock();
 
         dbgln_if(THREAD_DEBUG, "Thread {} blocking on {} ({}) -->", *this, &blocker, blocker.state_string());
+        u64 block_start_tsc = read_tsc();
         bool did_timeout = false;
         u32 lock_count_to_restore = 0;
         auto previous_locked = unlock_process_if_locked(lock_count_to_restore);
@@ -933,6 +937,8 @@ public:
             break;
         }
 
+        record_block_latency(blocker.blocker_type(), read_tsc() - block_start_tsc);
+
         if (blocker.was_interrupted_by_signal()) {
             ScopedSpinLock scheduler_lock(g_scheduler_lock);
             ScopedSpinLock lock(m_lock);
@@ -1166,6 +1172,42 @@ public:
     }
 #endif
 
+    // Always-on latency statistics, allocated on the thread's first syscall.
+    struct LatencyStatistics {
+        Array<OwnPtr<LatencyHistogram>, Syscall::Function::__Count> syscalls;
+        Array<LatencyHistogram, to_underlying(PageFaultResponse::Continue) + 1> page_faults;
+        Array<LatencyHistogram, to_underlying(Blocker::Type::Wait) + 1> blockers;
+        LatencyHistogram lock_waits;
+    };
+
+    // A copy of the statistics, which can be inspected (and serialized) without holding any locks.
+    struct LatencyStatisticsSnapshot {
+        Array<LatencyHistogram, Syscall::Function::__Count> syscalls;
+        Array<LatencyHistogram, to_underlying(PageFaultResponse::Continue) + 1> page_faults;
+        Array<LatencyHistogram, to_underlying(Blocker::Type::Wait) + 1> blockers;
+        LatencyHistogram lock_waits;
+    };
+
+    // Returns false if the thread hasn't recorded anything yet.
+    bool snapshot_latency_statistics(LatencyStatisticsSnapshot&) const;
+
+    void record_syscall_latency(FlatPtr function, u64 cycles);
+    void record_page_fault_latency(PageFaultResponse response, u64 cycles)
+    {
+        if (m_latency_statistics)
+            m_latency_statistics->page_faults[to_underlying(response)].record(cycles);
+    }
+    void record_block_latency(Blocker::Type type, u64 cycles)
+    {
+        if (m_latency_statistics)
+            m_latency_statistics->blockers[to_underlying(type)].record(cycles);
+    }
+    void record_lock_wait_latency(u64 cycles)
+    {
+        if (m_latency_statistics)
+            m_latency_statistics->lock_waits.record(cycles);
+    }
+
     bool is_handling_page_fault() const
     {
         return m_handling_page_fault;
@@ -1320,6 +1362,9 @@ private:
     unsigned m_ipv4_socket_read_bytes { 0 };
     unsigned m_ipv4_socket_write_bytes { 0 };
 
+    OwnPtr<LatencyStatistics> m_latency_statistics;
+    mutable SpinLock<u8> m_latency_statistics_lock;
+
     FPUState* m_fpu_state { nullptr };
     State m_state { Invalid };
     String m_name;
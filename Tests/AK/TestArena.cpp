@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Arena.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+TEST_CASE(allocations_are_aligned_and_disjoint)
+{
+    Arena arena(256);
+    Vector<u8*> allocations;
+    for (size_t i = 1; i < 200; ++i) {
+        size_t alignment = 1u << (i % 5);
+        auto* allocation = static_cast<u8*>(arena.allocate(i, alignment));
+        EXPECT_EQ(reinterpret_cast<FlatPtr>(allocation) % alignment, 0u);
+        __builtin_memset(allocation, i, i);
+        allocations.append(allocation);
+    }
+    for (size_t i = 1; i < 200; ++i) {
+        for (size_t j = 0; j < i; ++j)
+            EXPECT_EQ(allocations[i - 1][j], static_cast<u8>(i));
+    }
+}
+
+TEST_CASE(destructors_run_in_reverse_order)
+{
+    Vector<int> destroyed;
+    struct Node {
+        Node(Vector<int>& destroyed, int id)
+            : destroyed(destroyed)
+            , id(id)
+        {
+        }
+        ~Node() { destroyed.append(id); }
+
+        Vector<int>& destroyed;
+        int id;
+    };
+
+    {
+        Arena arena;
+        for (int i = 0; i < 5; ++i)
+            EXPECT_EQ(arena.make<Node>(destroyed, i).id, i);
+        EXPECT(destroyed.is_empty());
+        arena.reset();
+        EXPECT_EQ(destroyed, (Vector<int> { 4, 3, 2, 1, 0 }));
+
+        arena.make<Node>(destroyed, 5);
+    }
+    EXPECT_EQ(destroyed, (Vector<int> { 4, 3, 2, 1, 0, 5 }));
+}
+
+TEST_CASE(objects_owning_heap_memory)
+{
+    Arena arena;
+    for (int i = 0; i < 1000; ++i) {
+        auto& string = arena.make<String>(String::formatted("this string is long enough to live on the heap: {}", i));
+        EXPECT(string.ends_with(String::number(i)));
+    }
+}
+
+TEST_CASE(large_allocations)
+{
+    Arena arena(1024);
+    auto* small = static_cast<u8*>(arena.allocate(16));
+    auto* large = static_cast<u8*>(arena.allocate(100000));
+    __builtin_memset(large, 0xaa, 100000);
+    auto* next_small = static_cast<u8*>(arena.allocate(16));
+    // The large allocation didn't use up the current chunk.
+    EXPECT_EQ(next_small, small + 16);
+    EXPECT_EQ(large[99999], 0xaa);
+}
+
+TEST_CASE(deallocate_last_allocation)
+{
+    Arena arena;
+    auto* first = arena.allocate(32);
+    auto* second = arena.allocate(32);
+    arena.deallocate(first, 32);
+    EXPECT_EQ(arena.allocate(32), static_cast<u8*>(second) + 32);
+    arena.deallocate(static_cast<u8*>(second) + 32, 32);
+    EXPECT_EQ(arena.allocate(32), static_cast<u8*>(second) + 32);
+}
+
+TEST_CASE(grow_last_allocation_in_place)
+{
+    Arena arena(4096);
+    auto* first = arena.allocate(32);
+    EXPECT(arena.try_grow_in_place(first, 32, 64));
+    EXPECT_EQ(arena.allocate(32), static_cast<u8*>(first) + 64);
+    EXPECT(!arena.try_grow_in_place(first, 64, 128));
+    EXPECT(!arena.try_grow_in_place(first, 64, 1000000));
+}
+
+TEST_CASE(growing_vector_does_not_waste_arena_memory)
+{
+    Arena arena(4096);
+    Vector<int, 0, ArenaAllocator> numbers { ArenaAllocator { arena } };
+    numbers.append(0);
+    auto* buffer = numbers.data();
+    for (int i = 1; i < 500; ++i)
+        numbers.append(i);
+    // The vector kept growing at the top of the chunk, so its buffer never moved.
+    EXPECT_EQ(numbers.data(), buffer);
+    EXPECT_EQ(arena.allocate(sizeof(int), alignof(int)), buffer + numbers.capacity());
+    for (int i = 0; i < 500; ++i)
+        EXPECT_EQ(numbers[i], i);
+}
+
+TEST_CASE(reset_reuses_memory)
+{
+    Arena arena(4096);
+    for (int i = 0; i < 1000; ++i)
+        (void)arena.allocate(64);
+    arena.reset();
+
+    // The arena keeps one of its chunks around, so allocations after a reset start over in that one.
+    auto* first = arena.allocate(64);
+    for (int i = 0; i < 1000; ++i)
+        (void)arena.allocate(64);
+    arena.reset();
+    EXPECT_EQ(arena.allocate(64), first);
+}
+
+TEST_CASE(vector_in_arena)
+{
+    Arena arena(512);
+    Vector<String, 0, ArenaAllocator> strings { ArenaAllocator { arena } };
+    for (int i = 0; i < 1000; ++i)
+        strings.append(String::number(i));
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(strings[i], String::number(i));
+
+    auto moved = move(strings);
+    EXPECT(strings.is_empty());
+    EXPECT_EQ(moved.size(), 1000u);
+    EXPECT_EQ(moved.allocator().arena(), &arena);
+
+    auto copy = moved;
+    EXPECT_EQ(copy.allocator().arena(), &arena);
+    EXPECT_EQ(copy[999], "999");
+
+    Vector<String> on_the_heap = copy;
+    EXPECT_EQ(on_the_heap.size(), 1000u);
+    EXPECT_EQ(on_the_heap[123], "123");
+
+    Vector<int, 4, ArenaAllocator> numbers { ArenaAllocator { arena } };
+    for (int i = 0; i < 100; ++i)
+        numbers.append(i);
+    numbers.clear();
+    EXPECT(numbers.is_empty());
+}
+
+static_assert(sizeof(Vector<int>) == 3 * sizeof(void*));
+
+struct BenchmarkNode {
+    BenchmarkNode* left { nullptr };
+    BenchmarkNode* right { nullptr };
+    int value { 0 };
+};
+
+static constexpr size_t benchmark_node_count = 1000000;
+
+BENCHMARK_CASE(make_nodes_with_new)
+{
+    Vector<OwnPtr<BenchmarkNode>> nodes;
+    nodes.ensure_capacity(benchmark_node_count);
+    for (size_t i = 0; i < benchmark_node_count; ++i)
+        nodes.unchecked_append(make<BenchmarkNode>());
+}
+
+BENCHMARK_CASE(make_nodes_in_arena)
+{
+    Arena arena;
+    for (size_t i = 0; i < benchmark_node_count; ++i)
+        arena.make<BenchmarkNode>();
+}
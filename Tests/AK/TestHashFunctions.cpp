@@ -6,8 +6,12 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Array.h>
 #include <AK/HashFunctions.h>
+#include <AK/String.h>
+#include <AK/StringHash.h>
 #include <AK/Types.h>
+#include <AK/Vector.h>
 
 TEST_CASE(int_hash)
 {
@@ -59,3 +63,67 @@ TEST_CASE(constexpr_ptr_hash)
     // "ptr_hash" test binds the result.
     static_assert(ptr_hash(FlatPtr(42)));
 }
+
+static constexpr char text[] = "The quick brown fox jumps over the lazy dog, twice or thrice.";
+
+TEST_CASE(string_hash)
+{
+    static_assert(string_hash("", 0) == 0u);
+    static_assert(string_hash("a", 1) != string_hash("b", 1));
+
+    // The compile-time fallback must produce the same hashes as the word-at-a-time version,
+    // for every tail length.
+    constexpr Array<u32, 40> constexpr_hashes = [] {
+        Array<u32, 40> hashes {};
+        for (size_t i = 0; i < hashes.size(); ++i)
+            hashes[i] = string_hash(text, i);
+        return hashes;
+    }();
+    for (size_t i = 0; i < constexpr_hashes.size(); ++i) {
+        volatile size_t length = i;
+        EXPECT_EQ(string_hash(text, length), constexpr_hashes[i]);
+    }
+}
+
+TEST_CASE(string_hash_distribution)
+{
+    // Similar short keys (like the ones in property tables) should not collide in the low bits,
+    // which is all that small hash tables look at.
+    constexpr size_t key_count = 4096;
+    Vector<u8> seen;
+    seen.resize(key_count);
+    size_t collisions = 0;
+    for (size_t i = 0; i < key_count; ++i) {
+        auto key = String::formatted("key{}", i);
+        auto bucket = key.hash() % key_count;
+        if (seen[bucket]++)
+            ++collisions;
+    }
+    // A perfectly random function would collide about key_count / e times.
+    EXPECT(collisions < key_count / 2);
+}
+
+TEST_CASE(case_insensitive_string_hash)
+{
+    EXPECT_EQ(case_insensitive_string_hash("NickServ", 8), case_insensitive_string_hash("nickserv", 8));
+    EXPECT_EQ(case_insensitive_string_hash("NickServ", 8), string_hash("nickserv", 8));
+    EXPECT_NE(case_insensitive_string_hash("NickServ", 8), case_insensitive_string_hash("ChanServ", 8));
+}
+
+static void hash_benchmark(size_t length)
+{
+    auto string = String::repeated('x', length);
+    constexpr size_t bytes_to_hash = 256 * MiB;
+    u32 hash = 0;
+    for (size_t i = 0; i < bytes_to_hash / length; ++i) {
+        // Don't let the compiler hoist the hash out of the loop.
+        asm volatile("" ::: "memory");
+        hash ^= string_hash(string.characters(), length);
+    }
+    EXPECT_NE(hash, 1u);
+}
+
+BENCHMARK_CASE(string_hash_8_bytes) { hash_benchmark(8); }
+BENCHMARK_CASE(string_hash_32_bytes) { hash_benchmark(32); }
+BENCHMARK_CASE(string_hash_256_bytes) { hash_benchmark(256); }
+BENCHMARK_CASE(string_hash_4096_bytes) { hash_benchmark(4096); }
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonParser.h>
+#include <AK/JsonPullParser.h>
+#include <AK/StringBuilder.h>
+
+using Event = JsonPullParser::Event;
+
+static Vector<Event> events_for(StringView input)
+{
+    JsonPullParser parser(input);
+    Vector<Event> events;
+    for (;;) {
+        auto event = parser.next();
+        events.append(event);
+        if (event == Event::EndOfInput || event == Event::Error)
+            return events;
+    }
+}
+
+TEST_CASE(events)
+{
+    auto events = events_for(R"({ "a": [1, "two", true, false, null], "b": {} })");
+    Vector<Event> expected {
+        Event::ObjectStart,
+        Event::Key,
+        Event::ArrayStart,
+        Event::Number,
+        Event::String,
+        Event::True,
+        Event::False,
+        Event::Null,
+        Event::ArrayEnd,
+        Event::Key,
+        Event::ObjectStart,
+        Event::ObjectEnd,
+        Event::ObjectEnd,
+        Event::EndOfInput,
+    };
+    EXPECT_EQ(events, expected);
+}
+
+TEST_CASE(strings_are_views_into_the_input)
+{
+    StringView input = R"(["plain", "esc\"apedA"])";
+    JsonPullParser parser(input);
+    EXPECT_EQ(parser.next(), Event::ArrayStart);
+
+    EXPECT_EQ(parser.next(), Event::String);
+    EXPECT(!parser.string_has_escapes());
+    EXPECT_EQ(parser.raw_string(), "plain");
+    EXPECT(parser.raw_string().characters_without_null_termination() >= input.characters_without_null_termination());
+    EXPECT(parser.raw_string().characters_without_null_termination() < input.characters_without_null_termination() + input.length());
+
+    EXPECT_EQ(parser.next(), Event::String);
+    EXPECT(parser.string_has_escapes());
+    EXPECT_EQ(parser.raw_string(), R"(esc\"apedA)");
+    EXPECT_EQ(parser.string(), "esc\"apedA");
+}
+
+TEST_CASE(numbers)
+{
+    auto parse_number = [](StringView input) {
+        JsonPullParser parser(input);
+        EXPECT_EQ(parser.next(), Event::Number);
+        EXPECT_EQ(parser.next(), Event::EndOfInput);
+        return parser.number();
+    };
+
+    EXPECT_EQ(parse_number("0").type(), JsonValue::Type::UnsignedInt32);
+    EXPECT_EQ(parse_number("4294967295").as_u32(), 4294967295u);
+    EXPECT_EQ(parse_number("-0").as_i32(), 0);
+    EXPECT_EQ(parse_number("-2147483648").as_i32(), NumericLimits<i32>::min());
+    EXPECT_EQ(parse_number("-2147483649").as_i64(), -2147483649ll);
+    EXPECT_EQ(parse_number("4294967296").as_i64(), 4294967296ll);
+    EXPECT_EQ(parse_number("-9223372036854775808").as_i64(), NumericLimits<i64>::min());
+    EXPECT_EQ(parse_number("18446744073709551615").as_u64(), NumericLimits<u64>::max());
+
+    EXPECT_EQ(parse_number("1.5").as_double(), 1.5);
+    EXPECT_EQ(parse_number("-0.25").as_double(), -0.25);
+    EXPECT_EQ(parse_number("1e3").as_double(), 1000.0);
+    EXPECT_EQ(parse_number("12.5E-1").as_double(), 1.25);
+    EXPECT_EQ(parse_number("0.1").as_double(), 0.1);
+    EXPECT_EQ(parse_number("1e400").as_double(), __builtin_huge_val());
+    EXPECT_EQ(parse_number("0e400").as_double(), 0.0);
+
+    EXPECT_EQ(events_for("01").last(), Event::Error);
+    EXPECT_EQ(events_for("-").last(), Event::Error);
+    EXPECT_EQ(events_for("1.").last(), Event::Error);
+    EXPECT_EQ(events_for("1e").last(), Event::Error);
+    EXPECT_EQ(events_for("-01").last(), Event::Error);
+}
+
+TEST_CASE(malformed_input)
+{
+    EXPECT_EQ(events_for("").last(), Event::Error);
+    EXPECT_EQ(events_for("[1,]").last(), Event::Error);
+    EXPECT_EQ(events_for("[1 2]").last(), Event::Error);
+    EXPECT_EQ(events_for(R"({"a":1,})").last(), Event::Error);
+    EXPECT_EQ(events_for(R"({"a" 1})").last(), Event::Error);
+    EXPECT_EQ(events_for(R"({1:1})").last(), Event::Error);
+    EXPECT_EQ(events_for(R"(["\x"])").last(), Event::Error);
+    EXPECT_EQ(events_for(R"(["\u12"])").last(), Event::Error);
+    EXPECT_EQ(events_for("[\"\n\"]").last(), Event::Error);
+    EXPECT_EQ(events_for("[1]]").last(), Event::Error);
+    EXPECT_EQ(events_for("1 2").last(), Event::Error);
+    EXPECT_EQ(events_for("[").last(), Event::Error);
+}
+
+TEST_CASE(skip_value)
+{
+    JsonPullParser parser(R"({ "skipped": { "a": [1, [2, {}]], "b": "}" }, "kept": 42 })");
+    EXPECT_EQ(parser.next(), Event::ObjectStart);
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.next(), Event::ObjectStart);
+    EXPECT(parser.skip_value());
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.raw_string(), "kept");
+    EXPECT_EQ(parser.next(), Event::Number);
+    EXPECT_EQ(parser.number().as_u32(), 42u);
+    EXPECT_EQ(parser.next(), Event::ObjectEnd);
+    EXPECT_EQ(parser.next(), Event::EndOfInput);
+}
+
+TEST_CASE(tree_parser_agrees)
+{
+    auto json = JsonValue::from_string(R"({"name":"x","values":[1,-2,3.5,"s\n"],"nested":{"empty":[]}})");
+    EXPECT(json.has_value());
+    EXPECT_EQ(json->to_string(), R"({"name":"x","values":[1,-2,3.5,"s\n"],"nested":{"empty":[]}})");
+}
+
+// A synthetic profile in the shape of the perfcore files written by the kernel and read by Profiler.
+static String const& profile_json()
+{
+    static String s_profile;
+    if (!s_profile.is_null())
+        return s_profile;
+
+    StringBuilder builder;
+    builder.append(R"({"strings":["/bin/Shell","/usr/lib/libc.so"],"events":[)");
+    for (size_t i = 0; i < 20000; ++i) {
+        if (i)
+            builder.append(',');
+        builder.appendff(R"({{"type":"{}","pid":{},"tid":{},"timestamp":{},"lost_samples":0,"stack":[)",
+            i % 8 ? "sample" : "malloc", 30 + i % 4, 30 + i % 16, 1000000 + i * 7);
+        for (size_t frame = 0; frame < 16; ++frame) {
+            if (frame)
+                builder.append(',');
+            builder.appendff("{}", 0xc0100000u + ((i * 31 + frame * 4099) % 0x100000));
+        }
+        builder.append("]}");
+    }
+    builder.append("]}");
+    s_profile = builder.to_string();
+    return s_profile;
+}
+
+BENCHMARK_CASE(parse_profile_tree)
+{
+    auto& input = profile_json();
+    for (size_t round = 0; round < 5; ++round) {
+        auto json = JsonParser(input).parse();
+        EXPECT(json.has_value());
+        EXPECT_EQ(json->as_object().get("events").as_array().size(), 20000u);
+    }
+}
+
+BENCHMARK_CASE(parse_profile_streaming)
+{
+    auto& input = profile_json();
+    for (size_t round = 0; round < 5; ++round) {
+        JsonPullParser parser(input);
+        size_t sample_count = 0;
+        size_t frame_count = 0;
+        for (auto event = parser.next(); event != Event::EndOfInput; event = parser.next()) {
+            VERIFY(event != Event::Error);
+            if (event == Event::String && parser.raw_string() == "sample"sv)
+                ++sample_count;
+            else if (event == Event::Number && parser.depth() == 4)
+                ++frame_count;
+        }
+        EXPECT_EQ(sample_count, 17500u);
+        EXPECT_EQ(frame_count, 20000u * 16);
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/MergeSort.h>
+#include <AK/Noncopyable.h>
+#include <AK/Vector.h>
+
+struct KeyAndIndex {
+    int key;
+    size_t index;
+};
+
+static Vector<KeyAndIndex> generate(size_t size, int key_range)
+{
+    Vector<KeyAndIndex> data;
+    u32 state = 0x9E3779B9;
+    for (size_t i = 0; i < size; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        data.append({ static_cast<int>(state % key_range), i });
+    }
+    return data;
+}
+
+static bool is_stably_sorted(Vector<KeyAndIndex> const& data)
+{
+    for (size_t i = 1; i < data.size(); ++i) {
+        if (data[i].key < data[i - 1].key)
+            return false;
+        if (data[i].key == data[i - 1].key && data[i].index < data[i - 1].index)
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE(is_stable)
+{
+    for (size_t size : { 0, 1, 2, 23, 24, 25, 48, 49, 1000, 12345 }) {
+        for (int key_range : { 1, 7, 1000000 }) {
+            auto data = generate(size, key_range);
+            merge_sort(data, [](auto& a, auto& b) { return a.key < b.key; });
+            EXPECT_EQ(data.size(), size);
+            EXPECT(is_stably_sorted(data));
+        }
+    }
+}
+
+TEST_CASE(sorts_sorted_and_reverse_input)
+{
+    Vector<int> sorted;
+    Vector<int> reverse;
+    for (int i = 0; i < 10000; ++i) {
+        sorted.append(i);
+        reverse.append(10000 - i);
+    }
+    merge_sort(sorted);
+    merge_sort(reverse);
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(sorted[i], i);
+        EXPECT_EQ(reverse[i], i + 1);
+    }
+}
+
+TEST_CASE(sorts_without_copy)
+{
+    struct NoCopy {
+        AK_MAKE_NONCOPYABLE(NoCopy);
+
+    public:
+        NoCopy() = default;
+        NoCopy(NoCopy&&) = default;
+
+        NoCopy& operator=(NoCopy&&) = default;
+
+        int value { 0 };
+    };
+
+    Vector<NoCopy> data;
+    for (size_t i = 0; i < 200; ++i) {
+        NoCopy element;
+        element.value = (200 - i) % 64;
+        data.append(move(element));
+    }
+    merge_sort(data, [](auto& a, auto& b) { return a.value < b.value; });
+    for (size_t i = 1; i < data.size(); ++i)
+        EXPECT(data[i - 1].value <= data[i].value);
+}
+
+static void benchmark_sort(Vector<int>&& data)
+{
+    merge_sort(data);
+    for (size_t i = 1; i < data.size(); ++i)
+        VERIFY(data[i - 1] <= data[i]);
+}
+
+static constexpr int benchmark_size = 1000000;
+
+BENCHMARK_CASE(merge_sort_random)
+{
+    Vector<int> data;
+    for (auto& element : generate(benchmark_size, NumericLimits<int>::max()))
+        data.append(element.key);
+    benchmark_sort(move(data));
+}
+
+BENCHMARK_CASE(merge_sort_sorted)
+{
+    Vector<int> data;
+    for (int i = 0; i < benchmark_size; ++i)
+        data.append(i);
+    benchmark_sort(move(data));
+}
+
+BENCHMARK_CASE(merge_sort_reverse)
+{
+    Vector<int> data;
+    for (int i = 0; i < benchmark_size; ++i)
+        data.append(benchmark_size - i);
+    benchmark_sort(move(data));
+}
+
+BENCHMARK_CASE(merge_sort_many_duplicates)
+{
+    Vector<int> data;
+    for (auto& element : generate(benchmark_size, 16))
+        data.append(element.key);
+    benchmark_sort(move(data));
+}
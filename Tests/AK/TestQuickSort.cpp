@@ -10,6 +10,8 @@
 #include <AK/Noncopyable.h>
 #include <AK/QuickSort.h>
 #include <AK/StdLibExtras.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
 
 TEST_CASE(sorts_without_copy)
 {
@@ -42,6 +44,15 @@ TEST_CASE(sorts_without_copy)
 
     AK::single_pivot_quick_sort(array.begin(), array.end(), [](auto& a, auto& b) { return a.value < b.value; });
 
+    for (size_t i = 0; i < 63; ++i)
+        EXPECT(array[i].value <= array[i + 1].value);
+
+    // Test the pattern-defeating quick sort.
+    for (size_t i = 0; i < 64; ++i)
+        array[i].value = (64 - i) % 32 + 32;
+
+    quick_sort(array, [](auto& a, auto& b) { return a.value < b.value; });
+
     for (size_t i = 0; i < 63; ++i)
         EXPECT(array[i].value <= array[i + 1].value);
 }
@@ -98,3 +109,143 @@ TEST_CASE(maximum_stack_depth)
 
     delete[] data;
 }
+
+enum class Pattern {
+    Random,
+    Sorted,
+    Reverse,
+    ManyDuplicates,
+    OrganPipe,
+    SortedWithNoise,
+};
+
+static Vector<int> generate(Pattern pattern, size_t size)
+{
+    Vector<int> data;
+    data.ensure_capacity(size);
+    u32 state = 0x2545F491;
+    auto next_random = [&] {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+    for (size_t i = 0; i < size; ++i) {
+        switch (pattern) {
+        case Pattern::Random:
+            data.unchecked_append(static_cast<int>(next_random()));
+            break;
+        case Pattern::Sorted:
+            data.unchecked_append(i);
+            break;
+        case Pattern::Reverse:
+            data.unchecked_append(size - i);
+            break;
+        case Pattern::ManyDuplicates:
+            data.unchecked_append(next_random() % 16);
+            break;
+        case Pattern::OrganPipe:
+            data.unchecked_append(i < size / 2 ? i : size - i);
+            break;
+        case Pattern::SortedWithNoise:
+            data.unchecked_append(next_random() % 64 == 0 ? static_cast<int>(next_random()) : static_cast<int>(i));
+            break;
+        }
+    }
+    return data;
+}
+
+static bool is_sorted(Vector<int> const& data)
+{
+    for (size_t i = 1; i < data.size(); ++i) {
+        if (data[i] < data[i - 1])
+            return false;
+    }
+    return true;
+}
+
+static u64 checksum(Vector<int> const& data)
+{
+    u64 sum = 0;
+    for (auto value : data)
+        sum += static_cast<u32>(value) * 2654435761u;
+    return sum;
+}
+
+TEST_CASE(sorts_patterns)
+{
+    for (auto pattern : { Pattern::Random, Pattern::Sorted, Pattern::Reverse, Pattern::ManyDuplicates, Pattern::OrganPipe, Pattern::SortedWithNoise }) {
+        for (size_t size : { 0, 1, 2, 3, 23, 24, 25, 100, 129, 1000, 50000 }) {
+            auto data = generate(pattern, size);
+            auto expected_checksum = checksum(data);
+            quick_sort(data);
+            EXPECT(is_sorted(data));
+            EXPECT_EQ(checksum(data), expected_checksum);
+
+            data = generate(pattern, size);
+            quick_sort(data.begin(), data.end(), [](int a, int b) { return a > b; });
+            for (size_t i = 1; i < data.size(); ++i)
+                EXPECT(data[i - 1] >= data[i]);
+        }
+    }
+}
+
+TEST_CASE(sorts_strings)
+{
+    Vector<String> strings;
+    for (int i = 0; i < 1000; ++i)
+        strings.append(String::number((i * 7919) % 1000));
+    quick_sort(strings);
+    for (size_t i = 1; i < strings.size(); ++i)
+        EXPECT(strings[i - 1] <= strings[i]);
+}
+
+TEST_CASE(sorts_sub_ranges)
+{
+    auto data = generate(Pattern::Random, 1000);
+    auto original = data;
+    pattern_defeating_quick_sort(data, 100, 900, [](int a, int b) { return a < b; });
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(data[i], original[i]);
+    for (size_t i = 101; i < 900; ++i)
+        EXPECT(data[i - 1] <= data[i]);
+    for (size_t i = 900; i < 1000; ++i)
+        EXPECT_EQ(data[i], original[i]);
+}
+
+// A comparator that isn't a strict weak ordering can't be expected to sort anything, but it must not make the sort
+// touch memory outside of the collection, or lose elements.
+TEST_CASE(survives_inconsistent_comparator)
+{
+    auto data = generate(Pattern::ManyDuplicates, 10000);
+    auto expected_checksum = checksum(data);
+    quick_sort(data, [](int a, int b) { return a <= b; });
+    EXPECT_EQ(checksum(data), expected_checksum);
+
+    u32 state = 1;
+    quick_sort(data, [&](int, int) {
+        state = state * 1103515245 + 12345;
+        return (state >> 16) & 1;
+    });
+    EXPECT_EQ(checksum(data), expected_checksum);
+}
+
+static void benchmark_sort(Pattern pattern)
+{
+    auto data = generate(pattern, 1000000);
+    quick_sort(data);
+    EXPECT(is_sorted(data));
+}
+
+BENCHMARK_CASE(quick_sort_random) { benchmark_sort(Pattern::Random); }
+BENCHMARK_CASE(quick_sort_sorted) { benchmark_sort(Pattern::Sorted); }
+BENCHMARK_CASE(quick_sort_reverse) { benchmark_sort(Pattern::Reverse); }
+BENCHMARK_CASE(quick_sort_many_duplicates) { benchmark_sort(Pattern::ManyDuplicates); }
+
+BENCHMARK_CASE(dual_pivot_quick_sort_random)
+{
+    // For comparison with quick_sort_random.
+    auto data = generate(Pattern::Random, 1000000);
+    dual_pivot_quick_sort(data, 0, data.size() - 1, [](int a, int b) { return a < b; });
+    EXPECT(is_sorted(data));
+}
@@ -303,3 +303,39 @@ TEST_CASE(roman_numerals)
     auto four_thousand = String::roman_number_from(4000);
     EXPECT_EQ(four_thousand, "4000");
 }
+
+static constexpr size_t benchmark_iterations = 1000000;
+
+BENCHMARK_CASE(construct_short_strings)
+{
+    size_t total_length = 0;
+    for (size_t i = 0; i < benchmark_iterations; ++i) {
+        String string { "short string"sv };
+        total_length += string.length();
+    }
+    EXPECT_EQ(total_length, 12 * benchmark_iterations);
+}
+
+BENCHMARK_CASE(copy_short_strings)
+{
+    String original { "short string"sv };
+    Vector<String> copies;
+    copies.ensure_capacity(benchmark_iterations);
+    for (size_t i = 0; i < benchmark_iterations; ++i)
+        copies.unchecked_append(original);
+    EXPECT_EQ(copies.last(), original);
+}
+
+BENCHMARK_CASE(hash_short_strings)
+{
+    Vector<String> strings;
+    u32 expected_hash_sum = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+        strings.append(String::number(i));
+        expected_hash_sum += strings.last().view().hash();
+    }
+    u32 hash_sum = 0;
+    for (size_t i = 0; i < benchmark_iterations; ++i)
+        hash_sum += strings[i % strings.size()].hash();
+    EXPECT_EQ(hash_sum, expected_hash_sum * static_cast<u32>(benchmark_iterations / strings.size()));
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/HashTable.h>
+#include <AK/String.h>
+#include <AK/SwissHashTable.h>
+
+TEST_CASE(construct)
+{
+    using IntTable = SwissHashTable<int>;
+    EXPECT(IntTable().is_empty());
+    EXPECT_EQ(IntTable().size(), 0u);
+    EXPECT(IntTable().begin() == IntTable().end());
+}
+
+TEST_CASE(basic_move)
+{
+    SwissHashTable<int> foo;
+    foo.set(1);
+    EXPECT_EQ(foo.size(), 1u);
+    auto bar = move(foo);
+    EXPECT_EQ(bar.size(), 1u);
+    EXPECT_EQ(foo.size(), 0u);
+    foo = move(bar);
+    EXPECT_EQ(bar.size(), 0u);
+    EXPECT_EQ(foo.size(), 1u);
+    EXPECT(foo.contains(1));
+}
+
+TEST_CASE(copy)
+{
+    SwissHashTable<String> strings;
+    for (int i = 0; i < 100; ++i)
+        strings.set(String::number(i));
+    auto copy = strings;
+    EXPECT_EQ(copy.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT(copy.contains(String::number(i)));
+}
+
+TEST_CASE(set_result)
+{
+    SwissHashTable<String, CaseInsensitiveStringTraits> table;
+    EXPECT_EQ(table.set("nickserv"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(table.set("NickServ"), AK::HashSetResult::ReplacedExistingEntry);
+    EXPECT_EQ(table.set("NICKSERV", AK::HashSetExistingEntryBehavior::Keep), AK::HashSetResult::KeptExistingEntry);
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_EQ(*table.begin(), "NickServ");
+}
+
+TEST_CASE(range_loop)
+{
+    SwissHashTable<int> table;
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+
+    int loop_counter = 0;
+    int sum = 0;
+    for (auto value : table) {
+        ++loop_counter;
+        sum += value;
+    }
+    EXPECT_EQ(loop_counter, 1000);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST_CASE(many_strings)
+{
+    SwissHashTable<String> strings;
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.set(String::number(i)), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.size(), 999u);
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.remove(String::number(i)), true);
+    EXPECT_EQ(strings.is_empty(), true);
+}
+
+TEST_CASE(many_collisions)
+{
+    struct StringCollisionTraits : public GenericTraits<String> {
+        static unsigned hash(const String&) { return 0; }
+    };
+
+    SwissHashTable<String, StringCollisionTraits> strings;
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.set(String::number(i)), AK::HashSetResult::InsertedNewEntry);
+
+    EXPECT_EQ(strings.set("foo"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.size(), 1000u);
+
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.remove(String::number(i)), true);
+
+    EXPECT(strings.find("foo") != strings.end());
+    EXPECT_EQ(strings.size(), 1u);
+}
+
+TEST_CASE(space_reuse)
+{
+    struct StringCollisionTraits : public GenericTraits<String> {
+        static unsigned hash(const String&) { return 0; }
+    };
+
+    SwissHashTable<String, StringCollisionTraits> strings;
+
+    // Add a few items to allow it to do initial resizing.
+    EXPECT_EQ(strings.set("0"), AK::HashSetResult::InsertedNewEntry);
+    for (int i = 1; i < 5; ++i) {
+        EXPECT_EQ(strings.set(String::number(i)), AK::HashSetResult::InsertedNewEntry);
+        EXPECT_EQ(strings.remove(String::number(i - 1)), true);
+    }
+
+    auto capacity = strings.capacity();
+
+    for (int i = 5; i < 999; ++i) {
+        EXPECT_EQ(strings.set(String::number(i)), AK::HashSetResult::InsertedNewEntry);
+        EXPECT_EQ(strings.remove(String::number(i - 1)), true);
+    }
+
+    EXPECT_EQ(strings.capacity(), capacity);
+}
+
+TEST_CASE(remove_while_iterating)
+{
+    SwissHashTable<int> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(i);
+
+    for (auto it = table.begin(); it != table.end();) {
+        auto current = it;
+        ++it;
+        if (*current % 2)
+            table.remove(current);
+    }
+
+    EXPECT_EQ(table.size(), 50u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(table.contains(i), i % 2 == 0);
+}
+
+TEST_CASE(ensure_capacity)
+{
+    SwissHashTable<int> table;
+    table.ensure_capacity(1000);
+    auto capacity = table.capacity();
+    EXPECT(capacity >= 1000u);
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+    EXPECT_EQ(table.capacity(), capacity);
+}
+
+TEST_CASE(hash_map)
+{
+    SwissHashMap<String, int> map;
+    map.set("one", 1);
+    map.set("two", 2);
+    map.set("three", 3);
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.get("two").value(), 2);
+    EXPECT(!map.get("four").has_value());
+    EXPECT_EQ(map.remove("one"), true);
+    EXPECT_EQ(map.contains("one"), false);
+    map.ensure("four") = 4;
+    EXPECT_EQ(map.get("four").value(), 4);
+    EXPECT_EQ(map.keys().size(), 3u);
+}
+
+// Compare against the bucket-based HashTable. Keys are spread out so that neither table gets
+// a free ride from consecutive integers hashing to consecutive buckets.
+static constexpr int benchmark_key_count = 100000;
+static int benchmark_key(int i) { return i * 2654435761u; }
+
+template<typename TableType>
+static void insert_benchmark()
+{
+    for (int round = 0; round < 10; ++round) {
+        TableType table;
+        for (int i = 0; i < benchmark_key_count; ++i)
+            table.set(benchmark_key(i));
+        EXPECT_EQ(table.size(), static_cast<size_t>(benchmark_key_count));
+    }
+}
+
+template<typename TableType>
+static void lookup_benchmark(bool hit)
+{
+    TableType table;
+    for (int i = 0; i < benchmark_key_count; ++i)
+        table.set(benchmark_key(i * 2));
+    size_t found = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < benchmark_key_count; ++i)
+            found += table.contains(benchmark_key(i * 2 + (hit ? 0 : 1)));
+    }
+    EXPECT_EQ(found, hit ? 10u * benchmark_key_count : 0u);
+}
+
+template<typename TableType>
+static void erase_heavy_benchmark()
+{
+    // A sliding window of keys: every insertion is paired with a removal.
+    TableType table;
+    constexpr int window = 1000;
+    for (int i = 0; i < benchmark_key_count * 10; ++i) {
+        table.set(benchmark_key(i));
+        if (i >= window)
+            EXPECT(table.remove(benchmark_key(i - window)));
+    }
+    EXPECT_EQ(table.size(), static_cast<size_t>(window));
+}
+
+BENCHMARK_CASE(insert_hash_table) { insert_benchmark<HashTable<int>>(); }
+BENCHMARK_CASE(insert_swiss_hash_table) { insert_benchmark<SwissHashTable<int>>(); }
+BENCHMARK_CASE(lookup_hit_hash_table) { lookup_benchmark<HashTable<int>>(true); }
+BENCHMARK_CASE(lookup_hit_swiss_hash_table) { lookup_benchmark<SwissHashTable<int>>(true); }
+BENCHMARK_CASE(lookup_miss_hash_table) { lookup_benchmark<HashTable<int>>(false); }
+BENCHMARK_CASE(lookup_miss_swiss_hash_table) { lookup_benchmark<SwissHashTable<int>>(false); }
+BENCHMARK_CASE(erase_heavy_hash_table) { erase_heavy_benchmark<HashTable<int>>(); }
+BENCHMARK_CASE(erase_heavy_swiss_hash_table) { erase_heavy_benchmark<SwissHashTable<int>>(); }
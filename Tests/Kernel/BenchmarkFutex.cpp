@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <serenity.h>
+
+static constexpr size_t thread_count = 8;
+static constexpr u32 round_trips_per_thread = 20000;
+
+struct PingPong {
+    alignas(64) u32 value { 0 };
+};
+
+// Each thread pair bounces a value back and forth through its own futex, so all
+// contention is on the kernel's futex bookkeeping rather than on the futex word.
+static void* ping_pong_thread(void* argument)
+{
+    auto& ping_pong = *static_cast<PingPong*>(argument);
+    for (u32 i = 0; i < round_trips_per_thread; ++i) {
+        u32 expected = i * 2;
+        while (AK::atomic_load(&ping_pong.value) != expected)
+            futex_wait(&ping_pong.value, AK::atomic_load(&ping_pong.value), nullptr, 0);
+        AK::atomic_store(&ping_pong.value, expected + 1);
+        futex_wake(&ping_pong.value, 1);
+    }
+    return nullptr;
+}
+
+static void* pong_ping_thread(void* argument)
+{
+    auto& ping_pong = *static_cast<PingPong*>(argument);
+    for (u32 i = 0; i < round_trips_per_thread; ++i) {
+        u32 expected = i * 2 + 1;
+        while (AK::atomic_load(&ping_pong.value) != expected)
+            futex_wait(&ping_pong.value, AK::atomic_load(&ping_pong.value), nullptr, 0);
+        AK::atomic_store(&ping_pong.value, expected + 1);
+        futex_wake(&ping_pong.value, 1);
+    }
+    return nullptr;
+}
+
+BENCHMARK_CASE(unrelated_futexes)
+{
+    Array<PingPong, thread_count / 2> ping_pongs;
+    Array<pthread_t, thread_count> threads;
+    for (size_t i = 0; i < thread_count / 2; ++i) {
+        EXPECT_EQ(pthread_create(&threads[i * 2], nullptr, ping_pong_thread, &ping_pongs[i]), 0);
+        EXPECT_EQ(pthread_create(&threads[i * 2 + 1], nullptr, pong_ping_thread, &ping_pongs[i]), 0);
+    }
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+}
+
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_condition = PTHREAD_COND_INITIALIZER;
+static u32 s_generation = 0;
+static size_t s_waiting = 0;
+static constexpr u32 broadcast_count = 2000;
+
+static void* broadcast_waiter_thread(void*)
+{
+    pthread_mutex_lock(&s_mutex);
+    for (u32 generation = 0; generation < broadcast_count; ++generation) {
+        ++s_waiting;
+        while (s_generation == generation)
+            pthread_cond_wait(&s_condition, &s_mutex);
+    }
+    pthread_mutex_unlock(&s_mutex);
+    return nullptr;
+}
+
+BENCHMARK_CASE(condition_broadcast)
+{
+    // Every broadcast wakes one waiter and requeues the rest onto the mutex,
+    // instead of waking all of them just to have them fight over the mutex.
+    Array<pthread_t, thread_count> threads;
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_create(&thread, nullptr, broadcast_waiter_thread, nullptr), 0);
+
+    for (u32 generation = 0; generation < broadcast_count; ++generation) {
+        pthread_mutex_lock(&s_mutex);
+        while (s_waiting < thread_count) {
+            pthread_mutex_unlock(&s_mutex);
+            sched_yield();
+            pthread_mutex_lock(&s_mutex);
+        }
+        s_waiting = 0;
+        ++s_generation;
+        pthread_cond_broadcast(&s_condition);
+        pthread_mutex_unlock(&s_mutex);
+    }
+
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteBuffer.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Pushes total_size bytes through a local socket pair in message_size chunks,
+// with a forked child on the other end reading and acknowledging everything.
+static void transfer_through_local_socket(size_t message_size, size_t total_size)
+{
+    int fds[2];
+    EXPECT_EQ(socketpair(AF_LOCAL, SOCK_STREAM, 0, fds), 0);
+
+    pid_t pid = fork();
+    EXPECT(pid >= 0);
+    if (pid == 0) {
+        close(fds[0]);
+        auto buffer = ByteBuffer::create_uninitialized(message_size);
+        size_t received = 0;
+        while (received < total_size) {
+            auto nread = read(fds[1], buffer.data(), buffer.size());
+            if (nread <= 0)
+                _exit(1);
+            received += nread;
+        }
+        u8 ack = 1;
+        _exit(write(fds[1], &ack, 1) == 1 ? 0 : 1);
+    }
+
+    close(fds[1]);
+    auto buffer = ByteBuffer::create_zeroed(message_size);
+    size_t sent = 0;
+    while (sent < total_size) {
+        auto nwritten = write(fds[0], buffer.data(), min(message_size, total_size - sent));
+        EXPECT(nwritten > 0);
+        if (nwritten <= 0)
+            break;
+        sent += nwritten;
+    }
+
+    u8 ack = 0;
+    EXPECT_EQ(read(fds[0], &ack, 1), 1);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    close(fds[0]);
+}
+
+BENCHMARK_CASE(small_messages)
+{
+    // Typical IPC traffic: lots of small messages.
+    transfer_through_local_socket(64, 16 * MiB);
+}
+
+BENCHMARK_CASE(medium_messages)
+{
+    transfer_through_local_socket(4 * KiB, 64 * MiB);
+}
+
+BENCHMARK_CASE(large_messages)
+{
+    // Bigger than the socket buffer, so the sender and receiver have to take turns.
+    transfer_through_local_socket(256 * KiB, 256 * MiB);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/Vector.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+static constexpr size_t thread_count = 8;
+static constexpr size_t iterations_per_thread = 200000;
+static constexpr size_t live_allocations_per_thread = 64;
+
+static void* allocate_and_free_locally(void*)
+{
+    Array<void*, live_allocations_per_thread> allocations {};
+    for (size_t i = 0; i < iterations_per_thread; ++i) {
+        auto& slot = allocations[i % live_allocations_per_thread];
+        free(slot);
+        // Cycle through the small size classes.
+        slot = malloc(8 << (i % 7));
+        EXPECT(slot != nullptr);
+    }
+    for (auto* allocation : allocations)
+        free(allocation);
+    return nullptr;
+}
+
+static void run_threads(void* (*function)(void*), void* argument = nullptr)
+{
+    Array<pthread_t, thread_count> threads;
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_create(&thread, nullptr, function, argument), 0);
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+}
+
+BENCHMARK_CASE(single_thread)
+{
+    allocate_and_free_locally(nullptr);
+}
+
+BENCHMARK_CASE(thread_local_allocations)
+{
+    // Every thread frees what it allocated itself.
+    run_threads(allocate_and_free_locally);
+}
+
+struct Handoff {
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t condition = PTHREAD_COND_INITIALIZER;
+    Vector<void*> pending;
+    bool done { false };
+};
+
+static void* consume_allocations(void* argument)
+{
+    auto& handoff = *static_cast<Handoff*>(argument);
+    for (;;) {
+        Vector<void*> batch;
+        pthread_mutex_lock(&handoff.mutex);
+        while (handoff.pending.is_empty() && !handoff.done)
+            pthread_cond_wait(&handoff.condition, &handoff.mutex);
+        swap(batch, handoff.pending);
+        bool done = handoff.done;
+        pthread_mutex_unlock(&handoff.mutex);
+        for (auto* allocation : batch)
+            free(allocation);
+        if (done && batch.is_empty())
+            return nullptr;
+    }
+}
+
+static void* produce_allocations(void* argument)
+{
+    auto& handoff = *static_cast<Handoff*>(argument);
+    for (size_t i = 0; i < iterations_per_thread; i += live_allocations_per_thread) {
+        Vector<void*> batch;
+        for (size_t j = 0; j < live_allocations_per_thread; ++j)
+            batch.append(malloc(8 << (j % 7)));
+        pthread_mutex_lock(&handoff.mutex);
+        handoff.pending.extend(move(batch));
+        pthread_cond_signal(&handoff.condition);
+        pthread_mutex_unlock(&handoff.mutex);
+    }
+    return nullptr;
+}
+
+BENCHMARK_CASE(cross_thread_frees)
+{
+    // Producer/consumer pairs: chunks are allocated on one thread and freed on another.
+    Array<Handoff, thread_count / 2> handoffs;
+    Array<pthread_t, thread_count / 2> consumers;
+    for (size_t i = 0; i < consumers.size(); ++i)
+        EXPECT_EQ(pthread_create(&consumers[i], nullptr, consume_allocations, &handoffs[i]), 0);
+
+    Array<pthread_t, thread_count / 2> producers;
+    for (size_t i = 0; i < producers.size(); ++i)
+        EXPECT_EQ(pthread_create(&producers[i], nullptr, produce_allocations, &handoffs[i]), 0);
+
+    for (auto& producer : producers)
+        EXPECT_EQ(pthread_join(producer, nullptr), 0);
+    for (auto& handoff : handoffs) {
+        pthread_mutex_lock(&handoff.mutex);
+        handoff.done = true;
+        pthread_cond_signal(&handoff.condition);
+        pthread_mutex_unlock(&handoff.mutex);
+    }
+    for (auto& consumer : consumers)
+        EXPECT_EQ(pthread_join(consumer, nullptr), 0);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <string.h>
+
+// Each benchmark processes the same number of bytes in total, spread over buffers of
+// different sizes, so small sizes measure call overhead and large sizes measure throughput.
+static constexpr size_t bytes_per_benchmark = 256 * MiB;
+static constexpr Array<size_t, 6> buffer_sizes { 7, 64, 256, 1 * KiB, 4 * KiB, 64 * KiB };
+
+// One byte of slack on either side lets us start the operations at an unaligned address.
+alignas(64) static char s_source[64 * KiB + 2];
+alignas(64) static char s_destination[64 * KiB + 2];
+
+static void fill_string(char* buffer, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+        buffer[i] = 'a' + i % 26;
+    buffer[length] = '\0';
+}
+
+template<typename Callback>
+static void for_each_buffer_size(Callback callback)
+{
+    for (auto size : buffer_sizes) {
+        for (size_t i = 0; i < bytes_per_benchmark / size; ++i)
+            callback(size);
+    }
+}
+
+BENCHMARK_CASE(strlen)
+{
+    for (auto size : buffer_sizes) {
+        fill_string(s_source + 1, size - 1);
+        for (size_t i = 0; i < bytes_per_benchmark / size; ++i)
+            EXPECT_EQ(strlen(s_source + 1), size - 1);
+    }
+}
+
+BENCHMARK_CASE(memchr)
+{
+    fill_string(s_source + 1, sizeof(s_source) - 2);
+    for_each_buffer_size([](size_t size) {
+        EXPECT_EQ(memchr(s_source + 1, '!', size), nullptr);
+    });
+}
+
+BENCHMARK_CASE(memcmp)
+{
+    fill_string(s_source + 1, sizeof(s_source) - 2);
+    fill_string(s_destination + 1, sizeof(s_destination) - 2);
+    for_each_buffer_size([](size_t size) {
+        EXPECT_EQ(memcmp(s_source + 1, s_destination + 1, size), 0);
+    });
+}
+
+BENCHMARK_CASE(strcmp)
+{
+    for (auto size : buffer_sizes) {
+        fill_string(s_source + 1, size - 1);
+        fill_string(s_destination, size - 1);
+        for (size_t i = 0; i < bytes_per_benchmark / size; ++i)
+            EXPECT_EQ(strcmp(s_source + 1, s_destination), 0);
+    }
+}
+
+BENCHMARK_CASE(memcpy)
+{
+    fill_string(s_source + 1, sizeof(s_source) - 2);
+    for_each_buffer_size([](size_t size) {
+        memcpy(s_destination + 1, s_source + 1, size);
+    });
+    EXPECT_EQ(memcmp(s_destination + 1, s_source + 1, sizeof(s_source) - 2), 0);
+}
+
+BENCHMARK_CASE(memmove_overlapping)
+{
+    fill_string(s_source, sizeof(s_source) - 1);
+    for_each_buffer_size([](size_t size) {
+        memmove(s_source + 1, s_source, size);
+        memmove(s_source, s_source + 1, size);
+    });
+}
+
+BENCHMARK_CASE(memset)
+{
+    for_each_buffer_size([](size_t size) {
+        memset(s_destination + 1, 'x', size);
+    });
+    EXPECT_EQ(s_destination[1], 'x');
+}
@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 #include <errno.h>
 #include <string.h>
+#include <sys/mman.h>
 
 TEST_CASE(strerror_r_basic)
 {
@@ -16,3 +17,252 @@ TEST_CASE(strerror_r_basic)
     EXPECT_EQ(strerror_r(EFAULT, buf, sizeof(buf)), 0);
     EXPECT_EQ(strcmp(buf, "Bad address"), 0);
 }
+
+// The SSE2 versions of the functions below take different paths depending on the alignment of their
+// arguments and on where the length falls relative to 16 and 64 bytes, so we try all of those.
+static constexpr size_t interesting_lengths[] = { 0, 1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 48, 49, 63, 64, 65, 127, 128, 129, 255, 256, 257, 2047, 2048, 2049 };
+static constexpr size_t max_interesting_length = 2049;
+static constexpr u8 guard_byte = 0xfe;
+
+alignas(64) static u8 s_source[max_interesting_length + 64];
+alignas(64) static u8 s_destination[max_interesting_length + 64];
+
+static u8 pattern_byte(size_t index)
+{
+    // Includes bytes >= 0x80, but never 0 or the guard byte.
+    return 1 + (index * 7) % 251;
+}
+
+static void fill_with_pattern(u8* buffer, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+        buffer[i] = pattern_byte(i);
+}
+
+TEST_CASE(memcpy_alignments_and_lengths)
+{
+    for (size_t source_alignment = 0; source_alignment < 16; ++source_alignment) {
+        for (size_t destination_alignment = 0; destination_alignment < 16; ++destination_alignment) {
+            for (auto length : interesting_lengths) {
+                auto* source = s_source + source_alignment;
+                auto* destination = s_destination + 16 + destination_alignment;
+                fill_with_pattern(source, length);
+                memset(s_destination, guard_byte, sizeof(s_destination));
+                EXPECT_EQ(memcpy(destination, source, length), destination);
+                for (size_t i = 0; i < length; ++i)
+                    EXPECT_EQ(destination[i], pattern_byte(i));
+                for (auto* byte = s_destination; byte < destination; ++byte)
+                    EXPECT_EQ(*byte, guard_byte);
+                for (auto* byte = destination + length; byte < s_destination + sizeof(s_destination); ++byte)
+                    EXPECT_EQ(*byte, guard_byte);
+            }
+        }
+    }
+}
+
+TEST_CASE(memset_alignments_and_lengths)
+{
+    for (size_t alignment = 0; alignment < 16; ++alignment) {
+        for (auto length : interesting_lengths) {
+            auto* destination = s_destination + 16 + alignment;
+            for (size_t i = 0; i < sizeof(s_destination); ++i)
+                s_destination[i] = guard_byte;
+            EXPECT_EQ(memset(destination, 0x80, length), destination);
+            for (size_t i = 0; i < sizeof(s_destination); ++i) {
+                bool is_inside = s_destination + i >= destination && s_destination + i < destination + length;
+                EXPECT_EQ(s_destination[i], is_inside ? 0x80 : guard_byte);
+            }
+        }
+    }
+}
+
+static void check_memmove(size_t source_offset, size_t destination_offset, size_t length)
+{
+    static u8 buffer[2 * max_interesting_length + 64];
+    static u8 expected[sizeof(buffer)];
+    fill_with_pattern(buffer, sizeof(buffer));
+    fill_with_pattern(expected, sizeof(expected));
+    // The reference copies through a temporary, so overlap can't affect it.
+    for (size_t i = 0; i < length; ++i)
+        expected[destination_offset + i] = pattern_byte(source_offset + i);
+
+    EXPECT_EQ(memmove(buffer + destination_offset, buffer + source_offset, length), buffer + destination_offset);
+    EXPECT_EQ(memcmp(buffer, expected, sizeof(buffer)), 0);
+}
+
+TEST_CASE(memmove_overlapping)
+{
+    static constexpr size_t distances[] = { 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65 };
+    for (auto length : interesting_lengths) {
+        for (auto distance : distances) {
+            for (size_t alignment = 0; alignment < 16; ++alignment) {
+                // Destination in front of the source, and behind it.
+                check_memmove(alignment + distance, alignment, length);
+                check_memmove(alignment, alignment + distance, length);
+            }
+        }
+    }
+}
+
+TEST_CASE(memmove_non_overlapping)
+{
+    for (auto length : interesting_lengths) {
+        check_memmove(0, length + 5, length);
+        check_memmove(length + 3, 1, length);
+    }
+}
+
+TEST_CASE(scanning_alignments_and_lengths)
+{
+    for (size_t alignment = 0; alignment < 16; ++alignment) {
+        for (auto length : interesting_lengths) {
+            auto* string = s_source + alignment;
+            fill_with_pattern(string, length);
+            string[length] = 0;
+            auto* chars = reinterpret_cast<char*>(string);
+
+            EXPECT_EQ(strlen(chars), length);
+            EXPECT_EQ(strnlen(chars, length + 10), length);
+            EXPECT_EQ(strnlen(chars, length / 2), length / 2);
+            EXPECT_EQ(strchr(chars, 0), chars + length);
+            EXPECT_EQ(strchr(chars, guard_byte), nullptr);
+            EXPECT_EQ(memchr(chars, 0, length + 1), chars + length);
+            EXPECT_EQ(memchr(chars, 0, length), nullptr);
+            if (length > 0) {
+                // Put a unique byte at the end, and look for it.
+                string[length - 1] = guard_byte;
+                EXPECT_EQ(strchr(chars, guard_byte), chars + length - 1);
+                EXPECT_EQ(memchr(chars, guard_byte, length), chars + length - 1);
+                EXPECT_EQ(memchr(chars, guard_byte, length - 1), nullptr);
+            }
+        }
+    }
+}
+
+TEST_CASE(compare_alignments_and_lengths)
+{
+    for (size_t alignment1 = 0; alignment1 < 16; ++alignment1) {
+        for (size_t alignment2 = 0; alignment2 < 16; ++alignment2) {
+            for (auto length : interesting_lengths) {
+                auto* string1 = s_source + alignment1;
+                auto* string2 = s_destination + alignment2;
+                fill_with_pattern(string1, length);
+                fill_with_pattern(string2, length);
+                string1[length] = 0;
+                string2[length] = 0;
+                auto* chars1 = reinterpret_cast<char*>(string1);
+                auto* chars2 = reinterpret_cast<char*>(string2);
+
+                EXPECT_EQ(strcmp(chars1, chars2), 0);
+                EXPECT_EQ(memcmp(string1, string2, length), 0);
+                if (length == 0)
+                    continue;
+
+                // A difference in the last byte, in both directions.
+                string2[length - 1] = string1[length - 1] + 1;
+                EXPECT(strcmp(chars1, chars2) < 0);
+                EXPECT(strcmp(chars2, chars1) > 0);
+                EXPECT(memcmp(string1, string2, length) < 0);
+                EXPECT(memcmp(string2, string1, length) > 0);
+                EXPECT_EQ(memcmp(string1, string2, length - 1), 0);
+
+                // A string that is a prefix of the other one compares less.
+                string2[length - 1] = string1[length - 1];
+                string2[length] = 'x';
+                string2[length + 1] = 0;
+                EXPECT(strcmp(chars1, chars2) < 0);
+                EXPECT(strcmp(chars2, chars1) > 0);
+            }
+        }
+    }
+}
+
+TEST_CASE(compare_bytes_above_0x7f)
+{
+    // The bytes are compared as unsigned char, so 0x80 and up are greater than ASCII.
+    for (size_t position = 0; position < 40; ++position) {
+        char string1[48];
+        char string2[48];
+        memset(string1, 'a', sizeof(string1));
+        memset(string2, 'a', sizeof(string2));
+        string1[47] = 0;
+        string2[47] = 0;
+        string1[position] = 0x7f;
+        string2[position] = static_cast<char>(0x80);
+        EXPECT(strcmp(string1, string2) < 0);
+        EXPECT(strcmp(string2, string1) > 0);
+        EXPECT(memcmp(string1, string2, sizeof(string1)) < 0);
+        EXPECT(memcmp(string2, string1, sizeof(string1)) > 0);
+
+        string1[position] = static_cast<char>(0x80);
+        string2[position] = static_cast<char>(0xff);
+        EXPECT(strcmp(string1, string2) < 0);
+        EXPECT(strcmp(string2, string1) > 0);
+        EXPECT(memcmp(string1, string2, sizeof(string1)) < 0);
+        EXPECT(memcmp(string2, string1, sizeof(string1)) > 0);
+    }
+}
+
+// Returns the start of a readable page that is followed by an inaccessible one.
+static u8* page_before_guard_page()
+{
+    static u8* s_page = nullptr;
+    if (!s_page) {
+        auto* pages = static_cast<u8*>(mmap(nullptr, 2 * PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0));
+        VERIFY(pages != MAP_FAILED);
+        VERIFY(mprotect(pages + PAGE_SIZE, PAGE_SIZE, PROT_NONE) == 0);
+        s_page = pages;
+    }
+    return s_page;
+}
+
+TEST_CASE(reads_ending_before_unmapped_page)
+{
+    auto* page = page_before_guard_page();
+    auto* page_end = page + PAGE_SIZE;
+    for (size_t length = 0; length < 80; ++length) {
+        // The string, including its null terminator, ends exactly at the end of the page.
+        auto* string = page_end - length - 1;
+        fill_with_pattern(string, length);
+        string[length] = 0;
+        auto* chars = reinterpret_cast<char*>(string);
+
+        EXPECT_EQ(strlen(chars), length);
+        EXPECT_EQ(strnlen(chars, length + 100), length);
+        EXPECT_EQ(strchr(chars, guard_byte), nullptr);
+        EXPECT_EQ(memchr(string, guard_byte, length + 1), nullptr);
+        EXPECT_EQ(memchr(string, 0, length + 1), string + length);
+
+        // Compare against a copy at a different alignment, so that only one side is near the boundary.
+        for (size_t alignment = 0; alignment < 16; ++alignment) {
+            auto* copy = s_destination + alignment;
+            memcpy(copy, string, length + 1);
+            auto* copy_chars = reinterpret_cast<char*>(copy);
+            EXPECT_EQ(strcmp(chars, copy_chars), 0);
+            EXPECT_EQ(strcmp(copy_chars, chars), 0);
+            EXPECT_EQ(memcmp(string, copy, length + 1), 0);
+        }
+
+        // Both strings right at the end of the page.
+        auto* other = page_end - 2 * (length + 1);
+        if (other >= page && length > 0) {
+            memmove(other, string, length + 1);
+            other[length - 1] = 0;
+            EXPECT(strcmp(reinterpret_cast<char*>(other), reinterpret_cast<char*>(page_end - length - 1)) != 0);
+        }
+    }
+
+    // Copies and fills that end right at the end of the page.
+    for (auto length : interesting_lengths) {
+        if (length > static_cast<size_t>(PAGE_SIZE) / 2)
+            continue;
+        auto* destination = page_end - length;
+        fill_with_pattern(s_source, length);
+        memcpy(destination, s_source, length);
+        EXPECT_EQ(memcmp(destination, s_source, length), 0);
+        memmove(destination, destination - 1, length);
+        memset(destination, 0x55, length);
+        for (size_t i = 0; i < length; ++i)
+            EXPECT_EQ(destination[i], 0x55);
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+BENCHMARK_CASE(push_in_loop)
+{
+    JSTest::run_and_expect_true(R"(
+        let a = [];
+        for (let i = 0; i < 300000; ++i)
+            a.push(i);
+        a.length === 300000 && a[299999] === 299999;
+    )");
+}
+
+BENCHMARK_CASE(indexed_read_write)
+{
+    JSTest::run_and_expect_true(R"(
+        let a = new Array(1000).fill(0);
+        for (let j = 0; j < 300; ++j) {
+            for (let i = 1; i < a.length; ++i)
+                a[i] = a[i - 1] + 1;
+        }
+        a[999] === 999;
+    )");
+}
+
+BENCHMARK_CASE(map_and_for_each)
+{
+    JSTest::run_and_expect_true(R"(
+        let a = [];
+        for (let i = 0; i < 1000; ++i)
+            a.push(i * 0.5);
+        let sum = 0;
+        for (let j = 0; j < 100; ++j)
+            a.map(x => x * 2).forEach(x => { sum += x; });
+        sum === 100 * 999 * 1000 / 2;
+    )");
+}
+
+BENCHMARK_CASE(index_of)
+{
+    JSTest::run_and_expect_true(R"(
+        let a = [];
+        for (let i = 0; i < 10000; ++i)
+            a.push(i);
+        let found = 0;
+        for (let j = 0; j < 1000; ++j)
+            found += a.indexOf(9000 + j % 1000);
+        found === 1000 * 9000 + 999 * 1000 / 2;
+    )");
+}
+
+BENCHMARK_CASE(sort_numbers)
+{
+    JSTest::run_and_expect_true(R"(
+        let a = [];
+        for (let i = 0; i < 50000; ++i)
+            a.push((i * 7919) % 50000);
+        a.sort();
+        let b = a.slice().sort((x, y) => x - y);
+        a[0] === 0 && a[1] === 1 && a[2] === 10 && b[49999] === 49999;
+    )");
+}
+
+BENCHMARK_CASE(iterate_keys)
+{
+    JSTest::run_and_expect_true(R"(
+        let a = [];
+        for (let i = 0; i < 20000; ++i)
+            a.push(i);
+        let count = 0;
+        for (let key in a)
+            ++count;
+        count === 20000 && Object.keys(a).length === 20000;
+    )");
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+#include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Serialization.h>
+
+static constexpr size_t load_count = 50;
+
+// A script with a lot of code that mostly isn't run, like the libraries that are loaded on startup.
+static String const& script()
+{
+    static String source;
+    if (!source.is_null())
+        return source;
+    StringBuilder builder;
+    for (size_t i = 0; i < 200; ++i) {
+        builder.appendff(R"(
+            function f{}(a, b) {{
+                let result = 0;
+                for (let i = 0; i < a; ++i) {{
+                    if (i % 3 === 0)
+                        result += b * i;
+                    else if (i % 3 === 1)
+                        result -= i;
+                    else
+                        result = result * 2 - {};
+                }}
+                const helper = x => x + {};
+                switch (b) {{
+                case 0: return helper(result);
+                case 1: return [result, "f{}"].length;
+                default: return {{ value: result }}.value;
+                }}
+            }}
+        )",
+            i, i, i, i);
+    }
+    builder.append("f199(10, 1) === 2;");
+    source = builder.build();
+    return source;
+}
+
+static void run(JS::Bytecode::Executable const& executable)
+{
+    JSTest::ScriptRunner runner;
+    runner.run(executable);
+    runner.expect_true();
+}
+
+BENCHMARK_CASE(load_from_source)
+{
+    for (size_t i = 0; i < load_count; ++i)
+        (void)JSTest::compile(JSTest::parse(script()));
+    auto program = JSTest::parse(script());
+    run(JSTest::compile(program));
+}
+
+BENCHMARK_CASE(load_from_cache)
+{
+    auto serialized_executable = JS::Bytecode::serialize_executable(JSTest::compile(JSTest::parse(script())));
+    EXPECT(serialized_executable.has_value());
+    for (size_t i = 0; i < load_count; ++i)
+        (void)JS::Bytecode::deserialize_executable(*serialized_executable);
+    auto executable = JS::Bytecode::deserialize_executable(*serialized_executable);
+    EXPECT(executable.has_value());
+    run(*executable);
+}
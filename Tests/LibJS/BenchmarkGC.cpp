@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+#include <LibJS/Heap/Heap.h>
+
+static void run_and_report(StringView name, StringView source)
+{
+    JSTest::ScriptRunner runner;
+    runner.run(source);
+    EXPECT(!runner.vm().exception());
+
+    auto& statistics = runner.interpreter().heap().statistics();
+    auto survival_percentage = statistics.cells_before_last_collection ? statistics.cells_surviving_last_collection * 100 / statistics.cells_before_last_collection : 0;
+    outln("{}: {} collections, longest pause {} us, total pause {} us, lazy sweeping {} us, {}% survived the last collection",
+        name,
+        statistics.collection_count,
+        statistics.longest_pause_in_microseconds,
+        statistics.total_pause_in_microseconds,
+        statistics.total_lazy_sweep_time_in_microseconds,
+        survival_percentage);
+}
+
+BENCHMARK_CASE(short_lived_objects)
+{
+    run_and_report("short_lived_objects", R"(
+        for (let i = 0; i < 300000; ++i)
+            ({ i, next: { i } });
+    )");
+}
+
+BENCHMARK_CASE(short_lived_objects_with_large_live_heap)
+{
+    // Every collection has to mark the live objects, but most of what gets allocated dies right away.
+    // (The live objects form a linked list rather than an array, as Array.prototype.push() is slow enough to drown out
+    // everything else.)
+    run_and_report("short_lived_objects_with_large_live_heap", R"(
+        let live = null;
+        for (let i = 0; i < 200000; ++i)
+            live = { i, next: live };
+        for (let i = 0; i < 300000; ++i)
+            ({ i, next: { i } });
+    )");
+}
+
+BENCHMARK_CASE(growing_live_heap)
+{
+    run_and_report("growing_live_heap", R"(
+        let live = null;
+        for (let i = 0; i < 300000; ++i)
+            live = { i, name: "object" + i, next: live };
+    )");
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// Loops over Int32 values, which the JIT does inline, with a call that it doesn't.
+static constexpr StringView script = R"(
+    function mix(a, b) {
+        return (a * 31) ^ b;
+    }
+    function checksum(n) {
+        var hash = 0;
+        for (var i = 0; i < n; i++) {
+            hash = (hash + i * 7) | 0;
+            hash = hash ^ (hash << 3) ^ (hash >> 5);
+            if (i % 1000 === 0)
+                hash = mix(hash, i) & 0xffffff;
+        }
+        return hash;
+    }
+    checksum(2000000) === 1428773661;
+)"sv;
+
+BENCHMARK_CASE(interpreted)
+{
+    JSTest::run_and_expect_true(script, JSTest::Mode::OptimizedBytecode);
+}
+
+BENCHMARK_CASE(jit)
+{
+    JSTest::run_and_expect_true(script, JSTest::Mode::JIT);
+}
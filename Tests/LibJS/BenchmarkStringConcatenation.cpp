@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+BENCHMARK_CASE(append_in_loop)
+{
+    JSTest::run_and_expect_true(R"(
+        let s = "";
+        for (let i = 0; i < 200000; ++i)
+            s += "item " + i + ", ";
+        s.length > 2000000;
+    )");
+}
+
+BENCHMARK_CASE(append_long_strings_in_loop)
+{
+    JSTest::run_and_expect_true(R"(
+        const line = "a line of text that is long enough to not be merged with its neighbours ".repeat(4);
+        let s = "";
+        for (let i = 0; i < 50000; ++i)
+            s = s + line + "\n";
+        s.length === 50000 * (line.length + 1);
+    )");
+}
+
+BENCHMARK_CASE(prepend_in_loop)
+{
+    JSTest::run_and_expect_true(R"(
+        let s = "";
+        for (let i = 0; i < 100000; ++i)
+            s = i + ", " + s;
+        s.startsWith("99999, ");
+    )");
+}
+
+BENCHMARK_CASE(template_literal_in_loop)
+{
+    JSTest::run_and_expect_true(R"(
+        let s = "";
+        for (let i = 0; i < 100000; ++i)
+            s = `${s}<li>${i}</li>`;
+        s.endsWith("<li>99999</li>");
+    )");
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibTest/TestCase.h>
+
+#include <AK/String.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+
+// Runs scripts in a fresh VM for the tests and benchmarks in this directory, which
+// mostly want to compare how different ways of executing a script behave.
+
+namespace JSTest {
+
+enum class Mode {
+    AST,
+    // Neither the script nor its functions go through the optimization pipeline.
+    Bytecode,
+    OptimizedBytecode,
+    JIT,
+};
+
+inline NonnullRefPtr<JS::Program> parse(StringView source)
+{
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = parser.parse_program();
+    EXPECT(!parser.has_errors());
+    return program;
+}
+
+// NOTE: The executable refers to the functions in the program, so it mustn't outlive it.
+inline JS::Bytecode::Executable compile(JS::Program const& program, Mode mode = Mode::OptimizedBytecode)
+{
+    VERIFY(mode != Mode::AST);
+    auto executable = JS::Bytecode::Generator::generate(program);
+    if (mode != Mode::Bytecode)
+        JS::Bytecode::Interpreter::optimization_pipeline().perform(executable);
+    return executable;
+}
+
+class ScriptRunner {
+public:
+    ScriptRunner()
+        : m_vm(JS::VM::create())
+        , m_interpreter(JS::Interpreter::create<JS::GlobalObject>(*m_vm))
+    {
+    }
+
+    ~ScriptRunner()
+    {
+        m_vm->clear_exception();
+    }
+
+    JS::VM& vm() { return *m_vm; }
+    JS::Interpreter& interpreter() { return *m_interpreter; }
+
+    void run(JS::Program const& program, Mode mode = Mode::AST)
+    {
+        m_vm->clear_exception();
+        if (mode == Mode::AST) {
+            m_interpreter->run(m_interpreter->global_object(), program);
+            return;
+        }
+        auto executable = compile(program, mode);
+        run(executable, mode);
+    }
+
+    // Functions are compiled when they're first called, so the mode also applies to them.
+    void run(JS::Bytecode::Executable const& executable, Mode mode = Mode::OptimizedBytecode)
+    {
+        VERIFY(mode != Mode::AST);
+        m_vm->clear_exception();
+        JS::Bytecode::Interpreter::set_optimizations_enabled(mode != Mode::Bytecode);
+        JS::Bytecode::Interpreter::set_jit_enabled(mode == Mode::JIT);
+        JS::Bytecode::Interpreter bytecode_interpreter(m_interpreter->global_object());
+        bytecode_interpreter.run(executable);
+        JS::Bytecode::Interpreter::set_jit_enabled(false);
+        JS::Bytecode::Interpreter::set_optimizations_enabled(true);
+    }
+
+    void run(StringView source, Mode mode = Mode::AST)
+    {
+        run(parse(source), mode);
+    }
+
+    // For scripts that check their own results, and complete with whether they were right.
+    void expect_true()
+    {
+        EXPECT(!m_vm->exception());
+        auto result = m_vm->last_value();
+        EXPECT(result.is_boolean() && result.as_bool());
+    }
+
+    // Describes how the last script completed, so that the results of running the same
+    // script in different ways can be compared as strings.
+    String result()
+    {
+        if (auto* exception = m_vm->exception())
+            return String::formatted("threw {}", describe(exception->value()));
+        return describe(m_vm->last_value());
+    }
+
+    static String describe(JS::Value value)
+    {
+        if (value.is_number() && value.is_negative_zero())
+            return "-0";
+        if (value.is_string())
+            return String::formatted("\"{}\"", value.as_string().string());
+        if (value.is_object() && is<JS::Error>(value.as_object())) {
+            auto& error = value.as_object();
+            return String::formatted("{}: {}", error.get_without_side_effects("name"), error.get_without_side_effects("message"));
+        }
+        return value.to_string_without_side_effects();
+    }
+
+private:
+    NonnullRefPtr<JS::VM> m_vm;
+    NonnullOwnPtr<JS::Interpreter> m_interpreter;
+};
+
+// Runs a script that is expected to complete with `true`.
+inline void run_and_expect_true(StringView source, Mode mode = Mode::AST)
+{
+    ScriptRunner runner;
+    runner.run(source, mode);
+    runner.expect_true();
+}
+
+// Runs a script in a fresh VM and describes how it completed.
+inline String run(StringView source, Mode mode)
+{
+    ScriptRunner runner;
+    runner.run(source, mode);
+    return runner.result();
+}
+
+// Runs a script in each of the given modes, which must all complete the same way. The AST interpreter is the
+// reference for the others, so it goes first unless the script uses something it can't run.
+inline void expect_result(StringView source, StringView expected, std::initializer_list<Mode> modes = { Mode::AST, Mode::Bytecode, Mode::OptimizedBytecode, Mode::JIT })
+{
+    for (auto mode : modes)
+        EXPECT_EQ(run(source, mode), expected);
+}
+
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+#include <AK/ByteReader.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/File.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/Bytecode/Cache.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Serialization.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static bool contains_instruction(JS::Bytecode::Executable const& executable, JS::Bytecode::Instruction::Type type)
+{
+    for (auto& block : executable.basic_blocks) {
+        for (JS::Bytecode::InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+            if ((*it).type() == type)
+                return true;
+        }
+    }
+    return false;
+}
+
+// Functions are serialized along with the script, so whether they're optimized has to be decided up front.
+static Optional<ByteBuffer> serialize(StringView source, JSTest::Mode mode, Optional<JS::Bytecode::Instruction::Type> expected_instruction = {})
+{
+    auto program = JSTest::parse(source);
+    auto executable = JSTest::compile(program, mode);
+    if (expected_instruction.has_value())
+        EXPECT(contains_instruction(executable, *expected_instruction));
+    JS::Bytecode::Interpreter::set_optimizations_enabled(mode != JSTest::Mode::Bytecode);
+    auto serialized_executable = JS::Bytecode::serialize_executable(executable);
+    JS::Bytecode::Interpreter::set_optimizations_enabled(true);
+    return serialized_executable;
+}
+
+// The deserialized executable must run the same as the one it was serialized from, without the source's AST around.
+static void expect_same_result_after_round_trip(StringView source, StringView expected, Optional<JS::Bytecode::Instruction::Type> expected_instruction = {}, JSTest::Mode mode = JSTest::Mode::OptimizedBytecode)
+{
+    JSTest::expect_result(source, expected, { JSTest::Mode::AST, mode });
+
+    auto serialized_executable = serialize(source, mode, expected_instruction);
+    EXPECT(serialized_executable.has_value());
+    if (!serialized_executable.has_value())
+        return;
+    auto executable = JS::Bytecode::deserialize_executable(*serialized_executable);
+    EXPECT(executable.has_value());
+    if (!executable.has_value())
+        return;
+
+    JSTest::ScriptRunner runner;
+    runner.run(*executable, mode);
+    EXPECT_EQ(runner.result(), expected);
+}
+
+TEST_CASE(round_trip_fused_jumps)
+{
+    // The peephole pass fuses comparisons with the conditional jumps that follow them.
+    expect_same_result_after_round_trip(R"(
+        var results = [];
+        for (var i = 0; i < 6; i++) {
+            if (i <= 1)
+                results.push("a");
+            else if (i == "2")
+                results.push("b");
+            else if (i === 3)
+                results.push("c");
+            else if (i >= 5)
+                results.push("d");
+            else if (i != 4)
+                results.push("e");
+            else
+                results.push("f");
+        }
+        results.join("");
+    )"sv,
+        "\"aabcfd\""sv, JS::Bytecode::Instruction::Type::JumpLessThan);
+}
+
+TEST_CASE(round_trip_push_declarative_environment)
+{
+    expect_same_result_after_round_trip(R"(
+        let a = 1;
+        const b = 2;
+        let read = () => a + b;
+        a = 10;
+        read();
+    )"sv,
+        "12"sv, JS::Bytecode::Instruction::Type::PushDeclarativeEnvironment);
+}
+
+TEST_CASE(round_trip_enter_unwind_context)
+{
+    expect_same_result_after_round_trip(R"(
+        var log = [];
+        try {
+            log.push("try");
+            null.x;
+        } catch (e) {
+            log.push(e.name);
+        } finally {
+            log.push("finally");
+        }
+        log.join();
+    )"sv,
+        "\"try,TypeError,finally\""sv, JS::Bytecode::Instruction::Type::EnterUnwindContext);
+}
+
+TEST_CASE(round_trip_new_bigint)
+{
+    expect_same_result_after_round_trip("(123456789012345678901234567890n * 2n).toString();"sv,
+        "\"246913578024691357802469135780\""sv, JS::Bytecode::Instruction::Type::NewBigInt);
+}
+
+TEST_CASE(round_trip_nested_functions)
+{
+    auto source = R"(
+        function outer(x) {
+            function middle(y) {
+                function inner(z) {
+                    return x + y + z;
+                }
+                return inner(y * 10);
+            }
+            var doubled = [1, 2].map(function (v) { return middle(v) * 2; });
+            return doubled.join();
+        }
+        outer(1) + " " + outer(100);
+    )"sv;
+    auto expected = "\"24,46 222,244\""sv;
+    expect_same_result_after_round_trip(source, expected, JS::Bytecode::Instruction::Type::NewFunction);
+    expect_same_result_after_round_trip(source, expected, JS::Bytecode::Instruction::Type::NewFunction, JSTest::Mode::Bytecode);
+}
+
+class TemporaryCacheDirectory {
+public:
+    TemporaryCacheDirectory()
+    {
+        char path[] = "/tmp/test-bytecode-cache.XXXXXX";
+        VERIFY(mkdtemp(path));
+        m_path = path;
+    }
+
+    ~TemporaryCacheDirectory()
+    {
+        for (auto& file : files())
+            unlink(file.characters());
+        rmdir(m_path.characters());
+    }
+
+    String const& path() const { return m_path; }
+
+    Vector<String> files() const
+    {
+        Vector<String> files;
+        Core::DirIterator iterator(m_path, Core::DirIterator::SkipDots);
+        while (iterator.has_next())
+            files.append(iterator.next_full_path());
+        return files;
+    }
+
+private:
+    String m_path;
+};
+
+static constexpr StringView cached_script = "function f(a) { return a * 2; } f(21) === 42;"sv;
+
+static ByteBuffer read_file(String const& path)
+{
+    auto file = Core::File::open(path, Core::OpenMode::ReadOnly).release_value();
+    return file->read_all();
+}
+
+static void write_file(String const& path, ReadonlyBytes contents)
+{
+    auto file = Core::File::open(path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate).release_value();
+    EXPECT(file->write(contents.data(), contents.size()));
+}
+
+// Stores the script in a fresh cache, lets the callback change the file, then tries to load it again.
+template<typename Callback>
+static Optional<JS::Bytecode::Executable> load_after_changing_cache_file(Callback callback)
+{
+    TemporaryCacheDirectory directory;
+    JS::Bytecode::Cache cache { directory.path(), true };
+    auto program = JSTest::parse(cached_script);
+    EXPECT(cache.store(cached_script, JSTest::compile(program)));
+
+    auto files = directory.files();
+    EXPECT_EQ(files.size(), 1u);
+    auto contents = read_file(files.first());
+    callback(contents);
+    write_file(files.first(), contents);
+    return cache.load(cached_script);
+}
+
+// The file starts with the digests of the source and of the serialized executable, see Cache::load().
+static constexpr size_t digest_size = Crypto::Hash::SHA256::digest_size();
+static constexpr size_t serialized_executable_offset = 2 * digest_size;
+
+TEST_CASE(cache_load_unchanged_file)
+{
+    auto executable = load_after_changing_cache_file([](ByteBuffer&) {});
+    EXPECT(executable.has_value());
+    if (executable.has_value()) {
+        JSTest::ScriptRunner runner;
+        runner.run(*executable);
+        runner.expect_true();
+    }
+}
+
+TEST_CASE(cache_load_rejects_missing_file)
+{
+    TemporaryCacheDirectory directory;
+    JS::Bytecode::Cache cache { directory.path(), true };
+    EXPECT(!cache.load(cached_script).has_value());
+}
+
+TEST_CASE(cache_load_rejects_truncated_file)
+{
+    for (size_t size : { static_cast<size_t>(0), digest_size, serialized_executable_offset, serialized_executable_offset + 4 }) {
+        auto executable = load_after_changing_cache_file([&](ByteBuffer& contents) {
+            contents.resize(size);
+        });
+        EXPECT(!executable.has_value());
+    }
+
+    auto executable = load_after_changing_cache_file([](ByteBuffer& contents) {
+        contents.resize(contents.size() - 1);
+    });
+    EXPECT(!executable.has_value());
+}
+
+TEST_CASE(cache_load_rejects_flipped_bits)
+{
+    size_t size = 0;
+    (void)load_after_changing_cache_file([&](ByteBuffer& contents) { size = contents.size(); });
+    EXPECT(size > serialized_executable_offset);
+
+    // Both the digests and the serialized executable are covered.
+    for (size_t offset : { static_cast<size_t>(0), digest_size + 1, serialized_executable_offset, size / 2, size - 1 }) {
+        auto executable = load_after_changing_cache_file([&](ByteBuffer& contents) {
+            contents[offset] ^= 0x10;
+        });
+        EXPECT(!executable.has_value());
+    }
+}
+
+TEST_CASE(cache_load_rejects_other_versions)
+{
+    // The version follows the magic number. The digest is updated so that only the version gives the file away.
+    // Version 1 didn't store the initialization mode of SetVariable.
+    for (u32 version : { 0u, 1u, 0xffffffffu }) {
+        auto executable = load_after_changing_cache_file([&](ByteBuffer& contents) {
+            auto serialized_executable = contents.bytes().slice(serialized_executable_offset);
+            ByteReader::store(serialized_executable.offset_pointer(sizeof(u32)), version);
+            auto digest = Crypto::Hash::SHA256::hash(serialized_executable.data(), serialized_executable.size());
+            contents.overwrite(digest_size, digest.immutable_data(), digest.data_length());
+        });
+        EXPECT(!executable.has_value());
+    }
+}
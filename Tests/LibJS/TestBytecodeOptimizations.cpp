@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// Runs each script with and without the optimization pipeline, which must not change what it does.
+
+// The AST interpreter can't run generators, so only the bytecode results are compared.
+static void expect_bytecode_result(StringView source, StringView expected)
+{
+    JSTest::expect_result(source, expected, { JSTest::Mode::Bytecode, JSTest::Mode::OptimizedBytecode, JSTest::Mode::JIT });
+}
+
+// Folding happens both at the top level of a script and in functions, which are compiled separately.
+static void expect_expression_result(StringView expression, StringView expected)
+{
+    JSTest::expect_result(String::formatted("{};", expression), expected);
+    JSTest::expect_result(String::formatted("function f() {{ return {}; }} f();", expression), expected);
+}
+
+TEST_CASE(folding_mixed_types)
+{
+    expect_expression_result("\"1\" + 2"sv, "\"12\""sv);
+    expect_expression_result("1 + \"2\""sv, "\"12\""sv);
+    expect_expression_result("1 + 2 + \"3\""sv, "\"33\""sv);
+    expect_expression_result("\"3\" - 1"sv, "2"sv);
+    expect_expression_result("\"5\" * \"2\""sv, "10"sv);
+    expect_expression_result("true + 1"sv, "2"sv);
+    expect_expression_result("null + 1"sv, "1"sv);
+    expect_expression_result("undefined + 1"sv, "NaN"sv);
+    expect_expression_result("\"10\" < \"9\""sv, "true"sv);
+    expect_expression_result("10 < 9"sv, "false"sv);
+    expect_expression_result("1 == \"1\""sv, "true"sv);
+    expect_expression_result("1 === \"1\""sv, "false"sv);
+}
+
+TEST_CASE(folding_negative_zero)
+{
+    expect_expression_result("0 * -1"sv, "-0"sv);
+    expect_expression_result("-1 * 0"sv, "-0"sv);
+    expect_expression_result("-0 + 0"sv, "0"sv);
+    expect_expression_result("-0 - 0"sv, "-0"sv);
+    expect_expression_result("0 - 0"sv, "0"sv);
+    expect_expression_result("1 / (0 * -1)"sv, "-Infinity"sv);
+    expect_expression_result("-0 === 0"sv, "true"sv);
+    expect_expression_result("(0 * -1) % 5"sv, "-0"sv);
+}
+
+TEST_CASE(folding_nan)
+{
+    expect_expression_result("0 / 0"sv, "NaN"sv);
+    expect_expression_result("(0 / 0) === (0 / 0)"sv, "false"sv);
+    expect_expression_result("(0 / 0) !== (0 / 0)"sv, "true"sv);
+    expect_expression_result("(0 / 0) == (0 / 0)"sv, "false"sv);
+    expect_expression_result("(0 / 0) < 1"sv, "false"sv);
+    expect_expression_result("(0 / 0) >= 1"sv, "false"sv);
+    expect_expression_result("(0 / 0) | 0"sv, "0"sv);
+}
+
+TEST_CASE(folding_int32_overflow)
+{
+    expect_expression_result("2147483647 + 1"sv, "2147483648"sv);
+    expect_expression_result("-2147483648 - 1"sv, "-2147483649"sv);
+    expect_expression_result("65536 * 65536"sv, "4294967296"sv);
+    expect_expression_result("46341 * 46341"sv, "2147488281"sv);
+    expect_expression_result("(2147483647 + 1) | 0"sv, "-2147483648"sv);
+    expect_expression_result("1 << 31"sv, "-2147483648"sv);
+    expect_expression_result("1 << 32"sv, "1"sv);
+    expect_expression_result("-1 >>> 0"sv, "4294967295"sv);
+    expect_expression_result("-1 >> 31"sv, "-1"sv);
+    expect_expression_result("-2147483648 % -1"sv, "-0"sv);
+}
+
+TEST_CASE(store_read_after_call)
+{
+    // The store before the call looks dead if the call can't go anywhere else.
+    JSTest::expect_result(R"(
+        function thrower() { throw 1; }
+        function f() {
+            var a = 1;
+            try {
+                a = 2;
+                thrower();
+                a = 3;
+            } catch (e) {
+                return a;
+            }
+            return -1;
+        }
+        f();
+    )"sv,
+        "2"sv);
+
+    // Captured variables aren't kept in registers, but the store mustn't be dropped either.
+    JSTest::expect_result(R"(
+        function f() {
+            var a = 1;
+            function read() { return a; }
+            a = 2;
+            var seen = read();
+            a = 3;
+            return seen;
+        }
+        f();
+    )"sv,
+        "2"sv);
+}
+
+TEST_CASE(store_read_in_next_loop_iteration)
+{
+    JSTest::expect_result(R"(
+        function f() {
+            var previous = 0;
+            var sum = 0;
+            for (var i = 0; i < 5; i++) {
+                sum = sum + previous;
+                previous = i;
+            }
+            return sum;
+        }
+        f();
+    )"sv,
+        "6"sv);
+}
+
+TEST_CASE(try_catch)
+{
+    JSTest::expect_result(R"(
+        function f(should_throw) {
+            var result = "start";
+            try {
+                result = "try";
+                if (should_throw)
+                    throw "thrown";
+                result = "no throw";
+            } catch (e) {
+                result = result + " " + e;
+            }
+            return result;
+        }
+        f(true) + ", " + f(false);
+    )"sv,
+        "\"try thrown, no throw\""sv);
+}
+
+TEST_CASE(try_finally)
+{
+    JSTest::expect_result(R"(
+        function f() {
+            var log = "";
+            try {
+                log = log + "try ";
+            } finally {
+                log = log + "finally";
+            }
+            return log;
+        }
+        f();
+    )"sv,
+        "\"try finally\""sv);
+
+    JSTest::expect_result(R"(
+        var log = [];
+        function f() {
+            try {
+                try {
+                    return "returned";
+                } finally {
+                    log.push("inner finally");
+                }
+            } catch (e) {
+                log.push("catch");
+            } finally {
+                log.push("outer finally");
+            }
+            return "not returned";
+        }
+        f() + ": " + log.join();
+    )"sv,
+        "\"returned: inner finally,outer finally\""sv);
+
+    JSTest::expect_result(R"(
+        var log = [];
+        function thrower() { throw "thrown"; }
+        function f() {
+            try {
+                thrower();
+                log.push("after call");
+            } finally {
+                log.push("finally");
+            }
+        }
+        try {
+            f();
+        } catch (e) {
+            log.push("caught " + e);
+        }
+        log.join();
+    )"sv,
+        "\"finally,caught thrown\""sv);
+}
+
+TEST_CASE(generators_across_yield)
+{
+    expect_bytecode_result(R"(
+        function* counter() {
+            var a = 1;
+            var b = 10;
+            var received = yield a;
+            a = a + b + received;
+            yield a;
+            var c = "1" + 2;
+            yield c;
+        }
+        var generator = counter();
+        var results = [];
+        results.push(generator.next().value);
+        results.push(generator.next(100).value);
+        results.push(generator.next().value);
+        results.push(generator.next().done);
+        results.join();
+    )"sv,
+        "\"1,111,12,true\""sv);
+}
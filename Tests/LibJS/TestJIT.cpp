@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// The JIT does some instructions inline for the common cases and leaves the rest to the interpreter, which must not
+// change what a script does. The operands come in as function arguments, so that the optimization pipeline can't fold
+// them away, and each function sees values for both the inline and the generic path.
+
+// Applies the function to each pair of operands, and describes the results so that -0 stands out.
+static constexpr StringView apply_to_pairs = R"(
+    function describe(value) {
+        return Object.is(value, -0) ? "-0" : String(value);
+    }
+    function apply_to_pairs(f, pairs) {
+        var results = [];
+        for (var i = 0; i < pairs.length; i++)
+            results.push(describe(f(pairs[i][0], pairs[i][1])));
+        return results.join();
+    }
+)"sv;
+
+static void expect_result_for_pairs(StringView source, StringView expected)
+{
+    JSTest::expect_result(String::formatted("{}{}", apply_to_pairs, source), expected);
+}
+
+TEST_CASE(add_overflow)
+{
+    expect_result_for_pairs(R"(
+        function add(a, b) { return a + b; }
+        apply_to_pairs(add, [[1, 2], [2147483647, 1], [-2147483648, -1], [2147483647, 2147483647], [-1, 1], [-0, 0], [1.5, 1]]);
+    )"sv,
+        "\"3,2147483648,-2147483649,4294967294,0,0,2.5\""sv);
+}
+
+TEST_CASE(sub_overflow)
+{
+    expect_result_for_pairs(R"(
+        function sub(a, b) { return a - b; }
+        apply_to_pairs(sub, [[1, 2], [-2147483648, 1], [2147483647, -1], [0, -2147483648], [0, 0], [-0, 0], [1.5, 1]]);
+    )"sv,
+        "\"-1,-2147483649,2147483648,2147483648,0,-0,0.5\""sv);
+}
+
+TEST_CASE(mul_overflow_and_negative_zero)
+{
+    expect_result_for_pairs(R"(
+        function mul(a, b) { return a * b; }
+        apply_to_pairs(mul, [[6, 7], [65536, 65536], [46341, 46341], [-2147483648, -1], [-1, 0], [0, -1], [0, 0], [-5, 0], [-1, -1], [1.5, 2]]);
+    )"sv,
+        "\"42,4294967296,2147488281,2147483648,-0,-0,0,-0,1,3\""sv);
+}
+
+TEST_CASE(increment_and_decrement_overflow)
+{
+    expect_result_for_pairs(R"(
+        function step(a, b) {
+            var up = a;
+            var down = b;
+            up++;
+            down--;
+            return up + " " + down;
+        }
+        apply_to_pairs(step, [[1, 1], [2147483647, -2147483648], [1.5, "3"]]);
+    )"sv,
+        "\"2 0,2147483648 -2147483649,2.5 2\""sv);
+}
+
+TEST_CASE(unsigned_right_shift_with_high_bit)
+{
+    expect_result_for_pairs(R"(
+        function ushr(a, b) { return a >>> b; }
+        apply_to_pairs(ushr, [[16, 2], [-1, 0], [-1, 1], [-2147483648, 0], [-2147483648, 31], [1 << 31, 0], [-16, 28], [2147483647, 0]]);
+    )"sv,
+        "\"4,4294967295,2147483647,2147483648,1,2147483648,15,2147483647\""sv);
+}
+
+TEST_CASE(shift_counts_of_32_and_above)
+{
+    // Only the lowest five bits of the count are used, which is what x86 does for 32-bit shifts too.
+    expect_result_for_pairs(R"(
+        function shifts(a, b) { return [a << b, a >> b, a >>> b].join(" "); }
+        apply_to_pairs(shifts, [[5, 32], [5, 33], [-8, 33], [-8, 63], [1, 64], [-1, -1], [1, 31], [-2147483648, 32]]);
+    )"sv,
+        "\"5 5 5,10 2 2,-16 -4 2147483644,0 -1 1,1 1 1,-2147483648 -1 1,-2147483648 0 0,-2147483648 -2147483648 2147483648\""sv);
+}
+
+TEST_CASE(jump_nullish)
+{
+    JSTest::expect_result(R"(
+        function or_default(value) { return value ?? "default"; }
+        [null, undefined, 0, -0, false, "", NaN, 1].map(function (value) { return String(or_default(value)); }).join();
+    )"sv,
+        "\"default,default,0,0,false,,NaN,1\""sv);
+}
+
+TEST_CASE(jump_undefined)
+{
+    // Default values in destructuring only apply to undefined.
+    JSTest::expect_result(R"(
+        function or_default(object) {
+            var { value = "default" } = object;
+            return value;
+        }
+        [{ value: null }, {}, { value: undefined }, { value: 0 }, { value: false }, { value: "" }].map(function (object) {
+            return String(or_default(object));
+        }).join();
+    )"sv,
+        "\"null,default,default,0,false,\""sv);
+}
+
+TEST_CASE(jump_conditional)
+{
+    JSTest::expect_result(R"(
+        function truthy(value) {
+            if (value)
+                return "t";
+            return "f";
+        }
+        var values = [true, false, 1, 0, -1, 0.5, -0, 0 / 0, 1 / 0, "", "0", "false", " ", null, undefined, {}, [], 0n, 1n, Symbol()];
+        values.map(truthy).join("");
+    )"sv,
+        "\"tftfttfftftttffttftt\""sv);
+
+    // The logical operators jump on the value of their left side.
+    JSTest::expect_result(R"(
+        function and(a, b) { return a && b; }
+        function or(a, b) { return a || b; }
+        [0, 0.5, 0 / 0, "", "x"].map(function (value) { return String(and(value, "b")) + "|" + String(or(value, "b")); }).join();
+    )"sv,
+        "\"0|b,b|0.5,NaN|b,|b,b|x\""sv);
+}
+
+TEST_CASE(int32_comparisons_with_other_types)
+{
+    expect_result_for_pairs(R"(
+        function compare(a, b) {
+            var results = [a < b, a <= b, a > b, a >= b, a == b, a != b, a === b, a !== b].map(Number).join("");
+            if (a < b)
+                results += "<";
+            return results;
+        }
+        apply_to_pairs(compare, [[1, 2], [2, 2], [-1, -2], [1, "1"], [1, 1.5], [0, -0], [1, 0 / 0], ["10", "9"]]);
+    )"sv,
+        "\"11000101<,01011010,00110101,01011001,11000101<,01011010,00000101,11000101<\""sv);
+}
+
+TEST_CASE(exception_from_generic_path_in_try_catch)
+{
+    // The Int32 loop runs inline, then the operands change to ones that make the generic path throw.
+    JSTest::expect_result(R"(
+        function throwing_value_of(message) {
+            return { valueOf() { throw message; } };
+        }
+        function sum_until_thrown(values) {
+            var sum = 0;
+            var log = [];
+            for (var i = 0; i < values.length; i++) {
+                try {
+                    sum = sum + values[i];
+                    log.push(sum);
+                } catch (e) {
+                    log.push("caught " + e);
+                } finally {
+                    log.push("finally");
+                }
+            }
+            return log.join();
+        }
+        sum_until_thrown([1, 2, throwing_value_of("a"), 3, null, throwing_value_of("b")]);
+    )"sv,
+        "\"1,finally,3,finally,caught a,finally,6,finally,6,finally,caught b,finally\""sv);
+
+    JSTest::expect_result(R"(
+        function get_x(object) {
+            try {
+                var y = object.x * 2;
+                return y + 1;
+            } catch (e) {
+                return e.name;
+            }
+        }
+        [get_x({ x: 1 }), get_x(null), get_x({ x: 2147483647 }), get_x(undefined)].join();
+    )"sv,
+        "\"3,TypeError,4294967295,TypeError\""sv);
+}
+
+TEST_CASE(native_call_that_reenters_the_interpreter)
+{
+    // The callbacks run on a new register window while the caller's native code is still on the stack.
+    JSTest::expect_result(R"(
+        function scale(values, factor) {
+            var base = 1;
+            var scaled = values.map(function (value) {
+                var inner = [value, value + 1].map(function (v) { return v * factor; });
+                return inner[0] + inner[1] + base;
+            });
+            base = base + 1;
+            return scaled.join() + " " + base;
+        }
+        scale([1, 2, 3], 10);
+    )"sv,
+        "\"31,51,71 2\""sv);
+
+    // The generic path of an inline instruction calls back into JavaScript too.
+    JSTest::expect_result(R"(
+        function add(a, b) {
+            var first = a + b;
+            var second = first * 2;
+            return first + " " + second;
+        }
+        var calls = 0;
+        var counted = { valueOf() { calls++; return add(calls, 1).length; } };
+        [add(1, 2), add(counted, 1), add(2147483647, 1), calls].join();
+    )"sv,
+        "\"3 6,4 8,2147483648 4294967296,1\""sv);
+
+    JSTest::expect_result(R"(
+        function sort_descending(values) {
+            var compared = 0;
+            values.sort(function (a, b) { compared++; return b - a; });
+            return values.join() + (compared > 0);
+        }
+        sort_descending([3, 1, 4, 1, 5, 9, 2, 6]);
+    )"sv,
+        "\"9,6,5,4,3,2,1,1true\""sv);
+}
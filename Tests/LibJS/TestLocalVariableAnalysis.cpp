@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// The bytecode generator keeps variables that no nested function can see in registers.
+// These scripts would give a different result if it kept one that is captured after all.
+
+TEST_CASE(captured_variable)
+{
+    JSTest::expect_result(R"(
+        function outer() {
+            var captured = 1;
+            var read = function () { return captured; };
+            captured = 2;
+            return read();
+        }
+        outer();
+    )"sv,
+        "2"sv);
+}
+
+TEST_CASE(captured_variable_referenced_through_escape)
+{
+    JSTest::expect_result(R"(
+        function outer() {
+            var captured = 1;
+            var read = function () { return c\u{61}ptured; };
+            captured = 2;
+            return read();
+        }
+        outer();
+    )"sv,
+        "2"sv);
+}
+
+TEST_CASE(captured_variable_assigned_through_escape)
+{
+    JSTest::expect_result(R"(
+        function counter() {
+            var count = 0;
+            var next = function () { \u0063ount = count + 1; };
+            next();
+            next();
+            return count;
+        }
+        counter();
+    )"sv,
+        "2"sv);
+}
+
+TEST_CASE(arguments_referenced_through_escape)
+{
+    JSTest::expect_result(R"(
+        function sum(a) {
+            var total = 0;
+            for (var i = 0; i < arguments.length; i++)
+                total = total + \u{61}rguments[i];
+            return total;
+        }
+        sum(1, 2, 3);
+    )"sv,
+        "6"sv);
+}
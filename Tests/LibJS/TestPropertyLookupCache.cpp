@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// Each script warms up the inline caches of GetById and PutById in a loop, then changes the object in a way that
+// has to make the cached entries miss. The AST interpreter doesn't have caches, so it serves as the reference.
+
+static constexpr StringView accessors = R"(
+    function get_x(o) { return o.x; }
+    function get_y(o) { return o.y; }
+    function set_x(o, value) { o.x = value; }
+    function warm_up(o) {
+        for (var i = 0; i < 10; i++) {
+            get_x(o);
+            get_y(o);
+        }
+    }
+)"sv;
+
+static void expect_result_with_accessors(StringView source, StringView expected)
+{
+    JSTest::expect_result(String::formatted("{}{}", accessors, source), expected);
+}
+
+TEST_CASE(delete_own_property)
+{
+    expect_result_with_accessors(R"(
+        var results = [];
+        var o = { x: 1, y: 2 };
+        warm_up(o);
+        Reflect.deleteProperty(o, "x");
+        results.push(String(get_x(o)));
+        // The remaining property moved to a different slot.
+        results.push(get_y(o));
+        o.x = 3;
+        results.push(get_x(o));
+        results.join();
+    )"sv,
+        "\"undefined,2,3\""sv);
+}
+
+TEST_CASE(delete_property_of_prototype)
+{
+    expect_result_with_accessors(R"(
+        var results = [];
+        var proto = { x: 1, y: 2 };
+        var o = Object.create(proto);
+        warm_up(o);
+        Reflect.deleteProperty(proto, "x");
+        results.push(String(get_x(o)));
+        results.push(get_y(o));
+        // A property of the object itself now shadows the prototype.
+        o.y = 3;
+        results.push(get_y(o));
+        results.join();
+    )"sv,
+        "\"undefined,2,3\""sv);
+}
+
+TEST_CASE(put_after_delete)
+{
+    expect_result_with_accessors(R"(
+        var o = { x: 1, y: 2 };
+        for (var i = 0; i < 10; i++)
+            set_x(o, i);
+        Reflect.deleteProperty(o, "x");
+        set_x(o, 10);
+        Object.keys(o).join() + " " + o.x + " " + o.y;
+    )"sv,
+        "\"y,x 10 2\""sv);
+}
+
+TEST_CASE(change_prototype_after_warm_up)
+{
+    expect_result_with_accessors(R"(
+        var results = [];
+        var first = { x: 1 };
+        var second = { x: 2 };
+        var o = Object.create(first);
+        warm_up(o);
+        Object.setPrototypeOf(o, second);
+        results.push(get_x(o));
+        Object.setPrototypeOf(o, {});
+        results.push(String(get_x(o)));
+        Object.setPrototypeOf(o, first);
+        first.x = 4;
+        results.push(get_x(o));
+        results.join();
+    )"sv,
+        "\"2,undefined,4\""sv);
+}
+
+TEST_CASE(objects_with_same_properties_and_different_prototypes)
+{
+    expect_result_with_accessors(R"(
+        var results = [];
+        var a = Object.create({ x: "a" });
+        var b = Object.create({ x: "b" });
+        warm_up(a);
+        results.push(get_x(b));
+        results.push(get_x(a));
+        results.join();
+    )"sv,
+        "\"b,a\""sv);
+}
+
+TEST_CASE(more_shapes_than_cache_entries)
+{
+    expect_result_with_accessors(R"(
+        var objects = [];
+        for (var i = 0; i < 8; i++) {
+            var o = {};
+            for (var j = 0; j < i; j++)
+                o["p" + j] = j;
+            o.x = i;
+            objects.push(o);
+        }
+        var sum = 0;
+        for (var round = 0; round < 10; round++) {
+            for (var i = 0; i < objects.length; i++)
+                sum += get_x(objects[i]);
+        }
+        sum;
+    )"sv,
+        "280"sv);
+}
+
+// Objects with lots of properties, or that had a property deleted, get a shape of their own that changes in place.
+static constexpr StringView make_dictionary = R"(
+    function make_dictionary() {
+        var o = {};
+        for (var i = 0; i < 150; i++)
+            o["p" + i] = i;
+        o.x = "x";
+        o.y = "y";
+        return o;
+    }
+)"sv;
+
+TEST_CASE(dictionary_delete_property)
+{
+    expect_result_with_accessors(String::formatted("{}{}", make_dictionary, R"(
+        var results = [];
+        var o = make_dictionary();
+        warm_up(o);
+        Reflect.deleteProperty(o, "p0");
+        results.push(get_x(o));
+        results.push(get_y(o));
+        Reflect.deleteProperty(o, "x");
+        results.push(String(get_x(o)));
+        results.push(get_y(o));
+        results.join();
+    )"sv),
+        "\"x,y,undefined,y\""sv);
+}
+
+TEST_CASE(dictionary_add_property)
+{
+    expect_result_with_accessors(String::formatted("{}{}", make_dictionary, R"(
+        var o = make_dictionary();
+        Reflect.deleteProperty(o, "x");
+        for (var i = 0; i < 10; i++)
+            get_x(o);
+        o.x = "added";
+        get_x(o);
+    )"sv),
+        "\"added\""sv);
+}
+
+TEST_CASE(dictionary_property_becomes_read_only)
+{
+    // The bytecode interpreter throws when an assignment fails even in sloppy mode, so only the property's value is
+    // compared, in a separate script.
+    for (auto mode : { JSTest::Mode::AST, JSTest::Mode::Bytecode }) {
+        JSTest::ScriptRunner runner;
+        runner.run(String::formatted("{}{}{}", accessors, make_dictionary, R"(
+            var o = make_dictionary();
+            for (var i = 0; i < 10; i++)
+                set_x(o, i);
+            Object.defineProperty(o, "x", { writable: false });
+            set_x(o, "written");
+        )"sv),
+            mode);
+        runner.run("get_x(o);"sv, mode);
+        EXPECT_EQ(runner.result(), "9");
+    }
+}
+
+TEST_CASE(dictionary_property_becomes_getter)
+{
+    expect_result_with_accessors(String::formatted("{}{}", make_dictionary, R"(
+        var o = make_dictionary();
+        warm_up(o);
+        Object.defineProperty(o, "x", { get() { return "getter"; } });
+        get_x(o);
+    )"sv),
+        "\"getter\""sv);
+}
+
+TEST_CASE(getter_replaces_data_property_on_prototype)
+{
+    expect_result_with_accessors(R"(
+        var proto = { x: 1, y: 2 };
+        var o = Object.create(proto);
+        warm_up(o);
+        Object.defineProperty(proto, "x", { get() { return "getter"; } });
+        get_x(o);
+    )"sv,
+        "\"getter\""sv);
+}
+
+TEST_CASE(getter_appears_further_up_the_prototype_chain)
+{
+    expect_result_with_accessors(R"(
+        var results = [];
+        var grandparent = {};
+        var parent = Object.create(grandparent);
+        var o = Object.create(parent);
+        warm_up(o);
+        Object.defineProperty(grandparent, "x", { get() { return "grandparent"; } });
+        results.push(get_x(o));
+        Object.defineProperty(parent, "x", { get() { return "parent"; } });
+        results.push(get_x(o));
+        results.join();
+    )"sv,
+        "\"grandparent,parent\""sv);
+}
+
+TEST_CASE(setter_appears_on_prototype)
+{
+    expect_result_with_accessors(R"(
+        var proto = {};
+        var o = Object.create(proto);
+        var assigned = [];
+        for (var i = 0; i < 10; i++) {
+            set_x(o, i);
+            Reflect.deleteProperty(o, "x");
+        }
+        Object.defineProperty(proto, "x", { set(value) { assigned.push(value); } });
+        set_x(o, "through setter");
+        assigned.join() + " " + Object.keys(o).length;
+    )"sv,
+        "\"through setter 0\""sv);
+}
+
+TEST_CASE(own_property_becomes_setter)
+{
+    expect_result_with_accessors(R"(
+        var o = { x: 0 };
+        for (var i = 0; i < 10; i++)
+            set_x(o, i);
+        var assigned;
+        Object.defineProperty(o, "x", { set(value) { assigned = value; }, get() { return "getter"; } });
+        set_x(o, "through setter");
+        assigned + " " + get_x(o);
+    )"sv,
+        "\"through setter getter\""sv);
+}
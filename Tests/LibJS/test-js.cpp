@@ -32,6 +32,13 @@ TESTJS_GLOBAL_FUNCTION(run_queued_promise_jobs, runQueuedPromiseJobs)
     return JS::js_undefined();
 }
 
+// WeakRefs keep their target alive until the end of the current execution, which is the whole test file.
+TESTJS_GLOBAL_FUNCTION(finish_execution_generation, finishExecutionGeneration, 0)
+{
+    vm.finish_execution_generation();
+    return JS::js_undefined();
+}
+
 TESTJS_GLOBAL_FUNCTION(get_weak_set_size, getWeakSetSize)
 {
     auto* object = vm.argument(0).to_object(global_object);
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <LibPthread/pthread.h>
+#include <errno.h>
+#include <time.h>
+
+static constexpr size_t thread_count = 8;
+static constexpr size_t iterations_per_thread = 100000;
+
+static void run_threads(void* (*function)(void*), void* argument)
+{
+    Array<pthread_t, thread_count> threads;
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_create(&thread, nullptr, function, argument), 0);
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+}
+
+struct Counter {
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    u64 value { 0 };
+    size_t work_per_iteration { 0 };
+};
+
+static void* increment_counter(void* argument)
+{
+    auto& counter = *static_cast<Counter*>(argument);
+    for (size_t i = 0; i < iterations_per_thread; ++i) {
+        pthread_mutex_lock(&counter.mutex);
+        // Simulate a critical section of some length.
+        for (size_t j = 0; j < counter.work_per_iteration; ++j)
+            AK::atomic_signal_fence(AK::memory_order_seq_cst);
+        ++counter.value;
+        pthread_mutex_unlock(&counter.mutex);
+    }
+    return nullptr;
+}
+
+BENCHMARK_CASE(mutex_short_critical_section)
+{
+    Counter counter;
+    run_threads(increment_counter, &counter);
+    EXPECT_EQ(counter.value, thread_count * iterations_per_thread);
+}
+
+BENCHMARK_CASE(mutex_long_critical_section)
+{
+    // Long enough that spinning should give up, and threads go to sleep.
+    Counter counter;
+    counter.work_per_iteration = 200;
+    run_threads(increment_counter, &counter);
+    EXPECT_EQ(counter.value, thread_count * iterations_per_thread);
+}
+
+struct ReadMostly {
+    pthread_rwlock_t rwlock;
+    Atomic<size_t> readers_inside { 0 };
+    u64 value { 0 };
+    size_t writer_every { 0 };
+    Atomic<bool> saw_writer_with_readers { false };
+};
+
+static void* read_or_write(void* argument)
+{
+    auto& shared = *static_cast<ReadMostly*>(argument);
+    for (size_t i = 0; i < iterations_per_thread; ++i) {
+        if (i % shared.writer_every == 0) {
+            pthread_rwlock_wrlock(&shared.rwlock);
+            if (shared.readers_inside.load() != 0)
+                shared.saw_writer_with_readers.store(true);
+            ++shared.value;
+            pthread_rwlock_unlock(&shared.rwlock);
+        } else {
+            pthread_rwlock_rdlock(&shared.rwlock);
+            shared.readers_inside.fetch_add(1);
+            [[maybe_unused]] auto value = shared.value;
+            shared.readers_inside.fetch_sub(1);
+            pthread_rwlock_unlock(&shared.rwlock);
+        }
+    }
+    return nullptr;
+}
+
+static void rwlock_benchmark(size_t writer_every)
+{
+    ReadMostly shared;
+    shared.writer_every = writer_every;
+    EXPECT_EQ(pthread_rwlock_init(&shared.rwlock, nullptr), 0);
+    run_threads(read_or_write, &shared);
+    EXPECT_EQ(shared.value, thread_count * ((iterations_per_thread + writer_every - 1) / writer_every));
+    EXPECT(!shared.saw_writer_with_readers.load());
+    EXPECT_EQ(pthread_rwlock_destroy(&shared.rwlock), 0);
+}
+
+BENCHMARK_CASE(rwlock_read_mostly) { rwlock_benchmark(100); }
+BENCHMARK_CASE(rwlock_write_heavy) { rwlock_benchmark(2); }
+
+struct Queue {
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t not_empty = PTHREAD_COND_INITIALIZER;
+    size_t pending { 0 };
+    size_t consumed { 0 };
+    bool done { false };
+};
+
+static void* consume(void* argument)
+{
+    auto& queue = *static_cast<Queue*>(argument);
+    pthread_mutex_lock(&queue.mutex);
+    for (;;) {
+        while (queue.pending == 0 && !queue.done)
+            pthread_cond_wait(&queue.not_empty, &queue.mutex);
+        if (queue.pending == 0)
+            break;
+        --queue.pending;
+        ++queue.consumed;
+    }
+    pthread_mutex_unlock(&queue.mutex);
+    return nullptr;
+}
+
+static void condition_benchmark(bool broadcast)
+{
+    // One producer signals while holding the mutex, which is where waking waiters up
+    // directly would only have them run into the held mutex.
+    Queue queue;
+    Array<pthread_t, thread_count> consumers;
+    for (auto& consumer : consumers)
+        EXPECT_EQ(pthread_create(&consumer, nullptr, consume, &queue), 0);
+
+    for (size_t i = 0; i < iterations_per_thread; ++i) {
+        pthread_mutex_lock(&queue.mutex);
+        ++queue.pending;
+        if (broadcast)
+            pthread_cond_broadcast(&queue.not_empty);
+        else
+            pthread_cond_signal(&queue.not_empty);
+        pthread_mutex_unlock(&queue.mutex);
+    }
+
+    pthread_mutex_lock(&queue.mutex);
+    queue.done = true;
+    pthread_cond_broadcast(&queue.not_empty);
+    pthread_mutex_unlock(&queue.mutex);
+    for (auto& consumer : consumers)
+        EXPECT_EQ(pthread_join(consumer, nullptr), 0);
+    EXPECT_EQ(queue.consumed, iterations_per_thread);
+}
+
+BENCHMARK_CASE(condition_signal_under_mutex) { condition_benchmark(false); }
+BENCHMARK_CASE(condition_broadcast_under_mutex) { condition_benchmark(true); }
+
+struct PingPong {
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t turn_changed = PTHREAD_COND_INITIALIZER;
+    size_t turn { 0 };
+};
+
+static constexpr size_t ping_pong_rounds = 20000;
+
+static void* play(void* argument)
+{
+    auto& ping_pong = *static_cast<PingPong*>(argument);
+    pthread_mutex_lock(&ping_pong.mutex);
+    for (size_t round = 0; round < ping_pong_rounds; ++round) {
+        while (ping_pong.turn % 2 == 0)
+            pthread_cond_wait(&ping_pong.turn_changed, &ping_pong.mutex);
+        ++ping_pong.turn;
+        pthread_cond_signal(&ping_pong.turn_changed);
+    }
+    pthread_mutex_unlock(&ping_pong.mutex);
+    return nullptr;
+}
+
+BENCHMARK_CASE(condition_ping_pong)
+{
+    // Two threads take turns, so every signal has exactly one waiter to hand over to.
+    PingPong ping_pong;
+    pthread_t other;
+    EXPECT_EQ(pthread_create(&other, nullptr, play, &ping_pong), 0);
+    pthread_mutex_lock(&ping_pong.mutex);
+    for (size_t round = 0; round < ping_pong_rounds; ++round) {
+        while (ping_pong.turn % 2 == 1)
+            pthread_cond_wait(&ping_pong.turn_changed, &ping_pong.mutex);
+        ++ping_pong.turn;
+        pthread_cond_signal(&ping_pong.turn_changed);
+    }
+    pthread_mutex_unlock(&ping_pong.mutex);
+    EXPECT_EQ(pthread_join(other, nullptr), 0);
+    EXPECT_EQ(ping_pong.turn, 2 * ping_pong_rounds);
+}
+
+TEST_CASE(rwlock_try_and_timed_lock)
+{
+    pthread_rwlock_t rwlock;
+    EXPECT_EQ(pthread_rwlock_init(&rwlock, nullptr), 0);
+
+    // Readers can share the lock, writers can't.
+    EXPECT_EQ(pthread_rwlock_tryrdlock(&rwlock), 0);
+    EXPECT_EQ(pthread_rwlock_tryrdlock(&rwlock), 0);
+    EXPECT_EQ(pthread_rwlock_trywrlock(&rwlock), EBUSY);
+    EXPECT_EQ(pthread_rwlock_unlock(&rwlock), 0);
+    EXPECT_EQ(pthread_rwlock_unlock(&rwlock), 0);
+
+    EXPECT_EQ(pthread_rwlock_trywrlock(&rwlock), 0);
+    EXPECT_EQ(pthread_rwlock_tryrdlock(&rwlock), EBUSY);
+
+    // Another thread gives up on waiting for the writer after a while.
+    pthread_t reader;
+    EXPECT_EQ(pthread_create(
+                  &reader, nullptr, [](void* argument) -> void* {
+                      timespec deadline;
+                      clock_gettime(CLOCK_REALTIME, &deadline);
+                      deadline.tv_nsec += 10'000'000;
+                      if (deadline.tv_nsec >= 1'000'000'000) {
+                          deadline.tv_nsec -= 1'000'000'000;
+                          ++deadline.tv_sec;
+                      }
+                      return reinterpret_cast<void*>(static_cast<FlatPtr>(pthread_rwlock_timedrdlock(static_cast<pthread_rwlock_t*>(argument), &deadline)));
+                  },
+                  &rwlock),
+        0);
+    void* result;
+    EXPECT_EQ(pthread_join(reader, &result), 0);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(result), static_cast<FlatPtr>(ETIMEDOUT));
+    EXPECT_EQ(pthread_rwlock_unlock(&rwlock), 0);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <LibPthread/pthread.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+
+static constexpr size_t reader_count = 4;
+static constexpr time_t give_up_after_seconds = 10;
+
+struct Shared {
+    pthread_rwlock_t rwlock;
+    Atomic<bool> stop { false };
+    Atomic<bool> readers_gave_up { false };
+    Atomic<size_t> readers_inside { 0 };
+    Atomic<size_t> reads { 0 };
+    time_t deadline { 0 };
+};
+
+static time_t now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
+}
+
+static void* read_continuously(void* argument)
+{
+    auto& shared = *static_cast<Shared*>(argument);
+    while (!shared.stop.load()) {
+        EXPECT_EQ(pthread_rwlock_rdlock(&shared.rwlock), 0);
+        shared.readers_inside.fetch_add(1);
+        // Stay inside for a bit, so that there's nearly always at least one reader holding the lock.
+        for (size_t i = 0; i < 1000; ++i)
+            AK::atomic_signal_fence(AK::memory_order_seq_cst);
+        shared.reads.fetch_add(1);
+        shared.readers_inside.fetch_sub(1);
+        EXPECT_EQ(pthread_rwlock_unlock(&shared.rwlock), 0);
+
+        // If the writer starves, stop reading eventually so that the test fails instead of hanging.
+        if (now() > shared.deadline) {
+            shared.readers_gave_up.store(true);
+            break;
+        }
+    }
+    return nullptr;
+}
+
+TEST_CASE(writer_makes_progress_under_continuous_readers)
+{
+    Shared shared;
+    shared.deadline = now() + give_up_after_seconds;
+    EXPECT_EQ(pthread_rwlock_init(&shared.rwlock, nullptr), 0);
+
+    Array<pthread_t, reader_count> readers;
+    for (auto& reader : readers)
+        EXPECT_EQ(pthread_create(&reader, nullptr, read_continuously, &shared), 0);
+
+    // Wait until the readers are going.
+    while (shared.reads.load() < 1000)
+        sched_yield();
+
+    size_t writes = 0;
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(pthread_rwlock_wrlock(&shared.rwlock), 0);
+        EXPECT_EQ(shared.readers_inside.load(), 0u);
+        ++writes;
+        EXPECT_EQ(pthread_rwlock_unlock(&shared.rwlock), 0);
+    }
+
+    shared.stop.store(true);
+    for (auto& reader : readers)
+        EXPECT_EQ(pthread_join(reader, nullptr), 0);
+
+    EXPECT_EQ(writes, 100u);
+    EXPECT(!shared.readers_gave_up.load());
+    EXPECT_EQ(pthread_rwlock_destroy(&shared.rwlock), 0);
+}
+
+static void* try_to_read(void* argument)
+{
+    auto& rwlock = *static_cast<pthread_rwlock_t*>(argument);
+    auto rc = pthread_rwlock_tryrdlock(&rwlock);
+    if (rc == 0)
+        pthread_rwlock_unlock(&rwlock);
+    return reinterpret_cast<void*>(static_cast<FlatPtr>(rc));
+}
+
+static void* write_with_timeout(void* argument)
+{
+    auto& rwlock = *static_cast<pthread_rwlock_t*>(argument);
+    timespec timeout;
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_nsec += 100'000'000;
+    if (timeout.tv_nsec >= 1'000'000'000) {
+        timeout.tv_nsec -= 1'000'000'000;
+        ++timeout.tv_sec;
+    }
+    return reinterpret_cast<void*>(static_cast<FlatPtr>(pthread_rwlock_timedwrlock(&rwlock, &timeout)));
+}
+
+TEST_CASE(readers_are_let_back_in_after_writer_times_out)
+{
+    pthread_rwlock_t rwlock;
+    EXPECT_EQ(pthread_rwlock_init(&rwlock, nullptr), 0);
+    EXPECT_EQ(pthread_rwlock_rdlock(&rwlock), 0);
+
+    pthread_t writer;
+    void* result = nullptr;
+    EXPECT_EQ(pthread_create(&writer, nullptr, write_with_timeout, &rwlock), 0);
+    EXPECT_EQ(pthread_join(writer, &result), 0);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(result), static_cast<FlatPtr>(ETIMEDOUT));
+
+    // The writer is gone, so new readers mustn't be kept out on its behalf.
+    pthread_t reader;
+    EXPECT_EQ(pthread_create(&reader, nullptr, try_to_read, &rwlock), 0);
+    EXPECT_EQ(pthread_join(reader, &result), 0);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(result), 0u);
+
+    EXPECT_EQ(pthread_rwlock_unlock(&rwlock), 0);
+    EXPECT_EQ(pthread_rwlock_trywrlock(&rwlock), 0);
+    EXPECT_EQ(pthread_rwlock_unlock(&rwlock), 0);
+    EXPECT_EQ(pthread_rwlock_destroy(&rwlock), 0);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Vector.h>
+#include <LibThreading/ParallelSort.h>
+
+static Vector<u32> generate(size_t size, u32 modulus)
+{
+    Vector<u32> data;
+    data.ensure_capacity(size);
+    u32 state = 0x2545F491;
+    for (size_t i = 0; i < size; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        data.unchecked_append(state % modulus);
+    }
+    return data;
+}
+
+TEST_CASE(sorts)
+{
+    Threading::ThreadPool pool(4);
+    for (size_t size : { 0, 1, 1000, 16384, 100000, 123457 }) {
+        auto data = generate(size, NumericLimits<u32>::max());
+        u64 expected_sum = 0;
+        for (auto value : data)
+            expected_sum += value;
+
+        Threading::parallel_sort(pool, data);
+        u64 sum = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            sum += data[i];
+            if (i)
+                EXPECT(data[i - 1] <= data[i]);
+        }
+        EXPECT_EQ(sum, expected_sum);
+    }
+}
+
+TEST_CASE(stable_sort_is_stable)
+{
+    struct KeyAndIndex {
+        u32 key;
+        size_t index;
+    };
+
+    Threading::ThreadPool pool(3);
+    auto keys = generate(100003, 100);
+    Vector<KeyAndIndex> data;
+    for (size_t i = 0; i < keys.size(); ++i)
+        data.append({ keys[i], i });
+
+    Threading::parallel_stable_sort(pool, data, [](auto& a, auto& b) { return a.key < b.key; });
+    for (size_t i = 1; i < data.size(); ++i) {
+        EXPECT(data[i - 1].key <= data[i].key);
+        if (data[i - 1].key == data[i].key)
+            EXPECT(data[i - 1].index < data[i].index);
+    }
+}
+
+static void benchmark_sort(size_t worker_count)
+{
+    Threading::ThreadPool pool(worker_count);
+    auto data = generate(4000000, NumericLimits<u32>::max());
+    Threading::parallel_sort(pool, data);
+    for (size_t i = 1; i < data.size(); ++i)
+        VERIFY(data[i - 1] <= data[i]);
+}
+
+BENCHMARK_CASE(parallel_sort_1_worker) { benchmark_sort(1); }
+BENCHMARK_CASE(parallel_sort_2_workers) { benchmark_sort(2); }
+BENCHMARK_CASE(parallel_sort_4_workers) { benchmark_sort(4); }
+BENCHMARK_CASE(parallel_sort_8_workers) { benchmark_sort(8); }
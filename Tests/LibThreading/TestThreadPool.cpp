@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/FixedArray.h>
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibThreading/WorkStealingQueue.h>
+
+TEST_CASE(work_stealing_queue_order)
+{
+    Threading::WorkStealingQueue<uintptr_t> queue(4);
+    for (uintptr_t i = 1; i <= 100; ++i)
+        queue.push(i);
+
+    // The owner pops the newest element, thieves steal the oldest one.
+    EXPECT_EQ(queue.pop().value(), 100u);
+    EXPECT_EQ(queue.steal().value(), 1u);
+    for (uintptr_t i = 99; i >= 2; --i)
+        EXPECT_EQ(queue.pop().value(), i);
+    EXPECT(queue.is_empty());
+    EXPECT(!queue.pop().has_value());
+    EXPECT(!queue.steal().has_value());
+}
+
+static constexpr size_t thief_count = 3;
+static constexpr uintptr_t stolen_item_count = 200000;
+
+struct StealingRace {
+    Threading::WorkStealingQueue<uintptr_t> queue { 64 };
+    Atomic<bool> done { false };
+    Array<u64, thief_count> stolen_sums {};
+};
+
+struct Thief {
+    StealingRace* race;
+    size_t index;
+};
+
+static void* steal_until_done(void* argument)
+{
+    auto& thief = *static_cast<Thief*>(argument);
+    u64 sum = 0;
+    while (!thief.race->done.load() || !thief.race->queue.is_empty()) {
+        if (auto item = thief.race->queue.steal(); item.has_value())
+            sum += item.value();
+    }
+    thief.race->stolen_sums[thief.index] = sum;
+    return nullptr;
+}
+
+TEST_CASE(work_stealing_queue_every_item_is_taken_once)
+{
+    StealingRace race;
+    Array<Thief, thief_count> thieves;
+    Array<pthread_t, thief_count> threads;
+    for (size_t i = 0; i < thief_count; ++i) {
+        thieves[i] = { &race, i };
+        EXPECT_EQ(pthread_create(&threads[i], nullptr, steal_until_done, &thieves[i]), 0);
+    }
+
+    u64 popped_sum = 0;
+    for (uintptr_t i = 1; i <= stolen_item_count; ++i) {
+        race.queue.push(i);
+        if (i % 3 == 0) {
+            if (auto item = race.queue.pop(); item.has_value())
+                popped_sum += item.value();
+        }
+    }
+    race.done.store(true);
+    for (auto item = race.queue.pop(); item.has_value(); item = race.queue.pop())
+        popped_sum += item.value();
+
+    u64 total = popped_sum;
+    for (size_t i = 0; i < thief_count; ++i) {
+        EXPECT_EQ(pthread_join(threads[i], nullptr), 0);
+        total += race.stolen_sums[i];
+    }
+    EXPECT_EQ(total, static_cast<u64>(stolen_item_count) * (stolen_item_count + 1) / 2);
+}
+
+TEST_CASE(parallel_for_visits_every_index_once)
+{
+    Threading::ThreadPool pool(4);
+    FixedArray<Atomic<u32>> visits(100000);
+    pool.parallel_for(0, visits.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            visits[i].fetch_add(1);
+    });
+    for (auto& visit_count : visits)
+        EXPECT_EQ(visit_count.load(), 1u);
+
+    // Empty ranges and ranges smaller than a single chunk.
+    pool.parallel_for(5, 5, [&](size_t, size_t) { VERIFY_NOT_REACHED(); });
+    size_t calls = 0;
+    pool.parallel_for(0, 3, [&](size_t begin, size_t end) { calls += end - begin; }, 100);
+    EXPECT_EQ(calls, 3u);
+}
+
+TEST_CASE(nested_parallel_for)
+{
+    Threading::ThreadPool pool(4);
+    Atomic<size_t> total { 0 };
+    pool.parallel_for(
+        0, 64, [&](size_t outer_begin, size_t outer_end) {
+            for (size_t i = outer_begin; i < outer_end; ++i) {
+                pool.parallel_for(
+                    0, 1000, [&](size_t begin, size_t end) { total.fetch_add(end - begin); }, 10);
+            }
+        },
+        1);
+    EXPECT_EQ(total.load(), 64u * 1000);
+}
+
+TEST_CASE(parallel_reduce)
+{
+    Threading::ThreadPool pool(3);
+    auto sum = pool.parallel_reduce(
+        1, 100001, u64 { 0 },
+        [](size_t begin, size_t end) {
+            u64 partial = 0;
+            for (size_t i = begin; i < end; ++i)
+                partial += i;
+            return partial;
+        },
+        [](u64 a, u64 b) { return a + b; }, 1000);
+    EXPECT_EQ(sum, 100000ull * 100001 / 2);
+
+    // Partial results are combined in order.
+    auto digits = pool.parallel_reduce(
+        0, 10, String::empty(),
+        [](size_t begin, size_t end) {
+            StringBuilder builder;
+            for (size_t i = begin; i < end; ++i)
+                builder.appendff("{}", i);
+            return builder.to_string();
+        },
+        [](String a, String b) { return String::formatted("{}{}", a, b); }, 1);
+    EXPECT_EQ(digits, "0123456789");
+}
+
+TEST_CASE(future_await)
+{
+    Threading::ThreadPool pool(2);
+    auto future = pool.async<int>([] { return 42; });
+    EXPECT_EQ(future->await(), 42);
+    EXPECT(future->is_resolved());
+}
+
+TEST_CASE(future_completion_runs_on_event_loop)
+{
+    Core::EventLoop loop;
+    Threading::ThreadPool pool(2);
+    auto caller = pthread_self();
+    bool completed = false;
+    auto future = pool.async<String>(
+        [] { return String("done"); },
+        [&](String& result) {
+            EXPECT_EQ(result, "done");
+            EXPECT(pthread_equal(pthread_self(), caller));
+            completed = true;
+            loop.quit(0);
+        });
+    loop.exec();
+    EXPECT(completed);
+}
+
+// Scalability: the same amount of CPU-bound work, spread over pools of different sizes.
+static u64 busy_work(size_t begin, size_t end)
+{
+    u64 state = 0;
+    for (size_t i = begin; i < end; ++i) {
+        state ^= i;
+        for (size_t round = 0; round < 200; ++round)
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return state;
+}
+
+static void scalability_benchmark(size_t worker_count)
+{
+    Threading::ThreadPool pool(worker_count);
+    auto result = pool.parallel_reduce(
+        0, 2000000, u64 { 0 }, busy_work, [](u64 a, u64 b) { return a ^ b; }, 4096);
+    EXPECT(result != 1);
+}
+
+BENCHMARK_CASE(parallel_reduce_1_worker) { scalability_benchmark(1); }
+BENCHMARK_CASE(parallel_reduce_2_workers) { scalability_benchmark(2); }
+BENCHMARK_CASE(parallel_reduce_4_workers) { scalability_benchmark(4); }
+BENCHMARK_CASE(parallel_reduce_8_workers) { scalability_benchmark(8); }
+
+BENCHMARK_CASE(tiny_jobs)
+{
+    // Mostly measures scheduling overhead: every chunk is a single index.
+    Threading::ThreadPool pool(4);
+    Atomic<size_t> total { 0 };
+    pool.parallel_for(
+        0, 200000, [&](size_t begin, size_t end) { total.fetch_add(end - begin, AK::MemoryOrder::memory_order_relaxed); }, 1);
+    EXPECT_EQ(total.load(), 200000u);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// Memory-heavy loops for measuring SoftMMU throughput.
+// Run this both natively and under UserspaceEmulator and compare the numbers.
+
+static volatile uint32_t s_sink;
+
+template<typename Callback>
+static void run_benchmark(const char* name, size_t bytes_per_iteration, int iterations, Callback callback)
+{
+    Core::ElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+        callback();
+    auto elapsed_ms = max(timer.elapsed(), 1);
+    auto total_kib = (bytes_per_iteration * iterations) / KiB;
+    outln("{:>16}: {:>6} ms, {:>8} KiB/s", name, elapsed_ms, total_kib * 1000 / elapsed_ms);
+}
+
+int main(int argc, char** argv)
+{
+    int size_in_kib = 1024;
+    int iterations = 16;
+
+    auto args_parser = Core::ArgsParser();
+    args_parser.set_general_help("Measure guest memory access throughput; a benchmark for UserEmulator.");
+    args_parser.add_option(size_in_kib, "Size of the buffers in KiB (Default: 1024)", "size", 's', "size");
+    args_parser.add_option(iterations, "Number of passes over the buffers (Default: 16)", "iterations", 'i', "iterations");
+    args_parser.parse(argc, argv);
+
+    size_t size = size_in_kib * KiB;
+    auto* source = (uint32_t*)mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, 0, 0);
+    auto* destination = (uint32_t*)mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, 0, 0);
+    VERIFY(source != MAP_FAILED);
+    VERIFY(destination != MAP_FAILED);
+    size_t count = size / sizeof(uint32_t);
+
+    run_benchmark("store32", size, iterations, [&] {
+        for (size_t i = 0; i < count; ++i)
+            source[i] = i;
+    });
+
+    run_benchmark("load32", size, iterations, [&] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < count; ++i)
+            sum += source[i];
+        s_sink = sum;
+    });
+
+    // One load per page, so that every access touches a different page.
+    size_t stride = PAGE_SIZE / sizeof(uint32_t) + 1;
+    run_benchmark("strided load32", ((count + stride - 1) / stride) * sizeof(uint32_t), iterations, [&] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < count; i += stride)
+            sum += source[i];
+        s_sink = sum;
+    });
+
+    run_benchmark("memset", size, iterations, [&] {
+        memset(destination, 0x55, size);
+    });
+
+    run_benchmark("memcpy", size, iterations, [&] {
+        memcpy(destination, source, size);
+    });
+
+    // Heap memory goes through the MallocTracer, so it is expected to stay on the slow path.
+    auto* heap_buffer = (uint32_t*)malloc(64 * KiB);
+    VERIFY(heap_buffer);
+    run_benchmark("malloc store32", 64 * KiB, iterations, [&] {
+        for (size_t i = 0; i < (64 * KiB) / sizeof(uint32_t); ++i)
+            heap_buffer[i] = i;
+    });
+    free(heap_buffer);
+
+    munmap(source, size);
+    munmap(destination, size);
+    return 0;
+}
@@ -645,7 +645,8 @@ JsonObject Sheet::gather_documentation() const
         if (!doc.is_string())
             return;
 
-        JsonParser parser(doc.to_string_without_side_effects());
+        auto doc_string = doc.to_string_without_side_effects();
+        JsonParser parser(doc_string);
         auto doc_object = parser.parse();
 
         if (doc_object.has_value())
@@ -14,6 +14,8 @@ namespace HackStudio {
 
 DebuggerGlobalJSObject::DebuggerGlobalJSObject()
 {
+    m_may_interfere_with_inline_caches = true;
+
     auto regs = Debugger::the().session()->get_registers();
     auto lib = Debugger::the().session()->library_at(regs.eip);
     if (!lib)
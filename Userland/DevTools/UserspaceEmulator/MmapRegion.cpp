@@ -288,11 +288,18 @@ NonnullOwnPtr<MmapRegion> MmapRegion::split_at(VirtualAddress offset)
     return other_region;
 }
 
+void MmapRegion::set_malloc(bool b)
+{
+    m_malloc = b;
+    emulator().mmu().flush_tlb();
+}
+
 void MmapRegion::set_prot(int prot)
 {
     set_readable(prot & PROT_READ);
     set_writable(prot & PROT_WRITE);
     set_executable(prot & PROT_EXEC);
+    emulator().mmu().flush_tlb();
     if (m_file_backed) {
         if (mprotect(m_data, size(), prot & ~PROT_EXEC) < 0) {
             perror("MmapRegion::set_prot: mprotect");
@@ -38,7 +38,7 @@ public:
     virtual u8* shadow_data() override { return m_shadow_data; }
 
     bool is_malloc_block() const { return m_malloc; }
-    void set_malloc(bool b) { m_malloc = b; }
+    void set_malloc(bool);
 
     NonnullOwnPtr<MmapRegion> split_at(VirtualAddress);
 
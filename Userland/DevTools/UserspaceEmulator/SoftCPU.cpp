@@ -2570,6 +2570,18 @@ template<typename T>
 ALWAYS_INLINE static void do_movs(SoftCPU& cpu, const X86::Instruction& insn)
 {
     auto src_segment = cpu.segment(insn.segment_prefix().value_or(X86::SegmentRegister::DS));
+    if (insn.has_rep_prefix() && !cpu.df() && insn.a32()) {
+        // Fast path for forward memory copy, which moves the shadow bytes along with the data.
+        u32 count = cpu.ecx().value();
+        if (Emulator::the().mmu().fast_copy_memory({ cpu.es(), cpu.edi().value() }, { src_segment, cpu.esi().value() }, count * sizeof(T))) {
+            // FIXME: Should an uninitialized ECX taint ESI and EDI here?
+            cpu.set_esi({ (u32)(cpu.esi().value() + count * sizeof(T)), cpu.esi().shadow() });
+            cpu.set_edi({ (u32)(cpu.edi().value() + count * sizeof(T)), cpu.edi().shadow() });
+            cpu.set_ecx(shadow_wrap_as_initialized<u32>(0));
+            return;
+        }
+    }
+
     cpu.do_once_or_repeat<false>(insn, [&] {
         auto src = cpu.read_memory<T>({ src_segment, cpu.source_index(insn.a32()).value() });
         cpu.write_memory<T>({ cpu.es(), cpu.destination_index(insn.a32()).value() }, src);
@@ -40,6 +40,7 @@ void SoftMMU::remove_region(Region& region)
         m_page_to_region_map[first_page_in_region + i] = nullptr;
     }
 
+    flush_tlb();
     m_regions.remove_first_matching([&](auto& entry) { return entry.ptr() == &region; });
 }
 
@@ -80,6 +81,7 @@ void SoftMMU::ensure_split_at(X86::LogicalAddress address)
         m_page_to_region_map[page] = new_region.ptr();
     }
 
+    flush_tlb();
     m_regions.append(move(new_region));
     quick_sort((Vector<OwnPtr<Region>>&)m_regions, [](auto& a, auto& b) { return a->base() < b->base(); });
 }
@@ -90,233 +92,165 @@ void SoftMMU::set_tls_region(NonnullOwnPtr<Region> region)
     m_tls_region = move(region);
 }
 
-ValueWithShadow<u8> SoftMMU::read8(X86::LogicalAddress address)
+void SoftMMU::flush_tlb()
 {
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::read8: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_readable()) {
-        reportln("SoftMMU::read8: Non-readable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    return region->read8(address.offset() - region->base());
+    for (auto& entry : m_tlb)
+        entry = {};
 }
 
-ValueWithShadow<u16> SoftMMU::read16(X86::LogicalAddress address)
+bool SoftMMU::can_access_directly(Region& region) const
 {
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::read16: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_readable()) {
-        reportln("SoftMMU::read16: Non-readable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    return region->read16(address.offset() - region->base());
-}
-
-ValueWithShadow<u32> SoftMMU::read32(X86::LogicalAddress address)
-{
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::read32: No region for @ {:04x}:{:p}", address.selector(), address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_readable()) {
-        reportln("SoftMMU::read32: Non-readable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    return region->read32(address.offset() - region->base());
+    // Malloc blocks have every access audited by the MallocTracer, so they always take the slow path.
+    if (is<MmapRegion>(region) && static_cast<const MmapRegion&>(region).is_malloc_block())
+        return false;
+    return region.is_readable();
 }
 
-ValueWithShadow<u64> SoftMMU::read64(X86::LogicalAddress address)
+void SoftMMU::update_tlb(X86::LogicalAddress address, Region& region)
 {
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::read64: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_readable()) {
-        reportln("SoftMMU::read64: Non-readable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    return region->read64(address.offset() - region->base());
-}
+    if (address.selector() == 0x2b)
+        return;
+    if (!can_access_directly(region))
+        return;
 
-ValueWithShadow<u128> SoftMMU::read128(X86::LogicalAddress address)
-{
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::read128: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
+    u32 page_index = address.offset() / PAGE_SIZE;
+    u32 page_base = page_index * PAGE_SIZE;
 
-    if (!region->is_readable()) {
-        reportln("SoftMMU::read128: Non-readable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
+    // Regions (e.g the ones created for ELF segments) aren't necessarily page-aligned,
+    // so only cache pages that are completely covered by this region.
+    if (page_base < region.base() || page_base + PAGE_SIZE > region.end())
+        return;
 
-    return region->read128(address.offset() - region->base());
+    auto& entry = m_tlb[page_index % tlb_entry_count];
+    entry.page_index = page_index;
+    entry.data = region.data() + (page_base - region.base());
+    entry.shadow_data = region.shadow_data() + (page_base - region.base());
+    entry.writable = region.is_writable();
 }
 
-ValueWithShadow<u256> SoftMMU::read256(X86::LogicalAddress address)
+template<typename T>
+ValueWithShadow<T> SoftMMU::slow_read(X86::LogicalAddress address)
 {
     auto* region = find_region(address);
     if (!region) {
-        reportln("SoftMMU::read256: No region for @ {:p}", address.offset());
+        reportln("SoftMMU::read{}: No region for @ {:04x}:{:p}", sizeof(T) * 8, address.selector(), address.offset());
         m_emulator.dump_backtrace();
         TODO();
     }
 
     if (!region->is_readable()) {
-        reportln("SoftMMU::read256: Non-readable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    return region->read256(address.offset() - region->base());
-}
-
-void SoftMMU::write8(X86::LogicalAddress address, ValueWithShadow<u8> value)
-{
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::write8: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_writable()) {
-        reportln("SoftMMU::write8: Non-writable region @ {:p}", address.offset());
+        reportln("SoftMMU::read{}: Non-readable region @ {:p}", sizeof(T) * 8, address.offset());
         m_emulator.dump_backtrace();
         TODO();
     }
-    region->write8(address.offset() - region->base(), value);
-}
 
-void SoftMMU::write16(X86::LogicalAddress address, ValueWithShadow<u16> value)
-{
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::write16: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_writable()) {
-        reportln("SoftMMU::write16: Non-writable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    region->write16(address.offset() - region->base(), value);
+    update_tlb(address, *region);
+
+    u32 offset = address.offset() - region->base();
+    if constexpr (sizeof(T) == 1)
+        return region->read8(offset);
+    else if constexpr (sizeof(T) == 2)
+        return region->read16(offset);
+    else if constexpr (sizeof(T) == 4)
+        return region->read32(offset);
+    else if constexpr (sizeof(T) == 8)
+        return region->read64(offset);
+    else if constexpr (sizeof(T) == 16)
+        return region->read128(offset);
+    else
+        return region->read256(offset);
 }
 
-void SoftMMU::write32(X86::LogicalAddress address, ValueWithShadow<u32> value)
+template<typename T>
+void SoftMMU::slow_write(X86::LogicalAddress address, ValueWithShadow<T> value)
 {
     auto* region = find_region(address);
     if (!region) {
-        reportln("SoftMMU::write32: No region for @ {:p}", address.offset());
+        reportln("SoftMMU::write{}: No region for @ {:04x}:{:p}", sizeof(T) * 8, address.selector(), address.offset());
         m_emulator.dump_backtrace();
         TODO();
     }
 
     if (!region->is_writable()) {
-        reportln("SoftMMU::write32: Non-writable region @ {:p}", address.offset());
+        reportln("SoftMMU::write{}: Non-writable region @ {:p}", sizeof(T) * 8, address.offset());
         m_emulator.dump_backtrace();
         TODO();
     }
 
-    region->write32(address.offset() - region->base(), value);
+    update_tlb(address, *region);
+
+    u32 offset = address.offset() - region->base();
+    if constexpr (sizeof(T) == 1)
+        region->write8(offset, value);
+    else if constexpr (sizeof(T) == 2)
+        region->write16(offset, value);
+    else if constexpr (sizeof(T) == 4)
+        region->write32(offset, value);
+    else if constexpr (sizeof(T) == 8)
+        region->write64(offset, value);
+    else if constexpr (sizeof(T) == 16)
+        region->write128(offset, value);
+    else
+        region->write256(offset, value);
 }
 
-void SoftMMU::write64(X86::LogicalAddress address, ValueWithShadow<u64> value)
-{
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::write64: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_writable()) {
-        reportln("SoftMMU::write64: Non-writable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    region->write64(address.offset() - region->base(), value);
-}
+template ValueWithShadow<u8> SoftMMU::slow_read<u8>(X86::LogicalAddress);
+template ValueWithShadow<u16> SoftMMU::slow_read<u16>(X86::LogicalAddress);
+template ValueWithShadow<u32> SoftMMU::slow_read<u32>(X86::LogicalAddress);
+template ValueWithShadow<u64> SoftMMU::slow_read<u64>(X86::LogicalAddress);
+template ValueWithShadow<u128> SoftMMU::slow_read<u128>(X86::LogicalAddress);
+template ValueWithShadow<u256> SoftMMU::slow_read<u256>(X86::LogicalAddress);
 
-void SoftMMU::write128(X86::LogicalAddress address, ValueWithShadow<u128> value)
-{
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::write128: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_writable()) {
-        reportln("SoftMMU::write128: Non-writable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    region->write128(address.offset() - region->base(), value);
-}
-
-void SoftMMU::write256(X86::LogicalAddress address, ValueWithShadow<u256> value)
-{
-    auto* region = find_region(address);
-    if (!region) {
-        reportln("SoftMMU::write256: No region for @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    if (!region->is_writable()) {
-        reportln("SoftMMU::write256: Non-writable region @ {:p}", address.offset());
-        m_emulator.dump_backtrace();
-        TODO();
-    }
-
-    region->write256(address.offset() - region->base(), value);
-}
+template void SoftMMU::slow_write<u8>(X86::LogicalAddress, ValueWithShadow<u8>);
+template void SoftMMU::slow_write<u16>(X86::LogicalAddress, ValueWithShadow<u16>);
+template void SoftMMU::slow_write<u32>(X86::LogicalAddress, ValueWithShadow<u32>);
+template void SoftMMU::slow_write<u64>(X86::LogicalAddress, ValueWithShadow<u64>);
+template void SoftMMU::slow_write<u128>(X86::LogicalAddress, ValueWithShadow<u128>);
+template void SoftMMU::slow_write<u256>(X86::LogicalAddress, ValueWithShadow<u256>);
 
 void SoftMMU::copy_to_vm(FlatPtr destination, const void* source, size_t size)
 {
     // FIXME: We should have a way to preserve the shadow data here as well.
-    for (size_t i = 0; i < size; ++i)
-        write8({ 0x23, destination + i }, shadow_wrap_as_initialized(((const u8*)source)[i]));
+    while (size) {
+        auto* region = find_region({ 0x23, destination });
+        if (!region || !region->is_writable() || !can_access_directly(*region)) {
+            // Let the regular write path deal with reporting errors and auditing.
+            write8({ 0x23, destination }, shadow_wrap_as_initialized(*(const u8*)source));
+            source = (const u8*)source + 1;
+            ++destination;
+            --size;
+            continue;
+        }
+        size_t offset_in_region = destination - region->base();
+        size_t chunk_size = min(size, (size_t)region->size() - offset_in_region);
+        memcpy(region->data() + offset_in_region, source, chunk_size);
+        memset(region->shadow_data() + offset_in_region, 0x01, chunk_size);
+        source = (const u8*)source + chunk_size;
+        destination += chunk_size;
+        size -= chunk_size;
+    }
 }
 
 void SoftMMU::copy_from_vm(void* destination, const FlatPtr source, size_t size)
 {
     // FIXME: We should have a way to preserve the shadow data here as well.
-    for (size_t i = 0; i < size; ++i)
-        ((u8*)destination)[i] = read8({ 0x23, source + i }).value();
+    FlatPtr current_source = source;
+    while (size) {
+        auto* region = find_region({ 0x23, current_source });
+        if (!region || !can_access_directly(*region)) {
+            *(u8*)destination = read8({ 0x23, current_source }).value();
+            destination = (u8*)destination + 1;
+            ++current_source;
+            --size;
+            continue;
+        }
+        size_t offset_in_region = current_source - region->base();
+        size_t chunk_size = min(size, (size_t)region->size() - offset_in_region);
+        memcpy(destination, region->data() + offset_in_region, chunk_size);
+        destination = (u8*)destination + chunk_size;
+        current_source += chunk_size;
+        size -= chunk_size;
+    }
 }
 
 ByteBuffer SoftMMU::copy_buffer_from_vm(const FlatPtr source, size_t size)
@@ -376,4 +310,33 @@ bool SoftMMU::fast_fill_memory32(X86::LogicalAddress address, size_t count, Valu
     return true;
 }
 
+bool SoftMMU::fast_copy_memory(X86::LogicalAddress destination, X86::LogicalAddress source, size_t size)
+{
+    if (!size)
+        return true;
+    auto* destination_region = find_region(destination);
+    auto* source_region = find_region(source);
+    if (!destination_region || !source_region)
+        return false;
+    if (!destination_region->contains(destination.offset() + size - 1) || !source_region->contains(source.offset() + size - 1))
+        return false;
+    if (!destination_region->is_writable() || !source_region->is_readable())
+        return false;
+    if (!can_access_directly(*destination_region) || !can_access_directly(*source_region))
+        return false;
+
+    // A forward copy into an overlapping range ahead of the source replicates the
+    // source bytes, which memmove() doesn't do. Leave that (rare) case to the slow path.
+    if (destination.offset() > source.offset() && destination.offset() < source.offset() + size)
+        return false;
+
+    auto* destination_data = destination_region->data() + (destination.offset() - destination_region->base());
+    auto* destination_shadow = destination_region->shadow_data() + (destination.offset() - destination_region->base());
+    auto* source_data = source_region->data() + (source.offset() - source_region->base());
+    auto* source_shadow = source_region->shadow_data() + (source.offset() - source_region->base());
+    memmove(destination_data, source_data, size);
+    memmove(destination_shadow, source_shadow, size);
+    return true;
+}
+
 }
@@ -22,19 +22,19 @@ class SoftMMU {
 public:
     explicit SoftMMU(Emulator&);
 
-    ValueWithShadow<u8> read8(X86::LogicalAddress);
-    ValueWithShadow<u16> read16(X86::LogicalAddress);
-    ValueWithShadow<u32> read32(X86::LogicalAddress);
-    ValueWithShadow<u64> read64(X86::LogicalAddress);
-    ValueWithShadow<u128> read128(X86::LogicalAddress);
-    ValueWithShadow<u256> read256(X86::LogicalAddress);
-
-    void write8(X86::LogicalAddress, ValueWithShadow<u8>);
-    void write16(X86::LogicalAddress, ValueWithShadow<u16>);
-    void write32(X86::LogicalAddress, ValueWithShadow<u32>);
-    void write64(X86::LogicalAddress, ValueWithShadow<u64>);
-    void write128(X86::LogicalAddress, ValueWithShadow<u128>);
-    void write256(X86::LogicalAddress, ValueWithShadow<u256>);
+    ValueWithShadow<u8> read8(X86::LogicalAddress address) { return read<u8>(address); }
+    ValueWithShadow<u16> read16(X86::LogicalAddress address) { return read<u16>(address); }
+    ValueWithShadow<u32> read32(X86::LogicalAddress address) { return read<u32>(address); }
+    ValueWithShadow<u64> read64(X86::LogicalAddress address) { return read<u64>(address); }
+    ValueWithShadow<u128> read128(X86::LogicalAddress address) { return read<u128>(address); }
+    ValueWithShadow<u256> read256(X86::LogicalAddress address) { return read<u256>(address); }
+
+    void write8(X86::LogicalAddress address, ValueWithShadow<u8> value) { write<u8>(address, value); }
+    void write16(X86::LogicalAddress address, ValueWithShadow<u16> value) { write<u16>(address, value); }
+    void write32(X86::LogicalAddress address, ValueWithShadow<u32> value) { write<u32>(address, value); }
+    void write64(X86::LogicalAddress address, ValueWithShadow<u64> value) { write<u64>(address, value); }
+    void write128(X86::LogicalAddress address, ValueWithShadow<u128> value) { write<u128>(address, value); }
+    void write256(X86::LogicalAddress address, ValueWithShadow<u256> value) { write<u256>(address, value); }
 
     ALWAYS_INLINE Region* find_region(X86::LogicalAddress address)
     {
@@ -51,8 +51,13 @@ public:
 
     void set_tls_region(NonnullOwnPtr<Region>);
 
+    // Must be called whenever a region is unmapped, split, or has its protection
+    // or malloc-block status changed, since the TLB caches host pointers and access bits.
+    void flush_tlb();
+
     bool fast_fill_memory8(X86::LogicalAddress, size_t size, ValueWithShadow<u8>);
     bool fast_fill_memory32(X86::LogicalAddress, size_t size, ValueWithShadow<u32>);
+    bool fast_copy_memory(X86::LogicalAddress destination, X86::LogicalAddress source, size_t size);
 
     void copy_to_vm(FlatPtr destination, const void* source, size_t);
     void copy_from_vm(void* destination, const FlatPtr source, size_t);
@@ -94,10 +99,70 @@ public:
     }
 
 private:
+    // A small direct-mapped software TLB of recently accessed pages.
+    // Entries point straight at the host memory backing a guest page, which lets
+    // most accesses skip the region lookup and the virtual Region::read/write calls.
+    // Only pages that are entirely covered by a region that doesn't need access
+    // auditing (i.e not a malloc block) are ever cached here.
+    struct TLBEntry {
+        u32 page_index { 0xffffffff };
+        u8* data { nullptr };
+        u8* shadow_data { nullptr };
+        bool writable { false };
+    };
+
+    static constexpr size_t tlb_entry_count = 256;
+
+    ALWAYS_INLINE TLBEntry* tlb_lookup(X86::LogicalAddress address, size_t access_size)
+    {
+        if (address.selector() == 0x2b)
+            return nullptr;
+        u32 offset_in_page = address.offset() & (PAGE_SIZE - 1);
+        if (offset_in_page + access_size > PAGE_SIZE)
+            return nullptr;
+        u32 page_index = address.offset() / PAGE_SIZE;
+        auto& entry = m_tlb[page_index % tlb_entry_count];
+        if (entry.page_index != page_index)
+            return nullptr;
+        return &entry;
+    }
+
+    template<typename T>
+    ALWAYS_INLINE ValueWithShadow<T> read(X86::LogicalAddress address)
+    {
+        if (auto* entry = tlb_lookup(address, sizeof(T))) {
+            u32 offset_in_page = address.offset() & (PAGE_SIZE - 1);
+            return { *reinterpret_cast<const T*>(entry->data + offset_in_page), *reinterpret_cast<const T*>(entry->shadow_data + offset_in_page) };
+        }
+        return slow_read<T>(address);
+    }
+
+    template<typename T>
+    ALWAYS_INLINE void write(X86::LogicalAddress address, ValueWithShadow<T> value)
+    {
+        if (auto* entry = tlb_lookup(address, sizeof(T)); entry && entry->writable) {
+            u32 offset_in_page = address.offset() & (PAGE_SIZE - 1);
+            *reinterpret_cast<T*>(entry->data + offset_in_page) = value.value();
+            *reinterpret_cast<T*>(entry->shadow_data + offset_in_page) = value.shadow();
+            return;
+        }
+        slow_write<T>(address, value);
+    }
+
+    template<typename T>
+    ValueWithShadow<T> slow_read(X86::LogicalAddress);
+    template<typename T>
+    void slow_write(X86::LogicalAddress, ValueWithShadow<T>);
+
+    bool can_access_directly(Region&) const;
+    void update_tlb(X86::LogicalAddress, Region&);
+
     Emulator& m_emulator;
 
     Region* m_page_to_region_map[786432] = { nullptr };
 
+    TLBEntry m_tlb[tlb_entry_count];
+
     OwnPtr<Region> m_tls_region;
     NonnullOwnPtrVector<Region> m_regions;
 };
@@ -22,8 +22,17 @@ int __pthread_mutex_init(pthread_mutex_t*, const pthread_mutexattr_t*);
 int __pthread_mutex_lock(pthread_mutex_t*);
 int __pthread_mutex_trylock(pthread_mutex_t*);
 int __pthread_mutex_lock_pessimistic_np(pthread_mutex_t*);
+void __pthread_mutex_wake_requeued_np(pthread_mutex_t*);
 int __pthread_mutex_unlock(pthread_mutex_t*);
 
+// Tells the CPU that we're busy-waiting for another thread to release a lock.
+static inline void __pthread_spin_pause_np(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#endif
+}
+
 typedef void (*KeyDestructor)(void*);
 
 int __pthread_key_create(pthread_key_t*, KeyDestructor);
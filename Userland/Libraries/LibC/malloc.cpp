@@ -48,6 +48,11 @@ static bool s_scrub_malloc = true;
 static bool s_scrub_free = true;
 static bool s_profiling = false;
 static bool s_in_userspace_emulator = false;
+#ifdef NO_TLS
+static bool s_use_thread_caches = false;
+#else
+static bool s_use_thread_caches = true;
+#endif
 
 ALWAYS_INLINE static void ue_notify_malloc(const void* ptr, size_t size)
 {
@@ -98,6 +103,35 @@ struct MallocStats {
 };
 static MallocStats g_malloc_stats = {};
 
+// Each thread keeps a small stash of free chunks for the smaller size classes, so that
+// most malloc() and free() calls don't have to take s_malloc_mutex at all. Chunks move
+// between a thread's cache and the global allocators in batches.
+//
+// A chunk freed by a thread other than the one that allocated it simply ends up in the
+// freeing thread's cache, and flows back to its block once that cache overflows.
+constexpr size_t max_thread_cached_chunk_size = 1016;
+constexpr size_t thread_cache_batch_size = 16;
+constexpr size_t thread_cache_max_chunks_per_size_class = 4 * thread_cache_batch_size;
+
+consteval size_t count_thread_cached_size_classes()
+{
+    size_t count = 0;
+    while (size_classes[count] && size_classes[count] <= max_thread_cached_chunk_size)
+        ++count;
+    return count;
+}
+static constexpr size_t num_thread_cached_size_classes = count_thread_cached_size_classes();
+
+struct ThreadCache {
+    FreelistEntry* chunks[num_thread_cached_size_classes];
+    size_t chunk_counts[num_thread_cached_size_classes];
+};
+#ifdef NO_TLS
+static ThreadCache s_thread_cache;
+#else
+static __thread ThreadCache s_thread_cache;
+#endif
+
 static size_t s_hot_empty_block_count { 0 };
 static ChunkedBlock* s_hot_empty_blocks[number_of_hot_chunked_blocks_to_keep_around] { nullptr };
 static size_t s_cold_empty_block_count { 0 };
@@ -174,60 +208,11 @@ enum class CallerWillInitializeMemory {
     Yes,
 };
 
-static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_initialize_memory)
+// NOTE: The caller must hold s_malloc_mutex.
+static void* allocate_chunk(Allocator& allocator, size_t good_size)
 {
-    if (s_log_malloc)
-        dbgln("LibC: malloc({})", size);
-
-    if (!size) {
-        // Legally we could just return a null pointer here, but this is more
-        // compatible with existing software.
-        size = 1;
-    }
-
-    g_malloc_stats.number_of_malloc_calls++;
-
-    size_t good_size;
-    auto* allocator = allocator_for_size(size, good_size);
-
-    PthreadMutexLocker locker(s_malloc_mutex);
-
-    if (!allocator) {
-        size_t real_size = round_up_to_power_of_two(sizeof(BigAllocationBlock) + size, ChunkedBlock::block_size);
-#ifdef RECYCLE_BIG_ALLOCATIONS
-        if (auto* allocator = big_allocator_for_size(real_size)) {
-            if (!allocator->blocks.is_empty()) {
-                g_malloc_stats.number_of_big_allocator_hits++;
-                auto* block = allocator->blocks.take_last();
-                int rc = madvise(block, real_size, MADV_SET_NONVOLATILE);
-                bool this_block_was_purged = rc == 1;
-                if (rc < 0) {
-                    perror("madvise");
-                    VERIFY_NOT_REACHED();
-                }
-                if (mprotect(block, real_size, PROT_READ | PROT_WRITE) < 0) {
-                    perror("mprotect");
-                    VERIFY_NOT_REACHED();
-                }
-                if (this_block_was_purged) {
-                    g_malloc_stats.number_of_big_allocator_purge_hits++;
-                    new (block) BigAllocationBlock(real_size);
-                }
-
-                ue_notify_malloc(&block->m_slot[0], size);
-                return &block->m_slot[0];
-            }
-        }
-#endif
-        g_malloc_stats.number_of_big_allocs++;
-        auto* block = (BigAllocationBlock*)os_alloc(real_size, "malloc: BigAllocationBlock");
-        new (block) BigAllocationBlock(real_size);
-        ue_notify_malloc(&block->m_slot[0], size);
-        return &block->m_slot[0];
-    }
-
     ChunkedBlock* block = nullptr;
-    for (auto& current : allocator->usable_blocks) {
+    for (auto& current : allocator.usable_blocks) {
         if (current.free_chunks()) {
             block = &current;
             break;
@@ -244,7 +229,7 @@ static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_ini
             snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
             set_mmap_name(block, ChunkedBlock::block_size, buffer);
         }
-        allocator->usable_blocks.append(*block);
+        allocator.usable_blocks.append(*block);
     }
 
     if (!block && s_cold_empty_block_count) {
@@ -267,7 +252,7 @@ static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_ini
             new (block) ChunkedBlock(good_size);
             ue_notify_chunk_size_changed(block, good_size);
         }
-        allocator->usable_blocks.append(*block);
+        allocator.usable_blocks.append(*block);
     }
 
     if (!block) {
@@ -276,8 +261,8 @@ static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_ini
         snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
         block = (ChunkedBlock*)os_alloc(ChunkedBlock::block_size, buffer);
         new (block) ChunkedBlock(good_size);
-        allocator->usable_blocks.append(*block);
-        ++allocator->block_count;
+        allocator.usable_blocks.append(*block);
+        ++allocator.block_count;
     }
 
     --block->m_free_chunks;
@@ -292,9 +277,154 @@ static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_ini
     if (block->is_full()) {
         g_malloc_stats.number_of_blocks_full++;
         dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
+        allocator.usable_blocks.remove(*block);
+        allocator.full_blocks.append(*block);
+    }
+    return ptr;
+}
+
+// NOTE: The caller must hold s_malloc_mutex.
+static void free_chunk(void* ptr)
+{
+    auto* block = (ChunkedBlock*)((FlatPtr)ptr & ChunkedBlock::block_mask);
+
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = block->m_freelist;
+    block->m_freelist = entry;
+
+    if (block->is_full()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block->m_size, good_size);
+        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
+        g_malloc_stats.number_of_freed_full_blocks++;
+        allocator->full_blocks.remove(*block);
+        allocator->usable_blocks.prepend(*block);
+    }
+
+    ++block->m_free_chunks;
+
+    if (!block->used_chunks()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block->m_size, good_size);
+        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
+            g_malloc_stats.number_of_hot_keeps++;
+            allocator->usable_blocks.remove(*block);
+            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
+            return;
+        }
+        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
+            g_malloc_stats.number_of_cold_keeps++;
+            allocator->usable_blocks.remove(*block);
+            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
+            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
+            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
+            return;
+        }
+        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
+        g_malloc_stats.number_of_frees++;
         allocator->usable_blocks.remove(*block);
-        allocator->full_blocks.append(*block);
+        --allocator->block_count;
+        os_free(block, ChunkedBlock::block_size);
+    }
+}
+
+static void* allocate_chunk_from_thread_cache(Allocator& allocator, size_t size_class, size_t good_size)
+{
+    auto& cache = s_thread_cache;
+    if (!cache.chunks[size_class]) {
+        PthreadMutexLocker locker(s_malloc_mutex);
+        for (size_t i = 0; i < thread_cache_batch_size; ++i) {
+            auto* entry = (FreelistEntry*)allocate_chunk(allocator, good_size);
+            entry->next = cache.chunks[size_class];
+            cache.chunks[size_class] = entry;
+        }
+        cache.chunk_counts[size_class] += thread_cache_batch_size;
+    }
+    auto* entry = cache.chunks[size_class];
+    cache.chunks[size_class] = entry->next;
+    --cache.chunk_counts[size_class];
+    return entry;
+}
+
+static void flush_thread_cache(size_t size_class, size_t count)
+{
+    auto& cache = s_thread_cache;
+    PthreadMutexLocker locker(s_malloc_mutex);
+    for (; count && cache.chunks[size_class]; --count) {
+        auto* entry = cache.chunks[size_class];
+        cache.chunks[size_class] = entry->next;
+        --cache.chunk_counts[size_class];
+        free_chunk(entry);
+    }
+}
+
+static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_initialize_memory)
+{
+    if (s_log_malloc)
+        dbgln("LibC: malloc({})", size);
+
+    if (!size) {
+        // Legally we could just return a null pointer here, but this is more
+        // compatible with existing software.
+        size = 1;
+    }
+
+    g_malloc_stats.number_of_malloc_calls++;
+
+    size_t good_size;
+    auto* allocator = allocator_for_size(size, good_size);
+
+    if (allocator && s_use_thread_caches) {
+        size_t size_class = allocator - allocators();
+        if (size_class < num_thread_cached_size_classes) {
+            void* ptr = allocate_chunk_from_thread_cache(*allocator, size_class, good_size);
+            if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
+                memset(ptr, MALLOC_SCRUB_BYTE, good_size);
+            ue_notify_malloc(ptr, size);
+            return ptr;
+        }
     }
+
+    PthreadMutexLocker locker(s_malloc_mutex);
+
+    if (!allocator) {
+        size_t real_size = round_up_to_power_of_two(sizeof(BigAllocationBlock) + size, ChunkedBlock::block_size);
+#ifdef RECYCLE_BIG_ALLOCATIONS
+        if (auto* allocator = big_allocator_for_size(real_size)) {
+            if (!allocator->blocks.is_empty()) {
+                g_malloc_stats.number_of_big_allocator_hits++;
+                auto* block = allocator->blocks.take_last();
+                int rc = madvise(block, real_size, MADV_SET_NONVOLATILE);
+                bool this_block_was_purged = rc == 1;
+                if (rc < 0) {
+                    perror("madvise");
+                    VERIFY_NOT_REACHED();
+                }
+                if (mprotect(block, real_size, PROT_READ | PROT_WRITE) < 0) {
+                    perror("mprotect");
+                    VERIFY_NOT_REACHED();
+                }
+                if (this_block_was_purged) {
+                    g_malloc_stats.number_of_big_allocator_purge_hits++;
+                    new (block) BigAllocationBlock(real_size);
+                }
+
+                ue_notify_malloc(&block->m_slot[0], size);
+                return &block->m_slot[0];
+            }
+        }
+#endif
+        g_malloc_stats.number_of_big_allocs++;
+        auto* block = (BigAllocationBlock*)os_alloc(real_size, "malloc: BigAllocationBlock");
+        new (block) BigAllocationBlock(real_size);
+        ue_notify_malloc(&block->m_slot[0], size);
+        return &block->m_slot[0];
+    }
+
+    void* ptr = allocate_chunk(*allocator, good_size);
+    auto* block = (ChunkedBlock*)((FlatPtr)ptr & ChunkedBlock::block_mask);
     dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
 
     if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
@@ -316,6 +446,23 @@ static void free_impl(void* ptr)
     void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::ChunkedBlock::block_mask);
     size_t magic = *(size_t*)block_base;
 
+    if (magic == MAGIC_PAGE_HEADER && s_use_thread_caches) {
+        auto* block = (ChunkedBlock*)block_base;
+        size_t good_size;
+        size_t size_class = allocator_for_size(block->m_size, good_size) - allocators();
+        if (size_class < num_thread_cached_size_classes) {
+            if (s_scrub_free)
+                memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
+            auto& cache = s_thread_cache;
+            auto* entry = (FreelistEntry*)ptr;
+            entry->next = cache.chunks[size_class];
+            cache.chunks[size_class] = entry;
+            if (++cache.chunk_counts[size_class] > thread_cache_max_chunks_per_size_class)
+                flush_thread_cache(size_class, thread_cache_batch_size);
+            return;
+        }
+    }
+
     PthreadMutexLocker locker(s_malloc_mutex);
 
     if (magic == MAGIC_BIGALLOC_HEADER) {
@@ -351,46 +498,7 @@ static void free_impl(void* ptr)
     if (s_scrub_free)
         memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
 
-    auto* entry = (FreelistEntry*)ptr;
-    entry->next = block->m_freelist;
-    block->m_freelist = entry;
-
-    if (block->is_full()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
-        g_malloc_stats.number_of_freed_full_blocks++;
-        allocator->full_blocks.remove(*block);
-        allocator->usable_blocks.prepend(*block);
-    }
-
-    ++block->m_free_chunks;
-
-    if (!block->used_chunks()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
-            g_malloc_stats.number_of_hot_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
-            return;
-        }
-        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
-            g_malloc_stats.number_of_cold_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
-            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
-            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
-            return;
-        }
-        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
-        g_malloc_stats.number_of_frees++;
-        allocator->usable_blocks.remove(*block);
-        --allocator->block_count;
-        os_free(block, ChunkedBlock::block_size);
-    }
+    free_chunk(ptr);
 }
 
 [[gnu::flatten]] void* malloc(size_t size)
@@ -462,6 +570,14 @@ void* realloc(void* ptr, size_t size)
     return new_ptr;
 }
 
+void __malloc_flush_thread_cache()
+{
+    if (!s_use_thread_caches)
+        return;
+    for (size_t size_class = 0; size_class < num_thread_cached_size_classes; ++size_class)
+        flush_thread_cache(size_class, s_thread_cache.chunk_counts[size_class]);
+}
+
 void __malloc_init()
 {
     s_in_userspace_emulator = (int)syscall(SC_emuctl, 0) != -ENOSYS;
@@ -470,6 +586,8 @@ void __malloc_init()
         // keeps track of heap memory anyway.
         s_scrub_malloc = false;
         s_scrub_free = false;
+        // UE's leak checker needs to see chunks going back to their blocks.
+        s_use_thread_caches = false;
     }
 
     if (secure_getenv("LIBC_NOSCRUB_MALLOC"))
@@ -480,6 +598,8 @@ void __malloc_init()
         s_log_malloc = true;
     if (secure_getenv("LIBC_PROFILE_MALLOC"))
         s_profiling = true;
+    if (secure_getenv("LIBC_NO_MALLOC_THREAD_CACHE"))
+        s_use_thread_caches = false;
 
     for (size_t i = 0; i < num_size_classes; ++i) {
         new (&allocators()[i]) Allocator();
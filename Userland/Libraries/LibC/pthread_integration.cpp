@@ -97,6 +97,10 @@ static constexpr u32 MUTEX_UNLOCKED = 0;
 static constexpr u32 MUTEX_LOCKED_NO_NEED_TO_WAKE = 1;
 static constexpr u32 MUTEX_LOCKED_NEED_TO_WAKE = 2;
 
+// How many times a contended mutex is polled before going to sleep on it. Most critical sections are a lot
+// shorter than the two system calls it takes to sleep and be woken up again.
+static constexpr size_t MUTEX_SPIN_COUNT = 100;
+
 int __pthread_mutex_init(pthread_mutex_t* mutex, const pthread_mutexattr_t* attributes)
 {
     mutex->lock = 0;
@@ -150,6 +154,15 @@ int __pthread_mutex_lock(pthread_mutex_t* mutex)
         }
     }
 
+    // Spin for a little while, in the hope that the owner releases the mutex soon. We only do this as long as
+    // nobody is sleeping on the mutex yet: if others already gave up on spinning, we likely won't do any better.
+    for (size_t i = 0; i < MUTEX_SPIN_COUNT && value == MUTEX_LOCKED_NO_NEED_TO_WAKE; ++i) {
+        __pthread_spin_pause_np();
+        value = AK::atomic_load(&mutex->lock, AK::memory_order_relaxed);
+        if (value == MUTEX_UNLOCKED && AK::atomic_compare_exchange_strong(&mutex->lock, value, MUTEX_LOCKED_NO_NEED_TO_WAKE, AK::memory_order_acquire))
+            goto locked;
+    }
+
     // Slow path: wait, record the fact that we're going to wait, and always
     // remember to wake the next thread up once we release the mutex.
     if (value != MUTEX_LOCKED_NEED_TO_WAKE)
@@ -160,6 +173,7 @@ int __pthread_mutex_lock(pthread_mutex_t* mutex)
         value = AK::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_acquire);
     }
 
+locked:
     if (mutex->type == __PTHREAD_MUTEX_RECURSIVE)
         AK::atomic_store(&mutex->owner, __pthread_self(), AK::memory_order_relaxed);
     mutex->level = 0;
@@ -185,6 +199,25 @@ int __pthread_mutex_lock_pessimistic_np(pthread_mutex_t* mutex)
     return 0;
 }
 
+void __pthread_mutex_wake_requeued_np(pthread_mutex_t* mutex)
+{
+    // Someone has just been moved from a condition variable's wait queue onto
+    // the mutex's. Make sure they get woken up: either by whoever holds the
+    // mutex, once they release it, or right away if it's not held at all.
+    u32 value = AK::atomic_load(&mutex->lock, AK::memory_order_relaxed);
+    while (true) {
+        if (value == MUTEX_LOCKED_NEED_TO_WAKE)
+            return;
+        if (value == MUTEX_UNLOCKED) {
+            int rc = futex_wake(&mutex->lock, 1);
+            VERIFY(rc >= 0);
+            return;
+        }
+        if (AK::atomic_compare_exchange_strong(&mutex->lock, value, MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_relaxed))
+            return;
+    }
+}
+
 int __pthread_mutex_unlock(pthread_mutex_t* mutex)
 {
     if (mutex->type == __PTHREAD_MUTEX_RECURSIVE && mutex->level > 0) {
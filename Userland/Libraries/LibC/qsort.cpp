@@ -34,7 +34,16 @@ inline void swap(const SizedObject& a, const SizedObject& b)
     const size_t size = a.size();
     const auto a_data = reinterpret_cast<char*>(a.data());
     const auto b_data = reinterpret_cast<char*>(b.data());
-    for (auto i = 0u; i < size; ++i) {
+    size_t i = 0;
+    for (; i + sizeof(u64) <= size; i += sizeof(u64)) {
+        u64 a_word;
+        u64 b_word;
+        __builtin_memcpy(&a_word, a_data + i, sizeof(u64));
+        __builtin_memcpy(&b_word, b_data + i, sizeof(u64));
+        __builtin_memcpy(a_data + i, &b_word, sizeof(u64));
+        __builtin_memcpy(b_data + i, &a_word, sizeof(u64));
+    }
+    for (; i < size; ++i) {
         swap(a_data[i], b_data[i]);
     }
 }
@@ -67,7 +76,7 @@ void qsort(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, cons
 
     SizedObjectSlice slice { bot, size };
 
-    AK::dual_pivot_quick_sort(slice, 0, nmemb - 1, [=](const SizedObject& a, const SizedObject& b) { return compar(a.data(), b.data()) < 0; });
+    AK::pattern_defeating_quick_sort(slice, 0, nmemb, [=](const SizedObject& a, const SizedObject& b) { return compar(a.data(), b.data()) < 0; });
 }
 
 void qsort_r(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*, void*), void* arg)
@@ -78,5 +87,5 @@ void qsort_r(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, co
 
     SizedObjectSlice slice { bot, size };
 
-    AK::dual_pivot_quick_sort(slice, 0, nmemb - 1, [=](const SizedObject& a, const SizedObject& b) { return compar(a.data(), b.data(), arg) < 0; });
+    AK::pattern_defeating_quick_sort(slice, 0, nmemb, [=](const SizedObject& a, const SizedObject& b) { return compar(a.data(), b.data(), arg) < 0; });
 }
@@ -92,6 +92,12 @@ static ALWAYS_INLINE int futex_wake(uint32_t* userspace_address, uint32_t count)
     return futex(userspace_address, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, count, NULL, NULL, 0);
 }
 
+static ALWAYS_INLINE int futex_requeue(uint32_t* userspace_address, uint32_t wake_count, uint32_t* target_address, uint32_t requeue_count)
+{
+    // NOTE: FUTEX_REQUEUE takes the number of waiters to requeue in place of the timeout.
+    return futex(userspace_address, FUTEX_REQUEUE | FUTEX_PRIVATE_FLAG, wake_count, (const struct timespec*)(uintptr_t)requeue_count, target_address, 0);
+}
+
 #define PURGE_ALL_VOLATILE 0x1
 #define PURGE_ALL_CLEAN_INODE 0x2
 
@@ -12,11 +12,259 @@
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
+#include <limits.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if ARCH(I386) || ARCH(X86_64)
+#    include <cpuid.h>
+#    include <emmintrin.h>
+#    define HAVE_SSE2_STRING_FUNCTIONS
+#endif
+
+// Copies of at least this many bytes go through `rep movsb`/`rep stos`, which modern CPUs
+// implement with wide internal stores and which don't pollute the vector registers.
+static constexpr size_t large_copy_threshold = 2048;
+
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+
+// SSE2 is part of the x86_64 baseline, so only i686 has to ask the CPU.
+// NOTE: AVX2 variants are intentionally missing: the kernel only saves the legacy FPU/SSE
+//       state (with fxsave) on context switches, so the upper halves of the YMM registers
+//       would be clobbered by other threads.
+static bool has_sse2()
+{
+#    ifdef __SSE2__
+    return true;
+#    else
+    enum class State : u8 {
+        Unknown,
+        Unsupported,
+        Supported,
+    };
+    static State s_state = State::Unknown;
+    if (s_state == State::Unknown) {
+        unsigned eax, ebx, ecx, edx;
+        bool supported = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (edx & bit_SSE2);
+        s_state = supported ? State::Supported : State::Unsupported;
+    }
+    return s_state == State::Supported;
+#    endif
+}
+
+#    define SSE2_FUNCTION __attribute__((target("sse2")))
+
+// The string scanning functions below only ever do aligned 16-byte loads. An aligned load
+// can't cross a page boundary, so it can't fault even if it reads past the end of the string.
+SSE2_FUNCTION static __m128i load_aligned(const u8* ptr)
+{
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+
+SSE2_FUNCTION static __m128i load_unaligned(const void* ptr)
+{
+    return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+}
+
+SSE2_FUNCTION static void store_unaligned(void* ptr, __m128i value)
+{
+    _mm_storeu_si128(static_cast<__m128i*>(ptr), value);
+}
+
+SSE2_FUNCTION static u32 matching_bytes(__m128i chunk, __m128i needle)
+{
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+}
+
+// Returns the index of the first byte equal to `needle`, or `size` if there is none.
+SSE2_FUNCTION static size_t find_byte_sse2(const u8* bytes, u8 needle, size_t size)
+{
+    if (size == 0)
+        return 0;
+    auto misalignment = reinterpret_cast<FlatPtr>(bytes) & 15;
+    auto* chunk = bytes - misalignment;
+    auto needles = _mm_set1_epi8(static_cast<char>(needle));
+
+    // Discard matches in front of the buffer.
+    u32 mask = matching_bytes(load_aligned(chunk), needles) >> misalignment;
+    size_t scanned = 0;
+    for (;;) {
+        if (mask) {
+            size_t index = scanned + __builtin_ctz(mask);
+            return index < size ? index : size;
+        }
+        scanned += scanned == 0 ? 16 - misalignment : 16;
+        if (scanned >= size)
+            return size;
+        chunk += 16;
+        mask = matching_bytes(load_aligned(chunk), needles);
+    }
+}
+
+SSE2_FUNCTION static size_t strlen_sse2(const char* str)
+{
+    auto* bytes = reinterpret_cast<const u8*>(str);
+    auto misalignment = reinterpret_cast<FlatPtr>(bytes) & 15;
+    auto* chunk = bytes - misalignment;
+    auto zeroes = _mm_setzero_si128();
+
+    u32 mask = matching_bytes(load_aligned(chunk), zeroes) >> misalignment;
+    if (mask)
+        return __builtin_ctz(mask);
+    for (;;) {
+        chunk += 16;
+        mask = matching_bytes(load_aligned(chunk), zeroes);
+        if (mask)
+            return chunk + __builtin_ctz(mask) - bytes;
+    }
+}
+
+SSE2_FUNCTION static char* strchr_sse2(const char* str, char ch)
+{
+    auto* bytes = reinterpret_cast<const u8*>(str);
+    auto misalignment = reinterpret_cast<FlatPtr>(bytes) & 15;
+    auto* chunk = bytes - misalignment;
+    auto zeroes = _mm_setzero_si128();
+    auto needles = _mm_set1_epi8(ch);
+
+    auto first_chunk = load_aligned(chunk);
+    u32 mask = (matching_bytes(first_chunk, needles) | matching_bytes(first_chunk, zeroes)) >> misalignment;
+    auto* match = bytes;
+    while (!mask) {
+        chunk += 16;
+        auto value = load_aligned(chunk);
+        mask = matching_bytes(value, needles) | matching_bytes(value, zeroes);
+        match = chunk;
+    }
+    match += __builtin_ctz(mask);
+    if (*match != static_cast<u8>(ch))
+        return nullptr;
+    return const_cast<char*>(reinterpret_cast<const char*>(match));
+}
+
+SSE2_FUNCTION static int memcmp_sse2(const u8* s1, const u8* s2, size_t n)
+{
+    for (; n >= 16; s1 += 16, s2 += 16, n -= 16) {
+        u32 mask = matching_bytes(load_unaligned(s1), load_unaligned(s2));
+        if (mask != 0xffff) {
+            auto index = __builtin_ctz(~mask);
+            return s1[index] < s2[index] ? -1 : 1;
+        }
+    }
+    for (; n; ++s1, ++s2, --n) {
+        if (*s1 != *s2)
+            return *s1 < *s2 ? -1 : 1;
+    }
+    return 0;
+}
+
+static bool is_safe_to_load_16_bytes(const u8* ptr)
+{
+    return (reinterpret_cast<FlatPtr>(ptr) & (PAGE_SIZE - 1)) <= static_cast<FlatPtr>(PAGE_SIZE - 16);
+}
+
+SSE2_FUNCTION static int strcmp_sse2(const u8* s1, const u8* s2)
+{
+    auto zeroes = _mm_setzero_si128();
+    for (;;) {
+        // The two strings are generally not aligned the same way, so use unaligned loads as
+        // long as neither of them can run into the next (possibly unmapped) page.
+        if (is_safe_to_load_16_bytes(s1) && is_safe_to_load_16_bytes(s2)) {
+            auto chunk1 = load_unaligned(s1);
+            u32 mask = ~matching_bytes(chunk1, load_unaligned(s2)) | matching_bytes(chunk1, zeroes);
+            mask &= 0xffff;
+            if (mask) {
+                auto index = __builtin_ctz(mask);
+                return s1[index] - s2[index];
+            }
+            s1 += 16;
+            s2 += 16;
+            continue;
+        }
+        if (*s1 != *s2 || *s1 == 0)
+            return *s1 - *s2;
+        ++s1;
+        ++s2;
+    }
+}
+
+// Loads everything before storing anything for sizes up to 32 bytes, and otherwise copies
+// forwards, so this is also safe to use for overlapping buffers as long as dest < src.
+SSE2_FUNCTION static void copy_forwards_sse2(u8* dest, const u8* src, size_t n)
+{
+    VERIFY(n >= 16);
+    auto head = load_unaligned(src);
+    auto tail = load_unaligned(src + n - 16);
+    for (size_t offset = 16; offset + 16 < n; offset += 16)
+        store_unaligned(dest + offset, load_unaligned(src + offset));
+    store_unaligned(dest, head);
+    store_unaligned(dest + n - 16, tail);
+}
+
+// The mirror image of copy_forwards_sse2(), safe for overlapping buffers with dest > src.
+SSE2_FUNCTION static void copy_backwards_sse2(u8* dest, const u8* src, size_t n)
+{
+    VERIFY(n >= 16);
+    auto head = load_unaligned(src);
+    auto tail = load_unaligned(src + n - 16);
+    for (size_t offset = n - 16; offset > 16;) {
+        offset -= 16;
+        store_unaligned(dest + offset, load_unaligned(src + offset));
+    }
+    store_unaligned(dest + n - 16, tail);
+    store_unaligned(dest, head);
+}
+
+SSE2_FUNCTION static void fill_sse2(u8* dest, u8 c, size_t n)
+{
+    VERIFY(n >= 16);
+    auto value = _mm_set1_epi8(static_cast<char>(c));
+    store_unaligned(dest, value);
+    store_unaligned(dest + n - 16, value);
+    // Everything in between is filled with aligned stores.
+    auto* end = dest + n - 16;
+    for (auto* chunk = reinterpret_cast<u8*>(reinterpret_cast<FlatPtr>(dest + 16) & ~15); chunk < end; chunk += 16)
+        _mm_store_si128(reinterpret_cast<__m128i*>(chunk), value);
+}
+
+#endif
+
+// Copies up to 16 bytes without any loops or branches on the exact size. All loads happen
+// before any stores, which makes this safe for overlapping buffers too.
+static void copy_small(u8* dest, const u8* src, size_t n)
+{
+    if (n >= 8) {
+        u64 head, tail;
+        __builtin_memcpy(&head, src, 8);
+        __builtin_memcpy(&tail, src + n - 8, 8);
+        __builtin_memcpy(dest, &head, 8);
+        __builtin_memcpy(dest + n - 8, &tail, 8);
+    } else if (n >= 4) {
+        u32 head, tail;
+        __builtin_memcpy(&head, src, 4);
+        __builtin_memcpy(&tail, src + n - 4, 4);
+        __builtin_memcpy(dest, &head, 4);
+        __builtin_memcpy(dest + n - 4, &tail, 4);
+    } else if (n > 0) {
+        // Covers 1, 2 and 3 bytes: first, middle and last byte.
+        u8 first = src[0];
+        u8 middle = src[n / 2];
+        u8 last = src[n - 1];
+        dest[0] = first;
+        dest[n / 2] = middle;
+        dest[n - 1] = last;
+    }
+}
+
+static void copy_forwards_rep_movsb(void* dest, const void* src, size_t n)
+{
+    asm volatile(
+        "rep movsb"
+        : "+D"(dest), "+S"(src), "+c"(n)::"memory");
+}
+
 extern "C" {
 
 size_t strspn(const char* s, const char* accept)
@@ -47,6 +295,10 @@ size_t strcspn(const char* s, const char* reject)
 
 size_t strlen(const char* str)
 {
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (has_sse2())
+        return strlen_sse2(str);
+#endif
     size_t len = 0;
     while (*(str++))
         ++len;
@@ -55,6 +307,10 @@ size_t strlen(const char* str)
 
 size_t strnlen(const char* str, size_t maxlen)
 {
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (has_sse2())
+        return find_byte_sse2(reinterpret_cast<const u8*>(str), 0, maxlen);
+#endif
     size_t len = 0;
     for (; len < maxlen && *str; str++)
         len++;
@@ -81,6 +337,10 @@ char* strndup(const char* str, size_t maxlen)
 
 int strcmp(const char* s1, const char* s2)
 {
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (has_sse2())
+        return strcmp_sse2(reinterpret_cast<const u8*>(s1), reinterpret_cast<const u8*>(s2));
+#endif
     while (*s1 == *s2++)
         if (*s1++ == 0)
             return 0;
@@ -104,6 +364,10 @@ int memcmp(const void* v1, const void* v2, size_t n)
 {
     auto* s1 = (const uint8_t*)v1;
     auto* s2 = (const uint8_t*)v2;
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (has_sse2())
+        return memcmp_sse2(s1, s2, n);
+#endif
     while (n-- > 0) {
         if (*s1++ != *s2++)
             return s1[-1] < s2[-1] ? -1 : 1;
@@ -113,18 +377,41 @@ int memcmp(const void* v1, const void* v2, size_t n)
 
 void* memcpy(void* dest_ptr, const void* src_ptr, size_t n)
 {
-    void* original_dest = dest_ptr;
-    asm volatile(
-        "rep movsb"
-        : "+D"(dest_ptr), "+S"(src_ptr), "+c"(n)::"memory");
-    return original_dest;
+    auto* dest = static_cast<u8*>(dest_ptr);
+    auto* src = static_cast<const u8*>(src_ptr);
+    if (n <= 16) {
+        copy_small(dest, src, n);
+        return dest_ptr;
+    }
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (n < large_copy_threshold && has_sse2()) {
+        copy_forwards_sse2(dest, src, n);
+        return dest_ptr;
+    }
+#endif
+    copy_forwards_rep_movsb(dest_ptr, src_ptr, n);
+    return dest_ptr;
 }
 
 void* memset(void* dest_ptr, int c, size_t n)
 {
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (n >= 16 && n < large_copy_threshold && has_sse2()) {
+        fill_sse2(static_cast<u8*>(dest_ptr), c, n);
+        return dest_ptr;
+    }
+#endif
     size_t dest = (size_t)dest_ptr;
-    // FIXME: Support starting at an unaligned address.
-    if (!(dest & 0x3) && n >= 12) {
+    if (n >= 2 * sizeof(size_t)) {
+        // Fill up to the next word boundary byte by byte, then do the rest a word at a time.
+        size_t head = -dest & (sizeof(size_t) - 1);
+        n -= head;
+        asm volatile(
+            "rep stosb\n"
+            : "+D"(dest), "+c"(head)
+            : "a"(c)
+            : "memory");
+
         size_t size_ts = n / sizeof(size_t);
         size_t expanded_c = explode_byte((u8)c);
 #if ARCH(I386)
@@ -154,9 +441,22 @@ void* memset(void* dest_ptr, int c, size_t n)
 
 void* memmove(void* dest, const void* src, size_t n)
 {
-    if (dest < src)
+    if (n <= 16) {
+        copy_small(static_cast<u8*>(dest), static_cast<const u8*>(src), n);
+        return dest;
+    }
+
+    // Copying forwards is fine as long as we never write over source bytes we haven't read yet.
+    if (dest < src || static_cast<const u8*>(src) + n <= dest)
         return memcpy(dest, src, n);
 
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (has_sse2()) {
+        copy_backwards_sse2(static_cast<u8*>(dest), static_cast<const u8*>(src), n);
+        return dest;
+    }
+#endif
+
     u8* pd = (u8*)dest;
     const u8* ps = (const u8*)src;
     for (pd += n, ps += n; n--;)
@@ -203,6 +503,10 @@ size_t strlcpy(char* dest, const char* src, size_t n)
 char* strchr(const char* str, int c)
 {
     char ch = c;
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (has_sse2())
+        return strchr_sse2(str, ch);
+#endif
     for (;; ++str) {
         if (*str == ch)
             return const_cast<char*>(str);
@@ -224,6 +528,12 @@ void* memchr(const void* ptr, int c, size_t size)
 {
     char ch = c;
     auto* cptr = (const char*)ptr;
+#ifdef HAVE_SSE2_STRING_FUNCTIONS
+    if (has_sse2()) {
+        auto index = find_byte_sse2((const u8*)ptr, ch, size);
+        return index < size ? const_cast<char*>(cptr + index) : nullptr;
+    }
+#endif
     for (size_t i = 0; i < size; ++i) {
         if (cptr[i] == ch)
             return const_cast<char*>(cptr + i);
@@ -14,6 +14,7 @@ typedef void (*AtExitFunction)(void*);
 
 extern void __libc_init();
 extern void __malloc_init();
+extern void __malloc_flush_thread_cache();
 extern void __stdio_init();
 extern void _init();
 extern bool __environ_is_malloced;
@@ -241,6 +241,7 @@ void DynamicLoader::do_lazy_relocations()
             VERIFY_NOT_REACHED();
         }
     }
+    m_resolved_symbols.clear();
 }
 
 void DynamicLoader::load_program_headers()
@@ -412,7 +413,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
     case R_X86_64_64: {
 #endif
         auto symbol = relocation.symbol();
-        auto res = lookup_symbol(symbol);
+        auto res = lookup_symbol_for_relocation(relocation);
         if (!res.has_value()) {
             if (symbol.bind() == STB_WEAK)
                 return RelocationResult::ResolveLater;
@@ -428,8 +429,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
     }
 #ifndef __LP64__
     case R_386_PC32: {
-        auto symbol = relocation.symbol();
-        auto result = lookup_symbol(symbol);
+        auto result = lookup_symbol_for_relocation(relocation);
         if (!result.has_value())
             return RelocationResult::Failed;
         auto relative_offset = result.value().address - m_dynamic_object->base_address().offset(relocation.offset());
@@ -441,7 +441,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
     case R_X86_64_GLOB_DAT: {
 #endif
         auto symbol = relocation.symbol();
-        auto res = lookup_symbol(symbol);
+        auto res = lookup_symbol_for_relocation(relocation);
         VirtualAddress symbol_location;
         if (!res.has_value()) {
             if (symbol.bind() == STB_WEAK) {
@@ -479,11 +479,10 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
 #else
     case R_X86_64_TPOFF64: {
 #endif
-        auto symbol = relocation.symbol();
         FlatPtr symbol_value;
         DynamicObject const* dynamic_object_of_symbol;
         if (relocation.symbol_index() != 0) {
-            auto res = lookup_symbol(symbol);
+            auto res = lookup_symbol_for_relocation(relocation);
             if (!res.has_value())
                 break;
             symbol_value = res.value().value;
@@ -608,6 +607,21 @@ void DynamicLoader::call_object_init_functions()
     }
 }
 
+Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol_for_relocation(const DynamicObject::Relocation& relocation)
+{
+    // Many relocations refer to the same symbol (vtables, GOT entries, data pointers), and looking up
+    // an undefined symbol means probing the hash table of every global object in turn.
+    auto symbol_index = relocation.symbol_index();
+    if (auto it = m_resolved_symbols.find(symbol_index); it != m_resolved_symbols.end())
+        return it->value;
+
+    auto result = lookup_symbol(relocation.symbol());
+    // Failed lookups are not cached, since weak symbols get another chance in do_lazy_relocations().
+    if (result.has_value())
+        m_resolved_symbols.set(symbol_index, result.value());
+    return result;
+}
+
 Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol(const ELF::DynamicObject::Symbol& symbol)
 {
     if (symbol.is_undefined() || symbol.bind() == STB_WEAK)
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Assertions.h>
+#include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/String.h>
@@ -130,6 +131,7 @@ private:
         ResolveLater = 2,
     };
     RelocationResult do_relocation(const DynamicObject::Relocation&, ShouldInitializeWeak should_initialize_weak);
+    Optional<DynamicObject::SymbolLookupResult> lookup_symbol_for_relocation(const DynamicObject::Relocation&);
     size_t calculate_tls_size() const;
     ssize_t negative_offset_from_tls_block_end(ssize_t tls_offset, size_t value_of_symbol) const;
 
@@ -156,6 +158,9 @@ private:
 
     Vector<DynamicObject::Relocation> m_unresolved_relocations;
 
+    // Symbols resolved while relocating this object, keyed by symbol index. Only used while linking.
+    HashMap<unsigned, DynamicObject::SymbolLookupResult> m_resolved_symbols;
+
     mutable RefPtr<DynamicObject> m_cached_dynamic_object;
 };
 
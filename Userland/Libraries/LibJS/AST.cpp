@@ -13,7 +13,10 @@
 #include <AK/TemporaryChange.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Serialization.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -93,6 +96,63 @@ Value Program::execute(Interpreter& interpreter, GlobalObject& global_object) co
     return interpreter.execute_statement(global_object, *this, ScopeType::Block);
 }
 
+PrecompiledFunctionBody::PrecompiledFunctionBody(SourceRange source_range, ByteBuffer serialized_executable)
+    : ScopeNode(source_range)
+    , m_serialized_executable(move(serialized_executable))
+{
+}
+
+PrecompiledFunctionBody::~PrecompiledFunctionBody()
+{
+}
+
+Value PrecompiledFunctionBody::execute(Interpreter&, GlobalObject&) const
+{
+    // NOTE: These only come out of the bytecode cache, which is only used when running bytecode.
+    VERIFY_NOT_REACHED();
+}
+
+Bytecode::Executable const* PrecompiledFunctionBody::executable() const
+{
+    if (m_executable)
+        return m_executable.ptr();
+    auto executable = Bytecode::deserialize_executable(m_serialized_executable);
+    if (!executable.has_value())
+        return nullptr;
+    m_executable = make<Bytecode::Executable>(executable.release_value());
+    m_serialized_executable.clear();
+    return m_executable.ptr();
+}
+
+Value LazyFunctionBody::execute(Interpreter&, GlobalObject&) const
+{
+    // NOTE: Functions ask for their parsed_body() before running it.
+    VERIFY_NOT_REACHED();
+}
+
+Statement const& LazyFunctionBody::parsed_body() const
+{
+    if (!m_parsed_body) {
+        auto body_or_error = Parser::parse_lazy_function_body(m_context);
+        if (body_or_error.is_error()) {
+            m_parse_error = body_or_error.error().to_string();
+            m_parsed_body = create_ast_node<BlockStatement>(source_range());
+        } else {
+            auto body = body_or_error.release_value();
+            body->set_local_variable_analysis(m_local_variable_analysis.release_nonnull());
+            m_parsed_body = move(body);
+        }
+    }
+    return *m_parsed_body;
+}
+
+Statement const& FunctionNode::parsed_body() const
+{
+    if (is<LazyFunctionBody>(*m_body))
+        return static_cast<LazyFunctionBody const&>(*m_body).parsed_body();
+    return *m_body;
+}
+
 Value FunctionDeclaration::execute(Interpreter& interpreter, GlobalObject&) const
 {
     InterpreterNodeScope node_scope { interpreter, *this };
@@ -1329,6 +1389,11 @@ void FunctionNode::dump(int indent, String const& class_name) const
     body().dump(indent + 2);
 }
 
+void LazyFunctionBody::dump(int indent) const
+{
+    parsed_body().dump(indent);
+}
+
 void FunctionDeclaration::dump(int indent) const
 {
     FunctionNode::dump(indent, class_name());
@@ -2078,19 +2143,19 @@ Value TemplateLiteral::execute(Interpreter& interpreter, GlobalObject& global_ob
 {
     InterpreterNodeScope node_scope { interpreter, *this };
 
-    StringBuilder string_builder;
+    PrimitiveString* result = &interpreter.vm().empty_string();
 
     for (auto& expression : m_expressions) {
         auto expr = expression.execute(interpreter, global_object);
         if (interpreter.exception())
             return {};
-        auto string = expr.to_string(global_object);
+        auto* string = expr.to_primitive_string(global_object);
         if (interpreter.exception())
             return {};
-        string_builder.append(string);
+        result = js_rope_string(interpreter.vm(), *result, *string);
     }
 
-    return js_string(interpreter.heap(), string_builder.build());
+    return result;
 }
 
 void TaggedTemplateLiteral::dump(int indent) const
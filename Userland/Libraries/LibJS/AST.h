@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
@@ -60,6 +61,8 @@ public:
     virtual bool is_identifier() const { return false; }
     virtual bool is_scope_node() const { return false; }
     virtual bool is_program() const { return false; }
+    virtual bool is_precompiled_function_body() const { return false; }
+    virtual bool is_lazy_function_body() const { return false; }
 
 protected:
     explicit ASTNode(SourceRange source_range)
@@ -150,6 +153,20 @@ public:
     NonnullRefPtrVector<FunctionDeclaration> const& functions() const { return m_functions; }
     NonnullRefPtrVector<FunctionDeclaration> const& hoisted_functions() const { return m_hoisted_functions; }
 
+    // Filled in by the parser for the outermost scope of functions and scripts. The bytecode generator uses this to keep
+    // variables that nothing else can reach in registers, rather than looking them up by name in an environment.
+    struct LocalVariableAnalysis {
+        // Names that are referenced from nested functions, or bound in a way that only works with environments.
+        HashTable<FlyString> captured_names;
+        // Set if there is a direct call to eval() or a with statement, which can reach any variable by name.
+        bool has_dynamic_variable_access { false };
+        // The arguments object of non-strict functions is tied to the parameter bindings.
+        bool references_arguments { false };
+    };
+    void set_local_variable_analysis(NonnullOwnPtr<LocalVariableAnalysis> analysis) { m_local_variable_analysis = move(analysis); }
+    LocalVariableAnalysis const* local_variable_analysis() const { return m_local_variable_analysis.ptr(); }
+    OwnPtr<LocalVariableAnalysis> take_local_variable_analysis() { return move(m_local_variable_analysis); }
+
 protected:
     explicit ScopeNode(SourceRange source_range)
         : Statement(source_range)
@@ -163,6 +180,7 @@ private:
     NonnullRefPtrVector<VariableDeclaration> m_variables;
     NonnullRefPtrVector<FunctionDeclaration> m_functions;
     NonnullRefPtrVector<FunctionDeclaration> m_hoisted_functions;
+    OwnPtr<LocalVariableAnalysis> m_local_variable_analysis;
 };
 
 class Program final : public ScopeNode {
@@ -191,6 +209,87 @@ public:
     }
 };
 
+// The body of a function that was loaded from the bytecode cache. The statements only exist as bytecode, but the
+// variable declarations are kept, as they are needed to set up the function environment.
+class PrecompiledFunctionBody final : public ScopeNode {
+public:
+    PrecompiledFunctionBody(SourceRange, ByteBuffer serialized_executable);
+    virtual ~PrecompiledFunctionBody() override;
+
+    virtual Value execute(Interpreter&, GlobalObject&) const override;
+
+    // The bytecode is only deserialized when the function is first called, as most functions in a script never are.
+    // Returns nullptr if the serialized executable is malformed.
+    Bytecode::Executable const* executable() const;
+
+private:
+    virtual bool is_precompiled_function_body() const override { return true; }
+
+    mutable ByteBuffer m_serialized_executable;
+    mutable OwnPtr<Bytecode::Executable> m_executable;
+};
+
+// The body of a function that the parser has only checked the syntax of. Most functions in large scripts are never
+// called, so their AST isn't kept around. The body is parsed again when it's first needed, which is why this remembers
+// where it starts and what state the parser was in at that point.
+class LazyFunctionBody final : public Statement {
+public:
+    // What the parser found out about the body of a function when it checked it, which is all it needs to skip over
+    // the body when the function around it is parsed again.
+    struct CheckedBody {
+        bool is_strict { false };
+        bool has_dynamic_variable_access { false };
+        HashTable<FlyString> referenced_names;
+        HashTable<FlyString> captured_names;
+    };
+
+    // Keyed by the offset of the body in the source. The parser is in the same state whenever it reaches an offset.
+    struct CheckedBodies : public RefCounted<CheckedBodies> {
+        HashMap<size_t, CheckedBody> bodies;
+    };
+
+    struct ParseContext {
+        // Shared by all the lazy bodies of a script, so they don't depend on the caller keeping the source around.
+        String source;
+        String filename;
+        RefPtr<CheckedBodies> checked_bodies;
+        size_t offset { 0 };
+        size_t line { 0 };
+        size_t column { 0 };
+        bool strict_mode { false };
+        bool allow_super_property_lookup { false };
+        bool allow_super_constructor_call { false };
+        bool in_function_context { false };
+        bool in_generator_function_context { false };
+        bool in_arrow_function_context { false };
+        bool in_break_context { false };
+        bool in_continue_context { false };
+    };
+
+    // The analysis is the one of the whole function, which also covers what its parameters refer to.
+    LazyFunctionBody(SourceRange source_range, ParseContext context, NonnullOwnPtr<ScopeNode::LocalVariableAnalysis> local_variable_analysis)
+        : Statement(source_range)
+        , m_context(move(context))
+        , m_local_variable_analysis(move(local_variable_analysis))
+    {
+    }
+
+    virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void dump(int indent) const override;
+
+    // If the body doesn't parse after all, this is an empty block and the error is kept for when the function is called.
+    Statement const& parsed_body() const;
+    String const& parse_error() const { return m_parse_error; }
+
+private:
+    virtual bool is_lazy_function_body() const override { return true; }
+
+    ParseContext m_context;
+    mutable OwnPtr<ScopeNode::LocalVariableAnalysis> m_local_variable_analysis;
+    mutable RefPtr<Statement> m_parsed_body;
+    mutable String m_parse_error;
+};
+
 class Expression : public ASTNode {
 public:
     explicit Expression(SourceRange source_range)
@@ -253,6 +352,8 @@ public:
 
     FlyString const& name() const { return m_name; }
     Statement const& body() const { return *m_body; }
+    // Same as body(), but parses the body first if the parser deferred that (see LazyFunctionBody).
+    Statement const& parsed_body() const;
     Vector<Parameter> const& parameters() const { return m_parameters; };
     i32 function_length() const { return m_function_length; }
     bool is_strict_mode() const { return m_is_strict_mode; }
@@ -1484,4 +1585,10 @@ inline bool ASTNode::fast_is<ScopeNode>() const { return is_scope_node(); }
 template<>
 inline bool ASTNode::fast_is<Program>() const { return is_program(); }
 
+template<>
+inline bool ASTNode::fast_is<PrecompiledFunctionBody>() const { return is_precompiled_function_body(); }
+
+template<>
+inline bool ASTNode::fast_is<LazyFunctionBody>() const { return is_lazy_function_body(); }
+
 }
@@ -18,47 +18,56 @@
 
 namespace JS {
 
-void ASTNode::generate_bytecode(Bytecode::Generator&) const
+void ASTNode::generate_bytecode(Bytecode::Generator& generator) const
 {
-    dbgln("Missing generate_bytecode() in {}", class_name());
-    TODO();
+    generator.unsupported_construct(class_name());
 }
 
 void ScopeNode::generate_bytecode(Bytecode::Generator& generator) const
 {
+    generator.begin_variable_scope();
+
     for (auto& function : functions()) {
         generator.emit<Bytecode::Op::NewFunction>(function);
-        generator.emit<Bytecode::Op::SetVariable>(generator.intern_string(function.name()));
+        generator.emit_store_variable(function.name());
     }
 
     HashMap<u32, Variable> scope_variables_with_declaration_kind;
 
     bool is_program_node = is<Program>(*this);
+    auto declare_variable = [&](FlyString const& name, DeclarationKind declaration_kind) {
+        if (is_program_node && declaration_kind == DeclarationKind::Var) {
+            generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
+            generator.emit<Bytecode::Op::PutById>(Bytecode::Register::global_object(), generator.intern_string(name));
+            return;
+        }
+        // The top-level lexical declarations of a script are shared with other scripts, so they stay in the environment.
+        if (!is_program_node && generator.can_keep_variable_in_register(name)) {
+            // A var with the same name as a parameter keeps the parameter's value.
+            if (declaration_kind == DeclarationKind::Var && generator.register_for_variable(name).has_value())
+                return;
+            auto variable_register = generator.declare_variable_in_register(name);
+            generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
+            generator.emit<Bytecode::Op::Store>(variable_register);
+            return;
+        }
+        // The function environment already has bindings for the top-level declarations of the function.
+        if (generator.is_function_body(*this))
+            return;
+        scope_variables_with_declaration_kind.set((size_t)generator.intern_string(name).value(), { js_undefined(), declaration_kind });
+    };
+
     for (auto& declaration : variables()) {
         for (auto& declarator : declaration.declarations()) {
-            if (is_program_node && declaration.declaration_kind() == DeclarationKind::Var) {
-                declarator.target().visit(
-                    [&](const NonnullRefPtr<Identifier>& id) {
-                        generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
-                        generator.emit<Bytecode::Op::PutById>(Bytecode::Register::global_object(), generator.intern_string(id->string()));
-                    },
-                    [&](const NonnullRefPtr<BindingPattern>& binding) {
-                        binding->for_each_bound_name([&](const auto& name) {
-                            generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
-                            generator.emit<Bytecode::Op::PutById>(Bytecode::Register::global_object(), generator.intern_string(name));
-                        });
-                    });
-            } else {
-                declarator.target().visit(
-                    [&](const NonnullRefPtr<Identifier>& id) {
-                        scope_variables_with_declaration_kind.set((size_t)generator.intern_string(id->string()).value(), { js_undefined(), declaration.declaration_kind() });
-                    },
-                    [&](const NonnullRefPtr<BindingPattern>& binding) {
-                        binding->for_each_bound_name([&](const auto& name) {
-                            scope_variables_with_declaration_kind.set((size_t)generator.intern_string(name).value(), { js_undefined(), declaration.declaration_kind() });
-                        });
+            declarator.target().visit(
+                [&](const NonnullRefPtr<Identifier>& id) {
+                    declare_variable(id->string(), declaration.declaration_kind());
+                },
+                [&](const NonnullRefPtr<BindingPattern>& binding) {
+                    binding->for_each_bound_name([&](const auto& name) {
+                        declare_variable(name, declaration.declaration_kind());
                     });
-            }
+                });
         }
     }
 
@@ -71,6 +80,8 @@ void ScopeNode::generate_bytecode(Bytecode::Generator& generator) const
         if (generator.is_current_block_terminated())
             break;
     }
+
+    generator.end_variable_scope();
 }
 
 void EmptyStatement::generate_bytecode(Bytecode::Generator&) const
@@ -229,7 +240,7 @@ void UnaryExpression::generate_bytecode(Bytecode::Generator& generator) const
         generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
         break;
     default:
-        TODO();
+        generator.unsupported_construct(class_name());
     }
 }
 
@@ -267,7 +278,7 @@ void RegExpLiteral::generate_bytecode(Bytecode::Generator& generator) const
 
 void Identifier::generate_bytecode(Bytecode::Generator& generator) const
 {
-    generator.emit<Bytecode::Op::GetVariable>(generator.intern_string(m_string));
+    generator.emit_load_variable(m_string);
 }
 
 void AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) const
@@ -279,7 +290,7 @@ void AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) con
 
         if (m_op == AssignmentOp::Assignment) {
             m_rhs->generate_bytecode(generator);
-            generator.emit<Bytecode::Op::SetVariable>(generator.intern_string(identifier.string()));
+            generator.emit_store_variable(identifier.string());
             return;
         }
 
@@ -363,10 +374,10 @@ void AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) con
         case AssignmentOp::NullishAssignment:
             break; // These are handled above.
         default:
-            TODO();
+            return generator.unsupported_construct(class_name());
         }
 
-        generator.emit<Bytecode::Op::SetVariable>(generator.intern_string(identifier.string()));
+        generator.emit_store_variable(identifier.string());
 
         if (end_block_ptr) {
             generator.emit<Bytecode::Op::Jump>().set_targets(
@@ -399,7 +410,7 @@ void AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) con
         return;
     }
 
-    TODO();
+    generator.unsupported_construct(class_name());
 }
 
 void WhileStatement::generate_bytecode(Bytecode::Generator& generator) const
@@ -508,6 +519,26 @@ void ForStatement::generate_bytecode(Bytecode::Generator& generator) const
 
     auto& end_block = generator.make_block();
 
+    // Lexical declarations in the head of the loop aren't part of any scope node, so we have to declare them here.
+    generator.begin_variable_scope();
+    if (m_init && is<VariableDeclaration>(*m_init)) {
+        auto& variable_declaration = static_cast<VariableDeclaration const&>(*m_init);
+        if (variable_declaration.declaration_kind() != DeclarationKind::Var) {
+            for (auto& declarator : variable_declaration.declarations()) {
+                auto declare_variable = [&](FlyString const& name) {
+                    if (!generator.can_keep_variable_in_register(name))
+                        return;
+                    auto variable_register = generator.declare_variable_in_register(name);
+                    generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
+                    generator.emit<Bytecode::Op::Store>(variable_register);
+                };
+                declarator.target().visit(
+                    [&](NonnullRefPtr<Identifier> const& id) { declare_variable(id->string()); },
+                    [&](NonnullRefPtr<BindingPattern> const& pattern) { pattern->for_each_bound_name(declare_variable); });
+            }
+        }
+    }
+
     if (m_init)
         m_init->generate_bytecode(generator);
 
@@ -563,6 +594,8 @@ void ForStatement::generate_bytecode(Bytecode::Generator& generator) const
         generator.switch_to_basic_block(end_block);
         generator.emit<Bytecode::Op::Load>(result_reg);
     }
+
+    generator.end_variable_scope();
 }
 
 void ObjectExpression::generate_bytecode(Bytecode::Generator& generator) const
@@ -576,7 +609,7 @@ void ObjectExpression::generate_bytecode(Bytecode::Generator& generator) const
 
     for (auto& property : m_properties) {
         if (property.type() != ObjectProperty::Type::KeyValue)
-            TODO();
+            return generator.unsupported_construct(class_name());
 
         if (is<StringLiteral>(property.key())) {
             auto& string_literal = static_cast<StringLiteral const&>(property.key());
@@ -605,7 +638,7 @@ void ArrayExpression::generate_bytecode(Bytecode::Generator& generator) const
             element->generate_bytecode(generator);
 
             if (is<SpreadExpression>(*element)) {
-                TODO();
+                generator.unsupported_construct(class_name());
                 continue;
             }
         } else {
@@ -659,18 +692,18 @@ static void generate_object_binding_pattern_bytecode(Bytecode::Generator& genera
             VERIFY(!initializer);
 
             auto identifier = name.get<NonnullRefPtr<Identifier>>()->string();
-            auto interned_identifier = generator.intern_string(identifier);
 
             generator.emit_with_extra_register_slots<Bytecode::Op::CopyObjectExcludingProperties>(excluded_property_names.size(), value_reg, excluded_property_names);
-            generator.emit<Bytecode::Op::SetVariable>(interned_identifier);
+            generator.emit_store_variable(identifier, Bytecode::Op::SetVariable::InitializationMode::Initialize);
 
             return;
         }
 
         Bytecode::StringTableIndex name_index;
+        FlyString identifier;
 
         if (name.has<NonnullRefPtr<Identifier>>()) {
-            auto identifier = name.get<NonnullRefPtr<Identifier>>()->string();
+            identifier = name.get<NonnullRefPtr<Identifier>>()->string();
             name_index = generator.intern_string(identifier);
 
             if (has_rest) {
@@ -720,13 +753,13 @@ static void generate_object_binding_pattern_bytecode(Bytecode::Generator& genera
         } else if (alias.has<Empty>()) {
             if (name.has<NonnullRefPtr<Expression>>()) {
                 // This needs some sort of SetVariableByValue opcode, as it's a runtime binding
-                TODO();
+                generator.unsupported_construct("computed keys in binding patterns"sv);
+                continue;
             }
 
-            generator.emit<Bytecode::Op::SetVariable>(name_index);
+            generator.emit_store_variable(identifier, Bytecode::Op::SetVariable::InitializationMode::Initialize);
         } else {
-            auto& identifier = alias.get<NonnullRefPtr<Identifier>>()->string();
-            generator.emit<Bytecode::Op::SetVariable>(generator.intern_string(identifier));
+            generator.emit_store_variable(alias.get<NonnullRefPtr<Identifier>>()->string(), Bytecode::Op::SetVariable::InitializationMode::Initialize);
         }
     }
 }
@@ -770,8 +803,7 @@ static void generate_array_binding_pattern_bytecode(Bytecode::Generator& generat
                 // This element is an elision
             },
             [&](NonnullRefPtr<Identifier> const& identifier) {
-                auto interned_index = generator.intern_string(identifier->string());
-                generator.emit<Bytecode::Op::SetVariable>(interned_index);
+                generator.emit_store_variable(identifier->string(), Bytecode::Op::SetVariable::InitializationMode::Initialize);
             },
             [&](NonnullRefPtr<BindingPattern> const& pattern) {
                 // Store the accumulator value in a permanent register
@@ -893,13 +925,17 @@ static void generate_binding_pattern_bytecode(Bytecode::Generator& generator, Bi
 void VariableDeclaration::generate_bytecode(Bytecode::Generator& generator) const
 {
     for (auto& declarator : m_declarations) {
-        if (declarator.init())
+        if (declarator.init()) {
             declarator.init()->generate_bytecode(generator);
-        else
+        } else if (m_declaration_kind == DeclarationKind::Var) {
+            // A var without an initializer leaves the variable alone, which matters if it is also a parameter.
+            continue;
+        } else {
             generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
+        }
         declarator.target().visit(
             [&](NonnullRefPtr<Identifier> const& id) {
-                generator.emit<Bytecode::Op::SetVariable>(generator.intern_string(id->string()));
+                generator.emit_store_variable(id->string(), Bytecode::Op::SetVariable::InitializationMode::Initialize);
             },
             [&](NonnullRefPtr<BindingPattern> const& pattern) {
                 auto value_register = generator.allocate_register();
@@ -920,17 +956,17 @@ void CallExpression::generate_bytecode(Bytecode::Generator& generator) const
         m_callee->generate_bytecode(generator);
         generator.emit<Bytecode::Op::Store>(callee_reg);
     } else if (is<SuperExpression>(*m_callee)) {
-        TODO();
+        return generator.unsupported_construct(class_name());
     } else if (is<MemberExpression>(*m_callee)) {
         auto& member_expression = static_cast<const MemberExpression&>(*m_callee);
         if (is<SuperExpression>(member_expression.object())) {
-            TODO();
+            return generator.unsupported_construct(class_name());
         } else {
             member_expression.object().generate_bytecode(generator);
             generator.emit<Bytecode::Op::Store>(this_reg);
             // FIXME: Don't copy this logic here, make MemberExpression generate it.
             if (!is<Identifier>(member_expression.property()))
-                TODO();
+                return generator.unsupported_construct(class_name());
             auto identifier_table_ref = generator.intern_string(static_cast<Identifier const&>(member_expression.property()).string());
             generator.emit<Bytecode::Op::GetById>(identifier_table_ref);
             generator.emit<Bytecode::Op::Store>(callee_reg);
@@ -975,7 +1011,7 @@ void YieldExpression::generate_bytecode(Bytecode::Generator& generator) const
     VERIFY(generator.is_in_generator_function());
 
     if (m_is_yield_from)
-        TODO();
+        return generator.unsupported_construct(class_name());
 
     if (m_argument)
         m_argument->generate_bytecode(generator);
@@ -1153,7 +1189,7 @@ void UpdateExpression::generate_bytecode(Bytecode::Generator& generator) const
 {
     if (is<Identifier>(*m_argument)) {
         auto& identifier = static_cast<Identifier const&>(*m_argument);
-        generator.emit<Bytecode::Op::GetVariable>(generator.intern_string(identifier.string()));
+        generator.emit_load_variable(identifier.string());
 
         Optional<Bytecode::Register> previous_value_for_postfix_reg;
         if (!m_prefixed) {
@@ -1166,14 +1202,14 @@ void UpdateExpression::generate_bytecode(Bytecode::Generator& generator) const
         else
             generator.emit<Bytecode::Op::Decrement>();
 
-        generator.emit<Bytecode::Op::SetVariable>(generator.intern_string(identifier.string()));
+        generator.emit_store_variable(identifier.string());
 
         if (!m_prefixed)
             generator.emit<Bytecode::Op::Load>(*previous_value_for_postfix_reg);
         return;
     }
 
-    TODO();
+    generator.unsupported_construct(class_name());
 }
 
 void ThrowStatement::generate_bytecode(Bytecode::Generator& generator) const
@@ -1196,17 +1232,15 @@ void TryStatement::generate_bytecode(Bytecode::Generator& generator) const
     Optional<Bytecode::Label> handler_target;
     Optional<Bytecode::Label> finalizer_target;
 
-    Bytecode::BasicBlock* next_block { nullptr };
+    auto& next_block = generator.make_block();
+    auto next_target = Bytecode::Label { next_block };
 
     if (m_finalizer) {
         auto& finalizer_block = generator.make_block();
         generator.switch_to_basic_block(finalizer_block);
         m_finalizer->generate_bytecode(generator);
-        if (!generator.is_current_block_terminated()) {
-            next_block = &generator.make_block();
-            auto next_target = Bytecode::Label { *next_block };
+        if (!generator.is_current_block_terminated())
             generator.emit<Bytecode::Op::ContinuePendingUnwind>(next_target);
-        }
         finalizer_target = Bytecode::Label { finalizer_block };
     }
 
@@ -1217,14 +1251,14 @@ void TryStatement::generate_bytecode(Bytecode::Generator& generator) const
             generator.emit<Bytecode::Op::LeaveUnwindContext>();
         m_handler->parameter().visit(
             [&](FlyString const& parameter) {
-                if (parameter.is_empty()) {
+                if (!parameter.is_empty()) {
                     // FIXME: We need a separate DeclarativeEnvironment here
                     generator.emit<Bytecode::Op::SetVariable>(generator.intern_string(parameter));
                 }
             },
             [&](NonnullRefPtr<BindingPattern> const&) {
                 // FIXME: Implement this path when the above DeclrativeEnvironment issue is dealt with.
-                TODO();
+                generator.unsupported_construct(class_name());
             });
 
         m_handler->body().generate_bytecode(generator);
@@ -1234,9 +1268,6 @@ void TryStatement::generate_bytecode(Bytecode::Generator& generator) const
                 generator.emit<Bytecode::Op::LeaveUnwindContext>();
                 generator.emit<Bytecode::Op::Jump>(finalizer_target);
             } else {
-                VERIFY(!next_block);
-                next_block = &generator.make_block();
-                auto next_target = Bytecode::Label { *next_block };
                 generator.emit<Bytecode::Op::Jump>(next_target);
             }
         }
@@ -1248,10 +1279,15 @@ void TryStatement::generate_bytecode(Bytecode::Generator& generator) const
 
     generator.switch_to_basic_block(target_block);
     m_block->generate_bytecode(generator);
-    if (m_finalizer && !generator.is_current_block_terminated())
-        generator.emit<Bytecode::Op::Jump>(finalizer_target);
+    if (!generator.is_current_block_terminated()) {
+        generator.emit<Bytecode::Op::LeaveUnwindContext>();
+        if (m_finalizer)
+            generator.emit<Bytecode::Op::Jump>(finalizer_target);
+        else
+            generator.emit<Bytecode::Op::Jump>(next_target);
+    }
 
-    generator.switch_to_basic_block(next_block ? *next_block : saved_block);
+    generator.switch_to_basic_block(next_block);
 }
 
 void SwitchStatement::generate_bytecode(Bytecode::Generator& generator) const
@@ -1313,7 +1349,7 @@ void SwitchStatement::generate_bytecode(Bytecode::Generator& generator) const
 void ClassDeclaration::generate_bytecode(Bytecode::Generator& generator) const
 {
     generator.emit<Bytecode::Op::NewClass>(m_class_expression);
-    generator.emit<Bytecode::Op::SetVariable>(generator.intern_string(m_class_expression.ptr()->name()));
+    generator.emit_store_variable(m_class_expression.ptr()->name());
 }
 
 }
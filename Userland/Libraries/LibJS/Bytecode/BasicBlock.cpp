@@ -64,6 +64,18 @@ void BasicBlock::grow(size_t additional_size)
     VERIFY(m_buffer_size <= m_buffer_capacity);
 }
 
+void BasicBlock::replace_instruction_stream(ReadonlyBytes instruction_stream)
+{
+    if (instruction_stream.size() > m_buffer_capacity) {
+        munmap(m_buffer, m_buffer_capacity);
+        m_buffer_capacity = instruction_stream.size();
+        m_buffer = (u8*)mmap(nullptr, m_buffer_capacity, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, 0, 0);
+        VERIFY(m_buffer != MAP_FAILED);
+    }
+    __builtin_memcpy(m_buffer, instruction_stream.data(), instruction_stream.size());
+    m_buffer_size = instruction_stream.size();
+}
+
 void InstructionStreamIterator::operator++()
 {
     VERIFY(!at_end());
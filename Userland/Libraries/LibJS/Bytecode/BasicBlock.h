@@ -41,6 +41,9 @@ private:
 struct UnwindInfo {
     BasicBlock const* handler;
     BasicBlock const* finalizer;
+    // The Interpreter::run() call that entered the context, counted from the outermost one. Exceptions thrown in a
+    // function called from inside the context only get here after they've made it out of that function's run().
+    size_t run_depth;
 };
 
 class BasicBlock {
@@ -60,6 +63,10 @@ public:
     bool can_grow(size_t additional_size) const { return m_buffer_size + additional_size <= m_buffer_capacity; }
     void grow(size_t additional_size);
 
+    // NOTE: This does not destroy the instructions that are currently in the block, as the new stream usually
+    //       contains (moved) copies of most of them. See Passes::BasicBlockRewriter.
+    void replace_instruction_stream(ReadonlyBytes);
+
     void terminate(Badge<Generator>) { m_is_terminated = true; }
     bool is_terminated() const { return m_is_terminated; }
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibCore/File.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/Bytecode/Cache.h>
+#include <LibJS/Bytecode/Serialization.h>
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace JS::Bytecode {
+
+Cache::Cache(String directory, bool optimized)
+    : m_directory(move(directory))
+    , m_optimized(optimized)
+{
+}
+
+String Cache::path_for(ReadonlyBytes digest) const
+{
+    StringBuilder builder;
+    builder.append(m_directory);
+    builder.append('/');
+    for (auto byte : digest)
+        builder.appendff("{:02x}", byte);
+    builder.append(m_optimized ? ".opt.jsbc"sv : ".jsbc"sv);
+    return builder.build();
+}
+
+Optional<Executable> Cache::load(StringView source) const
+{
+    auto digest = Crypto::Hash::SHA256::hash(source);
+    auto digest_bytes = ReadonlyBytes { digest.immutable_data(), digest.data_length() };
+
+    auto file_or_error = Core::File::open(path_for(digest_bytes), Core::OpenMode::ReadOnly);
+    if (file_or_error.is_error())
+        return {};
+    auto contents = file_or_error.value()->read_all();
+
+    // The file starts with the digest of the source, to catch files that have been renamed, followed by the digest of
+    // the serialized executable, to catch files that are truncated or corrupted. A corrupted executable could still
+    // deserialize successfully, but do something entirely different.
+    if (contents.size() < 2 * digest_bytes.size() || contents.bytes().slice(0, digest_bytes.size()) != digest_bytes)
+        return {};
+    auto serialized_executable = contents.bytes().slice(2 * digest_bytes.size());
+    auto serialized_executable_digest = Crypto::Hash::SHA256::hash(serialized_executable.data(), serialized_executable.size());
+    if (contents.bytes().slice(digest_bytes.size(), digest_bytes.size()) != ReadonlyBytes { serialized_executable_digest.immutable_data(), serialized_executable_digest.data_length() })
+        return {};
+    return deserialize_executable(serialized_executable);
+}
+
+bool Cache::store(StringView source, Executable const& executable) const
+{
+    auto serialized_executable = serialize_executable(executable);
+    if (!serialized_executable.has_value())
+        return false;
+
+    if (mkdir(m_directory.characters(), 0755) < 0 && errno != EEXIST)
+        return false;
+
+    auto digest = Crypto::Hash::SHA256::hash(source);
+    auto digest_bytes = ReadonlyBytes { digest.immutable_data(), digest.data_length() };
+    auto path = path_for(digest_bytes);
+    auto serialized_executable_digest = Crypto::Hash::SHA256::hash(*serialized_executable);
+
+    // Write to a temporary file first, so that nobody ever loads a partially written one.
+    auto temporary_path = String::formatted("{}.{}", path, getpid());
+    auto file_or_error = Core::File::open(temporary_path, Core::OpenMode::WriteOnly);
+    if (file_or_error.is_error())
+        return false;
+    auto& file = *file_or_error.value();
+    if (!file.write(digest_bytes.data(), digest_bytes.size())
+        || !file.write(serialized_executable_digest.immutable_data(), serialized_executable_digest.data_length())
+        || !file.write(serialized_executable->data(), serialized_executable->size())
+        || !file.close()) {
+        unlink(temporary_path.characters());
+        return false;
+    }
+    if (rename(temporary_path.characters(), path.characters()) < 0) {
+        unlink(temporary_path.characters());
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibJS/Bytecode/Generator.h>
+
+namespace JS::Bytecode {
+
+// Keeps the compiled bytecode of scripts on disk, so running the same source again doesn't have to parse and compile it.
+// Each script is stored in its own file, named after the SHA-256 digest of its source.
+class Cache {
+public:
+    // Whether the top level of scripts is optimized is part of the key, as it's up to the embedder.
+    Cache(String directory, bool optimized);
+
+    Optional<Executable> load(StringView source) const;
+    bool store(StringView source, Executable const&) const;
+
+private:
+    String path_for(ReadonlyBytes digest) const;
+
+    String m_directory;
+    bool m_optimized { false };
+};
+
+}
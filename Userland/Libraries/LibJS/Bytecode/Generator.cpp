@@ -23,9 +23,20 @@ Generator::~Generator()
 {
 }
 
-Executable Generator::generate(ASTNode const& node, bool is_in_generator_function)
+Executable Generator::generate(ASTNode const& node, bool is_in_generator_function, Vector<FunctionNode::Parameter> const& parameters)
+{
+    return generate_impl(node, is_in_generator_function, parameters, false).release_value();
+}
+
+Optional<Executable> Generator::try_generate(ASTNode const& node, bool is_in_generator_function, Vector<FunctionNode::Parameter> const& parameters)
+{
+    return generate_impl(node, is_in_generator_function, parameters, true);
+}
+
+Optional<Executable> Generator::generate_impl(ASTNode const& node, bool is_in_generator_function, Vector<FunctionNode::Parameter> const& parameters, bool give_up_on_unsupported_constructs)
 {
     Generator generator;
+    generator.m_give_up_on_unsupported_constructs = give_up_on_unsupported_constructs;
     generator.switch_to_basic_block(generator.make_block());
     if (is_in_generator_function) {
         generator.enter_generator_context();
@@ -34,7 +45,28 @@ Executable Generator::generate(ASTNode const& node, bool is_in_generator_functio
         generator.emit<Bytecode::Op::Yield>(Label { start_block });
         generator.switch_to_basic_block(start_block);
     }
+
+    if (is<ScopeNode>(node)) {
+        auto& scope_node = static_cast<ScopeNode const&>(node);
+        if (!is<Program>(scope_node))
+            generator.m_function_body = &scope_node;
+        generator.m_local_variable_analysis = scope_node.local_variable_analysis();
+    }
+
+    generator.begin_variable_scope();
+    if (generator.m_local_variable_analysis && !generator.m_local_variable_analysis->references_arguments) {
+        // The parameters have already been bound in the function environment, so we only look them up once.
+        for (auto& parameter : parameters) {
+            auto* name = parameter.binding.get_pointer<FlyString>();
+            if (!name || !generator.can_keep_variable_in_register(*name))
+                continue;
+            auto parameter_register = generator.declare_variable_in_register(*name);
+            generator.emit<Bytecode::Op::GetVariable>(generator.intern_string(*name));
+            generator.emit<Bytecode::Op::Store>(parameter_register);
+        }
+    }
     node.generate_bytecode(generator);
+    generator.end_variable_scope();
     if (is_in_generator_function) {
         // Terminate all unterminated blocks with yield return
         for (auto& block : generator.m_root_basic_blocks) {
@@ -45,7 +77,61 @@ Executable Generator::generate(ASTNode const& node, bool is_in_generator_functio
             generator.emit<Bytecode::Op::Yield>(nullptr);
         }
     }
-    return { move(generator.m_root_basic_blocks), move(generator.m_string_table), generator.m_next_register };
+    if (generator.m_encountered_unsupported_construct)
+        return {};
+    return Executable { move(generator.m_root_basic_blocks), move(generator.m_string_table), generator.m_next_register };
+}
+
+void Generator::unsupported_construct(StringView name)
+{
+    if (!m_give_up_on_unsupported_constructs) {
+        dbgln("Can't generate bytecode for {} yet", name);
+        TODO();
+    }
+    m_encountered_unsupported_construct = true;
+}
+
+bool Generator::can_keep_variable_in_register(FlyString const& name) const
+{
+    if (!m_local_variable_analysis || m_local_variable_analysis->has_dynamic_variable_access)
+        return false;
+    return name != "arguments"sv && !m_local_variable_analysis->captured_names.contains(name);
+}
+
+Register Generator::declare_variable_in_register(FlyString const& name)
+{
+    VERIFY(can_keep_variable_in_register(name));
+    auto& scope = m_variable_scopes.last();
+    if (auto existing_register = scope.get(name); existing_register.has_value())
+        return *existing_register;
+    auto new_register = allocate_register();
+    scope.set(name, new_register);
+    return new_register;
+}
+
+Optional<Register> Generator::register_for_variable(FlyString const& name) const
+{
+    for (ssize_t i = m_variable_scopes.size() - 1; i >= 0; --i) {
+        if (auto variable_register = m_variable_scopes[i].get(name); variable_register.has_value())
+            return variable_register;
+    }
+    return {};
+}
+
+void Generator::emit_load_variable(FlyString const& name)
+{
+    if (auto variable_register = register_for_variable(name); variable_register.has_value())
+        emit<Op::Load>(*variable_register);
+    else
+        emit<Op::GetVariable>(intern_string(name));
+}
+
+void Generator::emit_store_variable(FlyString const& name, Op::SetVariable::InitializationMode initialization_mode)
+{
+    if (auto variable_register = register_for_variable(name); variable_register.has_value())
+        emit<Op::Store>(*variable_register);
+    else
+        emit<Op::SetVariable>(intern_string(name), initialization_mode);
 }
 
 void Generator::grow(size_t additional_size)
@@ -9,7 +9,9 @@
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <AK/SinglyLinkedList.h>
+#include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/JIT/NativeExecutable.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/Register.h>
@@ -23,12 +25,21 @@ struct Executable {
     NonnullOwnPtr<StringTable> string_table;
     size_t number_of_registers { 0 };
 
+    // Executables that were loaded from the bytecode cache have no AST, so they own the nodes that NewFunction refers to.
+    NonnullRefPtrVector<FunctionExpression> function_nodes {};
+
+    // Compiled by the interpreter the first time it runs this executable, if the JIT is enabled.
+    mutable bool did_try_jitting { false };
+    mutable OwnPtr<JIT::NativeExecutable> native_executable {};
+
     String const& get_string(StringTableIndex index) const { return string_table->get(index); }
 };
 
 class Generator {
 public:
-    static Executable generate(ASTNode const&, bool is_in_generator_function = false);
+    static Executable generate(ASTNode const&, bool is_in_generator_function = false, Vector<FunctionNode::Parameter> const& parameters = {});
+    // Like generate(), but gives up on constructs that the generator doesn't support yet, rather than crashing.
+    static Optional<Executable> try_generate(ASTNode const&, bool is_in_generator_function = false, Vector<FunctionNode::Parameter> const& parameters = {});
 
     Register allocate_register();
 
@@ -109,6 +120,20 @@ public:
         return m_string_table->insert(string);
     }
 
+    // Variables that nothing outside of the code being generated can reach are kept in registers, see ScopeNode::LocalVariableAnalysis.
+    void begin_variable_scope() { m_variable_scopes.empend(); }
+    void end_variable_scope() { m_variable_scopes.take_last(); }
+    bool can_keep_variable_in_register(FlyString const&) const;
+    Register declare_variable_in_register(FlyString const&);
+    Optional<Register> register_for_variable(FlyString const&) const;
+    void emit_load_variable(FlyString const&);
+    void emit_store_variable(FlyString const&, Op::SetVariable::InitializationMode = Op::SetVariable::InitializationMode::Set);
+
+    bool is_function_body(ScopeNode const& scope_node) const { return &scope_node == m_function_body; }
+
+    // Called in place of TODO() for constructs that don't have a bytecode implementation yet.
+    void unsupported_construct(StringView name);
+
     bool is_in_generator_function() const { return m_is_in_generator_function; }
     void enter_generator_context() { m_is_in_generator_function = true; }
     void leave_generator_context() { m_is_in_generator_function = false; }
@@ -117,6 +142,8 @@ private:
     Generator();
     ~Generator();
 
+    static Optional<Executable> generate_impl(ASTNode const&, bool is_in_generator_function, Vector<FunctionNode::Parameter> const& parameters, bool give_up_on_unsupported_constructs);
+
     void grow(size_t);
     void* next_slot();
 
@@ -127,8 +154,13 @@ private:
     u32 m_next_register { 2 };
     u32 m_next_block { 1 };
     bool m_is_in_generator_function { false };
+    bool m_give_up_on_unsupported_constructs { false };
+    bool m_encountered_unsupported_construct { false };
     Vector<Label> m_continuable_scopes;
     Vector<Label> m_breakable_scopes;
+    ScopeNode const* m_function_body { nullptr };
+    ScopeNode::LocalVariableAnalysis const* m_local_variable_analysis { nullptr };
+    Vector<HashMap<FlyString, Register>> m_variable_scopes;
 };
 
 }
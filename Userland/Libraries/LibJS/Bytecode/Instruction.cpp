@@ -25,4 +25,82 @@ void Instruction::destroy(Instruction& instruction)
 #undef __BYTECODE_OP
 }
 
+bool Instruction::reads_accumulator() const
+{
+    switch (type()) {
+    case Type::Load:
+    case Type::LoadImmediate:
+    case Type::NewBigInt:
+    case Type::NewArray:
+    case Type::NewString:
+    case Type::NewObject:
+    case Type::NewRegExp:
+    case Type::CopyObjectExcludingProperties:
+    case Type::GetVariable:
+    case Type::Jump:
+    case Type::Call:
+    case Type::NewFunction:
+    case Type::NewClass:
+    case Type::PushDeclarativeEnvironment:
+    case Type::EnterUnwindContext:
+    case Type::LeaveUnwindContext:
+    case Type::ContinuePendingUnwind:
+        return false;
+    default:
+        return true;
+    }
+}
+
+// NOTE: This only returns true for instructions that overwrite the accumulator whenever they complete normally.
+bool Instruction::writes_accumulator() const
+{
+    switch (type()) {
+    case Type::Load:
+    case Type::LoadImmediate:
+    case Type::NewBigInt:
+    case Type::NewArray:
+    case Type::IteratorToArray:
+    case Type::NewString:
+    case Type::NewObject:
+    case Type::NewRegExp:
+    case Type::CopyObjectExcludingProperties:
+    case Type::GetVariable:
+    case Type::GetById:
+    case Type::GetByValue:
+    case Type::Call:
+    case Type::NewFunction:
+    case Type::Increment:
+    case Type::Decrement:
+    case Type::GetIterator:
+    case Type::IteratorNext:
+    case Type::IteratorResultDone:
+    case Type::IteratorResultValue:
+#define __BYTECODE_OP(op, _) case Type::op:
+        JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(op, _) case Type::Jump##op:
+        JS_ENUMERATE_FUSED_COMPARISON_JUMPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool Instruction::is_conditional_jump() const
+{
+    switch (type()) {
+    case Type::JumpConditional:
+    case Type::JumpNullish:
+    case Type::JumpUndefined:
+#define __BYTECODE_OP(op, _) case Type::Jump##op:
+        JS_ENUMERATE_FUSED_COMPARISON_JUMPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        return true;
+    default:
+        return false;
+    }
+}
+
 }
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/Function.h>
+#include <LibJS/Bytecode/Register.h>
 #include <LibJS/Forward.h>
 
 #define ENUMERATE_BYTECODE_OPS(O)    \
@@ -73,7 +75,15 @@
     O(IteratorNext)                  \
     O(IteratorResultDone)            \
     O(IteratorResultValue)           \
-    O(NewClass)
+    O(NewClass)                      \
+    O(JumpLessThan)                  \
+    O(JumpLessThanEquals)            \
+    O(JumpGreaterThan)               \
+    O(JumpGreaterThanEquals)         \
+    O(JumpAbstractEquals)            \
+    O(JumpAbstractInequals)          \
+    O(JumpTypedEquals)               \
+    O(JumpTypedInequals)
 
 namespace JS::Bytecode {
 
@@ -96,6 +106,19 @@ public:
     void replace_references(BasicBlock const&, BasicBlock const&);
     static void destroy(Instruction&);
 
+    // The accumulator is an implicit operand, so it's not passed to register visitors.
+    enum class RegisterAccess {
+        Read,
+        Write,
+        ReadWrite,
+    };
+    using RegisterVisitor = Function<void(Register&, RegisterAccess)>;
+    void visit_registers(RegisterVisitor const&);
+
+    bool reads_accumulator() const;
+    bool writes_accumulator() const;
+    bool is_conditional_jump() const;
+
 protected:
     explicit Instruction(Type type)
         : m_type(type)
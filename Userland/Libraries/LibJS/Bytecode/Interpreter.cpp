@@ -9,6 +9,7 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/JIT/Compiler.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/GlobalObject.h>
@@ -16,6 +17,8 @@
 namespace JS::Bytecode {
 
 static Interpreter* s_current;
+bool Interpreter::s_jit_enabled = false;
+bool Interpreter::s_optimizations_enabled = true;
 
 Interpreter* Interpreter::current()
 {
@@ -41,6 +44,8 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter will run unit {:p}", &executable);
 
     TemporaryChange restore_executable { m_current_executable, &executable };
+    TemporaryChange restore_run_depth { m_run_depth, m_run_depth + 1 };
+    TemporaryChange restore_saved_return_value { m_saved_return_value, Value {} };
 
     vm().set_last_value(Badge<Interpreter> {}, {});
 
@@ -67,16 +72,34 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
         registers()[Register::global_object_index] = Value(&global_object());
     }
 
+    if (s_jit_enabled && !executable.did_try_jitting) {
+        executable.did_try_jitting = true;
+        executable.native_executable = JIT::Compiler::compile(executable);
+    }
+    auto* native_executable = executable.native_executable.ptr();
+
     for (;;) {
         Bytecode::InstructionStreamIterator pc(block->instruction_stream());
         bool will_jump = false;
         bool will_return = false;
+        // The native code runs the block until an instruction needs the attention of the loop below, and leaves the
+        // iterator at that instruction as if the loop had just executed it.
+        bool did_execute_natively = false;
+        if (native_executable && native_executable->has_code_for(*block)) {
+            auto exit = native_executable->run(*this, registers().data(), *block);
+            block = exit.block;
+            pc = Bytecode::InstructionStreamIterator(block->instruction_stream());
+            pc.jump(exit.offset);
+            did_execute_natively = true;
+        }
         while (!pc.at_end()) {
             auto& instruction = *pc;
-            instruction.execute(*this);
+            if (!exchange(did_execute_natively, false))
+                instruction.execute(*this);
             if (vm().exception()) {
                 m_saved_exception = {};
-                if (m_unwind_contexts.is_empty())
+                m_saved_return_value = {};
+                if (m_unwind_contexts.is_empty() || m_unwind_contexts.last().run_depth != m_run_depth)
                     break;
                 auto& unwind_context = m_unwind_contexts.last();
                 if (unwind_context.handler) {
@@ -92,6 +115,8 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
                     m_saved_exception = Handle<Exception>::create(vm().exception());
                     vm().clear_exception();
                 }
+                // Nothing after the instruction that threw may run, whether or not we're jumping to a handler.
+                break;
             }
             if (m_pending_jump.has_value()) {
                 block = m_pending_jump.release_value();
@@ -99,6 +124,17 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
                 break;
             }
             if (!m_return_value.is_empty()) {
+                // Returning leaves the try blocks we're in, but the innermost finalizer still has to run first.
+                if (!exchange(m_is_suspending, false)) {
+                    while (!m_unwind_contexts.is_empty() && m_unwind_contexts.last().run_depth == m_run_depth && !m_unwind_contexts.last().finalizer)
+                        m_unwind_contexts.take_last();
+                    if (!m_unwind_contexts.is_empty() && m_unwind_contexts.last().run_depth == m_run_depth) {
+                        block = m_unwind_contexts.take_last().finalizer;
+                        m_saved_return_value = exchange(m_return_value, {});
+                        will_jump = true;
+                        break;
+                    }
+                }
                 will_return = true;
                 break;
             }
@@ -130,6 +166,10 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
 
     vm().set_last_value(Badge<Interpreter> {}, accumulator());
 
+    // Returning from inside a try block doesn't leave its unwind context, so that has to happen here.
+    while (!m_unwind_contexts.is_empty() && m_unwind_contexts.last().run_depth == m_run_depth)
+        m_unwind_contexts.take_last();
+
     if (!m_manually_entered_frames)
         m_register_windows.take_last();
 
@@ -148,9 +188,14 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
     return return_value;
 }
 
+bool Interpreter::has_pending_control_flow() const
+{
+    return m_vm.exception() || m_pending_jump.has_value() || !m_return_value.is_empty();
+}
+
 void Interpreter::enter_unwind_context(Optional<Label> handler_target, Optional<Label> finalizer_target)
 {
-    m_unwind_contexts.empend(handler_target.has_value() ? &handler_target->block() : nullptr, finalizer_target.has_value() ? &finalizer_target->block() : nullptr);
+    m_unwind_contexts.empend(handler_target.has_value() ? &handler_target->block() : nullptr, finalizer_target.has_value() ? &finalizer_target->block() : nullptr, m_run_depth);
 }
 
 void Interpreter::leave_unwind_context()
@@ -163,11 +208,28 @@ void Interpreter::continue_pending_unwind(Label const& resume_label)
     if (!m_saved_exception.is_null()) {
         vm().set_exception(*m_saved_exception.cell());
         m_saved_exception = {};
+    } else if (!m_saved_return_value.is_empty()) {
+        do_return(exchange(m_saved_return_value, {}));
     } else {
         jump(resume_label);
     }
 }
 
+void Interpreter::gather_roots(HashTable<Cell*>& roots)
+{
+    // Registers can hold the only reference to a local variable's value.
+    for (auto& window : m_register_windows) {
+        for (auto& value : window) {
+            if (value.is_cell())
+                roots.set(&value.as_cell());
+        }
+    }
+    if (m_return_value.is_cell())
+        roots.set(&m_return_value.as_cell());
+    if (m_saved_return_value.is_cell())
+        roots.set(&m_saved_return_value.as_cell());
+}
+
 AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> Interpreter::s_optimization_pipelines {};
 
 Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::OptimizationLevel level)
@@ -181,6 +243,7 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
 
     auto pm = make<PassManager>();
     if (level == OptimizationLevel::Default) {
+        pm->add<Passes::ConstantFolding>();
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::UnifySameBlocks>();
         pm->add<Passes::GenerateCFG>();
@@ -189,6 +252,15 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
         pm->add<Passes::UnifySameBlocks>();
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::MergeBlocks>();
+        // Merging blocks exposes more constants to the block-local folding.
+        pm->add<Passes::ConstantFolding>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::GenerateLiveness>();
+        pm->add<Passes::EliminateDeadStores>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::GenerateLiveness>();
+        pm->add<Passes::AllocateRegisters>();
+        pm->add<Passes::Peephole>();
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::PlaceBlocks>();
     } else {
@@ -54,6 +54,15 @@ public:
         m_pending_jump = &label.block();
     }
     void do_return(Value return_value) { m_return_value = return_value; }
+    // Like do_return(), but the generator is only suspended, so it doesn't leave any try blocks.
+    void do_yield(Value yield_value)
+    {
+        m_return_value = yield_value;
+        m_is_suspending = true;
+    }
+
+    // Whether the last instruction did something that run() has to act on before the next one can run.
+    bool has_pending_control_flow() const;
 
     void enter_unwind_context(Optional<Label> handler_target, Optional<Label> finalizer_target);
     void leave_unwind_context();
@@ -61,15 +70,26 @@ public:
 
     Executable const& current_executable() { return *m_current_executable; }
 
+    void gather_roots(HashTable<Cell*>&);
+
     enum class OptimizationLevel {
         Default,
         __Count,
     };
     static Bytecode::PassManager& optimization_pipeline(OptimizationLevel = OptimizationLevel::Default);
 
+    static bool jit_enabled() { return s_jit_enabled; }
+    static void set_jit_enabled(bool enabled) { s_jit_enabled = enabled; }
+
+    // Whether functions are run through the optimization pipeline when they're compiled.
+    static bool optimizations_enabled() { return s_optimizations_enabled; }
+    static void set_optimizations_enabled(bool enabled) { s_optimizations_enabled = enabled; }
+
 private:
     RegisterWindow& registers() { return m_register_windows.last(); }
 
+    static bool s_jit_enabled;
+    static bool s_optimizations_enabled;
     static AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> s_optimization_pipelines;
 
     VM& m_vm;
@@ -79,8 +99,12 @@ private:
     Value m_return_value;
     size_t m_manually_entered_frames { 0 };
     Executable const* m_current_executable { nullptr };
+    size_t m_run_depth { 0 };
     Vector<UnwindInfo> m_unwind_contexts;
     Handle<Exception> m_saved_exception;
+    // What a return statement inside a try block returns once the finalizer is done.
+    Value m_saved_return_value;
+    bool m_is_suspending { false };
 };
 
 }
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+
+namespace JS::Bytecode::JIT {
+
+// Emits the handful of x86_64 instructions that the baseline JIT needs. Operands are 64 bits wide unless the name of
+// the function says otherwise, and memory operands are always a base register plus a 32-bit displacement.
+class Assembler {
+public:
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX = 1,
+        RDX = 2,
+        RBX = 3,
+        RSP = 4,
+        RBP = 5,
+        RSI = 6,
+        RDI = 7,
+        R8 = 8,
+        R9 = 9,
+        R10 = 10,
+        R11 = 11,
+        R12 = 12,
+        R13 = 13,
+        R14 = 14,
+        R15 = 15,
+    };
+
+    struct Mem {
+        Reg base;
+        i32 offset { 0 };
+    };
+
+    // The low nibble of the Jcc and SETcc opcodes.
+    enum class Condition : u8 {
+        Overflow = 0x0,
+        Below = 0x2,
+        AboveOrEqual = 0x3,
+        Equal = 0x4,
+        NotEqual = 0x5,
+        BelowOrEqual = 0x6,
+        Above = 0x7,
+        Sign = 0x8,
+        LessThan = 0xc,
+        GreaterThanOrEqual = 0xd,
+        LessThanOrEqual = 0xe,
+        GreaterThan = 0xf,
+    };
+
+    // A position in the code that jumps can be emitted to before it is known. Jumps to it are patched by link().
+    struct Label {
+        Optional<size_t> offset;
+        Vector<size_t> jump_displacement_offsets;
+    };
+
+    // The 0x81 and 0xc1 opcodes select the operation with the reg field of ModRM.
+    enum class ArithmeticOp : u8 {
+        Add = 0,
+        Or = 1,
+        And = 4,
+        Sub = 5,
+        Xor = 6,
+        Cmp = 7,
+    };
+
+    enum class ShiftOp : u8 {
+        Shl = 4,
+        Shr = 5,
+        Sar = 7,
+    };
+
+    explicit Assembler(Vector<u8>& output)
+        : m_output(output)
+    {
+    }
+
+    size_t offset() const { return m_output.size(); }
+
+    void mov(Reg dst, Reg src) { emit_rr(true, 0x89, src, dst); }
+    void mov32(Reg dst, Reg src) { emit_rr(false, 0x89, src, dst); }
+    void mov(Reg dst, Mem src) { emit_rm(true, 0x8b, dst, src); }
+    void mov(Mem dst, Reg src) { emit_rm(true, 0x89, src, dst); }
+    void mov32(Reg dst, Mem src) { emit_rm(false, 0x8b, dst, src); }
+
+    void mov(Reg dst, u64 imm)
+    {
+        if (imm <= NumericLimits<u32>::max()) {
+            // Writing the lower half zeroes the upper one.
+            emit_rex(false, 0, to_underlying(dst));
+            emit8(0xb8 | (to_underlying(dst) & 7));
+            emit32(static_cast<u32>(imm));
+            return;
+        }
+        emit_rex(true, 0, to_underlying(dst));
+        emit8(0xb8 | (to_underlying(dst) & 7));
+        emit64(imm);
+    }
+
+    void arithmetic(ArithmeticOp op, Reg dst, Reg src) { emit_rr(true, (to_underlying(op) << 3) | 0x01, src, dst); }
+    void arithmetic32(ArithmeticOp op, Reg dst, Reg src) { emit_rr(false, (to_underlying(op) << 3) | 0x01, src, dst); }
+    void arithmetic32(ArithmeticOp op, Reg dst, i32 imm)
+    {
+        emit_rex(false, 0, to_underlying(dst));
+        emit8(0x81);
+        emit_modrm_reg(to_underlying(op), dst);
+        emit32(static_cast<u32>(imm));
+    }
+
+    void imul32(Reg dst, Reg src)
+    {
+        emit_rex(false, to_underlying(dst), to_underlying(src));
+        emit8(0x0f);
+        emit8(0xaf);
+        emit_modrm_reg(to_underlying(dst), src);
+    }
+
+    void shift(ShiftOp op, Reg dst, u8 imm)
+    {
+        emit_rex(true, 0, to_underlying(dst));
+        emit8(0xc1);
+        emit_modrm_reg(to_underlying(op), dst);
+        emit8(imm);
+    }
+
+    // Shifts by the lower bits of CL, like JavaScript does.
+    void shift32_by_cl(ShiftOp op, Reg dst)
+    {
+        emit_rex(false, 0, to_underlying(dst));
+        emit8(0xd3);
+        emit_modrm_reg(to_underlying(op), dst);
+    }
+
+    void test32(Reg lhs, Reg rhs) { emit_rr(false, 0x85, rhs, lhs); }
+
+    void test8(Reg lhs, Reg rhs)
+    {
+        VERIFY(to_underlying(lhs) < 4 && to_underlying(rhs) < 4);
+        emit8(0x84);
+        emit_modrm_reg(to_underlying(rhs), lhs);
+    }
+
+    // Sets the lowest byte of the register, which must be one that has a legacy byte form (AL, CL, DL or BL).
+    void set8(Condition condition, Reg dst)
+    {
+        VERIFY(to_underlying(dst) < 4);
+        emit8(0x0f);
+        emit8(0x90 | to_underlying(condition));
+        emit_modrm_reg(0, dst);
+    }
+
+    void movzx8(Reg dst, Reg src)
+    {
+        VERIFY(to_underlying(src) < 4);
+        emit_rex(false, to_underlying(dst), 0);
+        emit8(0x0f);
+        emit8(0xb6);
+        emit_modrm_reg(to_underlying(dst), src);
+    }
+
+    void push(Reg reg)
+    {
+        emit_rex(false, 0, to_underlying(reg));
+        emit8(0x50 | (to_underlying(reg) & 7));
+    }
+
+    void pop(Reg reg)
+    {
+        emit_rex(false, 0, to_underlying(reg));
+        emit8(0x58 | (to_underlying(reg) & 7));
+    }
+
+    void call(Reg reg)
+    {
+        emit_rex(false, 0, to_underlying(reg));
+        emit8(0xff);
+        emit_modrm_reg(2, reg);
+    }
+
+    void jump(Reg reg)
+    {
+        emit_rex(false, 0, to_underlying(reg));
+        emit8(0xff);
+        emit_modrm_reg(4, reg);
+    }
+
+    void jump(Label& label)
+    {
+        emit8(0xe9);
+        emit_displacement_to(label);
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        emit8(0x0f);
+        emit8(0x80 | to_underlying(condition));
+        emit_displacement_to(label);
+    }
+
+    void ret() { emit8(0xc3); }
+
+    void link(Label& label)
+    {
+        VERIFY(!label.offset.has_value());
+        label.offset = offset();
+        for (auto displacement_offset : label.jump_displacement_offsets)
+            patch_displacement(displacement_offset, *label.offset);
+        label.jump_displacement_offsets.clear();
+    }
+
+private:
+    void emit8(u8 value) { m_output.append(value); }
+
+    void emit32(u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            emit8(static_cast<u8>(value >> (i * 8)));
+    }
+
+    void emit64(u64 value)
+    {
+        for (size_t i = 0; i < 8; ++i)
+            emit8(static_cast<u8>(value >> (i * 8)));
+    }
+
+    void emit_rex(bool is_64_bit, u8 reg, u8 rm)
+    {
+        u8 rex = 0x40 | (is_64_bit ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0) | ((rm & 8) ? 0x01 : 0);
+        if (rex != 0x40)
+            emit8(rex);
+    }
+
+    void emit_modrm_reg(u8 reg, Reg rm) { emit8(0xc0 | ((reg & 7) << 3) | (to_underlying(rm) & 7)); }
+
+    void emit_modrm_mem(u8 reg, Mem mem)
+    {
+        // RSP and R12 need a SIB byte to be used as a base, so they always get one without an index.
+        emit8(0x80 | ((reg & 7) << 3) | (to_underlying(mem.base) & 7));
+        if ((to_underlying(mem.base) & 7) == to_underlying(Reg::RSP))
+            emit8(0x24);
+        emit32(static_cast<u32>(mem.offset));
+    }
+
+    void emit_rr(bool is_64_bit, u8 opcode, Reg reg, Reg rm)
+    {
+        emit_rex(is_64_bit, to_underlying(reg), to_underlying(rm));
+        emit8(opcode);
+        emit_modrm_reg(to_underlying(reg), rm);
+    }
+
+    void emit_rm(bool is_64_bit, u8 opcode, Reg reg, Mem mem)
+    {
+        emit_rex(is_64_bit, to_underlying(reg), to_underlying(mem.base));
+        emit8(opcode);
+        emit_modrm_mem(to_underlying(reg), mem);
+    }
+
+    void emit_displacement_to(Label& label)
+    {
+        auto displacement_offset = offset();
+        emit32(0);
+        if (label.offset.has_value())
+            patch_displacement(displacement_offset, *label.offset);
+        else
+            label.jump_displacement_offsets.append(displacement_offset);
+    }
+
+    void patch_displacement(size_t displacement_offset, size_t target_offset)
+    {
+        // Displacements are relative to the end of the jump, which is where the displacement ends.
+        auto displacement = static_cast<i32>(static_cast<i64>(target_offset) - static_cast<i64>(displacement_offset + 4));
+        for (size_t i = 0; i < 4; ++i)
+            m_output[displacement_offset + i] = static_cast<u8>(static_cast<u32>(displacement) >> (i * 8));
+    }
+
+    Vector<u8>& m_output;
+};
+
+}
@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/Debug.h>
+#include <AK/Platform.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/JIT/Assembler.h>
+#include <LibJS/Bytecode/JIT/Compiler.h>
+#include <LibJS/Bytecode/Op.h>
+
+namespace JS::Bytecode::JIT {
+
+#if ARCH(X86_64)
+
+using Reg = Assembler::Reg;
+using Mem = Assembler::Mem;
+using Condition = Assembler::Condition;
+using ArithmeticOp = Assembler::ArithmeticOp;
+using ShiftOp = Assembler::ShiftOp;
+
+static_assert(sizeof(Value) == sizeof(u64));
+static_assert(Register::accumulator_index == 0);
+
+// These stay the same for as long as the native code runs. They are callee-saved, so calls into C++ don't clobber them.
+static constexpr Reg REGISTERS = Reg::RBX;
+static constexpr Reg INTERPRETER = Reg::R12;
+
+template<typename OpType>
+static bool execute_instruction(Interpreter& interpreter, Instruction const& instruction)
+{
+    static_cast<OpType const&>(instruction).execute_impl(interpreter);
+    return interpreter.has_pending_control_flow();
+}
+
+static FlatPtr execute_function_for(Instruction const& instruction)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return bit_cast<FlatPtr>(&execute_instruction<Op::op>);
+
+    switch (instruction.type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
+static bool to_boolean(Value const& value)
+{
+    return value.to_boolean();
+}
+
+static Mem register_operand(Register reg)
+{
+    return { REGISTERS, static_cast<i32>(reg.index() * sizeof(Value)) };
+}
+
+static Mem accumulator_operand()
+{
+    return register_operand(Register::accumulator());
+}
+
+class CodeGenerator {
+public:
+    CodeGenerator(Executable const& executable, Vector<u8>& code)
+        : m_executable(executable)
+        , m_assembler(code)
+    {
+    }
+
+    HashMap<BasicBlock const*, size_t> generate()
+    {
+        m_block_labels.resize(m_executable.basic_blocks.size());
+        for (size_t i = 0; i < m_executable.basic_blocks.size(); ++i)
+            m_block_indices.set(&m_executable.basic_blocks[i], i);
+
+        // The entry is called as Exit (*)(Value* registers, Interpreter*, void* block_code), and the exit returns the
+        // Exit that was put into RAX and RDX. Three pushes keep the stack aligned to 16 bytes for the calls we make.
+        m_assembler.push(Reg::RBP);
+        m_assembler.mov(Reg::RBP, Reg::RSP);
+        m_assembler.push(REGISTERS);
+        m_assembler.push(INTERPRETER);
+        m_assembler.mov(REGISTERS, Reg::RDI);
+        m_assembler.mov(INTERPRETER, Reg::RSI);
+        m_assembler.jump(Reg::RDX);
+
+        m_assembler.link(m_exit);
+        m_assembler.pop(INTERPRETER);
+        m_assembler.pop(REGISTERS);
+        m_assembler.pop(Reg::RBP);
+        m_assembler.ret();
+
+        HashMap<BasicBlock const*, size_t> block_offsets;
+        for (auto& block : m_executable.basic_blocks) {
+            block_offsets.set(&block, m_assembler.offset());
+            m_assembler.link(label_for(block));
+            for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+                compile_instruction(*it, block, it.offset());
+            // Blocks without a terminator end the executable.
+            emit_exit(block, block.size());
+        }
+        return block_offsets;
+    }
+
+private:
+    Assembler::Label& label_for(BasicBlock const& block) { return m_block_labels[*m_block_indices.get(&block)]; }
+
+    void emit_exit(BasicBlock const& block, size_t offset)
+    {
+        m_assembler.mov(Reg::RAX, bit_cast<FlatPtr>(&block));
+        m_assembler.mov(Reg::RDX, offset);
+        m_assembler.jump(m_exit);
+    }
+
+    void emit_execute_generically(Instruction const& instruction, BasicBlock const& block, size_t offset)
+    {
+        m_assembler.mov(Reg::RDI, INTERPRETER);
+        m_assembler.mov(Reg::RSI, bit_cast<FlatPtr>(&instruction));
+        m_assembler.mov(Reg::RAX, execute_function_for(instruction));
+        m_assembler.call(Reg::RAX);
+
+        Assembler::Label keep_going;
+        m_assembler.test8(Reg::RAX, Reg::RAX);
+        m_assembler.jump_if(Condition::Equal, keep_going);
+        emit_exit(block, offset);
+        m_assembler.link(keep_going);
+    }
+
+    // Clobbers RCX.
+    void emit_jump_unless_int32(Reg value, Assembler::Label& label)
+    {
+        m_assembler.mov(Reg::RCX, value);
+        m_assembler.shift(ShiftOp::Shr, Reg::RCX, TAG_SHIFT);
+        m_assembler.arithmetic32(ArithmeticOp::Cmp, Reg::RCX, INT32_TAG);
+        m_assembler.jump_if(Condition::NotEqual, label);
+    }
+
+    // Clobbers RCX.
+    void emit_box(u64 tag, Reg value)
+    {
+        m_assembler.mov(Reg::RCX, tag << TAG_SHIFT);
+        m_assembler.arithmetic(ArithmeticOp::Or, value, Reg::RCX);
+    }
+
+    void emit_box_int32(Reg value)
+    {
+        m_assembler.mov32(value, value);
+        emit_box(INT32_TAG, value);
+    }
+
+    // Loads the lhs register into RAX and the accumulator into RDX, and jumps to `slow` unless both are Int32 values.
+    void emit_load_int32_operands(Register lhs, Assembler::Label& slow)
+    {
+        m_assembler.mov(Reg::RAX, register_operand(lhs));
+        m_assembler.mov(Reg::RDX, accumulator_operand());
+        emit_jump_unless_int32(Reg::RAX, slow);
+        emit_jump_unless_int32(Reg::RDX, slow);
+    }
+
+    // The operation works on EAX and EDX, and leaves the result as a Value in RAX. It can give up by jumping to `slow`.
+    template<typename EmitOperation>
+    void compile_int32_binary_op(Instruction const& instruction, BasicBlock const& block, size_t offset, Register lhs, EmitOperation emit_operation)
+    {
+        Assembler::Label slow;
+        Assembler::Label done;
+        emit_load_int32_operands(lhs, slow);
+        emit_operation(slow);
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        m_assembler.jump(done);
+        m_assembler.link(slow);
+        emit_execute_generically(instruction, block, offset);
+        m_assembler.link(done);
+    }
+
+    // Leaves the result as a Boolean Value in RAX, and 0 or 1 in RSI.
+    void emit_compare_int32(Condition condition)
+    {
+        m_assembler.arithmetic32(ArithmeticOp::Cmp, Reg::RAX, Reg::RDX);
+        m_assembler.set8(condition, Reg::RAX);
+        m_assembler.movzx8(Reg::RAX, Reg::RAX);
+        m_assembler.mov(Reg::RSI, Reg::RAX);
+        emit_box(BOOLEAN_TAG, Reg::RAX);
+    }
+
+    void compile_int32_comparison(Instruction const& instruction, BasicBlock const& block, size_t offset, Register lhs, Condition condition)
+    {
+        compile_int32_binary_op(instruction, block, offset, lhs, [&](auto&) {
+            emit_compare_int32(condition);
+        });
+    }
+
+    void compile_int32_comparison_jump(Op::Jump const& jump, BasicBlock const& block, size_t offset, Register lhs, Condition condition)
+    {
+        Assembler::Label slow;
+        emit_load_int32_operands(lhs, slow);
+        emit_compare_int32(condition);
+        // Like the other comparisons, the fused jumps leave the result in the accumulator.
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        m_assembler.test32(Reg::RSI, Reg::RSI);
+        m_assembler.jump_if(Condition::NotEqual, label_for(jump.true_target()->block()));
+        m_assembler.jump(label_for(jump.false_target()->block()));
+        m_assembler.link(slow);
+        emit_execute_generically(jump, block, offset);
+    }
+
+    void compile_increment_or_decrement(Instruction const& instruction, BasicBlock const& block, size_t offset, ArithmeticOp op)
+    {
+        Assembler::Label slow;
+        Assembler::Label done;
+        m_assembler.mov(Reg::RAX, accumulator_operand());
+        emit_jump_unless_int32(Reg::RAX, slow);
+        m_assembler.arithmetic32(op, Reg::RAX, 1);
+        m_assembler.jump_if(Condition::Overflow, slow);
+        emit_box_int32(Reg::RAX);
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        m_assembler.jump(done);
+        m_assembler.link(slow);
+        emit_execute_generically(instruction, block, offset);
+        m_assembler.link(done);
+    }
+
+    // Jumps to the true target if the tag of the accumulator, masked with `tag_mask`, is `tag`.
+    void compile_tag_jump(Op::Jump const& jump, u32 tag_mask, u64 tag)
+    {
+        m_assembler.mov(Reg::RAX, accumulator_operand());
+        m_assembler.shift(ShiftOp::Shr, Reg::RAX, TAG_SHIFT);
+        m_assembler.arithmetic32(ArithmeticOp::And, Reg::RAX, tag_mask);
+        m_assembler.arithmetic32(ArithmeticOp::Cmp, Reg::RAX, tag);
+        m_assembler.jump_if(Condition::Equal, label_for(jump.true_target()->block()));
+        m_assembler.jump(label_for(jump.false_target()->block()));
+    }
+
+    void compile_jump_conditional(Op::Jump const& jump)
+    {
+        // Booleans and Int32 values are truthy unless their payload is 0. Everything else asks Value::to_boolean().
+        Assembler::Label check_payload;
+        Assembler::Label slow;
+        m_assembler.mov(Reg::RAX, accumulator_operand());
+        m_assembler.mov(Reg::RCX, Reg::RAX);
+        m_assembler.shift(ShiftOp::Shr, Reg::RCX, TAG_SHIFT);
+        m_assembler.arithmetic32(ArithmeticOp::Cmp, Reg::RCX, BOOLEAN_TAG);
+        m_assembler.jump_if(Condition::Equal, check_payload);
+        m_assembler.arithmetic32(ArithmeticOp::Cmp, Reg::RCX, INT32_TAG);
+        m_assembler.jump_if(Condition::NotEqual, slow);
+        m_assembler.link(check_payload);
+        m_assembler.test32(Reg::RAX, Reg::RAX);
+        m_assembler.jump_if(Condition::NotEqual, label_for(jump.true_target()->block()));
+        m_assembler.jump(label_for(jump.false_target()->block()));
+
+        m_assembler.link(slow);
+        m_assembler.mov(Reg::RDI, REGISTERS);
+        m_assembler.mov(Reg::RAX, bit_cast<FlatPtr>(&to_boolean));
+        m_assembler.call(Reg::RAX);
+        m_assembler.test8(Reg::RAX, Reg::RAX);
+        m_assembler.jump_if(Condition::NotEqual, label_for(jump.true_target()->block()));
+        m_assembler.jump(label_for(jump.false_target()->block()));
+    }
+
+    void compile_instruction(Instruction const& instruction, BasicBlock const& block, size_t offset)
+    {
+        switch (instruction.type()) {
+        case Instruction::Type::Load:
+            m_assembler.mov(Reg::RAX, register_operand(static_cast<Op::Load const&>(instruction).src()));
+            m_assembler.mov(accumulator_operand(), Reg::RAX);
+            return;
+        case Instruction::Type::LoadImmediate:
+            m_assembler.mov(Reg::RAX, static_cast<Op::LoadImmediate const&>(instruction).value().encoded());
+            m_assembler.mov(accumulator_operand(), Reg::RAX);
+            return;
+        case Instruction::Type::Store:
+            m_assembler.mov(Reg::RAX, accumulator_operand());
+            m_assembler.mov(register_operand(static_cast<Op::Store const&>(instruction).dst()), Reg::RAX);
+            return;
+        case Instruction::Type::Jump:
+            m_assembler.jump(label_for(static_cast<Op::Jump const&>(instruction).true_target()->block()));
+            return;
+        case Instruction::Type::JumpConditional:
+            compile_jump_conditional(static_cast<Op::Jump const&>(instruction));
+            return;
+        case Instruction::Type::JumpNullish:
+            // Undefined and null only differ in the lowest bit of their tag.
+            compile_tag_jump(static_cast<Op::Jump const&>(instruction), 0xfffe, UNDEFINED_TAG);
+            return;
+        case Instruction::Type::JumpUndefined:
+            compile_tag_jump(static_cast<Op::Jump const&>(instruction), 0xffff, UNDEFINED_TAG);
+            return;
+        case Instruction::Type::Add:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::Add const&>(instruction).lhs(), [&](auto& slow) {
+                m_assembler.arithmetic32(ArithmeticOp::Add, Reg::RAX, Reg::RDX);
+                m_assembler.jump_if(Condition::Overflow, slow);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+        case Instruction::Type::Sub:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::Sub const&>(instruction).lhs(), [&](auto& slow) {
+                m_assembler.arithmetic32(ArithmeticOp::Sub, Reg::RAX, Reg::RDX);
+                m_assembler.jump_if(Condition::Overflow, slow);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+        case Instruction::Type::Mul:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::Mul const&>(instruction).lhs(), [&](auto& slow) {
+                Assembler::Label is_not_zero;
+                m_assembler.mov32(Reg::RSI, Reg::RAX);
+                m_assembler.imul32(Reg::RAX, Reg::RDX);
+                m_assembler.jump_if(Condition::Overflow, slow);
+                // A zero result is -0 if either side was negative, which isn't an Int32.
+                m_assembler.test32(Reg::RAX, Reg::RAX);
+                m_assembler.jump_if(Condition::NotEqual, is_not_zero);
+                m_assembler.arithmetic32(ArithmeticOp::Or, Reg::RSI, Reg::RDX);
+                m_assembler.jump_if(Condition::Sign, slow);
+                m_assembler.link(is_not_zero);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+        case Instruction::Type::BitwiseAnd:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::BitwiseAnd const&>(instruction).lhs(), [&](auto&) {
+                m_assembler.arithmetic32(ArithmeticOp::And, Reg::RAX, Reg::RDX);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+        case Instruction::Type::BitwiseOr:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::BitwiseOr const&>(instruction).lhs(), [&](auto&) {
+                m_assembler.arithmetic32(ArithmeticOp::Or, Reg::RAX, Reg::RDX);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+        case Instruction::Type::BitwiseXor:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::BitwiseXor const&>(instruction).lhs(), [&](auto&) {
+                m_assembler.arithmetic32(ArithmeticOp::Xor, Reg::RAX, Reg::RDX);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+        case Instruction::Type::LeftShift:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::LeftShift const&>(instruction).lhs(), [&](auto&) {
+                m_assembler.mov32(Reg::RCX, Reg::RDX);
+                m_assembler.shift32_by_cl(ShiftOp::Shl, Reg::RAX);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+        case Instruction::Type::RightShift:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::RightShift const&>(instruction).lhs(), [&](auto&) {
+                m_assembler.mov32(Reg::RCX, Reg::RDX);
+                m_assembler.shift32_by_cl(ShiftOp::Sar, Reg::RAX);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+        case Instruction::Type::UnsignedRightShift:
+            compile_int32_binary_op(instruction, block, offset, static_cast<Op::UnsignedRightShift const&>(instruction).lhs(), [&](auto& slow) {
+                m_assembler.mov32(Reg::RCX, Reg::RDX);
+                m_assembler.shift32_by_cl(ShiftOp::Shr, Reg::RAX);
+                // Results above 2^31 - 1 are only representable as doubles.
+                m_assembler.test32(Reg::RAX, Reg::RAX);
+                m_assembler.jump_if(Condition::Sign, slow);
+                emit_box_int32(Reg::RAX);
+            });
+            return;
+
+#define __COMPILE_COMPARISON(op, condition)                                                                               \
+    case Instruction::Type::op:                                                                                           \
+        compile_int32_comparison(instruction, block, offset, static_cast<Op::op const&>(instruction).lhs(), condition);   \
+        return;                                                                                                           \
+    case Instruction::Type::Jump##op:                                                                                     \
+        compile_int32_comparison_jump(static_cast<Op::Jump const&>(instruction), block, offset,                           \
+            static_cast<Op::Jump##op const&>(instruction).lhs(), condition);                                              \
+        return;
+
+            __COMPILE_COMPARISON(LessThan, Condition::LessThan)
+            __COMPILE_COMPARISON(LessThanEquals, Condition::LessThanOrEqual)
+            __COMPILE_COMPARISON(GreaterThan, Condition::GreaterThan)
+            __COMPILE_COMPARISON(GreaterThanEquals, Condition::GreaterThanOrEqual)
+            __COMPILE_COMPARISON(AbstractEquals, Condition::Equal)
+            __COMPILE_COMPARISON(AbstractInequals, Condition::NotEqual)
+            __COMPILE_COMPARISON(TypedEquals, Condition::Equal)
+            __COMPILE_COMPARISON(TypedInequals, Condition::NotEqual)
+#undef __COMPILE_COMPARISON
+
+        case Instruction::Type::Increment:
+            compile_increment_or_decrement(instruction, block, offset, ArithmeticOp::Add);
+            return;
+        case Instruction::Type::Decrement:
+            compile_increment_or_decrement(instruction, block, offset, ArithmeticOp::Sub);
+            return;
+        default:
+            emit_execute_generically(instruction, block, offset);
+            return;
+        }
+    }
+
+    Executable const& m_executable;
+    Assembler m_assembler;
+    Assembler::Label m_exit;
+    Vector<Assembler::Label> m_block_labels;
+    HashMap<BasicBlock const*, size_t> m_block_indices;
+};
+
+OwnPtr<NativeExecutable> Compiler::compile(Executable const& executable)
+{
+    Vector<u8> code;
+    auto block_offsets = CodeGenerator(executable, code).generate();
+    dbgln_if(JS_BYTECODE_DEBUG, "JIT: Compiled {} basic blocks into {} bytes", executable.basic_blocks.size(), code.size());
+    return NativeExecutable::create(code, move(block_offsets));
+}
+
+#else
+
+OwnPtr<NativeExecutable> Compiler::compile(Executable const&)
+{
+    return {};
+}
+
+#endif
+
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <LibJS/Bytecode/JIT/NativeExecutable.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode::JIT {
+
+// A baseline JIT: every instruction of every basic block is translated to x86_64 code on its own. Loads, stores, jumps
+// and arithmetic and comparisons on Int32 values are done inline. Everything else, including the cases that the inline
+// code doesn't handle, calls the instruction's execute_impl(), so there is nothing to deoptimize. All the values stay
+// in the register window of the interpreter, which lets the code return to the interpreter after any instruction.
+class Compiler {
+public:
+    // Returns nullptr if there is no JIT for this platform, or the code couldn't be made executable.
+    static OwnPtr<NativeExecutable> compile(Executable const&);
+};
+
+}
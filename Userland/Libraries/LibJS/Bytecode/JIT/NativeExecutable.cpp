@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <LibJS/Bytecode/JIT/NativeExecutable.h>
+#include <string.h>
+#include <sys/mman.h>
+
+namespace JS::Bytecode::JIT {
+
+OwnPtr<NativeExecutable> NativeExecutable::create(Vector<u8> const& code, HashMap<BasicBlock const*, size_t> block_offsets)
+{
+    // The code is never writable and executable at the same time.
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (memory == MAP_FAILED)
+        return {};
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        munmap(memory, code.size());
+        return {};
+    }
+    return adopt_own(*new NativeExecutable(memory, code.size(), move(block_offsets)));
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<BasicBlock const*, size_t> block_offsets)
+    : m_code(code)
+    , m_size(size)
+    , m_block_offsets(move(block_offsets))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    munmap(m_code, m_size);
+}
+
+NativeExecutable::Exit NativeExecutable::run(Interpreter& interpreter, Value* registers, BasicBlock const& block) const
+{
+    // The code starts with a function that sets things up and then jumps to the block's code, see Compiler::compile().
+    using EntryFunction = Exit (*)(Value* registers, Interpreter*, void* block_code);
+    auto block_offset = m_block_offsets.get(&block);
+    VERIFY(block_offset.has_value());
+    auto* code = static_cast<u8*>(m_code);
+    return bit_cast<EntryFunction>(code)(registers, &interpreter, code + *block_offset);
+}
+
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode::JIT {
+
+// The machine code that Compiler made for the basic blocks of an executable, mapped into executable memory.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    // Returns nullptr if the code can't be made executable.
+    static OwnPtr<NativeExecutable> create(Vector<u8> const& code, HashMap<BasicBlock const*, size_t> block_offsets);
+    ~NativeExecutable();
+
+    // Where the native code handed control back to Interpreter::run(). Either the instruction at this offset has run and
+    // did something the interpreter has to deal with (like throwing or jumping), or the offset is the end of the block.
+    struct Exit {
+        BasicBlock const* block { nullptr };
+        size_t offset { 0 };
+    };
+
+    bool has_code_for(BasicBlock const& block) const { return m_block_offsets.contains(&block); }
+
+    // Runs the code from the start of the given block, with all the registers of the interpreter in `registers`.
+    Exit run(Interpreter&, Value* registers, BasicBlock const&) const;
+
+private:
+    NativeExecutable(void* code, size_t size, HashMap<BasicBlock const*, size_t> block_offsets);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<BasicBlock const*, size_t> m_block_offsets;
+};
+
+}
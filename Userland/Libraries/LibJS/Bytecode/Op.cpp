@@ -46,6 +46,11 @@ void Load::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.accumulator() = interpreter.reg(m_src);
 }
 
+void Load::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    visitor(m_src, RegisterAccess::Read);
+}
+
 void LoadImmediate::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     interpreter.accumulator() = m_value;
@@ -56,6 +61,11 @@ void Store::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.reg(m_dst) = interpreter.accumulator();
 }
 
+void Store::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    visitor(m_dst, RegisterAccess::Write);
+}
+
 static Value abstract_inequals(GlobalObject& global_object, Value src1, Value src2)
 {
     return Value(!abstract_eq(global_object, src1, src2));
@@ -86,6 +96,10 @@ static Value typed_equals(GlobalObject&, Value src1, Value src2)
     String OpTitleCase::to_string_impl(Bytecode::Executable const&) const                 \
     {                                                                                     \
         return String::formatted(#OpTitleCase " {}", m_lhs_reg);                          \
+    }                                                                                     \
+    void OpTitleCase::visit_registers_impl(RegisterVisitor const& visitor)                \
+    {                                                                                     \
+        visitor(m_lhs_reg, RegisterAccess::Read);                                         \
     }
 
 JS_ENUMERATE_COMMON_BINARY_OPS(JS_DEFINE_COMMON_BINARY_OP)
@@ -126,6 +140,12 @@ void NewArray::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.accumulator() = Array::create_from(interpreter.global_object(), elements);
 }
 
+void NewArray::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    for (size_t i = 0; i < m_element_count; i++)
+        visitor(m_elements[i], RegisterAccess::Read);
+}
+
 void IteratorToArray::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& global_object = interpreter.global_object();
@@ -210,11 +230,23 @@ void CopyObjectExcludingProperties::execute_impl(Bytecode::Interpreter& interpre
     interpreter.accumulator() = to_object;
 }
 
+void CopyObjectExcludingProperties::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    visitor(m_from_object, RegisterAccess::Read);
+    for (size_t i = 0; i < m_excluded_names_count; ++i)
+        visitor(m_excluded_names[i], RegisterAccess::Read);
+}
+
 void ConcatString::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     interpreter.reg(m_lhs) = add(interpreter.global_object(), interpreter.reg(m_lhs), interpreter.accumulator());
 }
 
+void ConcatString::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    visitor(m_lhs, RegisterAccess::ReadWrite);
+}
+
 void GetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     interpreter.accumulator() = interpreter.vm().get_variable(interpreter.current_executable().get_string(m_identifier), interpreter.global_object());
@@ -222,19 +254,129 @@ void GetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 
 void SetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    interpreter.vm().set_variable(interpreter.current_executable().get_string(m_identifier), interpreter.accumulator(), interpreter.global_object());
+    interpreter.vm().set_variable(interpreter.current_executable().get_string(m_identifier), interpreter.accumulator(), interpreter.global_object(), m_initialization_mode == InitializationMode::Initialize);
+}
+
+static bool may_use_cache(PropertyLookupCache const& cache, Object const& object)
+{
+    if (object.may_interfere_with_inline_caches())
+        return false;
+    return !cache.is_for_array_length || !is<Array>(object);
+}
+
+// Data properties can turn into accessors without changing the shape of their object, so values found in the cache
+// have to be checked for that, and accessors left to the slow path.
+static Optional<Value> get_cached_property(PropertyLookupCache& cache, Object& object)
+{
+    if (!may_use_cache(cache, object))
+        return {};
+    auto serial = object.shape().serial();
+    for (auto& entry : cache.entries) {
+        if (entry.shape_serial != serial)
+            continue;
+        auto* holder = &object;
+        if (entry.prototype_shape_serial) {
+            // The prototype is part of the shape, so it's the same object that the entry was made for.
+            holder = object.shape().prototype();
+            if (holder->shape().serial() != entry.prototype_shape_serial)
+                return {};
+        }
+        auto value = holder->get_direct(entry.offset);
+        if (value.is_accessor())
+            return {};
+        return value.value_or(js_undefined());
+    }
+    return {};
+}
+
+static void cache_property_for_get(PropertyLookupCache& cache, Object& object, String const& name)
+{
+    cache.is_for_array_length = name == object.vm().names.length.as_string();
+    if (!may_use_cache(cache, object))
+        return;
+    StringOrSymbol key { name };
+    if (auto metadata = object.shape().lookup(key); metadata.has_value()) {
+        if (!object.get_direct(metadata->offset).is_accessor())
+            cache.add({ .shape_serial = object.shape().serial(), .offset = static_cast<u32>(metadata->offset) });
+        return;
+    }
+    auto* prototype = object.shape().prototype();
+    if (!prototype || !may_use_cache(cache, *prototype))
+        return;
+    if (auto metadata = prototype->shape().lookup(key); metadata.has_value() && !prototype->get_direct(metadata->offset).is_accessor())
+        cache.add({ .shape_serial = object.shape().serial(), .prototype_shape_serial = prototype->shape().serial(), .offset = static_cast<u32>(metadata->offset) });
 }
 
 void GetById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.accumulator().to_object(interpreter.global_object()))
-        interpreter.accumulator() = object->get(interpreter.current_executable().get_string(m_property));
+    auto base = interpreter.accumulator();
+    if (base.is_object()) {
+        if (auto value = get_cached_property(m_cache, base.as_object()); value.has_value()) {
+            ++m_cache.hits;
+            interpreter.accumulator() = *value;
+            return;
+        }
+    }
+    ++m_cache.misses;
+
+    auto* object = base.to_object(interpreter.global_object());
+    if (!object)
+        return;
+    auto& name = interpreter.current_executable().get_string(m_property);
+    interpreter.accumulator() = object->get(name);
+    if (base.is_object() && !interpreter.vm().exception())
+        cache_property_for_get(m_cache, *object, name);
+}
+
+// Only assignments to existing writable data properties of the object itself are cached, anything else may have to
+// add a property, call a setter or fail.
+static bool put_cached_property(PropertyLookupCache& cache, Object& object, Value value)
+{
+    if (!may_use_cache(cache, object))
+        return false;
+    auto serial = object.shape().serial();
+    for (auto& entry : cache.entries) {
+        if (entry.shape_serial != serial)
+            continue;
+        if (object.get_direct(entry.offset).is_accessor())
+            return false;
+        object.put_direct(entry.offset, value);
+        return true;
+    }
+    return false;
+}
+
+static void cache_property_for_put(PropertyLookupCache& cache, Object& object, String const& name)
+{
+    cache.is_for_array_length = name == object.vm().names.length.as_string();
+    if (!may_use_cache(cache, object))
+        return;
+    auto metadata = object.shape().lookup(StringOrSymbol { name });
+    if (metadata.has_value() && metadata->attributes.is_writable() && !object.get_direct(metadata->offset).is_accessor())
+        cache.add({ .shape_serial = object.shape().serial(), .offset = static_cast<u32>(metadata->offset) });
 }
 
 void PutById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object()))
-        object->set(interpreter.current_executable().get_string(m_property), interpreter.accumulator(), true);
+    auto base = interpreter.reg(m_base);
+    if (base.is_object() && put_cached_property(m_cache, base.as_object(), interpreter.accumulator())) {
+        ++m_cache.hits;
+        return;
+    }
+    ++m_cache.misses;
+
+    auto* object = base.to_object(interpreter.global_object());
+    if (!object)
+        return;
+    auto& name = interpreter.current_executable().get_string(m_property);
+    object->set(name, interpreter.accumulator(), true);
+    if (base.is_object() && !interpreter.vm().exception())
+        cache_property_for_put(m_cache, *object, name);
+}
+
+void PutById::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    visitor(m_base, RegisterAccess::Read);
 }
 
 void Jump::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -283,6 +425,35 @@ void JumpUndefined::execute_impl(Bytecode::Interpreter& interpreter) const
         interpreter.jump(m_false_target.value());
 }
 
+#define JS_DEFINE_FUSED_COMPARISON_JUMP(OpTitleCase, op_snake_case)                                                 \
+    void Jump##OpTitleCase::execute_impl(Bytecode::Interpreter& interpreter) const                                  \
+    {                                                                                                               \
+        VERIFY(m_true_target.has_value());                                                                          \
+        VERIFY(m_false_target.has_value());                                                                         \
+        auto lhs = interpreter.reg(m_lhs_reg);                                                                      \
+        auto rhs = interpreter.accumulator();                                                                       \
+        auto result = op_snake_case(interpreter.global_object(), lhs, rhs);                                         \
+        interpreter.accumulator() = result;                                                                         \
+        if (interpreter.vm().exception())                                                                           \
+            return;                                                                                                 \
+        if (result.as_bool())                                                                                       \
+            interpreter.jump(m_true_target.value());                                                                \
+        else                                                                                                        \
+            interpreter.jump(m_false_target.value());                                                               \
+    }                                                                                                               \
+    String Jump##OpTitleCase::to_string_impl(Bytecode::Executable const&) const                                     \
+    {                                                                                                               \
+        auto true_string = m_true_target.has_value() ? String::formatted("{}", *m_true_target) : "<empty>";         \
+        auto false_string = m_false_target.has_value() ? String::formatted("{}", *m_false_target) : "<empty>";      \
+        return String::formatted("Jump" #OpTitleCase " {} true:{} false:{}", m_lhs_reg, true_string, false_string); \
+    }                                                                                                               \
+    void Jump##OpTitleCase::visit_registers_impl(RegisterVisitor const& visitor)                                    \
+    {                                                                                                               \
+        visitor(m_lhs_reg, RegisterAccess::Read);                                                                   \
+    }
+
+JS_ENUMERATE_FUSED_COMPARISON_JUMPS(JS_DEFINE_FUSED_COMPARISON_JUMP)
+
 void Call::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto callee = interpreter.reg(m_callee);
@@ -311,6 +482,14 @@ void Call::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.accumulator() = return_value;
 }
 
+void Call::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    visitor(m_callee, RegisterAccess::Read);
+    visitor(m_this_value, RegisterAccess::Read);
+    for (size_t i = 0; i < m_argument_count; ++i)
+        visitor(m_arguments[i], RegisterAccess::Read);
+}
+
 void NewFunction::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
@@ -398,11 +577,13 @@ void Yield::execute_impl(Bytecode::Interpreter& interpreter) const
     auto yielded_value = interpreter.accumulator().value_or(js_undefined());
     auto object = JS::Object::create(interpreter.global_object(), nullptr);
     object->define_direct_property("result", yielded_value, JS::default_attributes);
-    if (m_continuation_label.has_value())
+    if (m_continuation_label.has_value()) {
         object->define_direct_property("continuation", Value(static_cast<double>(reinterpret_cast<u64>(&m_continuation_label->block()))), JS::default_attributes);
-    else
+        interpreter.do_yield(object);
+    } else {
         object->define_direct_property("continuation", Value(0), JS::default_attributes);
-    interpreter.do_return(object);
+        interpreter.do_return(object);
+    }
 }
 
 void Yield::replace_references_impl(BasicBlock const& from, BasicBlock const& to)
@@ -411,26 +592,66 @@ void Yield::replace_references_impl(BasicBlock const& from, BasicBlock const& to
         m_continuation_label = Label { to };
 }
 
+// Integer indices are by far the most common computed keys, and don't need to be turned into a string and back.
+static PropertyName to_property_name(GlobalObject& global_object, Value value)
+{
+    if (value.is_int32() && value.as_i32() >= 0)
+        return value.as_i32();
+    return value.to_property_key(global_object);
+}
+
 void GetByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object())) {
-        auto property_key = interpreter.accumulator().to_property_key(interpreter.global_object());
+    auto base = interpreter.reg(m_base);
+    auto property = interpreter.accumulator();
+
+    // NOTE: Reading an array element doesn't have to go through [[Get]] at all.
+    if (base.is_object() && is<Array>(base.as_object()) && property.is_int32() && property.as_i32() >= 0) {
+        auto value = base.as_object().indexed_properties().get_element_fast(property.as_i32());
+        if (!value.is_empty() && !value.is_accessor()) {
+            interpreter.accumulator() = value;
+            return;
+        }
+    }
+
+    if (auto* object = base.to_object(interpreter.global_object())) {
+        auto property_name = to_property_name(interpreter.global_object(), property);
         if (interpreter.vm().exception())
             return;
-        interpreter.accumulator() = object->get(property_key);
+        interpreter.accumulator() = object->get(property_name);
     }
 }
 
+void GetByValue::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    visitor(m_base, RegisterAccess::Read);
+}
+
 void PutByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object())) {
-        auto property_key = interpreter.reg(m_property).to_property_key(interpreter.global_object());
+    auto base = interpreter.reg(m_base);
+    auto property = interpreter.reg(m_property);
+
+    // NOTE: Writing an existing array element, or appending one, doesn't have to go through [[Set]] at all.
+    if (base.is_object() && is<Array>(base.as_object()) && property.is_int32() && property.as_i32() >= 0) {
+        if (static_cast<Array&>(base.as_object()).set_element_fast(property.as_i32(), interpreter.accumulator()))
+            return;
+    }
+
+    if (auto* object = base.to_object(interpreter.global_object())) {
+        auto property_name = to_property_name(interpreter.global_object(), property);
         if (interpreter.vm().exception())
             return;
-        object->set(property_key, interpreter.accumulator(), true);
+        object->set(property_name, interpreter.accumulator(), true);
     }
 }
 
+void PutByValue::visit_registers_impl(RegisterVisitor const& visitor)
+{
+    visitor(m_base, RegisterAccess::Read);
+    visitor(m_property, RegisterAccess::Read);
+}
+
 void GetIterator::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     interpreter.accumulator() = get_iterator(interpreter.global_object(), interpreter.accumulator());
@@ -544,17 +765,26 @@ String GetVariable::to_string_impl(Bytecode::Executable const& executable) const
 
 String SetVariable::to_string_impl(Bytecode::Executable const& executable) const
 {
+    if (m_initialization_mode == InitializationMode::Initialize)
+        return String::formatted("SetVariable {} ({}) initialize", m_identifier, executable.string_table->get(m_identifier));
     return String::formatted("SetVariable {} ({})", m_identifier, executable.string_table->get(m_identifier));
 }
 
+static String cache_statistics_to_string(PropertyLookupCache const& cache)
+{
+    if (!cache.hits && !cache.misses)
+        return String::empty();
+    return String::formatted(" [cache hits:{}, misses:{}]", cache.hits, cache.misses);
+}
+
 String PutById::to_string_impl(Bytecode::Executable const& executable) const
 {
-    return String::formatted("PutById base:{}, property:{} ({})", m_base, m_property, executable.string_table->get(m_property));
+    return String::formatted("PutById base:{}, property:{} ({}){}", m_base, m_property, executable.string_table->get(m_property), cache_statistics_to_string(m_cache));
 }
 
 String GetById::to_string_impl(Bytecode::Executable const& executable) const
 {
-    return String::formatted("GetById {} ({})", m_property, executable.string_table->get(m_property));
+    return String::formatted("GetById {} ({}){}", m_property, executable.string_table->get(m_property), cache_statistics_to_string(m_cache));
 }
 
 String Jump::to_string_impl(Bytecode::Executable const&) const
@@ -11,6 +11,7 @@
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/PropertyLookupCache.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Bytecode/StringTable.h>
 #include <LibJS/Heap/Cell.h>
@@ -30,6 +31,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
+
+    Register src() const { return m_src; }
 
 private:
     Register m_src;
@@ -46,6 +50,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    Value value() const { return m_value; }
 
 private:
     Value m_value;
@@ -62,6 +69,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
+
+    Register dst() const { return m_dst; }
 
 private:
     Register m_dst;
@@ -103,6 +113,9 @@ private:
         void execute_impl(Bytecode::Interpreter&) const;                       \
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
+        void visit_registers_impl(RegisterVisitor const&);                     \
+                                                                               \
+        Register lhs() const { return m_lhs_reg; }                             \
                                                                                \
     private:                                                                   \
         Register m_lhs_reg;                                                    \
@@ -129,6 +142,7 @@ JS_ENUMERATE_COMMON_BINARY_OPS(JS_DECLARE_COMMON_BINARY_OP)
         void execute_impl(Bytecode::Interpreter&) const;                       \
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
+        void visit_registers_impl(RegisterVisitor const&) { }                  \
     };
 
 JS_ENUMERATE_COMMON_UNARY_OPS(JS_DECLARE_COMMON_UNARY_OP)
@@ -145,6 +159,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex index() const { return m_string; }
 
 private:
     StringTableIndex m_string;
@@ -160,6 +177,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class NewRegExp final : public Instruction {
@@ -174,6 +192,10 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex source_index() const { return m_source_index; }
+    StringTableIndex flags_index() const { return m_flags_index; }
 
 private:
     StringTableIndex m_source_index;
@@ -195,9 +217,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
 
     size_t length_impl() const { return sizeof(*this) + sizeof(Register) * m_excluded_names_count; }
 
+    Register from_object() const { return m_from_object; }
+    Span<Register const> excluded_names() const { return { m_excluded_names, m_excluded_names_count }; }
+
 private:
     Register m_from_object;
     size_t m_excluded_names_count { 0 };
@@ -215,6 +241,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    Crypto::SignedBigInteger const& bigint() const { return m_bigint; }
 
 private:
     Crypto::SignedBigInteger m_bigint;
@@ -240,12 +269,15 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
 
     size_t length_impl() const
     {
         return sizeof(*this) + sizeof(Register) * m_element_count;
     }
 
+    Span<Register const> elements() const { return { m_elements, m_element_count }; }
+
 private:
     size_t m_element_count { 0 };
     Register m_elements[];
@@ -261,6 +293,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class ConcatString final : public Instruction {
@@ -274,6 +307,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
+
+    Register lhs() const { return m_lhs; }
 
 private:
     Register m_lhs;
@@ -281,18 +317,30 @@ private:
 
 class SetVariable final : public Instruction {
 public:
-    explicit SetVariable(StringTableIndex identifier)
+    enum class InitializationMode {
+        Set,
+        // Declarations may initialize const variables, which assignments can't change.
+        Initialize,
+    };
+
+    explicit SetVariable(StringTableIndex identifier, InitializationMode initialization_mode = InitializationMode::Set)
         : Instruction(Type::SetVariable)
         , m_identifier(identifier)
+        , m_initialization_mode(initialization_mode)
     {
     }
 
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex identifier() const { return m_identifier; }
+    InitializationMode initialization_mode() const { return m_initialization_mode; }
 
 private:
     StringTableIndex m_identifier;
+    InitializationMode m_initialization_mode;
 };
 
 class GetVariable final : public Instruction {
@@ -306,6 +354,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex identifier() const { return m_identifier; }
 
 private:
     StringTableIndex m_identifier;
@@ -322,9 +373,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex property() const { return m_property; }
 
 private:
     StringTableIndex m_property;
+    mutable PropertyLookupCache m_cache;
 };
 
 class PutById final : public Instruction {
@@ -339,10 +394,15 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
+
+    Register base() const { return m_base; }
+    StringTableIndex property() const { return m_property; }
 
 private:
     Register m_base;
     StringTableIndex m_property;
+    mutable PropertyLookupCache m_cache;
 };
 
 class GetByValue final : public Instruction {
@@ -356,6 +416,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
+
+    Register base() const { return m_base; }
 
 private:
     Register m_base;
@@ -373,6 +436,10 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
+
+    Register base() const { return m_base; }
+    Register property() const { return m_property; }
 
 private:
     Register m_base;
@@ -406,6 +473,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& true_target() const { return m_true_target; }
     auto& false_target() const { return m_false_target; }
@@ -448,6 +516,40 @@ public:
     String to_string_impl(Bytecode::Executable const&) const;
 };
 
+#define JS_ENUMERATE_FUSED_COMPARISON_JUMPS(O) \
+    O(LessThan, less_than)                     \
+    O(LessThanEquals, less_than_equals)        \
+    O(GreaterThan, greater_than)               \
+    O(GreaterThanEquals, greater_than_equals)  \
+    O(AbstractEquals, abstract_equals)         \
+    O(AbstractInequals, abstract_inequals)     \
+    O(TypedEquals, typed_equals)               \
+    O(TypedInequals, typed_inequals)
+
+// NOTE: These are a comparison followed by a JumpConditional, fused by the Peephole pass.
+//       Like the comparison, they leave the result in the accumulator.
+#define JS_DECLARE_FUSED_COMPARISON_JUMP(OpTitleCase, op_snake_case)                                                      \
+    class Jump##OpTitleCase final : public Jump {                                                                         \
+    public:                                                                                                               \
+        explicit Jump##OpTitleCase(Register lhs_reg, Optional<Label> true_target = {}, Optional<Label> false_target = {}) \
+            : Jump(Type::Jump##OpTitleCase, move(true_target), move(false_target))                                        \
+            , m_lhs_reg(lhs_reg)                                                                                          \
+        {                                                                                                                 \
+        }                                                                                                                 \
+                                                                                                                          \
+        void execute_impl(Bytecode::Interpreter&) const;                                                                  \
+        String to_string_impl(Bytecode::Executable const&) const;                                                         \
+        void visit_registers_impl(RegisterVisitor const&);                                                                \
+                                                                                                                          \
+        Register lhs() const { return m_lhs_reg; }                                                                        \
+                                                                                                                          \
+    private:                                                                                                              \
+        Register m_lhs_reg;                                                                                               \
+    };
+
+JS_ENUMERATE_FUSED_COMPARISON_JUMPS(JS_DECLARE_FUSED_COMPARISON_JUMP)
+#undef JS_DECLARE_FUSED_COMPARISON_JUMP
+
 // NOTE: This instruction is variable-width depending on the number of arguments!
 class Call final : public Instruction {
 public:
@@ -470,12 +572,18 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&);
 
     size_t length_impl() const
     {
         return sizeof(*this) + sizeof(Register) * m_argument_count;
     }
 
+    CallType call_type() const { return m_type; }
+    Register callee() const { return m_callee; }
+    Register this_value() const { return m_this_value; }
+    Span<Register const> arguments() const { return { m_arguments, m_argument_count }; }
+
 private:
     Register m_callee;
     Register m_this_value;
@@ -495,6 +603,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 
 private:
     ClassExpression const& m_class_expression;
@@ -511,6 +620,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    FunctionNode const& function_node() const { return m_function_node; }
 
 private:
     FunctionNode const& m_function_node;
@@ -528,6 +640,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Increment final : public Instruction {
@@ -540,6 +653,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Decrement final : public Instruction {
@@ -552,6 +666,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Throw final : public Instruction {
@@ -566,6 +681,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class EnterUnwindContext final : public Instruction {
@@ -583,6 +699,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& entry_point() const { return m_entry_point; }
     auto& handler_target() const { return m_handler_target; }
@@ -604,6 +721,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class ContinuePendingUnwind final : public Instruction {
@@ -619,6 +737,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& resume_target() const { return m_resume_target; }
 
@@ -644,6 +763,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& continuation() const { return m_continuation_label; }
 
@@ -662,6 +782,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    HashMap<u32, Variable> const& variables() const { return m_variables; }
 
 private:
     HashMap<u32, Variable> m_variables;
@@ -677,6 +800,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorNext final : public Instruction {
@@ -689,6 +813,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorResultDone final : public Instruction {
@@ -701,6 +826,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorResultValue final : public Instruction {
@@ -713,6 +839,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 }
@@ -749,6 +876,21 @@ ALWAYS_INLINE void Instruction::replace_references(BasicBlock const& from, Basic
 #undef __BYTECODE_OP
 }
 
+ALWAYS_INLINE void Instruction::visit_registers(RegisterVisitor const& visitor)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return static_cast<Bytecode::Op::op&>(*this).visit_registers_impl(visitor);
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
 ALWAYS_INLINE size_t Instruction::length() const
 {
     if (type() == Type::Call)
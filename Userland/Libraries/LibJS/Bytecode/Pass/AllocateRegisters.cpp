@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static constexpr u32 first_allocatable_register = Register::global_object_index + 1;
+
+void AllocateRegisters::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.live_registers_at_exit.has_value());
+    VERIFY(executable.always_live_registers.has_value());
+
+    auto for_each_instruction = [](BasicBlock& block, auto callback) {
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it)
+            callback(const_cast<Instruction&>(*it));
+    };
+
+    // Build the interference graph: a register interferes with everything that is live right after it's written.
+    HashMap<u32, RegisterSet> interference;
+    HashTable<u32> used_registers;
+    RegisterSet pinned_registers;
+    for (auto reg : *executable.always_live_registers)
+        pinned_registers.set(reg);
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<Instruction*> instructions;
+        for_each_instruction(block, [&](Instruction& instruction) {
+            instructions.append(&instruction);
+            instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess) {
+                used_registers.set(reg.index());
+            });
+        });
+
+        RegisterSet live = executable.live_registers_at_exit->get(&block).value_or({});
+        for (auto reg : *executable.always_live_registers)
+            live.set(reg);
+
+        for (ssize_t i = instructions.size() - 1; i >= 0; --i) {
+            auto& instruction = *instructions[i];
+            instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+                if (access == Instruction::RegisterAccess::Read)
+                    return;
+                for (auto other : live) {
+                    if (other == reg.index())
+                        continue;
+                    interference.ensure(reg.index()).set(other);
+                    interference.ensure(other).set(reg.index());
+                }
+            });
+            GenerateLiveness::update_liveness_backwards(instruction, live);
+        }
+
+        // Anything that is live on entry to the executable is read before it's written (e.g. an uninitialized local),
+        // so we can't tell what it may be sharing a slot with.
+        if (&block == &executable.executable.basic_blocks.first()) {
+            for (auto reg : live)
+                pinned_registers.set(reg);
+        }
+    }
+
+    Vector<u32> registers_to_allocate;
+    for (auto reg : used_registers) {
+        if (reg >= first_allocatable_register && !pinned_registers.contains(reg))
+            registers_to_allocate.append(reg);
+    }
+    quick_sort(registers_to_allocate);
+
+    // Greedily assign each register the lowest slot none of its neighbors have taken.
+    HashMap<u32, u32> assignment;
+    u32 highest_assigned_register = Register::global_object_index;
+    for (auto reg : pinned_registers) {
+        assignment.set(reg, reg);
+        highest_assigned_register = max(highest_assigned_register, reg);
+    }
+    for (auto reg : registers_to_allocate) {
+        HashTable<u32> taken;
+        for (auto neighbor : interference.get(reg).value_or({})) {
+            if (auto assigned = assignment.get(neighbor); assigned.has_value())
+                taken.set(*assigned);
+        }
+        u32 candidate = first_allocatable_register;
+        while (taken.contains(candidate) || pinned_registers.contains(candidate))
+            ++candidate;
+        assignment.set(reg, candidate);
+        highest_assigned_register = max(highest_assigned_register, candidate);
+    }
+
+    for (auto& block : executable.executable.basic_blocks) {
+        for_each_instruction(block, [&](Instruction& instruction) {
+            instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess) {
+                if (auto assigned = assignment.get(reg.index()); assigned.has_value())
+                    reg = Register(*assigned);
+            });
+        });
+    }
+
+    auto number_of_registers = max<size_t>(highest_assigned_register + 1, first_allocatable_register);
+    if (number_of_registers < executable.executable.number_of_registers) {
+        count("registers removed"sv, executable.executable.number_of_registers - number_of_registers);
+        executable.executable.number_of_registers = number_of_registers;
+    }
+
+    finished();
+}
+
+}
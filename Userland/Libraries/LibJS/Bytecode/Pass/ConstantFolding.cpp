@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static bool is_foldable_constant(Value value)
+{
+    return value.is_number() || value.is_boolean() || value.is_nullish();
+}
+
+// NOTE: Only operations that can neither have side effects nor throw are folded, and they have to give the same
+//       result as the corresponding function in Value.cpp.
+static Optional<Value> fold_binary_operation(Instruction::Type type, Value lhs, Value rhs)
+{
+    switch (type) {
+    case Instruction::Type::TypedEquals:
+        return Value(strict_eq(lhs, rhs));
+    case Instruction::Type::TypedInequals:
+        return Value(!strict_eq(lhs, rhs));
+    default:
+        break;
+    }
+
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+
+    auto lhs_number = lhs.as_double();
+    auto rhs_number = rhs.as_double();
+    switch (type) {
+    case Instruction::Type::Add:
+        return Value(lhs_number + rhs_number);
+    case Instruction::Type::Sub:
+        return Value(lhs_number - rhs_number);
+    case Instruction::Type::Mul:
+        return Value(lhs_number * rhs_number);
+    case Instruction::Type::Div:
+        return Value(lhs_number / rhs_number);
+    case Instruction::Type::AbstractEquals:
+        return Value(strict_eq(lhs, rhs));
+    case Instruction::Type::AbstractInequals:
+        return Value(!strict_eq(lhs, rhs));
+    // Comparisons involving NaN are false.
+    case Instruction::Type::LessThan:
+        return Value(lhs_number < rhs_number);
+    case Instruction::Type::LessThanEquals:
+        return Value(lhs_number <= rhs_number);
+    case Instruction::Type::GreaterThan:
+        return Value(lhs_number > rhs_number);
+    case Instruction::Type::GreaterThanEquals:
+        return Value(lhs_number >= rhs_number);
+    default:
+        return {};
+    }
+}
+
+static Optional<Value> fold_unary_operation(Instruction::Type type, Value value)
+{
+    switch (type) {
+    case Instruction::Type::Not:
+        return Value(!value.to_boolean());
+    case Instruction::Type::UnaryMinus:
+        if (value.is_number())
+            return Value(-value.as_double());
+        return {};
+    case Instruction::Type::UnaryPlus:
+        if (value.is_number())
+            return value;
+        return {};
+    default:
+        return {};
+    }
+}
+
+static bool preserves_accumulator(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::Store:
+    case Instruction::Type::ConcatString:
+    case Instruction::Type::SetVariable:
+    case Instruction::Type::PutById:
+    case Instruction::Type::PutByValue:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void ConstantFolding::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        BasicBlockRewriter rewriter { block };
+
+        // The constants currently in the accumulator and in registers, as far as this block is concerned.
+        Optional<Value> accumulator;
+        HashMap<u32, Value> registers;
+
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            auto& instruction = *it;
+            ++it;
+
+            switch (instruction.type()) {
+            case Instruction::Type::LoadImmediate: {
+                auto value = static_cast<Op::LoadImmediate const&>(instruction).value();
+                if (is_foldable_constant(value))
+                    accumulator = value;
+                else
+                    accumulator = {};
+                rewriter.keep(instruction);
+                continue;
+            }
+            case Instruction::Type::Load: {
+                auto src = static_cast<Op::Load const&>(instruction).src();
+                if (auto value = registers.get(src.index()); value.has_value()) {
+                    rewriter.replace<Op::LoadImmediate>(instruction, *value);
+                    accumulator = *value;
+                    count("loads propagated"sv);
+                } else {
+                    rewriter.keep(instruction);
+                    accumulator = {};
+                }
+                continue;
+            }
+            case Instruction::Type::Store: {
+                auto dst = static_cast<Op::Store const&>(instruction).dst();
+                if (accumulator.has_value())
+                    registers.set(dst.index(), *accumulator);
+                else
+                    registers.remove(dst.index());
+                rewriter.keep(instruction);
+                continue;
+            }
+            case Instruction::Type::JumpConditional:
+            case Instruction::Type::JumpNullish:
+            case Instruction::Type::JumpUndefined: {
+                auto& jump = static_cast<Op::Jump const&>(instruction);
+                if (!accumulator.has_value()) {
+                    rewriter.keep(instruction);
+                    continue;
+                }
+                bool taken;
+                if (instruction.type() == Instruction::Type::JumpConditional)
+                    taken = accumulator->to_boolean();
+                else if (instruction.type() == Instruction::Type::JumpNullish)
+                    taken = accumulator->is_nullish();
+                else
+                    taken = accumulator->is_undefined();
+                auto target = taken ? jump.true_target() : jump.false_target();
+                rewriter.replace<Op::Jump>(instruction, target);
+                count("branches folded"sv);
+                continue;
+            }
+            default:
+                break;
+            }
+
+#define __BYTECODE_OP(OpTitleCase, op_snake_case)                                                                                \
+    case Instruction::Type::OpTitleCase: {                                                                                       \
+        auto lhs = registers.get(static_cast<Op::OpTitleCase const&>(instruction).lhs().index());                                \
+        auto result = lhs.has_value() && accumulator.has_value() ? fold_binary_operation(instruction.type(), *lhs, *accumulator) \
+                                                                 : Optional<Value> {};                                           \
+        if (result.has_value()) {                                                                                                \
+            rewriter.replace<Op::LoadImmediate>(instruction, *result);                                                           \
+            count("operations folded"sv);                                                                                        \
+        } else {                                                                                                                 \
+            rewriter.keep(instruction);                                                                                          \
+        }                                                                                                                        \
+        accumulator = result;                                                                                                    \
+        continue;                                                                                                                \
+    }
+
+            switch (instruction.type()) {
+                JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_OP)
+            default:
+                break;
+            }
+#undef __BYTECODE_OP
+
+#define __BYTECODE_OP(OpTitleCase, op_snake_case)                                                                            \
+    case Instruction::Type::OpTitleCase: {                                                                                   \
+        auto result = accumulator.has_value() ? fold_unary_operation(instruction.type(), *accumulator) : Optional<Value> {}; \
+        if (result.has_value()) {                                                                                            \
+            rewriter.replace<Op::LoadImmediate>(instruction, *result);                                                       \
+            count("operations folded"sv);                                                                                    \
+        } else {                                                                                                             \
+            rewriter.keep(instruction);                                                                                      \
+        }                                                                                                                    \
+        accumulator = result;                                                                                                \
+        continue;                                                                                                            \
+    }
+
+            switch (instruction.type()) {
+                JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+            default:
+                break;
+            }
+#undef __BYTECODE_OP
+
+            // Everything else: forget whatever this instruction may have changed.
+            const_cast<Instruction&>(instruction).visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+                if (access != Instruction::RegisterAccess::Read)
+                    registers.remove(reg.index());
+            });
+            if (!preserves_accumulator(instruction))
+                accumulator = {};
+            rewriter.keep(instruction);
+        }
+
+        rewriter.finish();
+    }
+
+    finished();
+}
+
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void EliminateDeadStores::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.live_registers_at_exit.has_value());
+    VERIFY(executable.always_live_registers.has_value());
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<Instruction const*> instructions;
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it)
+            instructions.append(&*it);
+
+        // Registers a handler or finalizer reads stay live across any instruction that may throw, even if they're
+        // written again before the end of the block.
+        auto& always_live = *executable.always_live_registers;
+        RegisterSet live = executable.live_registers_at_exit->get(&block).value_or({});
+        for (auto reg : always_live)
+            live.set(reg);
+
+        // Walk backwards, marking the instructions that only produce values nobody is going to read.
+        Vector<bool> is_dead;
+        is_dead.resize(instructions.size());
+        bool any_dead = false;
+        for (ssize_t i = instructions.size() - 1; i >= 0; --i) {
+            auto& instruction = *instructions[i];
+            switch (instruction.type()) {
+            case Instruction::Type::Store: {
+                auto dst = static_cast<Op::Store const&>(instruction).dst();
+                if (dst.index() > Register::global_object_index && !live.contains(dst.index()) && !always_live.contains(dst.index())) {
+                    is_dead[i] = true;
+                    count("stores removed"sv);
+                }
+                break;
+            }
+            case Instruction::Type::Load:
+            case Instruction::Type::LoadImmediate:
+                if (!live.contains(Register::accumulator_index) && !always_live.contains(Register::accumulator_index)) {
+                    is_dead[i] = true;
+                    count("loads removed"sv);
+                }
+                break;
+            default:
+                break;
+            }
+
+            if (is_dead[i])
+                any_dead = true;
+            else
+                GenerateLiveness::update_liveness_backwards(instruction, live);
+        }
+
+        if (!any_dead)
+            continue;
+
+        BasicBlockRewriter rewriter { block };
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            if (is_dead[i])
+                rewriter.drop(*instructions[i]);
+            else
+                rewriter.keep(*instructions[i]);
+        }
+        rewriter.finish();
+    }
+
+    finished();
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void GenerateLiveness::update_liveness_backwards(Instruction const& instruction, RegisterSet& live_registers)
+{
+    // Writes happen after reads, so kill the written registers first.
+    if (instruction.writes_accumulator())
+        live_registers.remove(Register::accumulator_index);
+    const_cast<Instruction&>(instruction).visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+        if (access == Instruction::RegisterAccess::Write)
+            live_registers.remove(reg.index());
+    });
+
+    if (instruction.reads_accumulator())
+        live_registers.set(Register::accumulator_index);
+    const_cast<Instruction&>(instruction).visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+        if (access != Instruction::RegisterAccess::Write)
+            live_registers.set(reg.index());
+    });
+}
+
+static Vector<Instruction const*> instructions_of(BasicBlock const& block)
+{
+    Vector<Instruction const*> instructions;
+    InstructionStreamIterator it { block.instruction_stream() };
+    while (!it.at_end()) {
+        instructions.append(&*it);
+        ++it;
+    }
+    return instructions;
+}
+
+void GenerateLiveness::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.cfg.has_value());
+    auto& cfg = *executable.cfg;
+
+    // Instructions can throw, and then the handler or finalizer of the current unwind context runs with whatever is
+    // in the registers at that point. Rather than adding an edge to the CFG for every instruction that may throw, we
+    // consider everything those blocks need to be live everywhere.
+    RegisterSet always_live_registers;
+    HashTable<BasicBlock const*> unwind_targets;
+    for (auto& block : executable.executable.basic_blocks) {
+        for (auto* instruction : instructions_of(block)) {
+            if (instruction->type() != Instruction::Type::EnterUnwindContext)
+                continue;
+            auto& enter = static_cast<Op::EnterUnwindContext const&>(*instruction);
+            if (enter.handler_target().has_value())
+                unwind_targets.set(&enter.handler_target()->block());
+            if (enter.finalizer_target().has_value())
+                unwind_targets.set(&enter.finalizer_target()->block());
+        }
+    }
+    if (!unwind_targets.is_empty())
+        always_live_registers.set(Register::accumulator_index);
+
+    HashMap<BasicBlock const*, RegisterSet> live_at_entry;
+    HashMap<BasicBlock const*, RegisterSet> live_at_exit;
+
+    // Iterate until nothing changes. Going through the blocks backwards makes this converge faster, as
+    // information flows from successors to predecessors.
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (ssize_t i = executable.executable.basic_blocks.size() - 1; i >= 0; --i) {
+            auto& block = executable.executable.basic_blocks[i];
+
+            RegisterSet live;
+            auto successors = cfg.get(&block);
+            if (!successors.has_value() || successors->is_empty()) {
+                // Falling off the end of the executable leaves the accumulator as the completion value.
+                live.set(Register::accumulator_index);
+            } else {
+                for (auto* successor : *successors) {
+                    for (auto reg : live_at_entry.get(successor).value_or({}))
+                        live.set(reg);
+                }
+            }
+            for (auto reg : always_live_registers)
+                live.set(reg);
+
+            auto instructions = instructions_of(block);
+            auto live_in = live;
+            for (ssize_t j = instructions.size() - 1; j >= 0; --j)
+                update_liveness_backwards(*instructions[j], live_in);
+
+            if (unwind_targets.contains(&block)) {
+                for (auto reg : live_in) {
+                    if (!always_live_registers.contains(reg)) {
+                        always_live_registers.set(reg);
+                        changed = true;
+                    }
+                }
+            }
+
+            auto& existing_live_in = live_at_entry.ensure(&block);
+            if (existing_live_in.size() != live_in.size()) {
+                existing_live_in = move(live_in);
+                changed = true;
+            }
+            live_at_exit.set(&block, move(live));
+        }
+    }
+
+    executable.live_registers_at_exit = move(live_at_exit);
+    executable.always_live_registers = move(always_live_registers);
+
+    finished();
+}
+
+}
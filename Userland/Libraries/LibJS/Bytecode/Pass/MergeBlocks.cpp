@@ -41,6 +41,14 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
                     continue;
                 }
             }
+
+            // Merging drops the terminator, which is only fine if all it does is jump to the successor.
+            // Other terminators with one successor, e.g. ContinuePendingUnwind, have to stay.
+            Instruction const* terminator = nullptr;
+            for (; !it.at_end(); ++it)
+                terminator = &*it;
+            if (terminator->type() != Instruction::Type::Jump)
+                continue;
         }
 
         if (auto cfg_entry = inverted_cfg.get(*entry.value.begin()); cfg_entry.has_value()) {
@@ -150,6 +158,9 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
             }
             __builtin_memcpy(block.next_slot(), entry->instruction_stream().data(), copy_end);
             block.grow(copy_end);
+            // The instructions have moved to the new block, don't destroy them along with this one.
+            // Whatever wasn't copied is a Jump, which has nothing to destroy.
+            const_cast<BasicBlock&>(*entry).replace_instruction_stream({});
         }
 
         auto first_successor_position = replace_blocks(successors, *new_block);
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static bool try_fuse_comparison_and_jump(BasicBlockRewriter& rewriter, Instruction const& comparison, Instruction const& jump_instruction)
+{
+    if (jump_instruction.type() != Instruction::Type::JumpConditional)
+        return false;
+    auto& jump = static_cast<Op::JumpConditional const&>(jump_instruction);
+
+    switch (comparison.type()) {
+#define __BYTECODE_OP(OpTitleCase, op_snake_case)                                                                \
+    case Instruction::Type::OpTitleCase: {                                                                       \
+        auto lhs = static_cast<Op::OpTitleCase const&>(comparison).lhs();                                        \
+        rewriter.replace<Op::Jump##OpTitleCase>(jump_instruction, lhs, jump.true_target(), jump.false_target()); \
+        rewriter.drop(comparison);                                                                               \
+        return true;                                                                                             \
+    }
+        JS_ENUMERATE_FUSED_COMPARISON_JUMPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    default:
+        return false;
+    }
+}
+
+void Peephole::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<Instruction const*> instructions;
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it)
+            instructions.append(&*it);
+
+        BasicBlockRewriter rewriter { block };
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            auto& instruction = *instructions[i];
+            if (i + 1 == instructions.size()) {
+                rewriter.keep(instruction);
+                break;
+            }
+            auto& next = *instructions[i + 1];
+
+            // <comparison> $lhs; JumpConditional -> Jump<comparison> $lhs
+            if (try_fuse_comparison_and_jump(rewriter, instruction, next)) {
+                count("jumps fused"sv);
+                ++i;
+                continue;
+            }
+
+            // Store $r; Load $r -> Store $r
+            if (instruction.type() == Instruction::Type::Store && next.type() == Instruction::Type::Load
+                && static_cast<Op::Store const&>(instruction).dst().index() == static_cast<Op::Load const&>(next).src().index()) {
+                rewriter.keep(instruction);
+                rewriter.drop(next);
+                count("loads removed"sv);
+                ++i;
+                continue;
+            }
+
+            // Load $r; Store $r -> Load $r
+            if (instruction.type() == Instruction::Type::Load && next.type() == Instruction::Type::Store
+                && static_cast<Op::Load const&>(instruction).src().index() == static_cast<Op::Store const&>(next).dst().index()) {
+                rewriter.keep(instruction);
+                rewriter.drop(next);
+                count("stores removed"sv);
+                ++i;
+                continue;
+            }
+
+            rewriter.keep(instruction);
+        }
+        rewriter.finish();
+    }
+
+    finished();
+}
+
+}
@@ -6,18 +6,26 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
+#include <stdio.h>
 #include <sys/time.h>
 #include <time.h>
 
 namespace JS::Bytecode {
 
+// A set of register indices. The accumulator is register 0, like everywhere else.
+using RegisterSet = HashTable<u32>;
+
 struct PassPipelineExecutable {
     Executable& executable;
     Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> cfg {};
     Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> inverted_cfg {};
     Optional<HashTable<BasicBlock const*>> exported_blocks {};
+    Optional<HashMap<BasicBlock const*, RegisterSet>> live_registers_at_exit {};
+    Optional<RegisterSet> always_live_registers {};
 };
 
 class Pass {
@@ -26,6 +34,8 @@ public:
     virtual ~Pass() = default;
 
     virtual void perform(PassPipelineExecutable&) = 0;
+    virtual StringView name() const = 0;
+
     void started()
     {
         gettimeofday(&m_start_time, nullptr);
@@ -44,15 +54,26 @@ public:
         }
         interval_us -= m_start_time.tv_usec;
         m_time_difference = interval_s * 1000000 + interval_us;
+        m_total_time += m_time_difference;
+        ++m_run_count;
     }
 
     u64 elapsed() const { return m_time_difference; }
 
+    // Statistics are accumulated over all the executables a pass has been run on.
+    u64 total_elapsed() const { return m_total_time; }
+    size_t run_count() const { return m_run_count; }
+    OrderedHashMap<StringView, u64> const& counters() const { return m_counters; }
+    void count(StringView counter, u64 amount = 1) { m_counters.ensure(counter) += amount; }
+
 protected:
     struct timeval m_start_time {
         0, 0
     };
     u64 m_time_difference { 0 };
+    u64 m_total_time { 0 };
+    size_t m_run_count { 0 };
+    OrderedHashMap<StringView, u64> m_counters;
 };
 
 class PassManager : public Pass {
@@ -79,17 +100,83 @@ public:
         finished();
     }
 
+    virtual StringView name() const override { return "PassManager"sv; }
+
+    void dump_statistics(FILE* file) const
+    {
+        outln(file, "Optimization pipeline ran {} times and took {}us:", run_count(), total_elapsed());
+        for (auto& pass : m_passes) {
+            StringBuilder builder;
+            builder.appendff("{:>20}: {}us", pass.name(), pass.total_elapsed());
+            for (auto& counter : pass.counters())
+                builder.appendff(", {} {}", counter.value, counter.key);
+            outln(file, "{}", builder.string_view());
+        }
+    }
+
 private:
     NonnullOwnPtrVector<Pass> m_passes;
 };
 
 namespace Passes {
 
+// Rebuilds a basic block out of the instructions a pass decides to keep, and new ones it emits in between.
+class BasicBlockRewriter {
+public:
+    explicit BasicBlockRewriter(BasicBlock& block)
+        : m_block(block)
+    {
+    }
+
+    void keep(Instruction const& instruction)
+    {
+        m_instruction_stream.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+    }
+
+    void drop(Instruction const& instruction)
+    {
+        Instruction::destroy(const_cast<Instruction&>(instruction));
+        m_did_change = true;
+    }
+
+    template<typename OpType, typename... Args>
+    void emit(Args&&... args)
+    {
+        auto offset = m_instruction_stream.size();
+        m_instruction_stream.resize(offset + sizeof(OpType));
+        new (m_instruction_stream.data() + offset) OpType(forward<Args>(args)...);
+        m_did_change = true;
+    }
+
+    // NOTE: The arguments may refer to the instruction being replaced, so it's only destroyed afterwards.
+    template<typename OpType, typename... Args>
+    void replace(Instruction const& instruction, Args&&... args)
+    {
+        emit<OpType>(forward<Args>(args)...);
+        drop(instruction);
+    }
+
+    bool did_change() const { return m_did_change; }
+
+    void finish()
+    {
+        if (m_did_change)
+            m_block.replace_instruction_stream(m_instruction_stream.span());
+    }
+
+private:
+    BasicBlock& m_block;
+    Vector<u8> m_instruction_stream;
+    bool m_did_change { false };
+};
+
 class GenerateCFG : public Pass {
 public:
     GenerateCFG() = default;
     ~GenerateCFG() override = default;
 
+    virtual StringView name() const override { return "GenerateCFG"sv; }
+
 private:
     virtual void perform(PassPipelineExecutable&) override;
 };
@@ -99,6 +186,8 @@ public:
     MergeBlocks() = default;
     ~MergeBlocks() override = default;
 
+    virtual StringView name() const override { return "MergeBlocks"sv; }
+
 private:
     virtual void perform(PassPipelineExecutable&) override;
 };
@@ -108,6 +197,8 @@ public:
     PlaceBlocks() = default;
     ~PlaceBlocks() override = default;
 
+    virtual StringView name() const override { return "PlaceBlocks"sv; }
+
 private:
     virtual void perform(PassPipelineExecutable&) override;
 };
@@ -117,6 +208,72 @@ public:
     UnifySameBlocks() = default;
     ~UnifySameBlocks() override = default;
 
+    virtual StringView name() const override { return "UnifySameBlocks"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Evaluates operations on constants at compile time and propagates constants stored in registers, within each basic block.
+// Conditional jumps on a constant become unconditional ones.
+class ConstantFolding : public Pass {
+public:
+    ConstantFolding() = default;
+    ~ConstantFolding() override = default;
+
+    virtual StringView name() const override { return "ConstantFolding"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Figures out which registers (and whether the accumulator) are live at the exit of each basic block. Requires the CFG.
+class GenerateLiveness : public Pass {
+public:
+    GenerateLiveness() = default;
+    ~GenerateLiveness() override = default;
+
+    virtual StringView name() const override { return "GenerateLiveness"sv; }
+
+    static void update_liveness_backwards(Instruction const&, RegisterSet& live_registers);
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Removes stores to registers, and loads into the accumulator, whose values are never read. Requires liveness.
+class EliminateDeadStores : public Pass {
+public:
+    EliminateDeadStores() = default;
+    ~EliminateDeadStores() override = default;
+
+    virtual StringView name() const override { return "EliminateDeadStores"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Renumbers the registers so that registers that are never live at the same time share a slot in the register window.
+// Requires liveness.
+class AllocateRegisters : public Pass {
+public:
+    AllocateRegisters() = default;
+    ~AllocateRegisters() override = default;
+
+    virtual StringView name() const override { return "AllocateRegisters"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Fuses common instruction pairs, e.g. a comparison followed by a JumpConditional, and removes redundant loads and stores.
+class Peephole : public Pass {
+public:
+    Peephole() = default;
+    ~Peephole() override = default;
+
+    virtual StringView name() const override { return "Peephole"sv; }
+
 private:
     virtual void perform(PassPipelineExecutable&) override;
 };
@@ -130,6 +287,8 @@ public:
 
     ~DumpCFG() override = default;
 
+    virtual StringView name() const override { return "DumpCFG"sv; }
+
 private:
     virtual void perform(PassPipelineExecutable&) override;
 
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Types.h>
+
+namespace JS::Bytecode {
+
+// Remembers where an instruction found a named property on objects of up to a few different shapes, so that the next
+// access to an object of one of those shapes can skip the property lookup. Shapes are told apart by their serial number
+// rather than their address, since the address of a shape may be reused for another one after garbage collection.
+struct PropertyLookupCache {
+    static constexpr size_t entry_count = 4;
+
+    struct Entry {
+        u64 shape_serial { 0 };
+        // Set if the property was found on the prototype of the object, rather than the object itself.
+        u64 prototype_shape_serial { 0 };
+        u32 offset { 0 };
+    };
+
+    void add(Entry const& entry)
+    {
+        entries[next_entry_to_replace] = entry;
+        next_entry_to_replace = (next_entry_to_replace + 1) % entry_count;
+    }
+
+    AK::Array<Entry, entry_count> entries;
+    u8 next_entry_to_replace { 0 };
+    // Arrays keep their "length" outside of their shape, and may share shapes with ordinary objects.
+    bool is_for_array_length { false };
+    u32 hits { 0 };
+    u32 misses { 0 };
+};
+
+}
@@ -0,0 +1,810 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/HashMap.h>
+#include <AK/MemoryStream.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Bytecode/Serialization.h>
+
+namespace JS::Bytecode {
+
+static constexpr u32 serialization_magic = 0x4342534a; // "JSBC"
+
+// NOTE: Instructions are stored by their Instruction::Type, so this has to change whenever ops are added, removed or
+//       reordered, and whenever the operands of an op change.
+static constexpr u32 serialization_version = 2;
+
+#define __BYTECODE_OP(op) +1
+static constexpr u8 instruction_type_count = 0 ENUMERATE_BYTECODE_OPS(__BYTECODE_OP);
+#undef __BYTECODE_OP
+
+enum class SerializedValueTag : u8 {
+    Empty,
+    Undefined,
+    Null,
+    Boolean,
+    Int32,
+    Double,
+};
+
+class ExecutableWriter {
+public:
+    ExecutableWriter(OutputStream& stream, Executable const& executable)
+        : m_stream(stream)
+        , m_executable(executable)
+    {
+    }
+
+    bool write();
+
+private:
+    void write_string(StringView string)
+    {
+        m_stream << static_cast<u32>(string.length());
+        m_stream << string.bytes();
+    }
+
+    void write_string_index(StringTableIndex index) { m_stream << static_cast<u32>(index.value()); }
+    void write_register(Register reg) { m_stream << reg.index(); }
+
+    void write_registers(Span<Register const> registers)
+    {
+        m_stream << static_cast<u32>(registers.size());
+        for (auto reg : registers)
+            write_register(reg);
+    }
+
+    void write_label(Label const& label) { m_stream << m_block_indices.get(&label.block()).value(); }
+
+    void write_optional_label(Optional<Label> const& label)
+    {
+        m_stream << static_cast<u8>(label.has_value());
+        if (label.has_value())
+            write_label(*label);
+    }
+
+    bool write_value(Value);
+    bool write_function(FunctionNode const&);
+    bool write_instruction(Instruction const&);
+
+    OutputStream& m_stream;
+    Executable const& m_executable;
+    HashMap<BasicBlock const*, u32> m_block_indices;
+    HashMap<FunctionNode const*, u32> m_function_indices;
+};
+
+bool ExecutableWriter::write()
+{
+    m_stream << static_cast<u32>(m_executable.number_of_registers);
+
+    auto& string_table = *m_executable.string_table;
+    m_stream << static_cast<u32>(string_table.size());
+    for (size_t i = 0; i < string_table.size(); ++i)
+        write_string(string_table.get(i));
+
+    // The functions come first, as the instructions that create them refer to them when they're read back.
+    Vector<FunctionNode const*> functions;
+    for (auto& block : m_executable.basic_blocks) {
+        m_block_indices.set(&block, m_block_indices.size());
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+            if ((*it).type() != Instruction::Type::NewFunction)
+                continue;
+            auto& function = static_cast<Op::NewFunction const&>(*it).function_node();
+            if (m_function_indices.contains(&function))
+                continue;
+            m_function_indices.set(&function, functions.size());
+            functions.append(&function);
+        }
+    }
+
+    m_stream << static_cast<u32>(functions.size());
+    for (auto* function : functions) {
+        if (!write_function(*function))
+            return false;
+    }
+
+    m_stream << static_cast<u32>(m_executable.basic_blocks.size());
+    for (auto& block : m_executable.basic_blocks)
+        write_string(block.name());
+    for (auto& block : m_executable.basic_blocks) {
+        u32 instruction_count = 0;
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it)
+            ++instruction_count;
+        m_stream << instruction_count;
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+            if (!write_instruction(*it))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool ExecutableWriter::write_value(Value value)
+{
+    if (value.is_empty()) {
+        m_stream << static_cast<u8>(SerializedValueTag::Empty);
+    } else if (value.is_undefined()) {
+        m_stream << static_cast<u8>(SerializedValueTag::Undefined);
+    } else if (value.is_null()) {
+        m_stream << static_cast<u8>(SerializedValueTag::Null);
+    } else if (value.is_boolean()) {
+        m_stream << static_cast<u8>(SerializedValueTag::Boolean);
+        m_stream << static_cast<u8>(value.as_bool());
+    } else if (value.is_int32()) {
+        m_stream << static_cast<u8>(SerializedValueTag::Int32);
+        m_stream << value.as_i32();
+    } else if (value.is_number()) {
+        m_stream << static_cast<u8>(SerializedValueTag::Double);
+        m_stream << value.as_double();
+    } else {
+        // Anything else lives on the heap.
+        return false;
+    }
+    return true;
+}
+
+bool ExecutableWriter::write_function(FunctionNode const& function)
+{
+    // FIXME: Default values and binding patterns need the parsed parameters, keep those functions in the AST world.
+    for (auto& parameter : function.parameters()) {
+        if (parameter.default_value || !parameter.binding.has<FlyString>())
+            return false;
+    }
+
+    // A body that failed to parse has nothing to serialize, and must throw when the function is called.
+    if (is<LazyFunctionBody>(function.body())) {
+        auto& lazy_body = static_cast<LazyFunctionBody const&>(function.body());
+        (void)lazy_body.parsed_body();
+        if (!lazy_body.parse_error().is_null())
+            return false;
+    }
+
+    write_string(function.name());
+    m_stream << static_cast<u8>(function.kind());
+    m_stream << static_cast<u8>(function.is_strict_mode());
+    m_stream << static_cast<u8>(function.is_arrow_function());
+    m_stream << function.function_length();
+
+    m_stream << static_cast<u32>(function.parameters().size());
+    for (auto& parameter : function.parameters()) {
+        write_string(parameter.binding.get<FlyString>());
+        m_stream << static_cast<u8>(parameter.is_rest);
+    }
+
+    // These are what OrdinaryFunctionObject::create_environment() creates bindings for.
+    struct Binding {
+        FlyString name;
+        DeclarationKind declaration_kind;
+    };
+    Vector<Binding> bindings;
+    if (is<ScopeNode>(function.parsed_body())) {
+        for (auto& declaration : static_cast<ScopeNode const&>(function.parsed_body()).variables()) {
+            for (auto& declarator : declaration.declarations()) {
+                declarator.target().visit(
+                    [&](NonnullRefPtr<Identifier> const& id) {
+                        bindings.append({ id->string(), declaration.declaration_kind() });
+                    },
+                    [&](NonnullRefPtr<BindingPattern> const& binding) {
+                        binding->for_each_bound_name([&](auto const& name) {
+                            bindings.append({ name, declaration.declaration_kind() });
+                        });
+                    });
+            }
+        }
+    }
+    m_stream << static_cast<u32>(bindings.size());
+    for (auto& binding : bindings) {
+        write_string(binding.name);
+        m_stream << static_cast<u8>(binding.declaration_kind);
+    }
+
+    // NOTE: Without the cache, functions are only compiled when they're first called. Functions that are never called
+    //       may well use something the generator doesn't support yet, so that must not bring us down here.
+    auto executable = Generator::try_generate(function.parsed_body(), function.kind() == FunctionKind::Generator, function.parameters());
+    if (!executable.has_value())
+        return false;
+    // Do the same to the function that compiling it on its first call would.
+    if (Interpreter::optimizations_enabled())
+        Interpreter::optimization_pipeline().perform(*executable);
+
+    // The body is stored on its own, so it can be deserialized when the function is first called.
+    auto serialized_executable = serialize_executable(*executable);
+    if (!serialized_executable.has_value())
+        return false;
+    m_stream << static_cast<u32>(serialized_executable->size());
+    m_stream << serialized_executable->bytes();
+    return true;
+}
+
+bool ExecutableWriter::write_instruction(Instruction const& instruction)
+{
+    m_stream << static_cast<u8>(instruction.type());
+
+    switch (instruction.type()) {
+    case Instruction::Type::Load:
+        write_register(static_cast<Op::Load const&>(instruction).src());
+        return true;
+    case Instruction::Type::LoadImmediate:
+        return write_value(static_cast<Op::LoadImmediate const&>(instruction).value());
+    case Instruction::Type::Store:
+        write_register(static_cast<Op::Store const&>(instruction).dst());
+        return true;
+#define __BYTECODE_OP(OpTitleCase, op_snake_case)                                   \
+    case Instruction::Type::OpTitleCase:                                            \
+        write_register(static_cast<Op::OpTitleCase const&>(instruction).lhs());     \
+        return true;
+        JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:
+        JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    case Instruction::Type::NewObject:
+    case Instruction::Type::IteratorToArray:
+    case Instruction::Type::Return:
+    case Instruction::Type::Increment:
+    case Instruction::Type::Decrement:
+    case Instruction::Type::Throw:
+    case Instruction::Type::LeaveUnwindContext:
+    case Instruction::Type::GetIterator:
+    case Instruction::Type::IteratorNext:
+    case Instruction::Type::IteratorResultDone:
+    case Instruction::Type::IteratorResultValue:
+        return true;
+    case Instruction::Type::NewString:
+        write_string_index(static_cast<Op::NewString const&>(instruction).index());
+        return true;
+    case Instruction::Type::NewRegExp: {
+        auto& new_regexp = static_cast<Op::NewRegExp const&>(instruction);
+        write_string_index(new_regexp.source_index());
+        write_string_index(new_regexp.flags_index());
+        return true;
+    }
+    case Instruction::Type::CopyObjectExcludingProperties: {
+        auto& copy = static_cast<Op::CopyObjectExcludingProperties const&>(instruction);
+        write_register(copy.from_object());
+        write_registers(copy.excluded_names());
+        return true;
+    }
+    case Instruction::Type::NewBigInt:
+        write_string(static_cast<Op::NewBigInt const&>(instruction).bigint().to_base(10));
+        return true;
+    case Instruction::Type::NewArray:
+        write_registers(static_cast<Op::NewArray const&>(instruction).elements());
+        return true;
+    case Instruction::Type::ConcatString:
+        write_register(static_cast<Op::ConcatString const&>(instruction).lhs());
+        return true;
+    case Instruction::Type::GetVariable:
+        write_string_index(static_cast<Op::GetVariable const&>(instruction).identifier());
+        return true;
+    case Instruction::Type::SetVariable: {
+        auto& set = static_cast<Op::SetVariable const&>(instruction);
+        write_string_index(set.identifier());
+        m_stream << static_cast<u8>(set.initialization_mode());
+        return true;
+    }
+    case Instruction::Type::GetById:
+        write_string_index(static_cast<Op::GetById const&>(instruction).property());
+        return true;
+    case Instruction::Type::PutById: {
+        auto& put = static_cast<Op::PutById const&>(instruction);
+        write_register(put.base());
+        write_string_index(put.property());
+        return true;
+    }
+    case Instruction::Type::GetByValue:
+        write_register(static_cast<Op::GetByValue const&>(instruction).base());
+        return true;
+    case Instruction::Type::PutByValue: {
+        auto& put = static_cast<Op::PutByValue const&>(instruction);
+        write_register(put.base());
+        write_register(put.property());
+        return true;
+    }
+    case Instruction::Type::Jump:
+    case Instruction::Type::JumpConditional:
+    case Instruction::Type::JumpNullish:
+    case Instruction::Type::JumpUndefined: {
+        auto& jump = static_cast<Op::Jump const&>(instruction);
+        write_optional_label(jump.true_target());
+        write_optional_label(jump.false_target());
+        return true;
+    }
+#define __BYTECODE_OP(OpTitleCase, op_snake_case)                                       \
+    case Instruction::Type::Jump##OpTitleCase: {                                        \
+        auto& jump = static_cast<Op::Jump##OpTitleCase const&>(instruction);            \
+        write_register(jump.lhs());                                                     \
+        write_optional_label(jump.true_target());                                       \
+        write_optional_label(jump.false_target());                                      \
+        return true;                                                                    \
+    }
+        JS_ENUMERATE_FUSED_COMPARISON_JUMPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    case Instruction::Type::Call: {
+        auto& call = static_cast<Op::Call const&>(instruction);
+        m_stream << static_cast<u8>(call.call_type());
+        write_register(call.callee());
+        write_register(call.this_value());
+        write_registers(call.arguments());
+        return true;
+    }
+    case Instruction::Type::NewFunction:
+        m_stream << m_function_indices.get(&static_cast<Op::NewFunction const&>(instruction).function_node()).value();
+        return true;
+    case Instruction::Type::PushDeclarativeEnvironment: {
+        auto& variables = static_cast<Op::PushDeclarativeEnvironment const&>(instruction).variables();
+        m_stream << static_cast<u32>(variables.size());
+        for (auto& it : variables) {
+            m_stream << it.key;
+            if (!write_value(it.value.value))
+                return false;
+            m_stream << static_cast<u8>(it.value.declaration_kind);
+        }
+        return true;
+    }
+    case Instruction::Type::EnterUnwindContext: {
+        auto& enter = static_cast<Op::EnterUnwindContext const&>(instruction);
+        write_label(enter.entry_point());
+        write_optional_label(enter.handler_target());
+        write_optional_label(enter.finalizer_target());
+        return true;
+    }
+    case Instruction::Type::ContinuePendingUnwind:
+        write_label(static_cast<Op::ContinuePendingUnwind const&>(instruction).resume_target());
+        return true;
+    case Instruction::Type::Yield:
+        write_optional_label(static_cast<Op::Yield const&>(instruction).continuation());
+        return true;
+    case Instruction::Type::NewClass:
+        // FIXME: Classes are still created from their AST node.
+        return false;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+class ExecutableReader {
+public:
+    explicit ExecutableReader(InputMemoryStream& stream)
+        : m_stream(stream)
+    {
+    }
+
+    Optional<Executable> read();
+
+private:
+    bool has_failed() const { return m_stream.has_any_error(); }
+    void fail() { m_stream.set_recoverable_error(); }
+
+    template<typename T>
+    T read_integer()
+    {
+        T value {};
+        m_stream >> value;
+        return value;
+    }
+
+    template<typename T>
+    T read_enum(T last_value)
+    {
+        auto value = read_integer<u8>();
+        if (value > static_cast<u8>(last_value)) {
+            fail();
+            return {};
+        }
+        return static_cast<T>(value);
+    }
+
+    String read_string();
+    StringTableIndex read_string_index();
+    Register read_register();
+    Vector<Register> read_registers();
+    Label read_label();
+    Optional<Label> read_optional_label();
+    Value read_value();
+    void read_function();
+    void read_instruction(ByteBuffer&);
+
+    template<typename OpType, typename... Args>
+    void append_with_extra_register_slots(ByteBuffer& instructions, size_t extra_register_slots, Args&&... args)
+    {
+        auto offset = instructions.size();
+        instructions.resize(offset + sizeof(OpType) + extra_register_slots * sizeof(Register));
+        new (instructions.data() + offset) OpType(forward<Args>(args)...);
+    }
+
+    template<typename OpType, typename... Args>
+    void append(ByteBuffer& instructions, Args&&... args)
+    {
+        append_with_extra_register_slots<OpType>(instructions, 0, forward<Args>(args)...);
+    }
+
+    InputMemoryStream& m_stream;
+    u32 m_number_of_registers { 0 };
+    NonnullOwnPtr<StringTable> m_string_table { make<StringTable>() };
+    NonnullOwnPtrVector<BasicBlock> m_blocks;
+    NonnullRefPtrVector<FunctionExpression> m_functions;
+};
+
+Optional<Executable> ExecutableReader::read()
+{
+    m_number_of_registers = read_integer<u32>();
+    if (m_number_of_registers <= Register::global_object_index)
+        fail();
+
+    auto string_count = read_integer<u32>();
+    for (u32 i = 0; i < string_count && !has_failed(); ++i)
+        m_string_table->insert(read_string());
+
+    auto function_count = read_integer<u32>();
+    for (u32 i = 0; i < function_count && !has_failed(); ++i)
+        read_function();
+
+    // Create all the blocks up front, so jumps can refer to the ones that come later.
+    auto block_count = read_integer<u32>();
+    if (has_failed() || block_count == 0 || block_count > m_stream.remaining()) {
+        fail();
+        return {};
+    }
+    for (u32 i = 0; i < block_count && !has_failed(); ++i)
+        m_blocks.append(BasicBlock::create(read_string()));
+
+    for (auto& block : m_blocks) {
+        if (has_failed())
+            return {};
+        ByteBuffer instructions;
+        auto instruction_count = read_integer<u32>();
+        for (u32 i = 0; i < instruction_count && !has_failed(); ++i)
+            read_instruction(instructions);
+        // NOTE: The instructions are moved into the block, which takes care of destroying them from now on.
+        block.replace_instruction_stream(instructions);
+    }
+
+    if (has_failed())
+        return {};
+
+    Executable executable { move(m_blocks), move(m_string_table), m_number_of_registers };
+    executable.function_nodes = move(m_functions);
+    return executable;
+}
+
+String ExecutableReader::read_string()
+{
+    auto length = read_integer<u32>();
+    if (has_failed() || length > m_stream.remaining()) {
+        fail();
+        return {};
+    }
+    auto bytes = ByteBuffer::create_uninitialized(length);
+    m_stream >> bytes.bytes();
+    return String { ReadonlyBytes { bytes.bytes() } };
+}
+
+StringTableIndex ExecutableReader::read_string_index()
+{
+    auto index = read_integer<u32>();
+    if (index >= m_string_table->size()) {
+        fail();
+        return 0;
+    }
+    return index;
+}
+
+Register ExecutableReader::read_register()
+{
+    auto index = read_integer<u32>();
+    if (index >= m_number_of_registers) {
+        fail();
+        return Register::accumulator();
+    }
+    return Register(index);
+}
+
+Vector<Register> ExecutableReader::read_registers()
+{
+    auto count = read_integer<u32>();
+    if (count > m_stream.remaining() / sizeof(u32)) {
+        fail();
+        return {};
+    }
+    Vector<Register> registers;
+    registers.ensure_capacity(count);
+    for (u32 i = 0; i < count; ++i)
+        registers.unchecked_append(read_register());
+    return registers;
+}
+
+Label ExecutableReader::read_label()
+{
+    auto index = read_integer<u32>();
+    if (index >= m_blocks.size()) {
+        fail();
+        return Label { m_blocks.first() };
+    }
+    return Label { m_blocks[index] };
+}
+
+Optional<Label> ExecutableReader::read_optional_label()
+{
+    if (!read_integer<u8>())
+        return {};
+    return read_label();
+}
+
+Value ExecutableReader::read_value()
+{
+    switch (read_enum(SerializedValueTag::Double)) {
+    case SerializedValueTag::Empty:
+        return {};
+    case SerializedValueTag::Undefined:
+        return js_undefined();
+    case SerializedValueTag::Null:
+        return js_null();
+    case SerializedValueTag::Boolean:
+        return Value(read_integer<u8>() != 0);
+    case SerializedValueTag::Int32:
+        return Value(read_integer<i32>());
+    case SerializedValueTag::Double:
+        return Value(read_integer<double>());
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void ExecutableReader::read_function()
+{
+    auto name = read_string();
+    auto kind = read_enum(FunctionKind::Regular);
+    auto is_strict_mode = read_integer<u8>() != 0;
+    auto is_arrow_function = read_integer<u8>() != 0;
+    auto function_length = read_integer<i32>();
+
+    auto parameter_count = read_integer<u32>();
+    Vector<FunctionNode::Parameter> parameters;
+    for (u32 i = 0; i < parameter_count && !has_failed(); ++i) {
+        auto parameter_name = read_string();
+        auto is_rest = read_integer<u8>() != 0;
+        parameters.append({ FlyString { parameter_name }, {}, is_rest });
+    }
+
+    auto variable_count = read_integer<u32>();
+    NonnullRefPtrVector<VariableDeclaration> variables;
+    for (u32 i = 0; i < variable_count && !has_failed(); ++i) {
+        auto variable_name = read_string();
+        auto declaration_kind = read_enum(DeclarationKind::Const);
+        NonnullRefPtrVector<VariableDeclarator> declarators;
+        declarators.append(create_ast_node<VariableDeclarator>({}, create_ast_node<Identifier>({}, variable_name)));
+        variables.append(create_ast_node<VariableDeclaration>({}, declaration_kind, move(declarators)));
+    }
+
+    auto serialized_executable_size = read_integer<u32>();
+    if (has_failed() || serialized_executable_size > m_stream.remaining()) {
+        fail();
+        return;
+    }
+    auto serialized_executable = ByteBuffer::create_uninitialized(serialized_executable_size);
+    m_stream >> serialized_executable.bytes();
+
+    auto body = create_ast_node<PrecompiledFunctionBody>({}, move(serialized_executable));
+    body->add_variables(move(variables));
+    m_functions.append(create_ast_node<FunctionExpression>({}, name, move(body), move(parameters), function_length, kind, is_strict_mode, is_arrow_function));
+}
+
+void ExecutableReader::read_instruction(ByteBuffer& instructions)
+{
+    auto type = read_enum(static_cast<Instruction::Type>(instruction_type_count - 1));
+    if (has_failed())
+        return;
+
+    switch (type) {
+    case Instruction::Type::Load:
+        append<Op::Load>(instructions, read_register());
+        return;
+    case Instruction::Type::LoadImmediate:
+        append<Op::LoadImmediate>(instructions, read_value());
+        return;
+    case Instruction::Type::Store:
+        append<Op::Store>(instructions, read_register());
+        return;
+#define __BYTECODE_OP(OpTitleCase, op_snake_case)                     \
+    case Instruction::Type::OpTitleCase:                              \
+        append<Op::OpTitleCase>(instructions, read_register());       \
+        return;
+        JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:          \
+        append<Op::OpTitleCase>(instructions);    \
+        return;
+        JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(OpTitleCase)             \
+    case Instruction::Type::OpTitleCase:       \
+        append<Op::OpTitleCase>(instructions); \
+        return;
+        __BYTECODE_OP(NewObject)
+        __BYTECODE_OP(IteratorToArray)
+        __BYTECODE_OP(Return)
+        __BYTECODE_OP(Increment)
+        __BYTECODE_OP(Decrement)
+        __BYTECODE_OP(Throw)
+        __BYTECODE_OP(LeaveUnwindContext)
+        __BYTECODE_OP(GetIterator)
+        __BYTECODE_OP(IteratorNext)
+        __BYTECODE_OP(IteratorResultDone)
+        __BYTECODE_OP(IteratorResultValue)
+#undef __BYTECODE_OP
+    case Instruction::Type::NewString:
+        append<Op::NewString>(instructions, read_string_index());
+        return;
+    case Instruction::Type::NewRegExp: {
+        auto source_index = read_string_index();
+        auto flags_index = read_string_index();
+        append<Op::NewRegExp>(instructions, source_index, flags_index);
+        return;
+    }
+    case Instruction::Type::CopyObjectExcludingProperties: {
+        auto from_object = read_register();
+        auto excluded_names = read_registers();
+        append_with_extra_register_slots<Op::CopyObjectExcludingProperties>(instructions, excluded_names.size(), from_object, excluded_names);
+        return;
+    }
+    case Instruction::Type::NewBigInt: {
+        auto digits = read_string();
+        // NOTE: from_base() asserts that it's given valid digits.
+        auto unsigned_digits = digits.starts_with('-') ? digits.substring_view(1) : digits.view();
+        if (unsigned_digits.is_empty()) {
+            fail();
+            return;
+        }
+        for (auto ch : unsigned_digits) {
+            if (!is_ascii_digit(ch)) {
+                fail();
+                return;
+            }
+        }
+        append<Op::NewBigInt>(instructions, Crypto::SignedBigInteger::from_base(10, digits));
+        return;
+    }
+    case Instruction::Type::NewArray: {
+        auto elements = read_registers();
+        append_with_extra_register_slots<Op::NewArray>(instructions, elements.size(), elements);
+        return;
+    }
+    case Instruction::Type::ConcatString:
+        append<Op::ConcatString>(instructions, read_register());
+        return;
+    case Instruction::Type::GetVariable:
+        append<Op::GetVariable>(instructions, read_string_index());
+        return;
+    case Instruction::Type::SetVariable: {
+        auto identifier = read_string_index();
+        auto initialization_mode = read_enum(Op::SetVariable::InitializationMode::Initialize);
+        append<Op::SetVariable>(instructions, identifier, initialization_mode);
+        return;
+    }
+    case Instruction::Type::GetById:
+        append<Op::GetById>(instructions, read_string_index());
+        return;
+    case Instruction::Type::PutById: {
+        auto base = read_register();
+        auto property = read_string_index();
+        append<Op::PutById>(instructions, base, property);
+        return;
+    }
+    case Instruction::Type::GetByValue:
+        append<Op::GetByValue>(instructions, read_register());
+        return;
+    case Instruction::Type::PutByValue: {
+        auto base = read_register();
+        auto property = read_register();
+        append<Op::PutByValue>(instructions, base, property);
+        return;
+    }
+#define __BYTECODE_OP(OpTitleCase)                                               \
+    case Instruction::Type::OpTitleCase: {                                       \
+        auto true_target = read_optional_label();                                \
+        auto false_target = read_optional_label();                               \
+        append<Op::OpTitleCase>(instructions, move(true_target), move(false_target)); \
+        return;                                                                  \
+    }
+        __BYTECODE_OP(Jump)
+        __BYTECODE_OP(JumpConditional)
+        __BYTECODE_OP(JumpNullish)
+        __BYTECODE_OP(JumpUndefined)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(OpTitleCase, op_snake_case)                                                \
+    case Instruction::Type::Jump##OpTitleCase: {                                                 \
+        auto lhs = read_register();                                                              \
+        auto true_target = read_optional_label();                                                \
+        auto false_target = read_optional_label();                                               \
+        append<Op::Jump##OpTitleCase>(instructions, lhs, move(true_target), move(false_target)); \
+        return;                                                                                  \
+    }
+        JS_ENUMERATE_FUSED_COMPARISON_JUMPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    case Instruction::Type::Call: {
+        auto call_type = read_enum(Op::Call::CallType::Construct);
+        auto callee = read_register();
+        auto this_value = read_register();
+        auto arguments = read_registers();
+        append_with_extra_register_slots<Op::Call>(instructions, arguments.size(), call_type, callee, this_value, arguments);
+        return;
+    }
+    case Instruction::Type::NewFunction: {
+        auto index = read_integer<u32>();
+        if (index >= m_functions.size()) {
+            fail();
+            return;
+        }
+        append<Op::NewFunction>(instructions, m_functions[index]);
+        return;
+    }
+    case Instruction::Type::PushDeclarativeEnvironment: {
+        auto count = read_integer<u32>();
+        HashMap<u32, Variable> variables;
+        for (u32 i = 0; i < count && !has_failed(); ++i) {
+            auto index = read_string_index();
+            auto value = read_value();
+            auto declaration_kind = read_enum(DeclarationKind::Const);
+            variables.set(index.value(), { value, declaration_kind });
+        }
+        append<Op::PushDeclarativeEnvironment>(instructions, move(variables));
+        return;
+    }
+    case Instruction::Type::EnterUnwindContext: {
+        auto entry_point = read_label();
+        auto handler_target = read_optional_label();
+        auto finalizer_target = read_optional_label();
+        append<Op::EnterUnwindContext>(instructions, move(entry_point), move(handler_target), move(finalizer_target));
+        return;
+    }
+    case Instruction::Type::ContinuePendingUnwind:
+        append<Op::ContinuePendingUnwind>(instructions, read_label());
+        return;
+    case Instruction::Type::Yield:
+        if (auto continuation = read_optional_label(); continuation.has_value())
+            append<Op::Yield>(instructions, continuation.release_value());
+        else
+            append<Op::Yield>(instructions, nullptr);
+        return;
+    case Instruction::Type::NewClass:
+        fail();
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+Optional<ByteBuffer> serialize_executable(Executable const& executable)
+{
+    DuplexMemoryStream stream;
+    stream << serialization_magic;
+    stream << serialization_version;
+    if (!ExecutableWriter { stream, executable }.write())
+        return {};
+    return stream.copy_into_contiguous_buffer();
+}
+
+Optional<Executable> deserialize_executable(ReadonlyBytes bytes)
+{
+    InputMemoryStream stream { bytes };
+    u32 magic = 0;
+    u32 version = 0;
+    stream >> magic;
+    stream >> version;
+
+    Optional<Executable> executable;
+    if (!stream.has_any_error() && magic == serialization_magic && version == serialization_version)
+        executable = ExecutableReader { stream }.read();
+
+    if (stream.handle_any_error() || !stream.eof())
+        return {};
+    return executable;
+}
+
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <LibJS/Bytecode/Generator.h>
+
+namespace JS::Bytecode {
+
+// Turns an executable into bytes that can be stored on disk, and back. The functions that the executable creates are
+// compiled and serialized along with it, so the result can be run without parsing the source again.
+// Returns an empty Optional if the executable contains something that can't be serialized (e.g. a class).
+Optional<ByteBuffer> serialize_executable(Executable const&);
+
+// Returns an empty Optional if the data is malformed or was produced by an incompatible version.
+// NOTE: The bodies of the functions are only deserialized when they're first called, see PrecompiledFunctionBody.
+Optional<Executable> deserialize_executable(ReadonlyBytes);
+
+}
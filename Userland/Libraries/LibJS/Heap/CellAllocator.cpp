@@ -5,6 +5,7 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/Debug.h>
 #include <LibJS/Heap/BlockAllocator.h>
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Heap/Heap.h>
@@ -23,10 +24,8 @@ CellAllocator::~CellAllocator()
 
 Cell* CellAllocator::allocate_cell(Heap& heap)
 {
-    if (m_usable_blocks.is_empty()) {
-        auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
-        m_usable_blocks.append(*block.leak_ptr());
-    }
+    if (m_usable_blocks.is_empty())
+        find_or_create_usable_block(heap);
 
     auto& block = *m_usable_blocks.last();
     auto* cell = block.allocate();
@@ -36,19 +35,54 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     return cell;
 }
 
-void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
+NEVER_INLINE void CellAllocator::find_or_create_usable_block(Heap& heap)
 {
-    auto& heap = block.heap();
-    block.m_list_node.remove();
-    // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
-    block.~HeapBlock();
-    heap.block_allocator().deallocate_block(&block);
+    // Blocks left over from the last collection are swept one at a time, until one of them has room for a new cell.
+    while (m_usable_blocks.is_empty() && !m_blocks_awaiting_sweep.is_empty())
+        sweep_block(heap, *m_blocks_awaiting_sweep.first(), false);
+
+    if (m_usable_blocks.is_empty()) {
+        auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
+        m_usable_blocks.append(*block.leak_ptr());
+    }
 }
 
-void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
+void CellAllocator::did_finish_marking(Badge<Heap>)
 {
-    VERIFY(!block.is_full());
-    m_usable_blocks.append(block);
+    auto move_to_blocks_awaiting_sweep = [&](BlockList& list) {
+        while (auto* block = list.take_first()) {
+            block->set_awaiting_sweep(true);
+            m_blocks_awaiting_sweep.append(*block);
+        }
+    };
+    move_to_blocks_awaiting_sweep(m_full_blocks);
+    move_to_blocks_awaiting_sweep(m_usable_blocks);
+}
+
+void CellAllocator::sweep_remaining_blocks(Badge<Heap>, Heap& heap)
+{
+    while (!m_blocks_awaiting_sweep.is_empty())
+        sweep_block(heap, *m_blocks_awaiting_sweep.first(), true);
+}
+
+void CellAllocator::sweep_block(Heap& heap, HeapBlock& block, bool release_if_empty)
+{
+    block.m_list_node.remove();
+    block.set_awaiting_sweep(false);
+    bool block_has_live_cells = heap.sweep_block({}, block);
+
+    if (!block_has_live_cells && release_if_empty) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", &block, block.cell_size());
+        // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
+        block.~HeapBlock();
+        heap.block_allocator().deallocate_block(&block);
+        return;
+    }
+
+    if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
 }
 
 }
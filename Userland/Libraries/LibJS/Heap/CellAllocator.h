@@ -34,18 +34,27 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_blocks_awaiting_sweep) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
-    void block_did_become_empty(Badge<Heap>, HeapBlock&);
-    void block_did_become_usable(Badge<Heap>, HeapBlock&);
+    // Once marking is done, every block waits to be swept until we need room for new cells in it.
+    void did_finish_marking(Badge<Heap>);
+    void sweep_remaining_blocks(Badge<Heap>, Heap&);
 
 private:
+    void find_or_create_usable_block(Heap&);
+    void sweep_block(Heap&, HeapBlock&, bool release_if_empty);
+
     const size_t m_cell_size;
 
     typedef IntrusiveList<HeapBlock, RawPtr<HeapBlock>, &HeapBlock::m_list_node> BlockList;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+    BlockList m_blocks_awaiting_sweep;
 };
 
 }
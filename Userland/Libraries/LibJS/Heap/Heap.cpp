@@ -9,7 +9,7 @@
 #include <AK/HashTable.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
-#include <LibCore/ElapsedTimer.h>
+#include <AK/Time.h>
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
@@ -18,6 +18,7 @@
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/WeakContainer.h>
 #include <setjmp.h>
+#include <time.h>
 
 namespace JS {
 
@@ -64,7 +65,16 @@ Cell* Heap::allocate_cell(size_t size)
     }
 
     auto& allocator = allocator_for_size(size);
-    return allocator.allocate_cell(*this);
+    auto* cell = allocator.allocate_cell(*this);
+    ++m_live_cell_count;
+    return cell;
+}
+
+static Time now()
+{
+    timespec now_spec;
+    clock_gettime(CLOCK_MONOTONIC, &now_spec);
+    return Time::from_timespec(now_spec);
 }
 
 void Heap::collect_garbage(CollectionType collection_type, bool print_report)
@@ -72,18 +82,79 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     VERIFY(!m_collecting_garbage);
     TemporaryChange change(m_collecting_garbage, true);
 
-    Core::ElapsedTimer collection_measurement_timer;
-    collection_measurement_timer.start();
+    if (collection_type == CollectionType::CollectGarbage && m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    auto start_time = now();
+
+    // Whatever the last collection left for lazy sweeping has to go before we can mark again.
+    finish_sweeping();
+
+    m_statistics.cells_before_last_collection = m_live_cell_count;
+    m_collected_cell_count = 0;
+    m_collected_cell_bytes = 0;
+
+    size_t live_cells = 0;
     if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
-        }
         HashTable<Cell*> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        live_cells = mark_live_cells(roots);
+        remove_dead_cells_from_weak_containers();
+    }
+
+    size_t block_count_before_sweep = 0;
+    if (print_report) {
+        for_each_block([&](auto&) {
+            ++block_count_before_sweep;
+            return IterationDecision::Continue;
+        });
     }
-    sweep_dead_cells(print_report, collection_measurement_timer);
+
+    for (auto& allocator : m_allocators)
+        allocator->did_finish_marking({});
+
+    m_statistics.cells_surviving_last_collection = live_cells;
+    m_max_allocations_between_gc = max(min_allocations_between_gc, live_cells);
+
+    // When tearing down the heap everything has to go now, and a report should describe the whole collection.
+    if (collection_type == CollectionType::CollectEverything || print_report)
+        finish_sweeping();
+
+    auto pause_time = (now() - start_time).to_microseconds();
+    ++m_statistics.collection_count;
+    m_statistics.last_pause_in_microseconds = pause_time;
+    m_statistics.longest_pause_in_microseconds = max(m_statistics.longest_pause_in_microseconds, pause_time);
+    m_statistics.total_pause_in_microseconds += pause_time;
+
+    if (print_report)
+        dump_report(block_count_before_sweep);
+}
+
+// This is kept out of line so that collect_garbage() has a small stack frame, with fewer stale values in it that
+// gather_conservative_roots() could mistake for live pointers.
+NEVER_INLINE void Heap::dump_report(size_t block_count_before_sweep)
+{
+    size_t live_block_count = 0;
+    for_each_block([&](auto&) {
+        ++live_block_count;
+        return IterationDecision::Continue;
+    });
+    size_t freed_block_count = block_count_before_sweep - live_block_count;
+    auto live_cells = m_statistics.cells_surviving_last_collection;
+    auto survival_percentage = m_statistics.cells_before_last_collection ? live_cells * 100 / m_statistics.cells_before_last_collection : 0;
+
+    dbgln("Garbage collection report");
+    dbgln("=============================================");
+    dbgln("     Time spent: {} ms", m_statistics.last_pause_in_microseconds / 1000);
+    dbgln("     Live cells: {} ({}% survived)", live_cells, survival_percentage);
+    dbgln("Collected cells: {} ({} bytes)", m_collected_cell_count, m_collected_cell_bytes);
+    dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
+    dbgln("   Freed blocks: {} ({} bytes)", freed_block_count, freed_block_count * HeapBlock::block_size);
+    dbgln("    Collections: {} (longest pause {} us, total {} us)", m_statistics.collection_count, m_statistics.longest_pause_in_microseconds, m_statistics.total_pause_in_microseconds);
+    dbgln("  Lazy sweeping: {} us", m_statistics.total_lazy_sweep_time_in_microseconds);
+    dbgln("=============================================");
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -119,17 +190,26 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
     HashTable<FlatPtr> possible_pointers;
 
+    auto add_possible_value = [&](FlatPtr data) {
+        possible_pointers.set(data);
+        if constexpr (sizeof(FlatPtr) == sizeof(u64)) {
+            // A JS::Value holding a cell keeps the pointer in its low bits, with the tag on top.
+            if ((static_cast<u64>(data) & SHIFTED_IS_CELL_PATTERN) == SHIFTED_IS_CELL_PATTERN)
+                possible_pointers.set(static_cast<FlatPtr>(data & PAYLOAD_MASK));
+        }
+    };
+
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
-    for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); i += sizeof(FlatPtr))
-        possible_pointers.set(raw_jmp_buf[i]);
+    for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
+        add_possible_value(raw_jmp_buf[i]);
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
     auto& stack_info = m_vm.stack_info();
 
     for (FlatPtr stack_address = stack_reference; stack_address < stack_info.top(); stack_address += sizeof(FlatPtr)) {
         auto data = *reinterpret_cast<FlatPtr*>(stack_address);
-        possible_pointers.set(data);
+        add_possible_value(data);
     }
 
     HashTable<HeapBlock*> all_live_heap_blocks;
@@ -156,6 +236,9 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
     }
 }
 
+// Cells are marked as soon as we find them, but their edges are only visited once they come off the work queue.
+// Visiting edges right away would recurse as deep as the object graph, which long linked lists easily make deeper than
+// the stack.
 class MarkingVisitor final : public Cell::Visitor {
 public:
     MarkingVisitor() { }
@@ -166,68 +249,38 @@ public:
             return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
         cell.set_marked(true);
-        cell.visit_edges(*this);
+        ++m_marked_cell_count;
+        m_work_queue.append(&cell);
     }
+
+    void mark_all_reachable_cells()
+    {
+        while (!m_work_queue.is_empty())
+            m_work_queue.take_last()->visit_edges(*this);
+    }
+
+    size_t marked_cell_count() const { return m_marked_cell_count; }
+
+private:
+    Vector<Cell*> m_work_queue;
+    size_t m_marked_cell_count { 0 };
 };
 
-void Heap::mark_live_cells(const HashTable<Cell*>& roots)
+size_t Heap::mark_live_cells(const HashTable<Cell*>& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
     MarkingVisitor visitor;
     for (auto* root : roots)
         visitor.visit(root);
+    visitor.mark_all_reachable_cells();
+    return visitor.marked_cell_count();
 }
 
-void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measurement_timer)
+void Heap::finish_sweeping()
 {
-    dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
-    Vector<HeapBlock*, 32> empty_blocks;
-    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
-    Vector<Cell*> swept_cells;
-
-    size_t collected_cells = 0;
-    size_t live_cells = 0;
-    size_t collected_cell_bytes = 0;
-    size_t live_cell_bytes = 0;
-
-    auto should_store_swept_cells = !m_weak_containers.is_empty();
-    for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked()) {
-                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                if (should_store_swept_cells)
-                    swept_cells.append(cell);
-                block.deallocate(cell);
-                ++collected_cells;
-                collected_cell_bytes += block.cell_size();
-            } else {
-                cell->set_marked(false);
-                block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
-            }
-        });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
-        return IterationDecision::Continue;
-    });
-
-    for (auto* block : empty_blocks) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
-        allocator_for_size(block->cell_size()).block_did_become_empty({}, *block);
-    }
-
-    for (auto* block : full_blocks_that_became_usable) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
-        allocator_for_size(block->cell_size()).block_did_become_usable({}, *block);
-    }
-
-    for (auto* weak_container : m_weak_containers)
-        weak_container->remove_swept_cells({}, swept_cells);
+    dbgln_if(HEAP_DEBUG, "finish_sweeping:");
+    for (auto& allocator : m_allocators)
+        allocator->sweep_remaining_blocks({}, *this);
 
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
@@ -235,25 +288,34 @@ void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measure
             return IterationDecision::Continue;
         });
     }
+}
 
-    int time_spent = measurement_timer.elapsed();
-
-    if (print_report) {
-        size_t live_block_count = 0;
-        for_each_block([&](auto&) {
-            ++live_block_count;
-            return IterationDecision::Continue;
-        });
+bool Heap::sweep_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    auto start_time = now();
+    bool block_has_live_cells = false;
+    block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+        if (!cell->is_marked()) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            block.deallocate(cell);
+            --m_live_cell_count;
+            ++m_collected_cell_count;
+            m_collected_cell_bytes += block.cell_size();
+        } else {
+            cell->set_marked(false);
+            block_has_live_cells = true;
+        }
+    });
+    if (!m_collecting_garbage)
+        m_statistics.total_lazy_sweep_time_in_microseconds += (now() - start_time).to_microseconds();
+    return block_has_live_cells;
+}
 
-        dbgln("Garbage collection report");
-        dbgln("=============================================");
-        dbgln("     Time spent: {} ms", time_spent);
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
-        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
-        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
-        dbgln("=============================================");
-    }
+void Heap::remove_dead_cells_from_weak_containers()
+{
+    // Nothing has been swept yet, so the weak containers can still look at their cells' mark bits.
+    for (auto* weak_container : m_weak_containers)
+        weak_container->remove_dead_cells({});
 }
 
 void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
@@ -11,7 +11,6 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
-#include <LibCore/Forward.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/BlockAllocator.h>
 #include <LibJS/Heap/Cell.h>
@@ -59,6 +58,27 @@ public:
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
 
+    struct Statistics {
+        size_t collection_count { 0 };
+        i64 last_pause_in_microseconds { 0 };
+        i64 longest_pause_in_microseconds { 0 };
+        i64 total_pause_in_microseconds { 0 };
+        // Sweeping happens in small steps as new cells are allocated, so it's not part of the pauses above.
+        i64 total_lazy_sweep_time_in_microseconds { 0 };
+        size_t cells_before_last_collection { 0 };
+        size_t cells_surviving_last_collection { 0 };
+    };
+    Statistics const& statistics() const { return m_statistics; }
+
+    // Cells that a collection found to be unreachable are only destroyed when their block gets swept, which may be
+    // a while later. Anything that can get at cells without keeping them alive (like a WeakPtr) must check this first.
+    static bool is_awaiting_sweep(Cell const& cell)
+    {
+        return !cell.is_marked() && HeapBlock::from_cell(&cell)->is_awaiting_sweep();
+    }
+
+    bool sweep_block(Badge<CellAllocator>, HeapBlock&);
+
     VM& vm() { return m_vm; }
 
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
@@ -83,8 +103,10 @@ private:
 
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
-    void mark_live_cells(const HashTable<Cell*>& live_cells);
-    void sweep_dead_cells(bool print_report, const Core::ElapsedTimer&);
+    size_t mark_live_cells(const HashTable<Cell*>& live_cells);
+    void finish_sweeping();
+    void dump_report(size_t block_count_before_sweep);
+    void remove_dead_cells_from_weak_containers();
 
     CellAllocator& allocator_for_size(size_t);
 
@@ -97,9 +119,17 @@ private:
         }
     }
 
-    size_t m_max_allocations_between_gc { 10000 };
+    // We let the heap grow by at least as many cells as survived the last collection before collecting again, so
+    // that the time spent collecting stays proportional to the time spent allocating no matter how big the heap is.
+    static constexpr size_t min_allocations_between_gc = 10000;
+    size_t m_max_allocations_between_gc { min_allocations_between_gc };
     size_t m_allocations_since_last_gc { 0 };
 
+    size_t m_live_cell_count { 0 };
+    size_t m_collected_cell_count { 0 };
+    size_t m_collected_cell_bytes { 0 };
+    Statistics m_statistics;
+
     bool m_should_collect_on_every_allocation { false };
 
     VM& m_vm;
@@ -30,6 +30,11 @@ public:
     size_t cell_count() const { return (block_size - sizeof(HeapBlock)) / m_cell_size; }
     bool is_full() const { return !has_lazy_freelist() && !m_freelist; }
 
+    // Set from the end of a collection's marking phase until this block has been swept. Until then, any cell in here
+    // that isn't marked is garbage that just hasn't been destroyed yet.
+    bool is_awaiting_sweep() const { return m_awaiting_sweep; }
+    void set_awaiting_sweep(bool awaiting_sweep) { m_awaiting_sweep = awaiting_sweep; }
+
     ALWAYS_INLINE Cell* allocate()
     {
         Cell* allocated_cell = nullptr;
@@ -107,7 +112,10 @@ private:
     }
 
     Heap& m_heap;
-    size_t m_cell_size { 0 };
+    // The cell size shares a word with the sweep flag so that the header doesn't grow, as that would knock the cells
+    // out of cache line alignment.
+    u32 m_cell_size { 0 };
+    bool m_awaiting_sweep { false };
     size_t m_next_lazy_freelist_index { 0 };
     FreelistEntry* m_freelist { nullptr };
     alignas(Cell) u8 m_storage[];
@@ -9,6 +9,7 @@
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/HashMap.h>
+#include <AK/StringBuilder.h>
 #include <stdio.h>
 
 namespace JS {
@@ -20,10 +21,11 @@ HashMap<char, TokenType> Lexer::s_single_char_tokens;
 
 Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t line_column)
     : m_source(source)
-    , m_current_token(TokenType::Eof, {}, StringView(nullptr), StringView(nullptr), filename, 0, 0, 0)
+    , m_current_token(TokenType::Eof, {}, StringView(nullptr), StringView(nullptr), StringView(nullptr), filename, 0, 0, 0)
     , m_filename(filename)
     , m_line_number(line_number)
     , m_line_column(line_column)
+    , m_decoded_identifiers(adopt_ref(*new DecodedIdentifiers))
 {
     if (s_keywords.is_empty()) {
         s_keywords.set("await", TokenType::Await);
@@ -317,14 +319,88 @@ bool Lexer::is_line_terminator() const
     return false;
 }
 
+static bool is_identifier_start_code_point(u32 code_point)
+{
+    return is_ascii_alpha(code_point) || code_point == '_' || code_point == '$';
+}
+
+static bool is_identifier_middle_code_point(u32 code_point)
+{
+    return is_identifier_start_code_point(code_point) || is_ascii_digit(code_point);
+}
+
+// Any character of an identifier can also be written as \uXXXX or \u{X...}. Returns the code point of such an escape
+// sequence at `start`, if there is one, and sets `length` to the number of characters it spans.
+static Optional<u32> parse_identifier_unicode_escape(StringView source, size_t start, size_t& length)
+{
+    if (start + 1 >= source.length() || source[start] != '\\' || source[start + 1] != 'u')
+        return {};
+
+    size_t position = start + 2;
+    u32 code_point = 0;
+    if (position < source.length() && source[position] == '{') {
+        ++position;
+        size_t digit_count = 0;
+        for (; position < source.length() && is_ascii_hex_digit(source[position]); ++position, ++digit_count) {
+            code_point = (code_point << 4) | parse_ascii_hex_digit(source[position]);
+            if (code_point > 0x10ffff)
+                return {};
+        }
+        if (digit_count == 0 || position >= source.length() || source[position] != '}')
+            return {};
+        ++position;
+    } else {
+        for (size_t i = 0; i < 4; ++i, ++position) {
+            if (position >= source.length() || !is_ascii_hex_digit(source[position]))
+                return {};
+            code_point = (code_point << 4) | parse_ascii_hex_digit(source[position]);
+        }
+    }
+
+    length = position - start;
+    return code_point;
+}
+
+Optional<u32> Lexer::identifier_unicode_escape(size_t& length) const
+{
+    if (m_eof || m_current_char != '\\')
+        return {};
+    return parse_identifier_unicode_escape(m_source, m_position - 1, length);
+}
+
 bool Lexer::is_identifier_start() const
 {
-    return is_ascii_alpha(m_current_char) || m_current_char == '_' || m_current_char == '$';
+    if (is_identifier_start_code_point(m_current_char))
+        return true;
+    size_t length = 0;
+    auto code_point = identifier_unicode_escape(length);
+    return code_point.has_value() && is_identifier_start_code_point(code_point.value());
 }
 
 bool Lexer::is_identifier_middle() const
 {
-    return is_identifier_start() || is_ascii_digit(m_current_char);
+    if (is_identifier_middle_code_point(m_current_char))
+        return true;
+    size_t length = 0;
+    auto code_point = identifier_unicode_escape(length);
+    return code_point.has_value() && is_identifier_middle_code_point(code_point.value());
+}
+
+StringView Lexer::decode_identifier(StringView identifier)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < identifier.length();) {
+        size_t length = 0;
+        if (auto code_point = parse_identifier_unicode_escape(identifier, i, length); code_point.has_value()) {
+            builder.append_code_point(code_point.value());
+            i += length;
+        } else {
+            builder.append(identifier[i++]);
+        }
+    }
+    FlyString decoded = builder.to_string();
+    m_decoded_identifiers->identifiers.set(decoded);
+    return decoded.view();
 }
 
 bool Lexer::is_line_comment_start(bool line_has_token_yet) const
@@ -420,6 +496,7 @@ Token Lexer::next()
     // can turn that into more specific error messages - instead of us having to make up a
     // bunch of Invalid* tokens (bad numeric literals, unterminated comments etc.)
     String token_message;
+    StringView identifier_value;
 
     if (m_current_token.type() == TokenType::RegexLiteral && !is_eof() && is_ascii_alpha(m_current_char) && !did_consume_whitespace_or_comments) {
         token_type = TokenType::RegexFlags;
@@ -466,16 +543,35 @@ Token Lexer::next()
         }
     } else if (is_identifier_start()) {
         // identifier or keyword
+        bool has_escape_sequences = false;
         do {
-            consume();
+            size_t escape_length = 0;
+            if (identifier_unicode_escape(escape_length).has_value()) {
+                has_escape_sequences = true;
+                for (size_t i = 0; i < escape_length; ++i)
+                    consume();
+            } else {
+                consume();
+            }
         } while (is_identifier_middle());
 
         StringView value = m_source.substring_view(value_start - 1, m_position - value_start);
-        auto it = s_keywords.find(value.hash(), [&](auto& entry) { return entry.key == value; });
+        if (has_escape_sequences)
+            identifier_value = decode_identifier(value);
+        else
+            identifier_value = value;
+
+        auto it = s_keywords.find(identifier_value.hash(), [&](auto& entry) { return entry.key == identifier_value; });
         if (it == s_keywords.end()) {
             token_type = TokenType::Identifier;
-        } else {
+        } else if (!has_escape_sequences) {
             token_type = it->value;
+        } else if (it->value == TokenType::Let || it->value == TokenType::Yield || it->value == TokenType::Await) {
+            // These are only reserved in some contexts, and can otherwise be used as identifiers, even escaped ones.
+            token_type = TokenType::Identifier;
+        } else {
+            token_type = TokenType::Invalid;
+            token_message = "Keywords must not contain escaped characters";
         }
     } else if (is_numeric_literal_start()) {
         token_type = TokenType::NumericLiteral;
@@ -652,11 +748,13 @@ Token Lexer::next()
         }
     }
 
+    auto original_value = m_source.substring_view(value_start - 1, m_position - value_start);
     m_current_token = Token(
         token_type,
         token_message,
         m_source.substring_view(trivia_start - 1, value_start - trivia_start),
-        m_source.substring_view(value_start - 1, m_position - value_start),
+        original_value,
+        identifier_value.is_null() ? original_value : identifier_value,
         m_filename,
         value_start_line_number,
         value_start_column_number,
@@ -8,7 +8,10 @@
 
 #include "Token.h"
 
+#include <AK/FlyString.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/RefCounted.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
 
@@ -34,6 +37,8 @@ private:
     bool is_line_terminator() const;
     bool is_identifier_start() const;
     bool is_identifier_middle() const;
+    Optional<u32> identifier_unicode_escape(size_t& length) const;
+    StringView decode_identifier(StringView);
     bool is_line_comment_start(bool line_has_token_yet) const;
     bool is_block_comment_start() const;
     bool is_block_comment_end() const;
@@ -63,6 +68,13 @@ private:
     };
     Vector<TemplateState> m_template_states;
 
+    // Tokens of identifiers that contain unicode escape sequences point into these decoded copies. They are shared
+    // by all copies of the lexer (the parser saves and restores them), so that they live as long as the parser does.
+    struct DecodedIdentifiers : public RefCounted<DecodedIdentifiers> {
+        HashTable<FlyString> identifiers;
+    };
+    NonnullRefPtr<DecodedIdentifiers> m_decoded_identifiers;
+
     static HashMap<String, TokenType> s_keywords;
     static HashMap<String, TokenType> s_three_char_tokens;
     static HashMap<String, TokenType> s_two_char_tokens;
@@ -56,6 +56,18 @@ public:
         // Manual clear required to resolve circular references
         popped->hoisted_function_declarations.clear();
 
+        // Everything a nested function refers to might be a variable it captures from us. Functions that failed to
+        // parse (like arrow functions that turned out to be something else) will be parsed again, so we skip them.
+        if (popped->type == Parser::Scope::Function && popped->parent && m_is_complete) {
+            auto parent_function_scope = popped->parent->get_current_function_scope();
+            for (auto& name : popped->referenced_names) {
+                parent_function_scope->referenced_names.set(name);
+                parent_function_scope->captured_names.set(name);
+            }
+            if (popped->has_dynamic_variable_access)
+                parent_function_scope->has_dynamic_variable_access = true;
+        }
+
         m_parser.m_state.current_scope = popped->parent;
     }
 
@@ -74,22 +86,36 @@ public:
                 scope_node->add_hoisted_function(hoistable_function.declaration);
             }
         }
+
+        if (scope->type == Parser::Scope::Function) {
+            auto analysis = make<ScopeNode::LocalVariableAnalysis>();
+            for (auto& name : scope->captured_names)
+                analysis->captured_names.set(name);
+            analysis->has_dynamic_variable_access = scope->has_dynamic_variable_access;
+            analysis->references_arguments = scope->referenced_names.contains("arguments"sv);
+            scope_node->set_local_variable_analysis(move(analysis));
+            m_is_complete = true;
+        }
     }
 
     static bool is_hoistable(Parser::Scope::HoistableDeclaration& declaration)
     {
         auto& name = declaration.declaration->name();
-        // See if we find any conflicting lexical declaration on the way up
+        // See if we find any conflicting lexical declaration on the way up to the function it's hoisted to.
+        // NOTE: Looking any further would also make this depend on whether the function was parsed lazily.
         for (RefPtr<Parser::Scope> scope = declaration.scope; !scope.is_null(); scope = scope->parent) {
             if (scope->lexical_declarations.contains(name)) {
                 return false;
             }
+            if (scope->type == Parser::Scope::Function)
+                break;
         }
         return true;
     }
 
     Parser& m_parser;
     unsigned m_mask { 0 };
+    bool m_is_complete { false };
 };
 
 class OperatorPrecedenceTable {
@@ -404,6 +430,9 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
         load_state();
     };
 
+    // The parameters already belong to the arrow function, so it needs its scope from the start.
+    ScopePusher scope(*this, ScopePusher::Var, Scope::Function);
+
     Vector<FunctionNode::Parameter> parameters;
     i32 function_length = -1;
     if (expect_parens) {
@@ -448,14 +477,18 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
 
     bool is_strict = false;
 
-    auto function_body_result = [&]() -> RefPtr<BlockStatement> {
+    auto function_body_result = [&]() -> RefPtr<Statement> {
         TemporaryChange change(m_state.in_arrow_function_context, true);
         if (match(TokenType::CurlyOpen)) {
             // Parse a function body with statements
-            ScopePusher scope(*this, ScopePusher::Var, Scope::Function);
-            auto body = parse_block_statement(is_strict);
-            scope.add_to_scope_node(body);
-            return body;
+            Optional<LazyFunctionBody::ParseContext> lazy_body_context;
+            if (should_parse_function_body_lazily())
+                lazy_body_context = lazy_function_body_context();
+            auto body = skip_checked_function_body(lazy_body_context, is_strict);
+            if (!body)
+                body = parse_block_statement(is_strict);
+            scope.add_to_scope_node(*body);
+            return defer_function_body(body.release_nonnull(), move(lazy_body_context), is_strict);
         }
         if (match_expression()) {
             // Parse a function body which returns a single expression
@@ -467,6 +500,7 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
             auto return_expression = parse_expression(2);
             auto return_block = create_ast_node<BlockStatement>({ m_state.current_token.filename(), rule_start.position(), position() });
             return_block->append<ReturnStatement>({ m_filename, rule_start.position(), position() }, move(return_expression));
+            scope.add_to_scope_node(return_block);
             return return_block;
         }
         // Invalid arrow function body
@@ -537,7 +571,10 @@ RefPtr<MetaProperty> Parser::try_parse_new_target_expression()
 NonnullRefPtr<ClassDeclaration> Parser::parse_class_declaration()
 {
     auto rule_start = push_start();
-    return create_ast_node<ClassDeclaration>({ m_state.current_token.filename(), rule_start.position(), position() }, parse_class_expression(true));
+    auto class_expression = parse_class_expression(true);
+    // Class declarations are only ever bound in an environment.
+    mark_name_as_captured(class_expression->name());
+    return create_ast_node<ClassDeclaration>({ m_state.current_token.filename(), rule_start.position(), position() }, move(class_expression));
 }
 
 NonnullRefPtr<ClassExpression> Parser::parse_class_expression(bool expect_class_name)
@@ -710,6 +747,8 @@ Parser::PrimaryExpressionParseResult Parser::parse_primary_expression()
 
             set_try_parse_arrow_function_expression_failed_at_position(paren_position, true);
         }
+        if (match(TokenType::Function))
+            m_parse_next_function_eagerly = true;
         auto expression = parse_expression(0);
         consume(TokenType::ParenClose);
         if (is<FunctionExpression>(*expression)) {
@@ -1532,6 +1571,7 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
 {
     auto rule_start = push_start();
     VERIFY(!(parse_options & FunctionNodeParseOptions::IsGetterFunction && parse_options & FunctionNodeParseOptions::IsSetterFunction));
+    auto parse_body_eagerly = exchange(m_parse_next_function_eagerly, false);
 
     TemporaryChange super_property_access_rollback(m_state.allow_super_property_lookup, !!(parse_options & FunctionNodeParseOptions::AllowSuperPropertyLookup));
     TemporaryChange super_constructor_call_rollback(m_state.allow_super_constructor_call, !!(parse_options & FunctionNodeParseOptions::AllowSuperConstructorCall));
@@ -1573,19 +1613,152 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
 
     m_state.function_parameters.append(parameters);
 
+    Optional<LazyFunctionBody::ParseContext> lazy_body_context;
+    if (!parse_body_eagerly && should_parse_function_body_lazily())
+        lazy_body_context = lazy_function_body_context();
+
     bool is_strict = false;
-    auto body = parse_block_statement(is_strict);
+    auto body = skip_checked_function_body(lazy_body_context, is_strict);
+    if (!body)
+        body = parse_block_statement(is_strict);
 
     m_state.function_parameters.take_last();
 
-    scope.add_to_scope_node(body);
+    scope.add_to_scope_node(*body);
 
     return create_ast_node<FunctionNodeType>(
         { m_state.current_token.filename(), rule_start.position(), position() },
-        name, move(body), move(parameters), function_length,
+        name, defer_function_body(body.release_nonnull(), move(lazy_body_context), is_strict), move(parameters), function_length,
         is_generator ? FunctionKind::Generator : FunctionKind::Regular, is_strict);
 }
 
+Result<NonnullRefPtr<BlockStatement>, Parser::Error> Parser::parse_lazy_function_body(LazyFunctionBody::ParseContext const& context)
+{
+    // NOTE: The lexer counts the first character as it reads it, so we start one column early.
+    Lexer lexer { context.source.substring_view(context.offset), context.filename, context.line, context.column - 1 };
+    Parser parser { lexer };
+    parser.m_lazy_function_source = context.source;
+    parser.m_lazy_function_filename = context.filename;
+    parser.m_lazy_function_source_offset = context.offset;
+    parser.m_checked_function_bodies = context.checked_bodies;
+
+    parser.m_state.strict_mode = context.strict_mode;
+    parser.m_state.allow_super_property_lookup = context.allow_super_property_lookup;
+    parser.m_state.allow_super_constructor_call = context.allow_super_constructor_call;
+    parser.m_state.in_function_context = context.in_function_context;
+    parser.m_state.in_generator_function_context = context.in_generator_function_context;
+    parser.m_state.in_arrow_function_context = context.in_arrow_function_context;
+    parser.m_state.in_break_context = context.in_break_context;
+    parser.m_state.in_continue_context = context.in_continue_context;
+
+    ScopePusher scope(parser, ScopePusher::Var, Scope::Function);
+    bool is_strict = false;
+    auto body = parser.parse_block_statement(is_strict);
+    scope.add_to_scope_node(body);
+
+    // This is the same source that parsed without any errors before, but we'd rather throw than crash if that changes.
+    if (parser.has_errors())
+        return parser.errors().first();
+    return body;
+}
+
+bool Parser::should_parse_function_body_lazily() const
+{
+    // The function's own scope has already been pushed. If it has no parent, it's what we've been asked to parse, like
+    // the function created by the Function constructor, or the body of a lazy function that is needed now.
+    return m_state.current_scope->parent && !has_errors();
+}
+
+LazyFunctionBody::ParseContext Parser::lazy_function_body_context()
+{
+    if (m_lazy_function_source.is_null()) {
+        m_lazy_function_source = m_state.lexer.source();
+        m_lazy_function_filename = m_state.lexer.filename();
+    }
+    if (!m_checked_function_bodies)
+        m_checked_function_bodies = adopt_ref(*new LazyFunctionBody::CheckedBodies);
+
+    // The offset is into the source of the whole script, which is what the bodies of nested functions are parsed from too.
+    auto& token = m_state.current_token;
+    LazyFunctionBody::ParseContext context;
+    context.source = m_lazy_function_source;
+    context.filename = m_lazy_function_filename;
+    context.checked_bodies = m_checked_function_bodies;
+    context.offset = m_lazy_function_source_offset + (token.original_value().characters_without_null_termination() - m_state.lexer.source().characters_without_null_termination());
+    context.line = token.line_number();
+    context.column = token.line_column();
+    context.strict_mode = m_state.strict_mode;
+    context.allow_super_property_lookup = m_state.allow_super_property_lookup;
+    context.allow_super_constructor_call = m_state.allow_super_constructor_call;
+    context.in_function_context = m_state.in_function_context;
+    context.in_generator_function_context = m_state.in_generator_function_context;
+    context.in_arrow_function_context = m_state.in_arrow_function_context;
+    context.in_break_context = m_state.in_break_context;
+    context.in_continue_context = m_state.in_continue_context;
+    return context;
+}
+
+NonnullRefPtr<Statement> Parser::defer_function_body(NonnullRefPtr<BlockStatement> body, Optional<LazyFunctionBody::ParseContext> context, bool is_strict)
+{
+    // Parsing the body again has to give the same result, so we only do that if nothing went wrong so far.
+    if (!context.has_value() || has_errors())
+        return body;
+
+    // Remember what the function's scope looks like now, so functions around this one don't have to check its body again.
+    auto& function_scope = *m_state.current_scope;
+    VERIFY(function_scope.type == Scope::Function);
+    LazyFunctionBody::CheckedBody checked_body;
+    checked_body.is_strict = is_strict;
+    checked_body.has_dynamic_variable_access = function_scope.has_dynamic_variable_access;
+    for (auto& name : function_scope.referenced_names)
+        checked_body.referenced_names.set(name);
+    for (auto& name : function_scope.captured_names)
+        checked_body.captured_names.set(name);
+    context->checked_bodies->bodies.set(context->offset, move(checked_body));
+
+    auto local_variable_analysis = body->take_local_variable_analysis();
+    return create_ast_node<LazyFunctionBody>(body->source_range(), context.release_value(), local_variable_analysis.release_nonnull());
+}
+
+RefPtr<BlockStatement> Parser::skip_checked_function_body(Optional<LazyFunctionBody::ParseContext> const& context, bool& is_strict)
+{
+    if (!context.has_value())
+        return nullptr;
+    // A body we haven't seen before has to be parsed in full, even though its nodes are thrown away right after. Early
+    // errors like a `break` outside of a loop or an invalid assignment target have to be reported before any of the
+    // script runs, and finding them takes the whole grammar. Only counting curlies would let them through until the
+    // function is first called.
+    auto checked_body = context->checked_bodies->bodies.find(context->offset);
+    if (checked_body == context->checked_bodies->bodies.end())
+        return nullptr;
+
+    // The body is only going to be deferred again, so there's no need to build any nodes for it. Knowing that it has no
+    // syntax errors, all we have to do is find the closing curly. Braces that belong to template literals are
+    // different tokens, so counting them is enough.
+    auto rule_start = push_start();
+    consume(TokenType::CurlyOpen);
+    for (size_t depth = 1; !done();) {
+        if (match(TokenType::CurlyOpen))
+            ++depth;
+        else if (match(TokenType::CurlyClose) && --depth == 0)
+            break;
+        m_state.current_token = m_state.lexer.next();
+    }
+    consume(TokenType::CurlyClose);
+    m_state.string_legacy_octal_escape_sequence_in_scope = false;
+
+    // The function's scope gets what it had after checking the body, which includes the names the body refers to.
+    auto& function_scope = *m_state.current_scope;
+    VERIFY(function_scope.type == Scope::Function);
+    is_strict = checked_body->value.is_strict;
+    function_scope.has_dynamic_variable_access |= checked_body->value.has_dynamic_variable_access;
+    for (auto& name : checked_body->value.referenced_names)
+        function_scope.referenced_names.set(name);
+    for (auto& name : checked_body->value.captured_names)
+        function_scope.captured_names.set(name);
+    return create_ast_node<BlockStatement>({ m_state.current_token.filename(), rule_start.position(), position() });
+}
+
 Vector<FunctionNode::Parameter> Parser::parse_formal_parameters(int& function_length, u8 parse_options)
 {
     auto rule_start = push_start();
@@ -2055,6 +2228,7 @@ NonnullRefPtr<WithStatement> Parser::parse_with_statement()
     auto rule_start = push_start();
     consume(TokenType::With);
     consume(TokenType::ParenOpen);
+    m_state.current_scope->get_current_function_scope()->has_dynamic_variable_access = true;
 
     auto object = parse_expression(0);
 
@@ -2116,6 +2290,12 @@ NonnullRefPtr<CatchClause> Parser::parse_catch_clause()
     if (!parameter.is_empty())
         check_identifier_name_for_assignment_validity(parameter);
 
+    // Catch parameters are only ever bound in an environment.
+    if (pattern_parameter)
+        pattern_parameter->for_each_bound_name([this](auto& name) { mark_name_as_captured(name); });
+    if (!parameter.is_empty())
+        mark_name_as_captured(parameter);
+
     auto body = parse_block_statement();
     if (pattern_parameter) {
         return create_ast_node<CatchClause>(
@@ -2425,9 +2605,30 @@ Token Parser::consume()
 {
     auto old_token = m_state.current_token;
     m_state.current_token = m_state.lexer.next();
+    switch (old_token.type()) {
+    case TokenType::Identifier:
+    case TokenType::Let:
+    case TokenType::Yield:
+    case TokenType::Await:
+        if (m_state.current_scope) {
+            auto function_scope = m_state.current_scope->get_current_function_scope();
+            function_scope->referenced_names.set(old_token.value());
+            if (old_token.value() == "eval"sv)
+                function_scope->has_dynamic_variable_access = true;
+        }
+        break;
+    default:
+        break;
+    }
     return old_token;
 }
 
+void Parser::mark_name_as_captured(StringView name)
+{
+    if (m_state.current_scope)
+        m_state.current_scope->get_current_function_scope()->captured_names.set(name);
+}
+
 void Parser::consume_or_insert_semicolon()
 {
     // Semicolon was found and will be consumed
@@ -8,6 +8,7 @@
 
 #include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/Result.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/AST.h>
 #include <LibJS/Lexer.h>
@@ -124,6 +125,9 @@ public:
         }
     };
 
+    // Parses the body of a function that was only checked before, see LazyFunctionBody.
+    static Result<NonnullRefPtr<BlockStatement>, Error> parse_lazy_function_body(LazyFunctionBody::ParseContext const&);
+
     bool has_errors() const { return m_state.errors.size(); }
     const Vector<Error>& errors() const { return m_state.errors; }
     void print_errors() const
@@ -163,11 +167,17 @@ private:
     Token consume(TokenType type);
     Token consume_and_validate_numeric_literal();
     void consume_or_insert_semicolon();
+    void mark_name_as_captured(StringView);
     void save_state();
     void load_state();
     void discard_saved_state();
     Position position() const;
 
+    bool should_parse_function_body_lazily() const;
+    LazyFunctionBody::ParseContext lazy_function_body_context();
+    NonnullRefPtr<Statement> defer_function_body(NonnullRefPtr<BlockStatement>, Optional<LazyFunctionBody::ParseContext>, bool is_strict);
+    RefPtr<BlockStatement> skip_checked_function_body(Optional<LazyFunctionBody::ParseContext> const&, bool& is_strict);
+
     void check_identifier_name_for_assignment_validity(StringView);
 
     bool try_parse_arrow_function_expression_failed_at_position(const Position&) const;
@@ -219,6 +229,12 @@ private:
 
         HashTable<FlyString> lexical_declarations;
 
+        // Only used on function scopes, to fill in ScopeNode::LocalVariableAnalysis. Identifiers are tracked by their
+        // tokens, which also picks up property names and such. That only means some variables stay in environments.
+        HashTable<StringView> referenced_names;
+        HashTable<StringView> captured_names;
+        bool has_dynamic_variable_access { false };
+
         explicit Scope(Type, RefPtr<Scope>);
         RefPtr<Scope> get_current_function_scope();
     };
@@ -265,5 +281,12 @@ private:
     FlyString m_filename;
     Vector<ParserState> m_saved_state;
     HashMap<Position, TokenMemoization, PositionKeyTraits> m_token_memoizations;
+
+    // Functions that are called right away, like `(function() { ... })()`, aren't worth parsing lazily.
+    bool m_parse_next_function_eagerly { false };
+    String m_lazy_function_source;
+    String m_lazy_function_filename;
+    size_t m_lazy_function_source_offset { 0 };
+    RefPtr<LazyFunctionBody::CheckedBodies> m_checked_function_bodies;
 };
 }
@@ -13,6 +13,7 @@ ArgumentsObject::ArgumentsObject(GlobalObject& global_object, Environment& envir
     : Object(*global_object.object_prototype())
     , m_environment(environment)
 {
+    m_may_interfere_with_inline_caches = true;
 }
 
 void ArgumentsObject::initialize(GlobalObject& global_object)
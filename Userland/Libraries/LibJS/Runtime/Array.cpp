@@ -233,4 +233,32 @@ MarkedValueList Array::internal_own_property_keys() const
     return keys;
 }
 
+// NON-STANDARD: Used by fast paths for [[Set]] and CreateDataProperty
+bool Array::set_element_fast(u32 index, Value value)
+{
+    auto& indexed_properties = this->indexed_properties();
+    if (indexed_properties.element_kind() == ElementKind::Sparse)
+        return false;
+
+    auto existing_value = indexed_properties.get_element_fast(index);
+    if (!existing_value.is_empty())
+        return !existing_value.is_accessor() && indexed_properties.replace_element_fast(index, value);
+
+    // Filling a hole or appending is only unobservable if nothing on the prototype chain could have a say in it.
+    auto array_like_size = indexed_properties.array_like_size();
+    if (index > array_like_size || !m_is_extensible)
+        return false;
+    if (index == array_like_size && (index >= NumericLimits<i32>::max() || !m_length_writable))
+        return false;
+    auto& global_object = this->global_object();
+    for (auto* prototype = shape().prototype(); prototype; prototype = prototype->shape().prototype()) {
+        if (prototype != global_object.array_prototype() && prototype != global_object.object_prototype())
+            return false;
+        if (prototype->indexed_properties().array_like_size() != 0)
+            return false;
+    }
+    indexed_properties.put(index, value);
+    return true;
+}
+
 }
@@ -27,10 +27,19 @@ public:
 
     [[nodiscard]] bool length_is_writable() const { return m_length_writable; };
 
+    // Stores an element directly if that's indistinguishable from [[Set]] and CreateDataProperty, returns false if the
+    // caller has to go through those.
+    bool set_element_fast(u32 index, Value);
+
+    virtual bool is_array() const override { return true; }
+
 private:
     bool set_length(PropertyDescriptor const&);
 
     bool m_length_writable { true };
 };
 
+template<>
+inline bool Object::fast_is<Array>() const { return is_array(); }
+
 }
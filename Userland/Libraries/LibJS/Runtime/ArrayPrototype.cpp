@@ -8,7 +8,9 @@
  */
 
 #include <AK/Function.h>
+#include <AK/AllOf.h>
 #include <AK/HashTable.h>
+#include <AK/MergeSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -154,6 +156,18 @@ static Object* array_species_create(GlobalObject& global_object, Object& origina
     return &result.as_object();
 }
 
+// NON-STANDARD: Elements of arrays in simple storage are always present and can be read without side effects, which
+// answers both HasProperty() and Get() at once. Returns an empty value if the caller has to ask the object.
+static Value array_element_fast(Object const& object, size_t index)
+{
+    if (!is<Array>(object) || index > NumericLimits<u32>::max())
+        return {};
+    auto value = object.indexed_properties().get_element_fast(index);
+    if (value.is_accessor())
+        return {};
+    return value;
+}
+
 // 23.1.3.7 Array.prototype.filter ( callbackfn [ , thisArg ] ), https://tc39.es/ecma262/#sec-array.prototype.filter
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::filter)
 {
@@ -255,14 +269,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
         auto property_name = PropertyName { k };
 
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = object->has_property(property_name);
+        auto k_value = array_element_fast(*object, k);
+        auto k_present = !k_value.is_empty() || object->has_property(property_name);
         if (vm.exception())
             return {};
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = object->get(property_name);
+            if (k_value.is_empty())
+                k_value = object->get(property_name);
             if (vm.exception())
                 return {};
 
@@ -313,14 +329,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         auto property_name = PropertyName { k };
 
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = object->has_property(property_name);
+        auto k_value = array_element_fast(*object, k);
+        auto k_present = !k_value.is_empty() || object->has_property(property_name);
         if (vm.exception())
             return {};
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = object->get(property_name);
+            if (k_value.is_empty())
+                k_value = object->get(property_name);
             if (vm.exception())
                 return {};
 
@@ -363,6 +381,10 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
             return {};
     }
     auto new_length_value = Value(new_length);
+    // NOTE: Appending to an array already updated its length, and setting a writable length to its current value
+    //       isn't observable.
+    if (is<Array>(*this_object) && static_cast<Array*>(this_object)->length_is_writable() && this_object->indexed_properties().array_like_size() == new_length)
+        return new_length_value;
     this_object->set(vm.names.length, new_length_value, true);
     if (vm.exception())
         return {};
@@ -816,6 +838,19 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // NOTE: Packed arrays have all elements up to their length, and comparing them can't change the array, so we can
+    //       scan the elements directly. Arrays that only hold numbers can't contain anything else.
+    if (is<Array>(*object) && is_packed(object->indexed_properties().element_kind())) {
+        auto& indexed_properties = object->indexed_properties();
+        if (indexed_properties.element_kind() != ElementKind::Packed && !search_element.is_number())
+            return Value(-1);
+        for (; k < length; ++k) {
+            if (strict_eq(search_element, indexed_properties.get_element_fast(k)))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_name = PropertyName { k };
@@ -1218,6 +1253,27 @@ static void array_merge_sort(VM& vm, GlobalObject& global_object, FunctionObject
     }
 }
 
+// NON-STANDARD: Without a compare function, numbers are sorted by their string representation. Converting them can't
+// have side effects, so we can do that once up front rather than on every comparison.
+static void sort_numbers_as_strings(MarkedValueList& numbers)
+{
+    struct NumberAndString {
+        Value number;
+        String string;
+    };
+    Vector<NumberAndString> entries;
+    entries.ensure_capacity(numbers.size());
+    for (auto& number : numbers)
+        entries.unchecked_append({ number, number.to_string_without_side_effects() });
+
+    // NOTE: Number strings are ASCII, so comparing bytes is the same as comparing code units. merge_sort() is stable,
+    //       as Array.prototype.sort() has to be.
+    merge_sort(entries, [](auto& a, auto& b) { return a.string < b.string; });
+
+    for (size_t i = 0; i < entries.size(); ++i)
+        numbers[i] = entries[i].number;
+}
+
 // 23.1.3.27 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1237,12 +1293,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 
     MarkedValueList items(vm.heap());
     for (size_t k = 0; k < length; ++k) {
-        auto k_present = object->has_property(k);
+        auto k_value = array_element_fast(*object, k);
+        auto k_present = !k_value.is_empty() || object->has_property(k);
         if (vm.exception())
             return {};
 
         if (k_present) {
-            auto k_value = object->get(k);
+            if (k_value.is_empty())
+                k_value = object->get(k);
             if (vm.exception())
                 return {};
 
@@ -1255,7 +1313,10 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // to be stable. FIXME: when initially scanning through the array, maintain a flag
     // for if an unstable sort would be indistinguishable from a stable sort (such as just
     // just strings or numbers), and in that case use quick sort instead for better performance.
-    array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), items);
+    if (callback.is_undefined() && all_of(items.begin(), items.end(), [](auto& item) { return item.is_number(); }))
+        sort_numbers_as_strings(items);
+    else
+        array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), items);
     if (vm.exception())
         return {};
 
@@ -42,19 +42,19 @@ bool FinalizationRegistry::remove_by_token(Object& unregister_token)
     return removed;
 }
 
-void FinalizationRegistry::remove_swept_cells(Badge<Heap>, Vector<Cell*>& cells)
+void FinalizationRegistry::remove_dead_cells(Badge<Heap>)
 {
-    auto any_cells_were_swept = false;
-    for (auto cell : cells) {
-        for (auto& record : m_records) {
-            if (record.target != cell)
-                continue;
-            record.target = nullptr;
-            any_cells_were_swept = true;
-            break;
-        }
+    // If we're about to be swept ourselves, there's nobody left to run the cleanup callback for.
+    if (!is_marked())
+        return;
+    auto any_cells_were_removed = false;
+    for (auto& record : m_records) {
+        if (!record.target || record.target->is_marked())
+            continue;
+        record.target = nullptr;
+        any_cells_were_removed = true;
     }
-    if (any_cells_were_swept)
+    if (any_cells_were_removed)
         vm().enqueue_finalization_registry_cleanup_job(*this);
 }
 
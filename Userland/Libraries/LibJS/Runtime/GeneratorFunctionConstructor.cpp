@@ -52,11 +52,13 @@ Value GeneratorFunctionConstructor::construct(FunctionObject& new_target)
     auto* bytecode_interpreter = Bytecode::Interpreter::current();
     VERIFY(bytecode_interpreter);
 
-    auto executable = Bytecode::Generator::generate(function->body(), true);
-    auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
-    passes.perform(executable);
+    auto executable = Bytecode::Generator::generate(function->parsed_body(), true, function->parameters());
+    if (JS::Bytecode::Interpreter::optimizations_enabled()) {
+        auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
+        passes.perform(executable);
+        dbgln_if(JS_BYTECODE_DEBUG, "Optimisation passes took {}us", passes.elapsed());
+    }
     if constexpr (JS_BYTECODE_DEBUG) {
-        dbgln("Optimisation passes took {}us", passes.elapsed());
         dbgln("Compiled Bytecode::Block for function '{}':", function->name());
         for (auto& block : executable.basic_blocks)
             block.dump(executable);
@@ -13,71 +13,98 @@ namespace JS {
 constexpr const size_t SPARSE_ARRAY_HOLE_THRESHOLD = 200;
 constexpr const size_t LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD = 4 * MiB;
 
+SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage()
+    : IndexedPropertyStorage(true)
+{
+}
+
 SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initial_values)
-    : m_array_size(initial_values.size())
+    : IndexedPropertyStorage(true)
     , m_packed_elements(move(initial_values))
 {
+    for (auto& value : m_packed_elements) {
+        if (value.is_empty())
+            ++m_hole_count;
+        else
+            update_element_kind(value);
+    }
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
 {
-    return index < m_array_size && !m_packed_elements[index].is_empty();
+    return index < m_packed_elements.size() && !m_packed_elements[index].is_empty();
 }
 
 Optional<ValueAndAttributes> SimpleIndexedPropertyStorage::get(u32 index) const
 {
-    if (index >= m_array_size)
+    if (index >= m_packed_elements.size())
         return {};
     return ValueAndAttributes { m_packed_elements[index], default_attributes };
 }
 
-void SimpleIndexedPropertyStorage::grow_storage_if_needed()
-{
-    if (m_array_size <= m_packed_elements.size())
-        return;
-    // Grow storage by 25% at a time.
-    m_packed_elements.resize(m_array_size + (m_array_size / 4));
-}
-
 void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttributes attributes)
 {
     VERIFY(attributes == default_attributes);
 
-    if (index >= m_array_size) {
-        m_array_size = index + 1;
-        grow_storage_if_needed();
+    if (index >= m_packed_elements.size()) {
+        m_hole_count += index + 1 - m_packed_elements.size();
+        // NOTE: Vector::resize() doesn't over-allocate, so make sure adding elements one after another stays linear.
+        m_packed_elements.grow_capacity(index + 1);
+        m_packed_elements.resize(index + 1);
     }
+
+    if (m_packed_elements[index].is_empty())
+        --m_hole_count;
+    // NOTE: Putting an empty value leaves a hole, e.g. for elisions in array literals.
+    if (value.is_empty())
+        ++m_hole_count;
+    else
+        update_element_kind(value);
     m_packed_elements[index] = value;
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
-    VERIFY(index < m_array_size);
+    VERIFY(index < m_packed_elements.size());
+    if (!m_packed_elements[index].is_empty())
+        ++m_hole_count;
     m_packed_elements[index] = {};
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
-    m_array_size--;
-    return { m_packed_elements.take_first(), default_attributes };
+    auto value = m_packed_elements.take_first();
+    if (value.is_empty())
+        --m_hole_count;
+    return { value, default_attributes };
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
-    m_array_size--;
-    auto last_element = m_packed_elements[m_array_size];
-    m_packed_elements[m_array_size] = {};
-    return { last_element, default_attributes };
+    auto value = m_packed_elements.take_last();
+    if (value.is_empty())
+        --m_hole_count;
+    return { value, default_attributes };
 }
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
-    m_array_size = new_size;
-    m_packed_elements.resize(new_size);
+    if (new_size > m_packed_elements.size()) {
+        m_hole_count += new_size - m_packed_elements.size();
+    } else {
+        for (size_t i = new_size; i < m_packed_elements.size(); ++i) {
+            if (m_packed_elements[i].is_empty())
+                --m_hole_count;
+        }
+    }
+    // NOTE: Shrinking and growing the length again is common (e.g. Array.prototype.push() sets the length after
+    //       appending), so don't give the capacity back.
+    m_packed_elements.resize_and_keep_capacity(new_size);
     return true;
 }
 
 GenericIndexedPropertyStorage::GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&& storage)
+    : IndexedPropertyStorage(false)
 {
     m_array_size = storage.array_like_size();
     for (size_t i = 0; i < storage.m_packed_elements.size(); ++i) {
@@ -203,14 +230,24 @@ bool IndexedPropertyIterator::operator!=(const IndexedPropertyIterator& other) c
 
 void IndexedPropertyIterator::skip_empty_indices()
 {
-    auto indices = m_indexed_properties.indices();
-    for (auto i : indices) {
-        if (i < m_index)
-            continue;
-        m_index = i;
+    auto array_like_size = m_indexed_properties.array_like_size();
+
+    if (m_indexed_properties.element_kind() != ElementKind::Sparse) {
+        while (m_index < array_like_size && m_indexed_properties.get_element_fast(m_index).is_empty())
+            ++m_index;
+        return;
+    }
+
+    if (!m_generic_indices.has_value())
+        m_generic_indices = m_indexed_properties.indices();
+    auto& indices = *m_generic_indices;
+    while (m_generic_indices_position < indices.size() && indices[m_generic_indices_position] < m_index)
+        ++m_generic_indices_position;
+    if (m_generic_indices_position < indices.size()) {
+        m_index = indices[m_generic_indices_position];
         return;
     }
-    m_index = m_indexed_properties.array_like_size();
+    m_index = array_like_size;
 }
 
 Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
@@ -268,7 +305,9 @@ bool IndexedProperties::set_array_like_size(size_t new_size)
 size_t IndexedProperties::real_size() const
 {
     if (m_storage->is_simple_storage()) {
-        auto& packed_elements = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).elements();
+        if (simple_storage().element_kind() != ElementKind::Holey)
+            return simple_storage().size();
+        auto& packed_elements = simple_storage().elements();
         size_t size = 0;
         for (auto& element : packed_elements) {
             if (!element.is_empty())
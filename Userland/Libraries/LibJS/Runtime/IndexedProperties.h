@@ -21,6 +21,22 @@ class IndexedProperties;
 class IndexedPropertyIterator;
 class GenericIndexedPropertyStorage;
 
+// What we know about the elements in simple storage, so fast paths can skip per-element checks. The kind of values
+// only ever moves towards more general kinds, but filling all holes makes a Holey array packed again.
+// Elements in generic storage are always Sparse.
+enum class ElementKind : u8 {
+    PackedInt32,  // Every index below the array-like size has an Int32 value.
+    PackedDouble, // Every index below the array-like size has a Number value.
+    Packed,       // Every index below the array-like size has a value.
+    Holey,        // There may be empty indices below the array-like size.
+    Sparse,       // The elements live in generic storage, and may have non-default attributes.
+};
+
+inline bool is_packed(ElementKind kind)
+{
+    return kind == ElementKind::PackedInt32 || kind == ElementKind::PackedDouble || kind == ElementKind::Packed;
+}
+
 class IndexedPropertyStorage {
 public:
     virtual ~IndexedPropertyStorage() {};
@@ -37,12 +53,21 @@ public:
     virtual size_t array_like_size() const = 0;
     virtual bool set_array_like_size(size_t new_size) = 0;
 
-    virtual bool is_simple_storage() const { return false; }
+    bool is_simple_storage() const { return m_is_simple_storage; }
+
+protected:
+    explicit IndexedPropertyStorage(bool is_simple_storage)
+        : m_is_simple_storage(is_simple_storage)
+    {
+    }
+
+private:
+    bool m_is_simple_storage { false };
 };
 
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
-    SimpleIndexedPropertyStorage() = default;
+    SimpleIndexedPropertyStorage();
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
 
     virtual bool has_index(u32 index) const override;
@@ -54,18 +79,44 @@ public:
     virtual ValueAndAttributes take_last() override;
 
     virtual size_t size() const override { return m_packed_elements.size(); }
-    virtual size_t array_like_size() const override { return m_array_size; }
+    virtual size_t array_like_size() const override { return m_packed_elements.size(); }
     virtual bool set_array_like_size(size_t new_size) override;
 
-    virtual bool is_simple_storage() const override { return true; }
     const Vector<Value>& elements() const { return m_packed_elements; }
+    ElementKind element_kind() const { return m_hole_count > 0 ? ElementKind::Holey : m_element_kind; }
+
+    // Returns an empty value if there's no element at the given index.
+    Value element(u32 index) const
+    {
+        if (index >= m_packed_elements.size())
+            return {};
+        return m_packed_elements[index];
+    }
+
+    // Only replaces an element that already exists, returns false otherwise.
+    bool replace_element(u32 index, Value value)
+    {
+        if (index >= m_packed_elements.size() || m_packed_elements[index].is_empty())
+            return false;
+        m_packed_elements[index] = value;
+        update_element_kind(value);
+        return true;
+    }
 
 private:
     friend GenericIndexedPropertyStorage;
 
-    void grow_storage_if_needed();
+    void update_element_kind(Value value)
+    {
+        if (m_element_kind == ElementKind::PackedInt32 && !value.is_int32())
+            m_element_kind = value.is_number() ? ElementKind::PackedDouble : ElementKind::Packed;
+        else if (m_element_kind == ElementKind::PackedDouble && !value.is_number())
+            m_element_kind = ElementKind::Packed;
+    }
 
-    size_t m_array_size { 0 };
+    // The kind of the values that are present, holes are counted separately.
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
+    size_t m_hole_count { 0 };
     Vector<Value> m_packed_elements;
 };
 
@@ -108,6 +159,10 @@ private:
     const IndexedProperties& m_indexed_properties;
     u32 m_index;
     bool m_skip_empty;
+
+    // The sorted indices of generic storage, which are only looked up once, rather than on every step.
+    Optional<Vector<u32>> m_generic_indices;
+    size_t m_generic_indices_position { 0 };
 };
 
 class IndexedProperties {
@@ -140,11 +195,35 @@ public:
 
     Vector<u32> indices() const;
 
+    ElementKind element_kind() const
+    {
+        if (!m_storage->is_simple_storage())
+            return ElementKind::Sparse;
+        return simple_storage().element_kind();
+    }
+
+    // The fast paths below don't go through any virtual calls, but only work on simple storage.
+    // They return an empty value or false if the caller has to take the slow path.
+
+    Value get_element_fast(u32 index) const
+    {
+        if (!m_storage->is_simple_storage())
+            return {};
+        return simple_storage().element(index);
+    }
+
+    bool replace_element_fast(u32 index, Value value)
+    {
+        if (!m_storage->is_simple_storage())
+            return false;
+        return simple_storage().replace_element(index, value);
+    }
+
     template<typename Callback>
     void for_each_value(Callback callback)
     {
         if (m_storage->is_simple_storage()) {
-            for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
+            for (auto& value : simple_storage().elements())
                 callback(value);
         } else {
             for (auto& element : static_cast<const GenericIndexedPropertyStorage&>(*m_storage).sparse_elements())
@@ -155,6 +234,9 @@ public:
 private:
     void switch_to_generic_storage();
 
+    SimpleIndexedPropertyStorage& simple_storage() { return static_cast<SimpleIndexedPropertyStorage&>(*m_storage); }
+    SimpleIndexedPropertyStorage const& simple_storage() const { return static_cast<SimpleIndexedPropertyStorage const&>(*m_storage); }
+
     NonnullOwnPtr<IndexedPropertyStorage> m_storage { make<SimpleIndexedPropertyStorage>() };
 };
 
@@ -128,6 +128,10 @@ bool Object::create_data_property(PropertyName const& property_name, Value value
     // 2. Assert: IsPropertyKey(P) is true.
     VERIFY(property_name.is_valid());
 
+    // NOTE: Creating array elements one after another is very common, so skip building a descriptor where we can.
+    if (property_name.is_number() && is_array() && static_cast<Array&>(*this).set_element_fast(property_name.as_number(), value))
+        return true;
+
     // 3. Let newDesc be the PropertyDescriptor { [[Value]]: V, [[Writable]]: true, [[Enumerable]]: true, [[Configurable]]: true }.
     auto new_descriptor = PropertyDescriptor {
         .value = value,
@@ -636,6 +640,10 @@ bool Object::internal_has_property(PropertyName const& property_name) const
     // 1. Assert: IsPropertyKey(P) is true.
     VERIFY(property_name.is_valid());
 
+    // NOTE: Array elements in simple storage are always own data properties, there's no need to build a descriptor.
+    if (property_name.is_number() && is_array() && !indexed_properties().get_element_fast(property_name.as_number()).is_empty())
+        return true;
+
     // 2. Let hasOwn be ? O.[[GetOwnProperty]](P).
     auto has_own = internal_get_own_property(property_name);
     if (vm.exception())
@@ -669,6 +677,12 @@ Value Object::internal_get(PropertyName const& property_name, Value receiver) co
     // 1. Assert: IsPropertyKey(P) is true.
     VERIFY(property_name.is_valid());
 
+    // NOTE: Array elements in simple storage are always own data properties, so we can return them directly.
+    if (property_name.is_number() && is_array()) {
+        if (auto value = indexed_properties().get_element_fast(property_name.as_number()); !value.is_empty() && !value.is_accessor())
+            return value;
+    }
+
     // 2. Let desc be ? O.[[GetOwnProperty]](P).
     auto descriptor = internal_get_own_property(property_name);
     if (vm.exception())
@@ -719,6 +733,12 @@ bool Object::internal_set(PropertyName const& property_name, Value value, Value
     // 1. Assert: IsPropertyKey(P) is true.
     VERIFY(property_name.is_valid());
 
+    // NOTE: Writing an existing element of an array, or appending one, doesn't need the full OrdinarySet dance.
+    if (property_name.is_number() && is_array() && receiver.is_object() && &receiver.as_object() == this) {
+        if (static_cast<Array&>(*this).set_element_fast(property_name.as_number(), value))
+            return true;
+    }
+
     // 2. Let ownDesc be ? O.[[GetOwnProperty]](P).
     auto own_descriptor = internal_get_own_property(property_name);
     if (vm.exception())
@@ -947,12 +967,9 @@ void Object::storage_set(PropertyName const& property_name, ValueAndAttributes c
 
     // NOTE: We disable transitions during initialize(), this makes building common runtime objects significantly faster.
     //       Transitions are primarily interesting when scripts add properties to objects.
-    if (!m_transitions_enabled && !m_shape->is_unique()) {
-        m_shape->add_property_without_transition(property_name, attributes);
-        m_storage.resize(m_shape->property_count());
-        m_storage[m_shape->property_count() - 1] = value;
-        return;
-    }
+    //       Our shape may be shared with other objects though, so it has to be made unique before we change it in place.
+    if (!m_transitions_enabled && !m_shape->is_unique())
+        ensure_shape_is_unique();
 
     auto property_name_string_or_symbol = property_name.to_string_or_symbol();
     auto metadata = shape().lookup(property_name_string_or_symbol);
@@ -967,11 +984,8 @@ void Object::storage_set(PropertyName const& property_name, ValueAndAttributes c
         if (m_shape->is_unique()) {
             m_shape->add_property_to_unique_shape(property_name_string_or_symbol, attributes);
             m_storage.resize(m_shape->property_count());
-        } else if (m_transitions_enabled) {
-            set_shape(*m_shape->create_put_transition(property_name_string_or_symbol, attributes));
         } else {
-            m_shape->add_property_without_transition(property_name, attributes);
-            m_storage.resize(m_shape->property_count());
+            set_shape(*m_shape->create_put_transition(property_name_string_or_symbol, attributes));
         }
         metadata = shape().lookup(property_name_string_or_symbol);
         VERIFY(metadata.has_value());
@@ -1169,6 +1183,11 @@ void Object::visit_edges(Cell::Visitor& visitor)
     for (auto& value : m_storage)
         visitor.visit(value);
 
+    // Numbers aren't cells, so there's nothing to visit in arrays that only hold numbers.
+    auto element_kind = m_indexed_properties.element_kind();
+    if (element_kind == ElementKind::PackedInt32 || element_kind == ElementKind::PackedDouble)
+        return;
+
     m_indexed_properties.for_each_value([&visitor](auto& value) {
         visitor.visit(value);
     });
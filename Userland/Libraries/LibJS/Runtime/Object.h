@@ -126,6 +126,7 @@ public:
     void define_native_function(PropertyName const&, Function<Value(VM&, GlobalObject&)>, i32 length, PropertyAttributes attributes);
     void define_native_accessor(PropertyName const&, Function<Value(VM&, GlobalObject&)> getter, Function<Value(VM&, GlobalObject&)> setter, PropertyAttributes attributes);
 
+    virtual bool is_array() const { return false; }
     virtual bool is_function() const { return false; }
     virtual bool is_typed_array() const { return false; }
     virtual bool is_string_object() const { return false; }
@@ -145,6 +146,7 @@ public:
     virtual Value value_of() const { return Value(const_cast<Object*>(this)); }
 
     Value get_direct(size_t index) const { return m_storage[index]; }
+    void put_direct(size_t index, Value value) { m_storage[index] = value; }
 
     const IndexedProperties& indexed_properties() const { return m_indexed_properties; }
     IndexedProperties& indexed_properties() { return m_indexed_properties; }
@@ -171,6 +173,10 @@ public:
 
     void ensure_shape_is_unique();
 
+    // Objects that implement [[Get]] or [[Set]] themselves can't have named property accesses answered by looking
+    // at their shape alone, so inline caches leave them alone.
+    bool may_interfere_with_inline_caches() const { return m_may_interfere_with_inline_caches; }
+
     void enable_transitions() { m_transitions_enabled = true; }
     void disable_transitions() { m_transitions_enabled = false; }
 
@@ -189,6 +195,8 @@ protected:
     // [[ParameterMap]]
     bool m_has_parameter_map { false };
 
+    bool m_may_interfere_with_inline_caches { false };
+
 private:
     void set_shape(Shape&);
 
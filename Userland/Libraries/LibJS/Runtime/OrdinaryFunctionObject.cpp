@@ -143,6 +143,16 @@ Value OrdinaryFunctionObject::execute_function_body()
 {
     auto& vm = this->vm();
 
+    // A lazily parsed body is parsed for real now, which shouldn't fail, but if it does the caller gets the error.
+    if (is<LazyFunctionBody>(*m_body)) {
+        auto& lazy_body = static_cast<LazyFunctionBody const&>(*m_body);
+        (void)lazy_body.parsed_body();
+        if (!lazy_body.parse_error().is_null()) {
+            vm.throw_exception<SyntaxError>(global_object(), lazy_body.parse_error());
+            return {};
+        }
+    }
+
     Interpreter* ast_interpreter = nullptr;
     auto* bytecode_interpreter = Bytecode::Interpreter::current();
 
@@ -180,18 +190,25 @@ Value OrdinaryFunctionObject::execute_function_body()
 
     if (bytecode_interpreter) {
         prepare_arguments();
-        if (!m_bytecode_executable.has_value()) {
-            m_bytecode_executable = Bytecode::Generator::generate(m_body, m_kind == FunctionKind::Generator);
-            auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
-            passes.perform(*m_bytecode_executable);
+        if (!m_bytecode_executable.has_value() && !is<PrecompiledFunctionBody>(body())) {
+            m_bytecode_executable = Bytecode::Generator::generate(body(), m_kind == FunctionKind::Generator, m_parameters);
+            if (JS::Bytecode::Interpreter::optimizations_enabled()) {
+                auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
+                passes.perform(*m_bytecode_executable);
+                dbgln_if(JS_BYTECODE_DEBUG, "Optimisation passes took {}us", passes.elapsed());
+            }
             if constexpr (JS_BYTECODE_DEBUG) {
-                dbgln("Optimisation passes took {}us", passes.elapsed());
                 dbgln("Compiled Bytecode::Block for function '{}':", m_name);
                 for (auto& block : m_bytecode_executable->basic_blocks)
                     block.dump(*m_bytecode_executable);
             }
         }
-        auto result = bytecode_interpreter->run(*m_bytecode_executable);
+        auto* executable = bytecode_executable();
+        if (!executable) {
+            vm.throw_exception<InternalError>(global_object(), ErrorType::InvalidFormat, "bytecode");
+            return {};
+        }
+        auto result = bytecode_interpreter->run(*executable);
         if (m_kind != FunctionKind::Generator)
             return result;
 
@@ -212,10 +229,25 @@ Value OrdinaryFunctionObject::execute_function_body()
         if (vm.exception())
             return {};
 
-        return ast_interpreter->execute_statement(global_object(), m_body, ScopeType::Function);
+        return ast_interpreter->execute_statement(global_object(), body(), ScopeType::Function);
     }
 }
 
+const Statement& OrdinaryFunctionObject::body() const
+{
+    // NOTE: We hold on to the lazy body, as the body it parses only lives as long as it does.
+    if (is<LazyFunctionBody>(*m_body))
+        return static_cast<LazyFunctionBody const&>(*m_body).parsed_body();
+    return m_body;
+}
+
+Bytecode::Executable const* OrdinaryFunctionObject::bytecode_executable() const
+{
+    if (is<PrecompiledFunctionBody>(body()))
+        return static_cast<PrecompiledFunctionBody const&>(body()).executable();
+    return m_bytecode_executable.has_value() ? &m_bytecode_executable.value() : nullptr;
+}
+
 Value OrdinaryFunctionObject::call()
 {
     if (m_is_class_constructor) {
@@ -22,7 +22,7 @@ public:
     virtual void initialize(GlobalObject&) override;
     virtual ~OrdinaryFunctionObject();
 
-    const Statement& body() const { return m_body; }
+    const Statement& body() const;
     const Vector<FunctionNode::Parameter>& parameters() const { return m_parameters; };
 
     virtual Value call() override;
@@ -33,7 +33,7 @@ public:
 
     void set_is_class_constructor() { m_is_class_constructor = true; };
 
-    auto& bytecode_executable() const { return m_bytecode_executable; }
+    Bytecode::Executable const* bytecode_executable() const;
 
     virtual Environment* environment() override { return m_environment; }
 
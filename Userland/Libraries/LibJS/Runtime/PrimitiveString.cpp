@@ -4,13 +4,36 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/VM.h>
 
 namespace JS {
 
+// Concatenations shorter than this are performed right away, as copying a few bytes is cheaper than another rope node.
+static constexpr size_t min_rope_length = 64;
+
+// Small strings appended to a rope are merged into its right-hand side, so that building a string piece by piece
+// doesn't create a rope node (and a level of depth) per piece.
+static constexpr size_t max_merged_right_hand_side_length = 256;
+
+// Ropes deeper than this get flattened, which keeps the amount of memory held by rope nodes proportional to the
+// length of the string they represent.
+static constexpr u32 max_rope_depth = 8192;
+
 PrimitiveString::PrimitiveString(String string)
-    : m_string(move(string))
+    : m_length(string.length())
+    , m_string(move(string))
+{
+}
+
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_is_rope(true)
+    , m_rope_depth(max(lhs.rope_depth(), rhs.rope_depth()) + 1)
+    , m_length(lhs.length() + rhs.length())
+    , m_lhs(&lhs)
+    , m_rhs(&rhs)
 {
 }
 
@@ -18,6 +41,42 @@ PrimitiveString::~PrimitiveString()
 {
 }
 
+void PrimitiveString::visit_edges(Cell::Visitor& visitor)
+{
+    Cell::visit_edges(visitor);
+    if (m_is_rope) {
+        visitor.visit(m_lhs);
+        visitor.visit(m_rhs);
+    }
+}
+
+void PrimitiveString::resolve_rope() const
+{
+    VERIFY(m_is_rope);
+
+    StringBuilder builder(m_length);
+
+    // Walk the tree in order with an explicit stack, as ropes built in a loop are very lopsided.
+    Vector<PrimitiveString const*> pieces;
+    pieces.append(m_rhs);
+    pieces.append(m_lhs);
+    while (!pieces.is_empty()) {
+        auto const* piece = pieces.take_last();
+        if (piece->m_is_rope) {
+            pieces.append(piece->m_rhs);
+            pieces.append(piece->m_lhs);
+            continue;
+        }
+        builder.append(piece->m_string);
+    }
+
+    m_string = builder.to_string();
+    m_is_rope = false;
+    m_rope_depth = 0;
+    m_lhs = nullptr;
+    m_rhs = nullptr;
+}
+
 PrimitiveString* js_string(Heap& heap, String string)
 {
     if (string.is_empty())
@@ -34,4 +93,37 @@ PrimitiveString* js_string(VM& vm, String string)
     return js_string(vm.heap(), move(string));
 }
 
+static String concatenate(PrimitiveString const& lhs, PrimitiveString const& rhs)
+{
+    StringBuilder builder(lhs.length() + rhs.length());
+    builder.append(lhs.string());
+    builder.append(rhs.string());
+    return builder.to_string();
+}
+
+PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    if (lhs.is_empty())
+        return &rhs;
+    if (rhs.is_empty())
+        return &lhs;
+
+    auto length = lhs.length() + rhs.length();
+    if (length < min_rope_length)
+        return js_string(vm, concatenate(lhs, rhs));
+
+    auto& heap = vm.heap();
+
+    // Fast path for appending to the right: ((a + b) + c) becomes (a + bc) if both b and c are small.
+    if (lhs.is_rope() && !rhs.is_rope() && !lhs.m_rhs->is_rope() && lhs.m_rhs->length() + rhs.length() <= max_merged_right_hand_side_length) {
+        auto* merged_rhs = js_string(vm, concatenate(*lhs.m_rhs, rhs));
+        return heap.allocate_without_global_object<PrimitiveString>(*lhs.m_lhs, *merged_rhs);
+    }
+
+    if (max(lhs.rope_depth(), rhs.rope_depth()) >= max_rope_depth)
+        return js_string(vm, concatenate(lhs, rhs));
+
+    return heap.allocate_without_global_object<PrimitiveString>(lhs, rhs);
+}
+
 }
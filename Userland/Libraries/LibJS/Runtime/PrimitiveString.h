@@ -14,17 +14,43 @@ namespace JS {
 class PrimitiveString final : public Cell {
 public:
     explicit PrimitiveString(String);
+    PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs);
     virtual ~PrimitiveString();
 
-    const String& string() const { return m_string; }
+    // A rope is the not-yet-performed concatenation of two other strings. It is flattened into a
+    // regular String the first time someone looks at its characters.
+    bool is_rope() const { return m_is_rope; }
+    u32 rope_depth() const { return m_rope_depth; }
+
+    size_t length() const { return m_length; }
+    bool is_empty() const { return m_length == 0; }
+
+    const String& string() const
+    {
+        if (m_is_rope)
+            resolve_rope();
+        return m_string;
+    }
 
 private:
+    friend PrimitiveString* js_rope_string(VM&, PrimitiveString&, PrimitiveString&);
+
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void resolve_rope() const;
+
+    mutable bool m_is_rope { false };
+    mutable u32 m_rope_depth { 0 };
+    size_t m_length { 0 };
 
-    String m_string;
+    mutable String m_string;
+    mutable PrimitiveString* m_lhs { nullptr };
+    mutable PrimitiveString* m_rhs { nullptr };
 };
 
 PrimitiveString* js_string(Heap&, String);
 PrimitiveString* js_string(VM&, String);
+PrimitiveString* js_rope_string(VM&, PrimitiveString& lhs, PrimitiveString& rhs);
 
 }
@@ -25,6 +25,7 @@ ProxyObject::ProxyObject(Object& target, Object& handler, Object& prototype)
     , m_target(target)
     , m_handler(handler)
 {
+    m_may_interfere_with_inline_caches = true;
 }
 
 ProxyObject::~ProxyObject()
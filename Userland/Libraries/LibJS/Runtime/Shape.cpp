@@ -28,7 +28,7 @@ Shape* Shape::get_or_prune_cached_forward_transition(TransitionKey const& key)
     auto it = m_forward_transitions.find(key);
     if (it == m_forward_transitions.end())
         return nullptr;
-    if (!it->value) {
+    if (!it->value || Heap::is_awaiting_sweep(*it->value)) {
         // The cached forward transition has gone stale (from garbage collection). Prune it.
         m_forward_transitions.remove(it);
         return nullptr;
@@ -36,6 +36,19 @@ Shape* Shape::get_or_prune_cached_forward_transition(TransitionKey const& key)
     return it->value;
 }
 
+Shape* Shape::get_or_prune_cached_prototype_transition(Object* prototype)
+{
+    auto it = m_prototype_transitions.find(prototype);
+    if (it == m_prototype_transitions.end())
+        return nullptr;
+    if (!it->value || Heap::is_awaiting_sweep(*it->value)) {
+        // The cached prototype transition has gone stale (from garbage collection). Prune it.
+        m_prototype_transitions.remove(it);
+        return nullptr;
+    }
+    return it->value;
+}
+
 Shape* Shape::create_put_transition(const StringOrSymbol& property_name, PropertyAttributes attributes)
 {
     TransitionKey key { property_name, attributes };
@@ -58,7 +71,18 @@ Shape* Shape::create_configure_transition(const StringOrSymbol& property_name, P
 
 Shape* Shape::create_prototype_transition(Object* new_prototype)
 {
-    return heap().allocate_without_global_object<Shape>(*this, new_prototype);
+    // NOTE: The prototype can't be a dangling pointer if the transition is still alive, since the new shape keeps it alive.
+    if (auto* existing_shape = get_or_prune_cached_prototype_transition(new_prototype))
+        return existing_shape;
+    auto* new_shape = heap().allocate_without_global_object<Shape>(*this, new_prototype);
+    m_prototype_transitions.set(new_prototype, new_shape);
+    return new_shape;
+}
+
+u64 Shape::next_serial()
+{
+    static u64 s_next_serial = 1;
+    return s_next_serial++;
 }
 
 Shape::Shape(ShapeWithoutGlobalObjectTag)
@@ -182,6 +206,7 @@ void Shape::add_property_to_unique_shape(const StringOrSymbol& property_name, Pr
     VERIFY(!m_property_table->contains(property_name));
     m_property_table->set(property_name, { m_property_table->size(), attributes });
     ++m_property_count;
+    invalidate_serial();
 }
 
 void Shape::reconfigure_property_in_unique_shape(const StringOrSymbol& property_name, PropertyAttributes attributes)
@@ -192,6 +217,7 @@ void Shape::reconfigure_property_in_unique_shape(const StringOrSymbol& property_
     VERIFY(it != m_property_table->end());
     it->value.attributes = attributes;
     m_property_table->set(property_name, it->value);
+    invalidate_serial();
 }
 
 void Shape::remove_property_from_unique_shape(const StringOrSymbol& property_name, size_t offset)
@@ -205,6 +231,7 @@ void Shape::remove_property_from_unique_shape(const StringOrSymbol& property_nam
         if (it.value.offset > offset)
             --it.value.offset;
     }
+    invalidate_serial();
 }
 
 void Shape::add_property_without_transition(StringOrSymbol const& property_name, PropertyAttributes attributes)
@@ -213,6 +240,7 @@ void Shape::add_property_without_transition(StringOrSymbol const& property_name,
     ensure_property_table();
     if (m_property_table->set(property_name, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry)
         ++m_property_count;
+    invalidate_serial();
 }
 
 FLATTEN void Shape::add_property_without_transition(PropertyName const& property_name, PropertyAttributes attributes)
@@ -61,6 +61,10 @@ public:
     void add_property_without_transition(PropertyName const&, PropertyAttributes);
 
     bool is_unique() const { return m_unique; }
+
+    // Identifies this shape and its current layout to inline caches. Unlike the address of the shape, a serial
+    // number is never reused, and it changes whenever the shape is modified in place.
+    u64 serial() const { return m_serial; }
     Shape* create_unique_clone() const;
 
     GlobalObject* global_object() const;
@@ -79,7 +83,11 @@ public:
 
     Vector<Property> property_table_ordered() const;
 
-    void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
+    void set_prototype_without_transition(Object* new_prototype)
+    {
+        m_prototype = new_prototype;
+        invalidate_serial();
+    }
 
     void remove_property_from_unique_shape(const StringOrSymbol&, size_t offset);
     void add_property_to_unique_shape(const StringOrSymbol&, PropertyAttributes attributes);
@@ -90,8 +98,12 @@ private:
     virtual void visit_edges(Visitor&) override;
 
     Shape* get_or_prune_cached_forward_transition(TransitionKey const&);
+    Shape* get_or_prune_cached_prototype_transition(Object* prototype);
     void ensure_property_table() const;
 
+    static u64 next_serial();
+    void invalidate_serial() { m_serial = next_serial(); }
+
     PropertyAttributes m_attributes { 0 };
     TransitionType m_transition_type : 6 { TransitionType::Invalid };
     bool m_unique : 1 { false };
@@ -101,10 +113,12 @@ private:
     mutable OwnPtr<HashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
 
     HashMap<TransitionKey, WeakPtr<Shape>> m_forward_transitions;
+    HashMap<Object*, WeakPtr<Shape>> m_prototype_transitions;
     Shape* m_previous { nullptr };
     StringOrSymbol m_property_name;
     Object* m_prototype { nullptr };
     size_t m_property_count { 0 };
+    u64 m_serial { next_serial() };
 };
 
 }
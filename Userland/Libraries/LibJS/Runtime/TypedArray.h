@@ -49,6 +49,8 @@ protected:
     explicit TypedArrayBase(Object& prototype)
         : Object(prototype)
     {
+        // Canonical numeric strings like "Infinity" are looked up as indices, not in our shape.
+        m_may_interfere_with_inline_caches = true;
     }
 
     u32 m_array_length { 0 };
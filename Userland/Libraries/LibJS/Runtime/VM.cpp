@@ -8,6 +8,7 @@
 #include <AK/Debug.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
@@ -117,6 +118,9 @@ void VM::gather_roots(HashTable<Cell*>& roots)
     for (auto& symbol : m_global_symbol_map)
         roots.set(symbol.value);
 
+    if (auto* bytecode_interpreter = Bytecode::Interpreter::current())
+        bytecode_interpreter->gather_roots(roots);
+
     for (auto* job : m_promise_jobs)
         roots.set(job);
 }
@@ -27,6 +27,28 @@ static constexpr u64 NEGATIVE_ZERO_BITS = ((u64)1 << 63);
 
 namespace JS {
 
+// Values are NaN-boxed into 64 bits: doubles are stored as they are, and everything else is stored in the payload of a NaN.
+// All NaN doubles are canonicalized to CANON_NAN_BITS, which frees up the top 16 bits of all other NaNs to be used as a tag.
+// Cells have the sign bit set in their tag, and the 48 bits below it hold the cell pointer. This relies on user space
+// pointers fitting into 48 bits, which is the case on all platforms we run on.
+static constexpr u64 CANON_NAN_BITS = 0x7FF8000000000000;
+static constexpr u64 TAG_SHIFT = 48;
+static constexpr u64 PAYLOAD_MASK = 0x0000FFFFFFFFFFFF;
+static constexpr u64 BASE_TAG = 0x7FF8;
+static constexpr u64 BOOLEAN_TAG = BASE_TAG | 0b001;
+static constexpr u64 INT32_TAG = BASE_TAG | 0b010;
+static constexpr u64 EMPTY_TAG = BASE_TAG | 0b011;
+static constexpr u64 UNDEFINED_TAG = BASE_TAG | 0b110;
+static constexpr u64 NULL_TAG = BASE_TAG | 0b111;
+static constexpr u64 IS_CELL_BIT = 0x8000 | BASE_TAG;
+static constexpr u64 OBJECT_TAG = IS_CELL_BIT | 0b001;
+static constexpr u64 STRING_TAG = IS_CELL_BIT | 0b010;
+static constexpr u64 SYMBOL_TAG = IS_CELL_BIT | 0b011;
+static constexpr u64 ACCESSOR_TAG = IS_CELL_BIT | 0b100;
+static constexpr u64 BIGINT_TAG = IS_CELL_BIT | 0b101;
+static constexpr u64 SHIFTED_BASE_TAG = BASE_TAG << TAG_SHIFT;
+static constexpr u64 SHIFTED_IS_CELL_PATTERN = IS_CELL_BIT << TAG_SHIFT;
+
 class Value {
 public:
     enum class Type {
@@ -49,29 +71,31 @@ public:
         Number,
     };
 
-    bool is_empty() const { return m_type == Type::Empty; }
-    bool is_undefined() const { return m_type == Type::Undefined; }
-    bool is_null() const { return m_type == Type::Null; }
-    bool is_number() const { return m_type == Type::Int32 || m_type == Type::Double; }
-    bool is_string() const { return m_type == Type::String; }
-    bool is_object() const { return m_type == Type::Object; }
-    bool is_boolean() const { return m_type == Type::Boolean; }
-    bool is_symbol() const { return m_type == Type::Symbol; }
-    bool is_accessor() const { return m_type == Type::Accessor; };
-    bool is_bigint() const { return m_type == Type::BigInt; };
-    bool is_nullish() const { return is_null() || is_undefined(); }
-    bool is_cell() const { return is_string() || is_accessor() || is_object() || is_bigint() || is_symbol(); }
+    bool is_empty() const { return tag() == EMPTY_TAG; }
+    bool is_undefined() const { return tag() == UNDEFINED_TAG; }
+    bool is_null() const { return tag() == NULL_TAG; }
+    bool is_number() const { return is_double() || is_int32(); }
+    // Numbers that are stored as an Int32 (not just any integral number), which fast paths can use without converting.
+    bool is_int32() const { return tag() == INT32_TAG; }
+    bool is_string() const { return tag() == STRING_TAG; }
+    bool is_object() const { return tag() == OBJECT_TAG; }
+    bool is_boolean() const { return tag() == BOOLEAN_TAG; }
+    bool is_symbol() const { return tag() == SYMBOL_TAG; }
+    bool is_accessor() const { return tag() == ACCESSOR_TAG; };
+    bool is_bigint() const { return tag() == BIGINT_TAG; };
+    bool is_nullish() const { return (tag() & 0xFFFE) == UNDEFINED_TAG; }
+    bool is_cell() const { return (m_value & SHIFTED_IS_CELL_PATTERN) == SHIFTED_IS_CELL_PATTERN; }
     bool is_array(GlobalObject&) const;
     bool is_function() const;
     bool is_constructor() const;
     bool is_regexp(GlobalObject&) const;
 
-    bool is_nan() const { return is_number() && __builtin_isnan(as_double()); }
+    bool is_nan() const { return m_value == CANON_NAN_BITS; }
     bool is_infinity() const { return is_number() && __builtin_isinf(as_double()); }
     bool is_positive_infinity() const { return is_number() && __builtin_isinf_sign(as_double()) > 0; }
     bool is_negative_infinity() const { return is_number() && __builtin_isinf_sign(as_double()) < 0; }
     bool is_positive_zero() const { return is_number() && bit_cast<u64>(as_double()) == 0; }
-    bool is_negative_zero() const { return is_number() && bit_cast<u64>(as_double()) == NEGATIVE_ZERO_BITS; }
+    bool is_negative_zero() const { return m_value == NEGATIVE_ZERO_BITS; }
     bool is_integral_number() const { return is_finite_number() && static_cast<i64>(as_double()) == as_double(); }
     bool is_finite_number() const
     {
@@ -82,168 +106,205 @@ public:
     }
 
     Value()
-        : m_type(Type::Empty)
+        : Value(EMPTY_TAG, 0)
     {
     }
 
     explicit Value(bool value)
-        : m_type(Type::Boolean)
+        : Value(BOOLEAN_TAG, value ? 1 : 0)
     {
-        m_value.as_bool = value;
     }
 
     explicit Value(double value)
     {
         bool is_negative_zero = bit_cast<u64>(value) == NEGATIVE_ZERO_BITS;
-        if (value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max() && trunc(value) == value && !is_negative_zero) {
-            m_type = Type::Int32;
-            m_value.as_i32 = static_cast<i32>(value);
-        } else {
-            m_type = Type::Double;
-            m_value.as_double = value;
-        }
+        if (value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max() && trunc(value) == value && !is_negative_zero)
+            m_value = encode(INT32_TAG, static_cast<u32>(static_cast<i32>(value)));
+        else if (__builtin_isnan(value))
+            m_value = CANON_NAN_BITS;
+        else
+            m_value = bit_cast<u64>(value);
     }
 
     explicit Value(unsigned long value)
     {
-        if (value > NumericLimits<i32>::max()) {
-            m_value.as_double = static_cast<double>(value);
-            m_type = Type::Double;
-        } else {
-            m_value.as_i32 = static_cast<i32>(value);
-            m_type = Type::Int32;
-        }
+        if (value > NumericLimits<i32>::max())
+            m_value = bit_cast<u64>(static_cast<double>(value));
+        else
+            m_value = encode(INT32_TAG, static_cast<u32>(value));
     }
 
     explicit Value(unsigned value)
     {
-        if (value > NumericLimits<i32>::max()) {
-            m_value.as_double = static_cast<double>(value);
-            m_type = Type::Double;
-        } else {
-            m_value.as_i32 = static_cast<i32>(value);
-            m_type = Type::Int32;
-        }
+        if (value > NumericLimits<i32>::max())
+            m_value = bit_cast<u64>(static_cast<double>(value));
+        else
+            m_value = encode(INT32_TAG, value);
     }
 
     explicit Value(i32 value)
-        : m_type(Type::Int32)
+        : Value(INT32_TAG, static_cast<u32>(value))
     {
-        m_value.as_i32 = value;
     }
 
     Value(const Object* object)
-        : m_type(object ? Type::Object : Type::Null)
+        : Value(object ? OBJECT_TAG : NULL_TAG, reinterpret_cast<FlatPtr>(object))
     {
-        m_value.as_object = const_cast<Object*>(object);
     }
 
     Value(const PrimitiveString* string)
-        : m_type(Type::String)
+        : Value(STRING_TAG, reinterpret_cast<FlatPtr>(string))
     {
-        m_value.as_string = const_cast<PrimitiveString*>(string);
     }
 
     Value(const Symbol* symbol)
-        : m_type(Type::Symbol)
+        : Value(SYMBOL_TAG, reinterpret_cast<FlatPtr>(symbol))
     {
-        m_value.as_symbol = const_cast<Symbol*>(symbol);
     }
 
     Value(const Accessor* accessor)
-        : m_type(Type::Accessor)
+        : Value(ACCESSOR_TAG, reinterpret_cast<FlatPtr>(accessor))
     {
-        m_value.as_accessor = const_cast<Accessor*>(accessor);
     }
 
     Value(const BigInt* bigint)
-        : m_type(Type::BigInt)
+        : Value(BIGINT_TAG, reinterpret_cast<FlatPtr>(bigint))
     {
-        m_value.as_bigint = const_cast<BigInt*>(bigint);
     }
 
     explicit Value(Type type)
-        : m_type(type)
     {
+        switch (type) {
+        case Type::Empty:
+            m_value = encode(EMPTY_TAG, 0);
+            break;
+        case Type::Undefined:
+            m_value = encode(UNDEFINED_TAG, 0);
+            break;
+        case Type::Null:
+            m_value = encode(NULL_TAG, 0);
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
     }
 
-    Type type() const { return m_type; }
+    Type type() const
+    {
+        if (is_double())
+            return Type::Double;
+        switch (tag()) {
+        case EMPTY_TAG:
+            return Type::Empty;
+        case UNDEFINED_TAG:
+            return Type::Undefined;
+        case NULL_TAG:
+            return Type::Null;
+        case INT32_TAG:
+            return Type::Int32;
+        case BOOLEAN_TAG:
+            return Type::Boolean;
+        case STRING_TAG:
+            return Type::String;
+        case OBJECT_TAG:
+            return Type::Object;
+        case SYMBOL_TAG:
+            return Type::Symbol;
+        case ACCESSOR_TAG:
+            return Type::Accessor;
+        case BIGINT_TAG:
+            return Type::BigInt;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
 
     double as_double() const
     {
         VERIFY(is_number());
-        if (m_type == Type::Int32)
-            return m_value.as_i32;
-        return m_value.as_double;
+        if (is_int32())
+            return int32_payload();
+        return bit_cast<double>(m_value);
     }
 
     bool as_bool() const
     {
-        VERIFY(type() == Type::Boolean);
-        return m_value.as_bool;
+        VERIFY(is_boolean());
+        return m_value & 1;
     }
 
     Object& as_object()
     {
-        VERIFY(type() == Type::Object);
-        return *m_value.as_object;
+        VERIFY(is_object());
+        return *extract_pointer<Object>();
     }
 
     const Object& as_object() const
     {
-        VERIFY(type() == Type::Object);
-        return *m_value.as_object;
+        VERIFY(is_object());
+        return *extract_pointer<Object>();
     }
 
     PrimitiveString& as_string()
     {
         VERIFY(is_string());
-        return *m_value.as_string;
+        return *extract_pointer<PrimitiveString>();
     }
 
     const PrimitiveString& as_string() const
     {
         VERIFY(is_string());
-        return *m_value.as_string;
+        return *extract_pointer<PrimitiveString>();
     }
 
     Symbol& as_symbol()
     {
         VERIFY(is_symbol());
-        return *m_value.as_symbol;
+        return *extract_pointer<Symbol>();
     }
 
     const Symbol& as_symbol() const
     {
         VERIFY(is_symbol());
-        return *m_value.as_symbol;
+        return *extract_pointer<Symbol>();
     }
 
     Cell& as_cell()
     {
         VERIFY(is_cell());
-        return *m_value.as_cell;
+        return *extract_pointer<Cell>();
     }
 
     Accessor& as_accessor()
     {
         VERIFY(is_accessor());
-        return *m_value.as_accessor;
+        return *extract_pointer<Accessor>();
     }
 
     BigInt& as_bigint()
     {
         VERIFY(is_bigint());
-        return *m_value.as_bigint;
+        return *extract_pointer<BigInt>();
+    }
+
+    const BigInt& as_bigint() const
+    {
+        VERIFY(is_bigint());
+        return *extract_pointer<BigInt>();
     }
 
     Array& as_array();
     FunctionObject& as_function();
 
-    i32 as_i32() const;
+    i32 as_i32() const
+    {
+        if (is_int32())
+            return int32_payload();
+        return static_cast<i32>(as_double());
+    }
     u32 as_u32() const;
 
-    u64 encoded() const { return m_value.encoded; }
+    u64 encoded() const { return m_value; }
 
     String to_string(GlobalObject&, bool legacy_null_to_empty_string = false) const;
     PrimitiveString* to_primitive_string(GlobalObject&);
@@ -258,8 +319,8 @@ public:
     StringOrSymbol to_property_key(GlobalObject&) const;
     i32 to_i32(GlobalObject& global_object) const
     {
-        if (m_type == Type::Int32)
-            return m_value.as_i32;
+        if (is_int32())
+            return int32_payload();
         return to_i32_slow_case(global_object);
     }
     u32 to_u32(GlobalObject&) const;
@@ -290,25 +351,30 @@ public:
     bool operator==(Value const&) const;
 
 private:
-    Type m_type { Type::Empty };
+    Value(u64 tag, u64 payload)
+        : m_value(encode(tag, payload))
+    {
+    }
+
+    static constexpr u64 encode(u64 tag, u64 payload) { return (tag << TAG_SHIFT) | payload; }
+
+    u64 tag() const { return m_value >> TAG_SHIFT; }
+
+    // Anything that doesn't have all bits of BASE_TAG set is a double, and so is the one NaN we let through.
+    bool is_double() const { return (m_value & SHIFTED_BASE_TAG) != SHIFTED_BASE_TAG || m_value == CANON_NAN_BITS; }
+
+    i32 int32_payload() const { return static_cast<i32>(static_cast<u32>(m_value)); }
+
+    template<typename T>
+    T* extract_pointer() const { return reinterpret_cast<T*>(static_cast<FlatPtr>(m_value & PAYLOAD_MASK)); }
 
     i32 to_i32_slow_case(GlobalObject&) const;
 
-    union {
-        bool as_bool;
-        i32 as_i32;
-        double as_double;
-        PrimitiveString* as_string;
-        Symbol* as_symbol;
-        Object* as_object;
-        Cell* as_cell;
-        Accessor* as_accessor;
-        BigInt* as_bigint;
-
-        u64 encoded;
-    } m_value { .encoded = 0 };
+    u64 m_value { encode(EMPTY_TAG, 0) };
 };
 
+static_assert(sizeof(Value) == sizeof(u64));
+
 inline Value js_undefined()
 {
     return Value(Value::Type::Undefined);
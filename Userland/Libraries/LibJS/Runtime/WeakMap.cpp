@@ -23,9 +23,14 @@ WeakMap::~WeakMap()
 {
 }
 
-void WeakMap::remove_swept_cells(Badge<Heap>, Vector<Cell*>& cells)
+void WeakMap::remove_dead_cells(Badge<Heap>)
 {
-    for (auto* cell : cells)
+    Vector<Cell*> dead_cells;
+    for (auto& entry : m_values) {
+        if (!entry.key->is_marked())
+            dead_cells.append(entry.key);
+    }
+    for (auto* cell : dead_cells)
         m_values.remove(cell);
 }
 
@@ -23,9 +23,14 @@ WeakSet::~WeakSet()
 {
 }
 
-void WeakSet::remove_swept_cells(Badge<Heap>, Vector<Cell*>& cells)
+void WeakSet::remove_dead_cells(Badge<Heap>)
 {
-    for (auto* cell : cells)
+    Vector<Cell*> dead_cells;
+    for (auto* cell : m_values) {
+        if (!cell->is_marked())
+            dead_cells.append(cell);
+    }
+    for (auto* cell : dead_cells)
         m_values.remove(cell);
 }
 
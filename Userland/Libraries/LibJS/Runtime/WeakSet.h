@@ -27,7 +27,7 @@ public:
     HashTable<Cell*> const& values() const { return m_values; };
     HashTable<Cell*>& values() { return m_values; };
 
-    virtual void remove_swept_cells(Badge<Heap>, Vector<Cell*>&) override;
+    virtual void remove_dead_cells(Badge<Heap>) override;
 
 private:
     HashTable<Cell*> m_values; // This stores Cell pointers instead of Object pointers to aide with sweeping
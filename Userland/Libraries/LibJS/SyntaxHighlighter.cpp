@@ -97,7 +97,7 @@ void SyntaxHighlighter::rehighlight(const Palette& palette)
     bool was_eof = false;
     for (auto token = lexer.next(); !was_eof; token = lexer.next()) {
         append_token(token.trivia(), token, true);
-        append_token(token.value(), token, false);
+        append_token(token.original_value(), token, false);
 
         if (token.type() == JS::TokenType::Eof)
             was_eof = true;
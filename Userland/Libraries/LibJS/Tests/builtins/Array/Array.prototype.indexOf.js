@@ -23,3 +23,20 @@ test("basic functionality", () => {
     expect([].indexOf()).toBe(-1);
     expect([undefined].indexOf()).toBe(0);
 });
+
+test("arrays of numbers", () => {
+    var array = [1, 2.5, NaN, -0, 2];
+
+    expect(array.indexOf(2)).toBe(4);
+    expect(array.indexOf(2.5)).toBe(1);
+    expect(array.indexOf(NaN)).toBe(-1);
+    expect(array.indexOf(0)).toBe(3);
+    expect(array.indexOf("1")).toBe(-1);
+});
+
+test("holes are looked up on the prototype", () => {
+    var array = [1];
+    array[2] = 3;
+    Object.setPrototypeOf(array, [0, "hole"]);
+    expect(Array.prototype.indexOf.call(array, "hole")).toBe(1);
+});
@@ -21,3 +21,20 @@ describe("normal behavior", () => {
         expect(a).toEqual(["hello", "friends", 1, 2, 3]);
     });
 });
+
+describe("special cases", () => {
+    test("setter on the prototype", () => {
+        var values = [];
+        var prototype = Object.create(Array.prototype);
+        Object.defineProperty(prototype, 1, {
+            set: value => {
+                values.push(value);
+            },
+        });
+        var a = ["hello"];
+        Object.setPrototypeOf(a, prototype);
+        expect(a.push("friends")).toBe(2);
+        expect(a.hasOwnProperty(1)).toBeFalse();
+        expect(values).toEqual(["friends"]);
+    });
+});
@@ -2,8 +2,16 @@ test("length is 0", () => {
     expect(FinalizationRegistry.prototype.cleanupSome).toHaveLength(0);
 });
 
-function registerInDifferentScope(registry) {
-    registry.register({}, {});
+// Conservative stack scanning can keep a target alive through a stale copy of it on the stack, so several targets
+// are registered, and the cleanups are checked against the ones that actually died.
+function registerInDifferentScope(registry, count) {
+    const weakRefs = [];
+    for (let i = 0; i < count; ++i) {
+        const target = {};
+        registry.register(target, {});
+        weakRefs.push(new WeakRef(target));
+    }
+    return weakRefs;
 }
 
 test("basic functionality", () => {
@@ -18,12 +26,15 @@ test("basic functionality", () => {
 
     expect(count).toBe(0);
 
-    registerInDifferentScope(registry);
+    var weakRefs = registerInDifferentScope(registry, 10);
+    finishExecutionGeneration();
     gc();
 
     registry.cleanupSome(increment);
 
-    expect(count).toBe(1);
+    var deadTargets = weakRefs.filter(weakRef => weakRef.deref() === undefined).length;
+    expect(deadTargets).toBeGreaterThan(0);
+    expect(count).toBe(deadTargets);
 });
 
 test("errors", () => {
@@ -33,3 +44,28 @@ test("errors", () => {
         registry.cleanupSome(5);
     }).toThrowWithMessage(TypeError, "is not a function");
 });
+
+test("targets that died are cleaned up once, even after their cells are reused", () => {
+    var registry = new FinalizationRegistry(() => {});
+    var live = {};
+    registry.register(live, "live");
+    (() => {
+        for (let i = 0; i < 100; ++i) registry.register({ a: i }, i);
+    })();
+    gc();
+
+    // These objects are allocated in the cells the dead targets were in.
+    var objects = [];
+    for (let i = 0; i < 10000; ++i) objects.push({ a: i });
+
+    // (A few targets may stay alive, if stale copies of them are left on the stack.)
+    var heldValues = [];
+    registry.cleanupSome(heldValue => heldValues.push(heldValue));
+    expect(heldValues.length).toBeGreaterThan(50);
+
+    gc();
+    registry.cleanupSome(heldValue => heldValues.push(heldValue));
+    expect(heldValues).not.toContain("live");
+    expect(new Set(heldValues).size).toBe(heldValues.length);
+    heldValues.forEach(heldValue => expect(heldValue >= 0 && heldValue < 100).toBeTrue());
+});
@@ -21,10 +21,45 @@ test("invalid values", () => {
 
 test("automatic removal of garbage-collected values", () => {
     const weakMap = new WeakMap();
-    {
-        expect(weakMap.set({ a: 1 }, 1)).toBe(weakMap);
-        expect(getWeakMapSize(weakMap)).toBe(1);
-    }
+    // Conservative stack scanning can keep a key alive through a stale copy of it on the stack, so several keys
+    // are added, and the map is checked against the ones that actually died.
+    const weakRefs = (() => {
+        const weakRefs = [];
+        for (let i = 0; i < 10; ++i) {
+            const key = { a: i };
+            expect(weakMap.set(key, i)).toBe(weakMap);
+            weakRefs.push(new WeakRef(key));
+        }
+        return weakRefs;
+    })();
+    expect(getWeakMapSize(weakMap)).toBe(10);
+    finishExecutionGeneration();
     gc();
-    expect(getWeakMapSize(weakMap)).toBe(0);
+
+    const liveKeys = weakRefs.filter(weakRef => weakRef.deref() !== undefined).length;
+    expect(liveKeys).toBeLessThan(10);
+    expect(getWeakMapSize(weakMap)).toBe(liveKeys);
+});
+
+test("keys that died are gone before their cells are reused", () => {
+    const weakMap = new WeakMap();
+    const live = { a: -1 };
+    weakMap.set(live, "live");
+    (() => {
+        for (let i = 0; i < 100; ++i) weakMap.set({ a: i }, i);
+    })();
+    gc();
+
+    // The dead keys' cells haven't been swept yet, but their entries must already be gone.
+    // (A few keys may stay alive, if stale copies of them are left on the stack.)
+    const size = getWeakMapSize(weakMap);
+    expect(size).toBeLessThan(50);
+    expect(weakMap.get(live)).toBe("live");
+
+    // These objects are allocated in the cells the dead keys were in.
+    const objects = [];
+    for (let i = 0; i < 10000; ++i) objects.push({ a: i });
+    expect(objects.some(object => weakMap.has(object))).toBeFalse();
+    expect(getWeakMapSize(weakMap)).toBe(size);
+    expect(weakMap.get(live)).toBe("live");
 });
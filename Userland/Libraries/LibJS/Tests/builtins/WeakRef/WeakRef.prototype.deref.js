@@ -19,3 +19,30 @@ test("kept alive for current synchronous execution sequence", () => {
     // This is fine 🔥
     expect(weakRef.deref()).not.toBe(undefined);
 });
+
+test("targets that died are gone before their cells are reused", () => {
+    const live = { a: -1 };
+    const liveWeakRef = new WeakRef(live);
+    const weakRefs = (() => {
+        const weakRefs = [];
+        for (let i = 0; i < 100; ++i) weakRefs.push(new WeakRef({ a: i }));
+        return weakRefs;
+    })();
+    finishExecutionGeneration();
+    gc();
+
+    // The targets' cells haven't been swept yet, but they must already be unreachable.
+    // (A few targets may stay alive, if stale copies of them are left on the stack.)
+    const isAlive = weakRefs.map(weakRef => weakRef.deref() !== undefined);
+    expect(isAlive.filter(alive => alive).length).toBeLessThan(50);
+    expect(liveWeakRef.deref()).toBe(live);
+
+    // These objects are allocated in the cells the dead targets were in.
+    const objects = [];
+    for (let i = 0; i < 10000; ++i) objects.push({ a: i });
+    weakRefs.forEach((weakRef, i) => {
+        if (isAlive[i]) expect(weakRef.deref().a).toBe(i);
+        else expect(weakRef.deref()).toBeUndefined();
+    });
+    expect(liveWeakRef.deref()).toBe(live);
+});
@@ -17,10 +17,45 @@ test("invalid values", () => {
 
 test("automatic removal of garbage-collected values", () => {
     const weakSet = new WeakSet();
-    {
-        expect(weakSet.add({ a: 1 })).toBe(weakSet);
-        expect(getWeakSetSize(weakSet)).toBe(1);
-    }
+    // Conservative stack scanning can keep a value alive through a stale copy of it on the stack, so several values
+    // are added, and the set is checked against the ones that actually died.
+    const weakRefs = (() => {
+        const weakRefs = [];
+        for (let i = 0; i < 10; ++i) {
+            const value = { a: i };
+            expect(weakSet.add(value)).toBe(weakSet);
+            weakRefs.push(new WeakRef(value));
+        }
+        return weakRefs;
+    })();
+    expect(getWeakSetSize(weakSet)).toBe(10);
+    finishExecutionGeneration();
     gc();
-    expect(getWeakSetSize(weakSet)).toBe(0);
+
+    const liveValues = weakRefs.filter(weakRef => weakRef.deref() !== undefined).length;
+    expect(liveValues).toBeLessThan(10);
+    expect(getWeakSetSize(weakSet)).toBe(liveValues);
+});
+
+test("values that died are gone before their cells are reused", () => {
+    const weakSet = new WeakSet();
+    const live = { a: -1 };
+    weakSet.add(live);
+    (() => {
+        for (let i = 0; i < 100; ++i) weakSet.add({ a: i });
+    })();
+    gc();
+
+    // The dead values' cells haven't been swept yet, but they must already be gone from the set.
+    // (A few values may stay alive, if stale copies of them are left on the stack.)
+    const size = getWeakSetSize(weakSet);
+    expect(size).toBeLessThan(50);
+    expect(weakSet.has(live)).toBeTrue();
+
+    // These objects are allocated in the cells the dead values were in.
+    const objects = [];
+    for (let i = 0; i < 10000; ++i) objects.push({ a: i });
+    expect(objects.some(object => weakSet.has(object))).toBeFalse();
+    expect(getWeakSetSize(weakSet)).toBe(size);
+    expect(weakSet.has(live)).toBeTrue();
 });
@@ -0,0 +1,150 @@
+// The bodies of nested functions are only parsed when they're first called.
+
+test("closures see variables of the functions around them", () => {
+    function outer(a) {
+        let b = a + 1;
+        function middle() {
+            const inner = () => {
+                b *= 2;
+                return a + b;
+            };
+            return inner();
+        }
+        return [middle(), middle(), b];
+    }
+    expect(outer(1)).toEqual([5, 9, 8]);
+});
+
+test("variables captured by parameters", () => {
+    function foo(a, getA = () => a) {
+        a = 2;
+        return getA();
+    }
+    expect(foo(1)).toBe(2);
+});
+
+test("arguments referenced from parameters", () => {
+    function foo(a, b = arguments.length) {
+        return b;
+    }
+    expect(foo(1)).toBe(1);
+});
+
+test("strict mode is inherited", () => {
+    "use strict";
+    function foo() {
+        return function () {
+            return this;
+        };
+    }
+    expect(foo()()).toBeUndefined();
+});
+
+test("generators", () => {
+    expect("function foo() { function* bar() { yield 1; } }").toEval();
+    expect("function foo() { function bar() { yield 1; } }").not.toEval();
+});
+
+test("methods using super", () => {
+    class A {
+        foo() {
+            return "A";
+        }
+    }
+    class B extends A {
+        foo() {
+            return `B${super.foo()}`;
+        }
+    }
+    expect(new B().foo()).toBe("BA");
+});
+
+test("functions inside template literals", () => {
+    const result = `${(() => {
+        return `${[1, 2].map(x => {
+            return x * 2;
+        })}`;
+    })()}`;
+    expect(result).toBe("2,4");
+});
+
+test("functions declared in blocks", () => {
+    function foo() {
+        {
+            function bar() {
+                return "bar";
+            }
+        }
+        return bar();
+    }
+    expect(foo()).toBe("bar");
+});
+
+test("syntax errors in bodies that are never called", () => {
+    expect("function foo() { function bar() { return 1 +; } }").not.toEval();
+    expect("function foo() { () => { return 1 +; }; }").not.toEval();
+    expect("function foo() { 'use strict'; function bar() { with ({}) {} } }").not.toEval();
+    expect("function foo() { function bar() { 'use strict'; with ({}) {} } }").not.toEval();
+    expect("function foo() { break; }").not.toEval();
+    expect("function foo() { a: { continue a; } }").not.toEval();
+    expect("function foo() { 1 = 2; }").not.toEval();
+    expect("function foo() { ({ a: 1 } = {}); }").not.toEval();
+});
+
+// Once a function's body has been checked, parsing the function around it again skips over it.
+test("variables captured through several skipped bodies", () => {
+    function level1() {
+        let count = 0;
+        function level2() {
+            function level3() {
+                function level4() {
+                    return ++count;
+                }
+                return level4();
+            }
+            return level3();
+        }
+        level2();
+        return [level2(), count];
+    }
+    expect(level1()).toEqual([2, 2]);
+});
+
+test("strict mode of skipped bodies", () => {
+    function outer() {
+        function strict() {
+            "use strict";
+            return isStrictMode();
+        }
+        function sloppy() {
+            return isStrictMode();
+        }
+        return [strict(), sloppy()];
+    }
+    expect(outer()).toEqual([true, false]);
+});
+
+test("direct eval in skipped bodies", () => {
+    function outer() {
+        var hidden = "outer";
+        function inner() {
+            return eval("hidden");
+        }
+        return inner();
+    }
+    expect(outer()).toBe("outer");
+});
+
+test("curlies in skipped bodies that aren't blocks", () => {
+    function outer() {
+        function inner() {
+            // }
+            /* } */
+            const strings = ["}", '{', `}${"{"}${`}`}`];
+            const regex = /[{}]}/;
+            return strings.join("") + regex.source;
+        }
+        return inner();
+    }
+    expect(outer()).toBe("}{}{}[{}]}");
+});
@@ -0,0 +1,56 @@
+test("escaped identifiers name the same binding as unescaped ones", () => {
+    var \u0061 = 1;
+    expect(a).toBe(1);
+    var b\u{62} = 2;
+    expect(bb).toBe(2);
+    expect(\u{62}b).toBe(2);
+    const obj = { c: 3 };
+    expect(obj.\u0063).toBe(3);
+    expect({ \u0064: 4 }.d).toBe(4);
+});
+
+test("closures capture variables referenced through escapes", () => {
+    function outer() {
+        var captured = 1;
+        const read = () => c\u0061ptured;
+        captured = 2;
+        return read;
+    }
+    expect(outer()()).toBe(2);
+
+    function counter() {
+        var count = 0;
+        return function () {
+            return ++\u{63}ount;
+        };
+    }
+    const next = counter();
+    next();
+    expect(next()).toBe(2);
+});
+
+test("escaped arguments refers to the arguments object", () => {
+    function f() {
+        return \u0061rguments.length;
+    }
+    expect(f(1, 2, 3)).toBe(3);
+
+    function g() {
+        const first = \u{61}rguments[0];
+        return first + \u0061rguments[1];
+    }
+    expect(g(1, 2)).toBe(3);
+});
+
+test("keywords must not contain escapes", () => {
+    expect("v\\u0061r x = 1;").not.toEval();
+    expect("\\u0069f (true) {}").not.toEval();
+    expect("var l\\u0065t = 1;").toEval();
+});
+
+test("invalid escapes", () => {
+    expect("var \\u0030 = 1;").not.toEval();
+    expect("var a\\u002d = 1;").not.toEval();
+    expect("var \\u{110000} = 1;").not.toEval();
+    expect("var \\x61 = 1;").not.toEval();
+});
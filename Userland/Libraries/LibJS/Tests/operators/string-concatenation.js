@@ -0,0 +1,48 @@
+test("building a long string in a loop", () => {
+    let s = "";
+    for (let i = 0; i < 10000; ++i) s += "ab";
+    expect(s).toHaveLength(20000);
+    expect(s.startsWith("abab")).toBeTrue();
+    expect(s.endsWith("abab")).toBeTrue();
+    expect(s.indexOf("ba")).toBe(1);
+    expect(s === "ab".repeat(10000)).toBeTrue();
+});
+
+test("prepending and appending", () => {
+    let s = "x".repeat(100);
+    for (let i = 0; i < 100; ++i) s = i + s + i;
+    expect(s.startsWith("9998979695")).toBeTrue();
+    expect(s.endsWith("9596979899")).toBeTrue();
+    expect(s.indexOf("0" + "x".repeat(100) + "0")).toBeGreaterThan(0);
+});
+
+test("concatenating long strings with themselves", () => {
+    let s = "0123456789".repeat(10);
+    for (let i = 0; i < 10; ++i) s = s + s;
+    expect(s).toHaveLength(100 * 1024);
+    expect(s.charAt(100 * 1024 - 1)).toBe("9");
+    expect(s.substring(95, 105)).toBe("5678901234");
+});
+
+test("concatenated strings as property keys", () => {
+    const prefix = "a-rather-long-property-name-prefix-".repeat(2);
+    const o = {};
+    o[prefix + "foo"] = 1;
+    o[prefix + "bar"] = 2;
+    expect(o[prefix + "foo"]).toBe(1);
+    expect(Object.keys(o)).toEqual([prefix + "foo", prefix + "bar"]);
+});
+
+test("concatenated strings are truthy", () => {
+    const s = "x".repeat(100) + "y".repeat(100);
+    expect(!!s).toBeTrue();
+    expect(!!("" + "")).toBeFalse();
+});
+
+test("template literals", () => {
+    const long = "long".repeat(20);
+    let s = "";
+    for (let i = 0; i < 100; ++i) s = `${s}${long}${i}`;
+    expect(s.endsWith(long + "99")).toBeTrue();
+    expect(s).toHaveLength(100 * 80 + 10 + 90 * 2);
+});
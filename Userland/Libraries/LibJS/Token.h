@@ -161,10 +161,11 @@ enum class TokenCategory {
 
 class Token {
 public:
-    Token(TokenType type, String message, StringView trivia, StringView value, StringView filename, size_t line_number, size_t line_column, size_t offset)
+    Token(TokenType type, String message, StringView trivia, StringView original_value, StringView value, StringView filename, size_t line_number, size_t line_column, size_t offset)
         : m_type(type)
         , m_message(message)
         , m_trivia(trivia)
+        , m_original_value(original_value)
         , m_value(value)
         , m_filename(filename)
         , m_line_number(line_number)
@@ -181,6 +182,9 @@ public:
 
     const String& message() const { return m_message; }
     const StringView& trivia() const { return m_trivia; }
+    // The token's characters, as they appear in the source.
+    const StringView& original_value() const { return m_original_value; }
+    // Same as original_value(), except that unicode escape sequences in identifiers have been decoded.
     const StringView& value() const { return m_value; }
     const StringView& filename() const { return m_filename; }
     size_t line_number() const { return m_line_number; }
@@ -205,6 +209,7 @@ private:
     TokenType m_type;
     String m_message;
     StringView m_trivia;
+    StringView m_original_value;
     StringView m_value;
     StringView m_filename;
     size_t m_line_number;
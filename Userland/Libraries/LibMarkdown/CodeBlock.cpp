@@ -91,16 +91,16 @@ String CodeBlock::render_for_terminal(size_t) const
     return builder.build();
 }
 
-OwnPtr<CodeBlock> CodeBlock::parse(Vector<StringView>::ConstIterator& lines)
+CodeBlock* CodeBlock::parse(Arena& arena, Vector<StringView>::ConstIterator& lines)
 {
     if (lines.is_end())
-        return {};
+        return nullptr;
 
     constexpr auto tick_tick_tick = "```";
 
     StringView line = *lines;
     if (!line.starts_with(tick_tick_tick))
-        return {};
+        return nullptr;
 
     // Our Markdown extension: we allow
     // specifying a style and a language
@@ -114,9 +114,9 @@ OwnPtr<CodeBlock> CodeBlock::parse(Vector<StringView>::ConstIterator& lines)
     // and if possible syntax-highlighted
     // as appropriate for a shell script.
     StringView style_spec = line.substring_view(3, line.length() - 3);
-    auto spec = Text::parse(style_spec);
+    auto spec = Text::parse(arena, style_spec);
     if (!spec.has_value())
-        return {};
+        return nullptr;
 
     ++lines;
 
@@ -136,7 +136,7 @@ OwnPtr<CodeBlock> CodeBlock::parse(Vector<StringView>::ConstIterator& lines)
         first = false;
     }
 
-    return make<CodeBlock>(move(spec.value()), builder.build());
+    return &arena.make<CodeBlock>(move(spec.value()), builder.build());
 }
 
 }
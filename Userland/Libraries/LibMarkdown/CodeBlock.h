@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <AK/OwnPtr.h>
 #include <LibMarkdown/Block.h>
 #include <LibMarkdown/Text.h>
 
@@ -23,7 +22,7 @@ public:
 
     virtual String render_to_html() const override;
     virtual String render_for_terminal(size_t view_width = 0) const override;
-    static OwnPtr<CodeBlock> parse(Vector<StringView>::ConstIterator& lines);
+    static CodeBlock* parse(Arena&, Vector<StringView>::ConstIterator& lines);
 
 private:
     String style_language() const;
@@ -51,12 +51,12 @@ String Document::render_for_terminal(size_t view_width) const
 }
 
 template<typename BlockType>
-static bool helper(Vector<StringView>::ConstIterator& lines, NonnullOwnPtrVector<Block>& blocks)
+static bool helper(Arena& arena, Vector<StringView>::ConstIterator& lines, Vector<Block&, 0, ArenaAllocator>& blocks)
 {
-    OwnPtr<BlockType> block = BlockType::parse(lines);
+    auto* block = BlockType::parse(arena, lines);
     if (!block)
         return false;
-    blocks.append(block.release_nonnull());
+    blocks.append(*block);
     return true;
 }
 
@@ -65,15 +65,16 @@ OwnPtr<Document> Document::parse(const StringView& str)
     const Vector<StringView> lines_vec = str.lines();
     auto lines = lines_vec.begin();
     auto document = make<Document>();
+    auto& arena = document->m_arena;
     auto& blocks = document->m_blocks;
-    NonnullOwnPtrVector<Paragraph::Line> paragraph_lines;
+    Vector<Paragraph::Line&, 0, ArenaAllocator> paragraph_lines { arena };
 
     auto flush_paragraph = [&] {
         if (paragraph_lines.is_empty())
             return;
-        auto paragraph = make<Paragraph>(move(paragraph_lines));
-        document->m_blocks.append(move(paragraph));
-        paragraph_lines.clear();
+        auto& paragraph = arena.make<Paragraph>(move(paragraph_lines));
+        document->m_blocks.append(paragraph);
+        paragraph_lines = Vector<Paragraph::Line&, 0, ArenaAllocator> { arena };
     };
     while (true) {
         if (lines.is_end())
@@ -85,23 +86,23 @@ OwnPtr<Document> Document::parse(const StringView& str)
             continue;
         }
 
-        bool any = helper<Table>(lines, blocks) || helper<List>(lines, blocks) || helper<CodeBlock>(lines, blocks)
-            || helper<Heading>(lines, blocks) || helper<HorizontalRule>(lines, blocks);
+        bool any = helper<Table>(arena, lines, blocks) || helper<List>(arena, lines, blocks) || helper<CodeBlock>(arena, lines, blocks)
+            || helper<Heading>(arena, lines, blocks) || helper<HorizontalRule>(arena, lines, blocks);
 
         if (any) {
             if (!paragraph_lines.is_empty()) {
-                auto last_block = document->m_blocks.take_last();
+                auto& last_block = document->m_blocks.take_last();
                 flush_paragraph();
-                document->m_blocks.append(move(last_block));
+                document->m_blocks.append(last_block);
             }
             continue;
         }
 
-        auto line = Paragraph::Line::parse(lines);
+        auto* line = Paragraph::Line::parse(arena, lines);
         if (!line)
             return {};
 
-        paragraph_lines.append(line.release_nonnull());
+        paragraph_lines.append(*line);
     }
 
     if (!paragraph_lines.is_empty())
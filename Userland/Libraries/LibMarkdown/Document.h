@@ -6,7 +6,8 @@
 
 #pragma once
 
-#include <AK/NonnullOwnPtrVector.h>
+#include <AK/Arena.h>
+#include <AK/OwnPtr.h>
 #include <AK/String.h>
 #include <LibMarkdown/Block.h>
 
@@ -20,7 +21,9 @@ public:
     static OwnPtr<Document> parse(const StringView&);
 
 private:
-    NonnullOwnPtrVector<Block> m_blocks;
+    // All blocks, and everything they're made of, live in the arena and go away together with the document.
+    Arena m_arena;
+    Vector<Block&, 0, ArenaAllocator> m_blocks { m_arena };
 };
 
 }
@@ -35,10 +35,10 @@ String Heading::render_for_terminal(size_t) const
     return builder.build();
 }
 
-OwnPtr<Heading> Heading::parse(Vector<StringView>::ConstIterator& lines)
+Heading* Heading::parse(Arena& arena, Vector<StringView>::ConstIterator& lines)
 {
     if (lines.is_end())
-        return {};
+        return nullptr;
 
     const StringView& line = *lines;
     size_t level;
@@ -49,17 +49,17 @@ OwnPtr<Heading> Heading::parse(Vector<StringView>::ConstIterator& lines)
     }
 
     if (!level || level >= line.length() || line[level] != ' ')
-        return {};
+        return nullptr;
 
     StringView title_view = line.substring_view(level + 1, line.length() - level - 1);
-    auto text = Text::parse(title_view);
+    auto text = Text::parse(arena, title_view);
     if (!text.has_value())
-        return {};
+        return nullptr;
 
-    auto heading = make<Heading>(move(text.value()), level);
+    auto& heading = arena.make<Heading>(move(text.value()), level);
 
     ++lines;
-    return heading;
+    return &heading;
 }
 
 }
@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <AK/OwnPtr.h>
 #include <AK/StringView.h>
 #include <AK/Vector.h>
 #include <LibMarkdown/Block.h>
@@ -26,7 +25,7 @@ public:
 
     virtual String render_to_html() const override;
     virtual String render_for_terminal(size_t view_width = 0) const override;
-    static OwnPtr<Heading> parse(Vector<StringView>::ConstIterator& lines);
+    static Heading* parse(Arena&, Vector<StringView>::ConstIterator& lines);
 
 private:
     Text m_text;
@@ -24,26 +24,26 @@ String HorizontalRule::render_for_terminal(size_t view_width) const
     return builder.to_string();
 }
 
-OwnPtr<HorizontalRule> HorizontalRule::parse(Vector<StringView>::ConstIterator& lines)
+HorizontalRule* HorizontalRule::parse(Arena& arena, Vector<StringView>::ConstIterator& lines)
 {
     if (lines.is_end())
-        return {};
+        return nullptr;
 
     const StringView& line = *lines;
 
     if (line.length() < 3)
-        return {};
+        return nullptr;
     if (!line.starts_with('-') && !line.starts_with('_') && !line.starts_with('*'))
-        return {};
+        return nullptr;
 
     auto first_character = line.characters_without_null_termination()[0];
     for (auto ch : line) {
         if (ch != first_character)
-            return {};
+            return nullptr;
     }
 
     ++lines;
-    return make<HorizontalRule>();
+    return &arena.make<HorizontalRule>();
 }
 
 }
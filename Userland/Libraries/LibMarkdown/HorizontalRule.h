@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <AK/OwnPtr.h>
+#include <AK/Arena.h>
 #include <AK/StringView.h>
 #include <AK/Vector.h>
 #include <LibMarkdown/Block.h>
@@ -22,7 +22,7 @@ public:
 
     virtual String render_to_html() const override;
     virtual String render_for_terminal(size_t view_width = 0) const override;
-    static OwnPtr<HorizontalRule> parse(Vector<StringView>::ConstIterator& lines);
+    static HorizontalRule* parse(Arena&, Vector<StringView>::ConstIterator& lines);
 };
 
 }
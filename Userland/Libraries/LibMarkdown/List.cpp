@@ -46,9 +46,9 @@ String List::render_for_terminal(size_t) const
     return builder.build();
 }
 
-OwnPtr<List> List::parse(Vector<StringView>::ConstIterator& lines)
+List* List::parse(Arena& arena, Vector<StringView>::ConstIterator& lines)
 {
-    Vector<Text> items;
+    Vector<Text, 0, ArenaAllocator> items { arena };
     bool is_ordered = false;
 
     bool first = true;
@@ -58,7 +58,7 @@ OwnPtr<List> List::parse(Vector<StringView>::ConstIterator& lines)
         if (first)
             return true;
 
-        auto text = Text::parse(item_builder.string_view());
+        auto text = Text::parse(arena, item_builder.string_view());
         if (!text.has_value())
             return false;
 
@@ -102,20 +102,20 @@ OwnPtr<List> List::parse(Vector<StringView>::ConstIterator& lines)
             if (first)
                 is_ordered = appears_ordered;
             else if (is_ordered != appears_ordered)
-                return {};
+                return nullptr;
 
             if (!flush_item_if_needed())
-                return {};
+                return nullptr;
 
             while (offset + 1 < line.length() && line[offset + 1] == ' ')
                 offset++;
 
         } else {
             if (first)
-                return {};
+                return nullptr;
             for (size_t i = 0; i < offset; i++) {
                 if (line[i] != ' ')
-                    return {};
+                    return nullptr;
             }
         }
 
@@ -129,8 +129,8 @@ OwnPtr<List> List::parse(Vector<StringView>::ConstIterator& lines)
     }
 
     if (!flush_item_if_needed() || first)
-        return {};
-    return make<List>(move(items), is_ordered);
+        return nullptr;
+    return &arena.make<List>(move(items), is_ordered);
 }
 
 }
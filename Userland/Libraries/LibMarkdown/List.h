@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <AK/OwnPtr.h>
 #include <AK/Vector.h>
 #include <LibMarkdown/Block.h>
 #include <LibMarkdown/Text.h>
@@ -15,7 +14,7 @@ namespace Markdown {
 
 class List final : public Block {
 public:
-    List(Vector<Text>&& text, bool is_ordered)
+    List(Vector<Text, 0, ArenaAllocator>&& text, bool is_ordered)
         : m_items(move(text))
         , m_is_ordered(is_ordered)
     {
@@ -25,11 +24,11 @@ public:
     virtual String render_to_html() const override;
     virtual String render_for_terminal(size_t view_width = 0) const override;
 
-    static OwnPtr<List> parse(Vector<StringView>::ConstIterator& lines);
+    static List* parse(Arena&, Vector<StringView>::ConstIterator& lines);
 
 private:
     // TODO: List items should be considered blocks of their own kind.
-    Vector<Text> m_items;
+    Vector<Text, 0, ArenaAllocator> m_items;
     bool m_is_ordered { false };
 };
 
@@ -38,15 +38,15 @@ String Paragraph::render_for_terminal(size_t) const
     return builder.build();
 }
 
-OwnPtr<Paragraph::Line> Paragraph::Line::parse(Vector<StringView>::ConstIterator& lines)
+Paragraph::Line* Paragraph::Line::parse(Arena& arena, Vector<StringView>::ConstIterator& lines)
 {
     if (lines.is_end())
-        return {};
+        return nullptr;
 
-    auto text = Text::parse(*lines++);
+    auto text = Text::parse(arena, *lines++);
     if (!text.has_value())
-        return {};
+        return nullptr;
 
-    return make<Paragraph::Line>(text.release_value());
+    return &arena.make<Paragraph::Line>(text.release_value());
 }
 }
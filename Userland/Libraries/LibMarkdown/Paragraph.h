@@ -6,8 +6,6 @@
 
 #pragma once
 
-#include <AK/NonnullOwnPtrVector.h>
-#include <AK/OwnPtr.h>
 #include <LibMarkdown/Block.h>
 #include <LibMarkdown/Text.h>
 
@@ -22,14 +20,14 @@ public:
         {
         }
 
-        static OwnPtr<Line> parse(Vector<StringView>::ConstIterator& lines);
+        static Line* parse(Arena&, Vector<StringView>::ConstIterator& lines);
         const Text& text() const { return m_text; }
 
     private:
         Text m_text;
     };
 
-    Paragraph(NonnullOwnPtrVector<Line>&& lines)
+    Paragraph(Vector<Line&, 0, ArenaAllocator>&& lines)
         : m_lines(move(lines))
     {
     }
@@ -40,7 +38,7 @@ public:
     virtual String render_for_terminal(size_t view_width = 0) const override;
 
 private:
-    NonnullOwnPtrVector<Line> m_lines;
+    Vector<Line&, 0, ArenaAllocator> m_lines;
 };
 
 }
@@ -98,17 +98,17 @@ String Table::render_to_html() const
     return builder.to_string();
 }
 
-OwnPtr<Table> Table::parse(Vector<StringView>::ConstIterator& lines)
+Table* Table::parse(Arena& arena, Vector<StringView>::ConstIterator& lines)
 {
     auto peek_it = lines;
     auto first_line = *peek_it;
     if (!first_line.starts_with('|'))
-        return {};
+        return nullptr;
 
     ++peek_it;
 
     if (peek_it.is_end())
-        return {};
+        return nullptr;
 
     auto header_segments = first_line.split_view('|', true);
     auto header_delimiters = peek_it->split_view('|', true);
@@ -126,23 +126,23 @@ OwnPtr<Table> Table::parse(Vector<StringView>::ConstIterator& lines)
     ++peek_it;
 
     if (header_delimiters.size() != header_segments.size())
-        return {};
+        return nullptr;
 
     if (header_delimiters.is_empty())
-        return {};
+        return nullptr;
 
     size_t total_width = 0;
 
-    auto table = make<Table>();
-    table->m_columns.resize(header_delimiters.size());
+    auto& table = arena.make<Table>();
+    table.m_columns.resize(header_delimiters.size());
 
     for (size_t i = 0; i < header_segments.size(); ++i) {
-        auto text_option = Text::parse(header_segments[i]);
+        auto text_option = Text::parse(arena, header_segments[i]);
         if (!text_option.has_value())
-            return {}; // An invalid 'text' in the header should just fail the table parse.
+            return nullptr; // An invalid 'text' in the header should just fail the table parse.
 
         auto text = text_option.release_value();
-        auto& column = table->m_columns[i];
+        auto& column = table.m_columns[i];
 
         column.header = move(text);
 
@@ -175,7 +175,7 @@ OwnPtr<Table> Table::parse(Vector<StringView>::ConstIterator& lines)
         total_width += relative_width;
     }
 
-    table->m_total_width = total_width;
+    table.m_total_width = total_width;
 
     for (off_t i = 0; i < peek_it - lines; ++i)
         ++lines;
@@ -199,23 +199,23 @@ OwnPtr<Table> Table::parse(Vector<StringView>::ConstIterator& lines)
             if (i >= segments.size()) {
                 // Ran out of segments, but still have headers.
                 // Just make an empty cell.
-                table->m_columns[i].rows.append(Text { "" });
+                table.m_columns[i].rows.append(Text { arena, "" });
             } else {
-                auto text_option = Text::parse(segments[i]);
+                auto text_option = Text::parse(arena, segments[i]);
                 // We treat an invalid 'text' as a literal.
                 if (text_option.has_value()) {
                     auto text = text_option.release_value();
-                    table->m_columns[i].rows.append(move(text));
+                    table.m_columns[i].rows.append(move(text));
                 } else {
-                    table->m_columns[i].rows.append(Text { segments[i] });
+                    table.m_columns[i].rows.append(Text { arena, segments[i] });
                 }
             }
         }
     }
 
-    table->m_row_count = row_count;
+    table.m_row_count = row_count;
 
-    return table;
+    return &table;
 }
 
 }
@@ -6,8 +6,6 @@
 
 #pragma once
 
-#include <AK/NonnullOwnPtrVector.h>
-#include <AK/OwnPtr.h>
 #include <LibMarkdown/Block.h>
 #include <LibMarkdown/Text.h>
 
@@ -33,7 +31,7 @@ public:
 
     virtual String render_to_html() const override;
     virtual String render_for_terminal(size_t view_width = 0) const override;
-    static OwnPtr<Table> parse(Vector<StringView>::ConstIterator& lines);
+    static Table* parse(Arena&, Vector<StringView>::ConstIterator& lines);
 
 private:
     Vector<Column> m_columns;
@@ -26,7 +26,8 @@ static String unescape(const StringView& text)
     return builder.build();
 }
 
-Text::Text(String&& text)
+Text::Text(Arena& arena, String&& text)
+    : m_spans(arena)
 {
     m_spans.append({ move(text), Style {} });
 }
@@ -167,13 +168,13 @@ String Text::render_for_terminal() const
     return builder.build();
 }
 
-Optional<Text> Text::parse(const StringView& str)
+Optional<Text> Text::parse(Arena& arena, const StringView& str)
 {
     Style current_style;
     size_t current_span_start = 0;
     int first_span_in_the_current_link = -1;
     bool current_link_is_actually_img = false;
-    Vector<Span> spans;
+    Vector<Span, 0, ArenaAllocator> spans { arena };
 
     auto append_span_if_needed = [&](size_t offset) {
         VERIFY(current_span_start <= offset);
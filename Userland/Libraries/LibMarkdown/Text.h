@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Arena.h>
 #include <AK/Noncopyable.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
@@ -29,26 +30,26 @@ public:
         Style style;
     };
 
-    explicit Text(String&& text);
+    Text(Arena&, String&& text);
     Text(Text&& text) = default;
     Text() = default;
 
     Text& operator=(Text&&) = default;
 
-    const Vector<Span>& spans() const { return m_spans; }
+    const Vector<Span, 0, ArenaAllocator>& spans() const { return m_spans; }
 
     String render_to_html() const;
     String render_for_terminal() const;
 
-    static Optional<Text> parse(const StringView&);
+    static Optional<Text> parse(Arena&, const StringView&);
 
 private:
-    Text(Vector<Span>&& spans)
+    Text(Vector<Span, 0, ArenaAllocator>&& spans)
         : m_spans(move(spans))
     {
     }
 
-    Vector<Span> m_spans;
+    Vector<Span, 0, ArenaAllocator> m_spans;
 };
 
 }
@@ -19,6 +19,7 @@
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/internals.h>
 #include <sys/mman.h>
 #include <syscall.h>
 #include <time.h>
@@ -90,6 +91,7 @@ static int create_thread(pthread_t* thread, void* (*entry)(void*), void* argumen
 [[noreturn]] static void exit_thread(void* code, void* stack_location, size_t stack_size)
 {
     __pthread_key_destroy_for_current_thread();
+    __malloc_flush_thread_cache();
     syscall(SC_exit_thread, code, stack_location, stack_size);
     VERIFY_NOT_REACHED();
 }
@@ -596,6 +598,11 @@ constexpr static u32 reader_wake_mask = 1 << 30;
 constexpr static u32 writer_wake_mask = 1 << 31;
 constexpr static u32 writer_locked_mask = 1 << 17;
 constexpr static u32 writer_intent_mask = 1 << 16;
+constexpr static u32 reader_count_mask = 0xffff;
+
+// How many times a contended rwlock is polled before going to sleep on it.
+constexpr static size_t rwlock_spin_count = 100;
+
 int pthread_rwlock_init(pthread_rwlock_t* __restrict lockp, const pthread_rwlockattr_t* __restrict attr)
 {
     // Just ignore the attributes. use defaults for now.
@@ -606,24 +613,56 @@ int pthread_rwlock_init(pthread_rwlock_t* __restrict lockp, const pthread_rwlock
     return 0;
 }
 
+static int rwlock_wait(u32* lockp, u32 value, u32 wake_mask, const struct timespec* timeout)
+{
+    // POSIX timeouts for rwlocks are measured against CLOCK_REALTIME.
+    int op = FUTEX_WAIT_BITSET;
+    if (timeout)
+        op |= FUTEX_CLOCK_REALTIME;
+    auto rc = futex(lockp, op, value, timeout, nullptr, wake_mask);
+    if (rc < 0 && errno != EAGAIN && errno != EINTR)
+        return errno;
+    return 0;
+}
+
+// Wakes up everyone who's sleeping on the lock. They all go back to competing for it, and whoever
+// doesn't get it sets their wake bit again before going back to sleep.
+static void rwlock_wake_all(u32* lockp)
+{
+    futex(lockp, FUTEX_WAKE_BITSET, INT32_MAX, nullptr, nullptr, reader_wake_mask | writer_wake_mask);
+}
+
 // Note that this function does not care about the top 32 bits at all.
-static int rwlock_rdlock_maybe_timed(u32* lockp, const struct timespec* timeout = nullptr, bool only_once = false, int value_if_timeout = -1, int value_if_okay = -2)
+static int rwlock_rdlock_maybe_timed(u32* lockp, const struct timespec* timeout = nullptr, bool only_once = false)
 {
     auto current = AK::atomic_load(lockp);
-    for (; !only_once;) {
+    size_t spins_left = rwlock_spin_count;
+    for (;;) {
         // First, see if this is locked for writing
         // if it's not, try to add to the counter.
-        // If someone is waiting to write, and there is one or no other readers, let them have the lock.
-        if (!(current & writer_locked_mask)) {
+        // If someone is waiting to write, let them have the lock first, so that a steady stream of
+        // readers can't starve them. Note that this also applies to threads that already hold a read lock.
+        if (!(current & (writer_locked_mask | writer_intent_mask))) {
             auto count = (u16)current;
-            if (!(current & writer_intent_mask) || count > 1) {
-                ++count;
-                auto desired = (current << 16) | count;
-                auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
-                if (!did_exchange)
-                    continue; // tough luck, try again.
-                return value_if_okay;
-            }
+            if (count == reader_count_mask)
+                return EAGAIN;
+            ++count;
+            auto desired = (current & ~reader_count_mask) | count;
+            auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
+            if (!did_exchange)
+                continue; // tough luck, try again.
+            return 0;
+        }
+
+        if (only_once)
+            return EBUSY;
+
+        // Writers tend to be done quickly, so poll for a bit before going to sleep.
+        if (spins_left > 0) {
+            --spins_left;
+            __pthread_spin_pause_np();
+            current = AK::atomic_load(lockp, AK::MemoryOrder::memory_order_relaxed);
+            continue;
         }
 
         // If no one else is waiting for the read wake bit, set it.
@@ -638,43 +677,45 @@ static int rwlock_rdlock_maybe_timed(u32* lockp, const struct timespec* timeout
 
         // Seems like someone is writing (or is interested in writing and we let them have the lock)
         // wait until they're done.
-        auto rc = futex(lockp, FUTEX_WAIT_BITSET, current, timeout, nullptr, reader_wake_mask);
-        if (rc < 0 && errno == ETIMEDOUT && timeout) {
-            return value_if_timeout;
-        }
-        if (rc < 0 && errno != EAGAIN) {
-            // Something broke. let's just bail out.
-            return errno;
-        }
-        errno = 0;
+        if (auto rc = rwlock_wait(lockp, current, reader_wake_mask, timeout); rc != 0)
+            return rc;
+
         // Reload the 'current' value
         current = AK::atomic_load(lockp);
     }
-    return value_if_timeout;
 }
 
-static int rwlock_wrlock_maybe_timed(pthread_rwlock_t* lockval_p, const struct timespec* timeout = nullptr, bool only_once = false, int value_if_timeout = -1, int value_if_okay = -2)
+static int rwlock_wrlock_maybe_timed(pthread_rwlock_t* lockval_p, const struct timespec* timeout = nullptr, bool only_once = false)
 {
     u32* lockp = reinterpret_cast<u32*>(lockval_p);
     auto current = AK::atomic_load(lockp);
-    for (; !only_once;) {
+    size_t spins_left = rwlock_spin_count;
+    for (;;) {
         // First, see if this is locked for writing, and if there are any readers.
         // if not, lock it.
-        // If someone is waiting to write, let them have the lock.
         if (!(current & writer_locked_mask) && ((u16)current) == 0) {
-            if (!(current & writer_intent_mask)) {
-                auto desired = current | writer_locked_mask | writer_intent_mask;
-                auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
-                if (!did_exchange)
-                    continue;
-
-                // Now that we've locked the value, it's safe to set our thread ID.
-                AK::atomic_store(reinterpret_cast<i32*>(lockval_p) + 1, pthread_self());
-                return value_if_okay;
-            }
+            auto desired = current | writer_locked_mask;
+            auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
+            if (!did_exchange)
+                continue;
+
+            // Now that we've locked the value, it's safe to set our thread ID.
+            AK::atomic_store(reinterpret_cast<i32*>(lockval_p) + 1, pthread_self());
+            return 0;
+        }
+
+        if (only_once)
+            return EBUSY;
+
+        if (spins_left > 0) {
+            --spins_left;
+            __pthread_spin_pause_np();
+            current = AK::atomic_load(lockp, AK::MemoryOrder::memory_order_relaxed);
+            continue;
         }
 
         // That didn't work, if no one else is waiting for the write bit, set it.
+        // This also keeps new readers from taking the lock, so that we don't starve.
         if (!(current & writer_wake_mask)) {
             auto desired = current | writer_wake_mask | writer_intent_mask;
             auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
@@ -684,22 +725,19 @@ static int rwlock_wrlock_maybe_timed(pthread_rwlock_t* lockval_p, const struct t
             current = desired;
         }
 
-        // Seems like someone is writing (or is interested in writing and we let them have the lock)
-        // wait until they're done.
-        auto rc = futex(lockp, FUTEX_WAIT_BITSET, current, timeout, nullptr, writer_wake_mask);
-        if (rc < 0 && errno == ETIMEDOUT && timeout) {
-            return value_if_timeout;
+        // Seems like someone is reading or writing, wait until they're done.
+        if (auto rc = rwlock_wait(lockp, current, writer_wake_mask, timeout); rc != 0) {
+            // We're giving up, so let the readers back in. Any other waiting writers will be woken up
+            // as well, and will set the intent bit again if they still can't get the lock.
+            auto previous = AK::atomic_fetch_and(lockp, ~(writer_intent_mask | reader_wake_mask | writer_wake_mask), AK::MemoryOrder::memory_order_relaxed);
+            if (previous & (reader_wake_mask | writer_wake_mask))
+                rwlock_wake_all(lockp);
+            return rc;
         }
-        if (rc < 0 && errno != EAGAIN) {
-            // Something broke. let's just bail out.
-            return errno;
-        }
-        errno = 0;
+
         // Reload the 'current' value
         current = AK::atomic_load(lockp);
     }
-
-    return value_if_timeout;
 }
 
 int pthread_rwlock_rdlock(pthread_rwlock_t* lockp)
@@ -707,45 +745,35 @@ int pthread_rwlock_rdlock(pthread_rwlock_t* lockp)
     if (!lockp)
         return EINVAL;
 
-    return rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp), nullptr, false, 0, 0);
+    return rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp));
 }
 int pthread_rwlock_timedrdlock(pthread_rwlock_t* __restrict lockp, const struct timespec* __restrict timespec)
 {
     if (!lockp)
         return EINVAL;
 
-    auto rc = rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp), timespec);
-    if (rc == -1) // "ok"
-        return 0;
-    if (rc == -2) // "timed out"
-        return 1;
-    return rc;
+    return rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp), timespec);
 }
 int pthread_rwlock_timedwrlock(pthread_rwlock_t* __restrict lockp, const struct timespec* __restrict timespec)
 {
     if (!lockp)
         return EINVAL;
 
-    auto rc = rwlock_wrlock_maybe_timed(lockp, timespec);
-    if (rc == -1) // "ok"
-        return 0;
-    if (rc == -2) // "timed out"
-        return 1;
-    return rc;
+    return rwlock_wrlock_maybe_timed(lockp, timespec);
 }
 int pthread_rwlock_tryrdlock(pthread_rwlock_t* lockp)
 {
     if (!lockp)
         return EINVAL;
 
-    return rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp), nullptr, true, EBUSY, 0);
+    return rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp), nullptr, true);
 }
 int pthread_rwlock_trywrlock(pthread_rwlock_t* lockp)
 {
     if (!lockp)
         return EINVAL;
 
-    return rwlock_wrlock_maybe_timed(lockp, nullptr, true, EBUSY, 0);
+    return rwlock_wrlock_maybe_timed(lockp, nullptr, true);
 }
 int pthread_rwlock_unlock(pthread_rwlock_t* lockval_p)
 {
@@ -763,12 +791,11 @@ int pthread_rwlock_unlock(pthread_rwlock_t* lockval_p)
             return EINVAL; // you don't own this lock, silly.
 
         // Now just unlock it.
-        auto desired = current & ~(writer_locked_mask | writer_intent_mask);
-        AK::atomic_store(lockp, desired, AK::MemoryOrder::memory_order_release);
+        AK::atomic_store(reinterpret_cast<i32*>(lockval_p) + 1, 0);
+        auto previous = AK::atomic_fetch_and(lockp, ~(writer_locked_mask | writer_intent_mask | reader_wake_mask | writer_wake_mask), AK::MemoryOrder::memory_order_release);
         // Then wake both readers and writers, if any.
-        auto rc = futex(lockp, FUTEX_WAKE_BITSET, current, nullptr, nullptr, (current & writer_wake_mask) | reader_wake_mask);
-        if (rc < 0)
-            return errno;
+        if (previous & (reader_wake_mask | writer_wake_mask))
+            rwlock_wake_all(lockp);
         return 0;
     }
 
@@ -779,10 +806,18 @@ int pthread_rwlock_unlock(pthread_rwlock_t* lockval_p)
             return EINVAL;
         }
         --count;
-        auto desired = (current << 16) | count;
+        auto desired = (current & ~reader_count_mask) | count;
+        // The last reader out wakes everyone who's waiting. If a writer is among them, the intent bit stays set
+        // until it's done, so that the readers can't grab the lock again before the writer gets to run.
+        if (count == 0)
+            desired &= ~(reader_wake_mask | writer_wake_mask);
         auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_release);
         if (!did_exchange)
             continue; // tough luck, try again.
+
+        if (count == 0 && (current & (reader_wake_mask | writer_wake_mask)))
+            rwlock_wake_all(lockp);
+        break;
     }
 
     // Finally, unlocked at last!
@@ -793,7 +828,7 @@ int pthread_rwlock_wrlock(pthread_rwlock_t* lockp)
     if (!lockp)
         return EINVAL;
 
-    return rwlock_wrlock_maybe_timed(lockp, nullptr, false, 0, 0);
+    return rwlock_wrlock_maybe_timed(lockp);
 }
 int pthread_rwlockattr_destroy(pthread_rwlockattr_t*)
 {
@@ -76,12 +76,14 @@ int pthread_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const s
     u32 value = AK::atomic_fetch_or(&cond->value, NEED_TO_WAKE_ONE | NEED_TO_WAKE_ALL, AK::memory_order_release) | NEED_TO_WAKE_ONE | NEED_TO_WAKE_ALL;
     pthread_mutex_unlock(mutex);
     int rc = futex_wait(&cond->value, value, abstime, cond->clockid);
-    if (rc < 0 && errno != EAGAIN)
-        return errno;
+    int saved_errno = errno;
 
-    // We might have been re-queued onto the mutex while we were sleeping. Take
-    // the pessimistic locking path.
+    // We have most likely been re-queued onto the mutex while we were sleeping,
+    // so take the pessimistic locking path. The mutex has to be reacquired even
+    // if the wait timed out.
     __pthread_mutex_lock_pessimistic_np(mutex);
+    if (rc < 0 && saved_errno != EAGAIN)
+        return saved_errno;
     return 0;
 }
 
@@ -105,11 +107,18 @@ int pthread_cond_signal(pthread_cond_t* cond)
     if (!(value & NEED_TO_WAKE_ONE)) [[likely]]
         return 0;
     // ...try to wake someone...
-    int rc = futex_wake(&cond->value, 1);
+    // Waking the waiter up right away would only have it contend on the mutex,
+    // which we're most likely holding. Instead, move it onto the mutex's wait
+    // queue, so that it's woken up once the mutex is released.
+    pthread_mutex_t* mutex = AK::atomic_load(&cond->mutex, AK::memory_order_relaxed);
+    VERIFY(mutex);
+    int rc = futex_requeue(&cond->value, 0, &mutex->lock, 1);
     VERIFY(rc >= 0);
-    // ...and if we have woken someone, put the flag back.
-    if (rc > 0)
+    // ...and if we have moved someone, put the flag back.
+    if (rc > 0) {
+        __pthread_mutex_wake_requeued_np(mutex);
         AK::atomic_fetch_or(&cond->value, NEED_TO_WAKE_ONE, AK::memory_order_relaxed);
+    }
 
     return 0;
 }
@@ -127,7 +136,7 @@ int pthread_cond_broadcast(pthread_cond_t* cond)
     pthread_mutex_t* mutex = AK::atomic_load(&cond->mutex, AK::memory_order_relaxed);
     VERIFY(mutex);
 
-    int rc = futex(&cond->value, FUTEX_REQUEUE | FUTEX_PRIVATE_FLAG, 1, nullptr, &mutex->lock, INT_MAX);
+    int rc = futex_requeue(&cond->value, 1, &mutex->lock, INT_MAX);
     VERIFY(rc >= 0);
     return 0;
 }
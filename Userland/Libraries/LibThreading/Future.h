@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <LibCore/Event.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Object.h>
+
+namespace Threading {
+
+class ThreadPool;
+
+// The result of a job submitted with ThreadPool::async(). The result can either be waited for with await(),
+// or handed to a completion callback, which runs on the event loop of the thread that submitted the job.
+template<typename T>
+class Future final : public Core::Object {
+    C_OBJECT(Future);
+
+public:
+    virtual ~Future() { }
+
+    bool is_resolved() const { return m_resolved.load(AK::MemoryOrder::memory_order_acquire); }
+
+    // Blocks until the result is available. Instead of sleeping, the calling thread runs other jobs from the pool in the meantime.
+    T& await();
+
+private:
+    friend class ThreadPool;
+
+    Future(ThreadPool& pool, Function<void(T&)> on_complete)
+        : m_pool(pool)
+        , m_on_complete(move(on_complete))
+    {
+    }
+
+    void resolve(T value)
+    {
+        m_value = move(value);
+        m_resolved.store(true, AK::MemoryOrder::memory_order_release);
+        if (!m_on_complete)
+            return;
+        Core::EventLoop::current().post_event(*this, make<Core::DeferredInvocationEvent>([protector = NonnullRefPtr(*this)](auto&) mutable {
+            protector->m_on_complete(protector->m_value.value());
+        }));
+        Core::EventLoop::wake();
+    }
+
+    ThreadPool& m_pool;
+    Function<void(T&)> m_on_complete;
+    Optional<T> m_value;
+    Atomic<bool> m_resolved { false };
+};
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/MergeSort.h>
+#include <AK/QuickSort.h>
+#include <AK/Vector.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Threading {
+
+namespace Detail {
+
+// Below this size, spreading the work over the pool costs more than it saves.
+constexpr size_t parallel_sort_threshold = 16384;
+
+template<bool stable, typename Collection, typename LessThan>
+void parallel_sort_impl(ThreadPool& pool, Collection& collection, LessThan less_than)
+{
+    size_t size = collection.size();
+    if (size < parallel_sort_threshold || pool.worker_count() == 1) {
+        if constexpr (stable)
+            merge_sort(collection, 0, size, move(less_than));
+        else
+            pattern_defeating_quick_sort(collection, 0, size, move(less_than));
+        return;
+    }
+
+    // Sort a few chunks per worker independently, then merge neighbouring chunks in rounds until only one is left.
+    // Every round halves the number of merges, so the last ones don't parallelize well, but they're linear.
+    size_t chunk_count = pool.worker_count() * 2;
+    size_t chunk_size = (size + chunk_count - 1) / chunk_count;
+    pool.parallel_for(
+        0, chunk_count, [&](size_t first_chunk, size_t last_chunk) {
+            auto chunk_less_than = less_than;
+            for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk) {
+                size_t chunk_begin = min(chunk * chunk_size, size);
+                size_t chunk_end = min(chunk_begin + chunk_size, size);
+                if constexpr (stable)
+                    merge_sort(collection, chunk_begin, chunk_end, chunk_less_than);
+                else
+                    pattern_defeating_quick_sort(collection, chunk_begin, chunk_end, chunk_less_than);
+            }
+        },
+        1);
+
+    for (size_t width = chunk_size; width < size; width *= 2) {
+        size_t merge_count = (size + 2 * width - 1) / (2 * width);
+        pool.parallel_for(
+            0, merge_count, [&](size_t first_merge, size_t last_merge) {
+                auto merge_less_than = less_than;
+                Vector<RemoveCVReference<decltype(collection[0])>> buffer;
+                for (size_t merge = first_merge; merge < last_merge; ++merge) {
+                    size_t merge_begin = merge * 2 * width;
+                    if (size - merge_begin <= width)
+                        continue;
+                    AK::Detail::merge_sorted_runs(collection, merge_begin, merge_begin + width, min(merge_begin + 2 * width, size), merge_less_than, buffer);
+                }
+            },
+            1);
+    }
+}
+
+}
+
+// Sorts the collection using the threads of the pool. The comparator is called from several threads at once.
+template<typename Collection, typename LessThan>
+void parallel_sort(ThreadPool& pool, Collection& collection, LessThan less_than)
+{
+    Detail::parallel_sort_impl<false>(pool, collection, move(less_than));
+}
+
+template<typename Collection>
+void parallel_sort(ThreadPool& pool, Collection& collection)
+{
+    Detail::parallel_sort_impl<false>(pool, collection, [](auto& a, auto& b) { return a < b; });
+}
+
+// Like parallel_sort(), but equal elements keep their order.
+template<typename Collection, typename LessThan>
+void parallel_stable_sort(ThreadPool& pool, Collection& collection, LessThan less_than)
+{
+    Detail::parallel_sort_impl<true>(pool, collection, move(less_than));
+}
+
+template<typename Collection>
+void parallel_stable_sort(ThreadPool& pool, Collection& collection)
+{
+    Detail::parallel_sort_impl<true>(pool, collection, [](auto& a, auto& b) { return a < b; });
+}
+
+}
@@ -21,7 +21,8 @@ Threading::Thread::Thread(Function<intptr_t()> action, StringView thread_name)
 Threading::Thread::~Thread()
 {
     if (m_tid && !m_detached) {
-        dbgln("Destroying thread \"{}\"({}) while it is still running!", m_thread_name, m_tid);
+        if (!m_has_exited)
+            dbgln("Destroying thread \"{}\"({}) while it is still running!", m_thread_name, m_tid);
         [[maybe_unused]] auto res = join();
     }
 }
@@ -34,7 +35,8 @@ void Threading::Thread::start()
         [](void* arg) -> void* {
             Thread* self = static_cast<Thread*>(arg);
             auto exit_code = self->m_action();
-            self->m_tid = 0;
+            // NOTE: The thread may still be detached or joined, which needs m_tid, so we can't clear it here.
+            self->m_has_exited = true;
             return reinterpret_cast<void*>(exit_code);
         },
         static_cast<void*>(this));
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/String.h>
+#include <LibThreading/ThreadPool.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace Threading {
+
+static __thread void* s_current_worker;
+
+ThreadPool& ThreadPool::the()
+{
+    static ThreadPool* s_the;
+    static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+    pthread_once(&s_once, [] {
+        auto processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+        s_the = new ThreadPool(processor_count > 0 ? processor_count : 1);
+    });
+    return *s_the;
+}
+
+ThreadPool::ThreadPool(size_t worker_count)
+{
+    VERIFY(worker_count > 0);
+    for (size_t i = 0; i < worker_count; ++i)
+        m_workers.append(make<Worker>(*this, i));
+
+    // All workers have to exist before any of them starts looking for something to steal.
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto& worker = m_workers[i];
+        int rc = pthread_create(&worker.thread, nullptr, worker_entry, &worker);
+        VERIFY(rc == 0);
+        pthread_setname_np(worker.thread, String::formatted("ThreadPool worker {}", i).characters());
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    pthread_mutex_lock(&m_mutex);
+    m_exiting = true;
+    pthread_cond_broadcast(&m_condition);
+    pthread_mutex_unlock(&m_mutex);
+
+    for (auto& worker : m_workers)
+        pthread_join(worker.thread, nullptr);
+}
+
+void* ThreadPool::worker_entry(void* argument)
+{
+    auto& worker = *static_cast<Worker*>(argument);
+    s_current_worker = &worker;
+    worker.pool.run_worker(worker);
+    return nullptr;
+}
+
+void ThreadPool::run_worker(Worker& worker)
+{
+    for (;;) {
+        if (auto* job = find_job(&worker)) {
+            (*job)();
+            delete job;
+            continue;
+        }
+
+        pthread_mutex_lock(&m_mutex);
+        m_sleeping_worker_count.fetch_add(1);
+        // NOTE: This pairs with the check in enqueue(): either we see the new job here, or enqueue() sees that we're asleep.
+        while (m_queued_job_count.load() == 0 && !m_exiting)
+            pthread_cond_wait(&m_condition, &m_mutex);
+        m_sleeping_worker_count.fetch_sub(1);
+        bool should_exit = m_exiting && m_queued_job_count.load() == 0;
+        pthread_mutex_unlock(&m_mutex);
+
+        if (should_exit)
+            return;
+    }
+}
+
+ThreadPool::Worker* ThreadPool::current_worker()
+{
+    auto* worker = static_cast<Worker*>(s_current_worker);
+    if (worker && &worker->pool == this)
+        return worker;
+    return nullptr;
+}
+
+void ThreadPool::submit(Function<void()> function)
+{
+    enqueue(new Job(move(function)));
+}
+
+void ThreadPool::enqueue(Job* job)
+{
+    if (auto* worker = current_worker()) {
+        worker->queue.push(job);
+    } else {
+        pthread_mutex_lock(&m_mutex);
+        m_injected_jobs.enqueue(job);
+        m_injected_job_count.fetch_add(1);
+        pthread_mutex_unlock(&m_mutex);
+    }
+
+    m_queued_job_count.fetch_add(1);
+    if (m_sleeping_worker_count.load() > 0) {
+        pthread_mutex_lock(&m_mutex);
+        pthread_cond_signal(&m_condition);
+        pthread_mutex_unlock(&m_mutex);
+    }
+}
+
+ThreadPool::Job* ThreadPool::find_job(Worker* worker)
+{
+    auto take = [this](Job* job) {
+        m_queued_job_count.fetch_sub(1);
+        return job;
+    };
+
+    if (worker) {
+        if (auto job = worker->queue.pop(); job.has_value())
+            return take(job.value());
+    }
+
+    if (m_injected_job_count.load(AK::MemoryOrder::memory_order_relaxed) > 0) {
+        Job* job = nullptr;
+        pthread_mutex_lock(&m_mutex);
+        if (!m_injected_jobs.is_empty()) {
+            job = m_injected_jobs.dequeue();
+            m_injected_job_count.fetch_sub(1);
+        }
+        pthread_mutex_unlock(&m_mutex);
+        if (job)
+            return take(job);
+    }
+
+    // Start with a different victim on every worker, so that thieves don't all pile onto the same queue.
+    size_t first_victim = worker ? worker->index + 1 : 0;
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        auto& victim = m_workers[(first_victim + i) % m_workers.size()];
+        if (&victim == worker)
+            continue;
+        if (auto job = victim.queue.steal(); job.has_value())
+            return take(job.value());
+    }
+    return nullptr;
+}
+
+void ThreadPool::help_until(Function<bool()> const& condition)
+{
+    auto* worker = current_worker();
+    while (!condition()) {
+        if (auto* job = find_job(worker)) {
+            (*job)();
+            delete job;
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+size_t ThreadPool::effective_grain_size(size_t range_size, size_t grain_size) const
+{
+    if (grain_size)
+        return grain_size;
+    // A few chunks per worker leaves some slack for stealing when chunks take different amounts of time.
+    return max<size_t>(1, range_size / (worker_count() * 4));
+}
+
+void ThreadPool::parallel_for(size_t begin, size_t end, Function<void(size_t, size_t)> const& body, size_t grain_size)
+{
+    if (begin >= end)
+        return;
+    grain_size = effective_grain_size(end - begin, grain_size);
+
+    Atomic<size_t> pending_chunks { 0 };
+    Function<void(size_t, size_t)> run_range;
+    run_range = [&](size_t range_begin, size_t range_end) {
+        // Hand the upper halves to the pool, and keep working on the lower half ourselves.
+        while (range_end - range_begin > grain_size) {
+            size_t middle = range_begin + (range_end - range_begin) / 2;
+            pending_chunks.fetch_add(1);
+            enqueue(new Job([&, middle, range_end] {
+                run_range(middle, range_end);
+                pending_chunks.fetch_sub(1, AK::MemoryOrder::memory_order_release);
+            }));
+            range_end = middle;
+        }
+        body(range_begin, range_end);
+    };
+
+    run_range(begin, end);
+    help_until([&] { return pending_chunks.load(AK::MemoryOrder::memory_order_acquire) == 0; });
+}
+
+}
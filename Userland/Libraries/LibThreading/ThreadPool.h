@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Queue.h>
+#include <AK/Vector.h>
+#include <LibThreading/Future.h>
+#include <LibThreading/WorkStealingQueue.h>
+#include <pthread.h>
+
+namespace Threading {
+
+// A pool of worker threads for data-parallel work. Every worker owns a WorkStealingQueue: jobs spawned from
+// a worker go onto its own queue, and idle workers steal from the others. Jobs submitted from outside the
+// pool go through a shared queue instead.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    // The shared pool, with one worker per online CPU.
+    static ThreadPool& the();
+
+    explicit ThreadPool(size_t worker_count);
+    // Finishes all queued jobs, then stops the workers.
+    ~ThreadPool();
+
+    size_t worker_count() const { return m_workers.size(); }
+
+    void submit(Function<void()>);
+
+    template<typename T>
+    NonnullRefPtr<Future<T>> async(Function<T()> work, Function<void(T&)> on_complete = nullptr)
+    {
+        auto future = adopt_ref(*new Future<T>(*this, move(on_complete)));
+        submit([future, work = move(work)]() mutable {
+            future->resolve(work());
+        });
+        return future;
+    }
+
+    // Calls body(chunk_begin, chunk_end) on disjoint chunks that cover [begin, end), and returns once all of them are done.
+    // The range is split in halves until the chunks are no larger than grain_size, so that idle workers can steal the
+    // larger halves. By default, the range is split into a few chunks per worker.
+    void parallel_for(size_t begin, size_t end, Function<void(size_t, size_t)> const& body, size_t grain_size = 0);
+
+    // Maps each chunk of [begin, end) to a partial result with map(chunk_begin, chunk_end), then folds the partial results
+    // together with combine(). Partial results are combined in order, so the result doesn't depend on scheduling.
+    template<typename T, typename Map, typename Combine>
+    T parallel_reduce(size_t begin, size_t end, T identity, Map map, Combine combine, size_t grain_size = 0)
+    {
+        if (begin >= end)
+            return identity;
+        grain_size = effective_grain_size(end - begin, grain_size);
+        size_t chunk_count = (end - begin + grain_size - 1) / grain_size;
+        Vector<T> partial_results;
+        partial_results.resize(chunk_count);
+        parallel_for(
+            0, chunk_count, [&](size_t first_chunk, size_t last_chunk) {
+                for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk) {
+                    size_t chunk_begin = begin + chunk * grain_size;
+                    partial_results[chunk] = map(chunk_begin, min(chunk_begin + grain_size, end));
+                }
+            },
+            1);
+        T result = move(identity);
+        for (auto& partial_result : partial_results)
+            result = combine(move(result), move(partial_result));
+        return result;
+    }
+
+    // Runs jobs from the pool on the calling thread until the condition holds.
+    void help_until(Function<bool()> const& condition);
+
+private:
+    using Job = Function<void()>;
+
+    struct Worker {
+        Worker(ThreadPool& pool, size_t index)
+            : pool(pool)
+            , index(index)
+        {
+        }
+
+        ThreadPool& pool;
+        size_t index;
+        WorkStealingQueue<Job*> queue;
+        pthread_t thread { 0 };
+    };
+
+    static void* worker_entry(void*);
+    void run_worker(Worker&);
+
+    void enqueue(Job*);
+    Job* find_job(Worker*);
+    Worker* current_worker();
+    size_t effective_grain_size(size_t range_size, size_t grain_size) const;
+
+    NonnullOwnPtrVector<Worker> m_workers;
+
+    pthread_mutex_t m_mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t m_condition = PTHREAD_COND_INITIALIZER;
+    Queue<Job*> m_injected_jobs;
+    Atomic<size_t> m_injected_job_count { 0 };
+
+    // Jobs that have been queued anywhere, but not yet picked up by a thread.
+    Atomic<size_t> m_queued_job_count { 0 };
+    Atomic<size_t> m_sleeping_worker_count { 0 };
+    bool m_exiting { false };
+};
+
+template<typename T>
+T& Future<T>::await()
+{
+    m_pool.help_until([this] { return is_resolved(); });
+    return m_value.value();
+}
+
+}
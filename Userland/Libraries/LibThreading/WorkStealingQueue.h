@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Types.h>
+
+namespace Threading {
+
+// A Chase-Lev work-stealing deque, with the memory orderings from "Correct and Efficient Work-Stealing
+// for Weak Memory Models" (Lê et al., 2013). The owning thread pushes and pops at the bottom, while any
+// other thread may steal from the top. T has to be trivially copyable, so in practice it's a pointer.
+template<typename T>
+class WorkStealingQueue {
+    AK_MAKE_NONCOPYABLE(WorkStealingQueue);
+    AK_MAKE_NONMOVABLE(WorkStealingQueue);
+
+public:
+    // The capacity has to be a power of two, since indices are wrapped with a mask.
+    explicit WorkStealingQueue(size_t initial_capacity = 256)
+        : m_buffer(new Buffer(initial_capacity, nullptr))
+    {
+        VERIFY(initial_capacity && (initial_capacity & (initial_capacity - 1)) == 0);
+    }
+
+    ~WorkStealingQueue()
+    {
+        auto* buffer = m_buffer.load(AK::MemoryOrder::memory_order_relaxed);
+        while (buffer) {
+            auto* previous = buffer->previous;
+            delete buffer;
+            buffer = previous;
+        }
+    }
+
+    // Only the owning thread may call push() and pop().
+    void push(T value)
+    {
+        auto bottom = m_bottom.load(AK::MemoryOrder::memory_order_relaxed);
+        auto top = m_top.load(AK::MemoryOrder::memory_order_acquire);
+        auto* buffer = m_buffer.load(AK::MemoryOrder::memory_order_relaxed);
+        if (bottom - top > static_cast<i64>(buffer->capacity) - 1)
+            buffer = grow(buffer, top, bottom);
+        buffer->put(bottom, value);
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+        m_bottom.store(bottom + 1, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    Optional<T> pop()
+    {
+        auto bottom = m_bottom.load(AK::MemoryOrder::memory_order_relaxed) - 1;
+        auto* buffer = m_buffer.load(AK::MemoryOrder::memory_order_relaxed);
+        m_bottom.store(bottom, AK::MemoryOrder::memory_order_relaxed);
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+        auto top = m_top.load(AK::MemoryOrder::memory_order_relaxed);
+
+        if (top > bottom) {
+            // The queue was already empty.
+            m_bottom.store(bottom + 1, AK::MemoryOrder::memory_order_relaxed);
+            return {};
+        }
+
+        T value = buffer->get(bottom);
+        if (top == bottom) {
+            // This is the last element, so we have to race any thieves for it.
+            bool won = m_top.compare_exchange_strong(top, top + 1, AK::MemoryOrder::memory_order_seq_cst);
+            m_bottom.store(bottom + 1, AK::MemoryOrder::memory_order_relaxed);
+            if (!won)
+                return {};
+        }
+        return value;
+    }
+
+    // May be called from any thread.
+    Optional<T> steal()
+    {
+        auto top = m_top.load(AK::MemoryOrder::memory_order_acquire);
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+        auto bottom = m_bottom.load(AK::MemoryOrder::memory_order_acquire);
+        if (top >= bottom)
+            return {};
+
+        auto* buffer = m_buffer.load(AK::MemoryOrder::memory_order_acquire);
+        T value = buffer->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, AK::MemoryOrder::memory_order_seq_cst))
+            return {};
+        return value;
+    }
+
+    bool is_empty() const
+    {
+        auto bottom = m_bottom.load(AK::MemoryOrder::memory_order_relaxed);
+        auto top = m_top.load(AK::MemoryOrder::memory_order_relaxed);
+        return top >= bottom;
+    }
+
+private:
+    static_assert(IsTriviallyCopyable<T>);
+
+    struct Buffer {
+        Buffer(size_t capacity, Buffer* previous)
+            : capacity(capacity)
+            , previous(previous)
+            , slots(new T[capacity])
+        {
+        }
+
+        ~Buffer() { delete[] slots; }
+
+        T get(i64 index) const { return AK::atomic_load(&slots[index & (capacity - 1)], AK::MemoryOrder::memory_order_relaxed); }
+        void put(i64 index, T value) { AK::atomic_store(&slots[index & (capacity - 1)], value, AK::MemoryOrder::memory_order_relaxed); }
+
+        size_t capacity;
+        // Thieves may still be reading from a buffer after it has been replaced, so old buffers
+        // are kept around until the queue itself goes away.
+        Buffer* previous;
+        T* slots;
+    };
+
+    Buffer* grow(Buffer* buffer, i64 top, i64 bottom)
+    {
+        auto* new_buffer = new Buffer(buffer->capacity * 2, buffer);
+        for (auto index = top; index < bottom; ++index)
+            new_buffer->put(index, buffer->get(index));
+        m_buffer.store(new_buffer, AK::MemoryOrder::memory_order_release);
+        return new_buffer;
+    }
+
+    // The owner and the thieves hammer on different ends of the queue, so keep them on separate cache lines.
+    alignas(64) Atomic<i64> m_top { 0 };
+    alignas(64) Atomic<i64> m_bottom { 0 };
+    Atomic<Buffer*> m_buffer;
+};
+
+}
@@ -14,9 +14,22 @@ Wrappable::~Wrappable()
 {
 }
 
+Wrapper* Wrappable::wrapper()
+{
+    return const_cast<Wrapper*>(const_cast<Wrappable const&>(*this).wrapper());
+}
+
+const Wrapper* Wrappable::wrapper() const
+{
+    // The garbage collector may already have found our wrapper unreachable without having swept it yet.
+    if (!m_wrapper || JS::Heap::is_awaiting_sweep(*m_wrapper))
+        return nullptr;
+    return m_wrapper;
+}
+
 void Wrappable::set_wrapper(Wrapper& wrapper)
 {
-    VERIFY(!m_wrapper);
+    VERIFY(!this->wrapper());
     m_wrapper = wrapper.make_weak_ptr();
 }
 
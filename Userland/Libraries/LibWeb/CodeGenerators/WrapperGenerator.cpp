@@ -934,6 +934,15 @@ namespace Web::Bindings {
 void @wrapper_class@::initialize(JS::GlobalObject& global_object)
 {
     @wrapper_base_class@::initialize(global_object);
+)~~~");
+
+    if (interface.extended_attributes.contains("CustomGet") || interface.extended_attributes.contains("CustomSet")) {
+        generator.append(R"~~~(
+    m_may_interfere_with_inline_caches = true;
+)~~~");
+    }
+
+    generator.append(R"~~~(
 }
 
 @wrapper_class@::~@wrapper_class@()
@@ -53,8 +53,9 @@ public:
     void did_set_location_href(Badge<Bindings::LocationObject>, const URL& new_href);
     void did_call_location_reload(Badge<Bindings::LocationObject>);
 
-    Bindings::WindowObject* wrapper() { return m_wrapper; }
-    const Bindings::WindowObject* wrapper() const { return m_wrapper; }
+    // Like Bindings::Wrappable::wrapper(), we mustn't hand out a wrapper that the garbage collector is about to sweep.
+    Bindings::WindowObject* wrapper() { return m_wrapper && !JS::Heap::is_awaiting_sweep(*m_wrapper) ? m_wrapper.ptr() : nullptr; }
+    const Bindings::WindowObject* wrapper() const { return m_wrapper && !JS::Heap::is_awaiting_sweep(*m_wrapper) ? m_wrapper.ptr() : nullptr; }
 
     void set_wrapper(Badge<Bindings::WindowObject>, Bindings::WindowObject&);
 
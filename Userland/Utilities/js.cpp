@@ -15,6 +15,7 @@
 #include <LibCore/StandardPaths.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Cache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/PassManager.h>
@@ -85,6 +86,8 @@ static bool s_dump_ast = false;
 static bool s_dump_bytecode = false;
 static bool s_run_bytecode = false;
 static bool s_opt_bytecode = false;
+static OwnPtr<JS::Bytecode::Cache> s_bytecode_cache;
+static bool s_dump_optimization_statistics = false;
 static bool s_print_last_result = false;
 static RefPtr<Line::Editor> s_editor;
 static String s_history_path = String::formatted("{}/.js-history", Core::StandardPaths::home_directory());
@@ -565,46 +568,67 @@ static bool write_to_file(String const& path)
     return true;
 }
 
-static bool parse_and_run(JS::Interpreter& interpreter, StringView const& source)
+static void dump_bytecode(JS::Bytecode::Executable const& unit)
 {
-    auto parser = JS::Parser(JS::Lexer(source));
-    auto program = parser.parse_program();
+    for (auto& block : unit.basic_blocks)
+        block.dump(unit);
+    if (!unit.string_table->is_empty()) {
+        outln();
+        unit.string_table->dump();
+    }
+}
 
-    if (s_dump_ast)
-        program->dump(0);
+static void run_bytecode(JS::Interpreter& interpreter, JS::Bytecode::Executable const& unit)
+{
+    JS::Bytecode::Interpreter bytecode_interpreter(interpreter.global_object());
+    bytecode_interpreter.run(unit);
+    // Dump afterwards, so that the statistics of the inline caches are included.
+    if (s_dump_bytecode)
+        dump_bytecode(unit);
+}
 
-    if (parser.has_errors()) {
-        auto error = parser.errors()[0];
-        auto hint = error.source_location_hint(source);
-        if (!hint.is_empty())
-            outln("{}", hint);
-        vm->throw_exception<JS::SyntaxError>(interpreter.global_object(), error.to_string());
-    } else {
-        if (s_dump_bytecode || s_run_bytecode) {
-            auto unit = JS::Bytecode::Generator::generate(*program);
-            if (s_opt_bytecode) {
-                auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
-                passes.perform(unit);
-                dbgln("Optimisation passes took {}us", passes.elapsed());
-            }
+// Only script files are worth caching. REPL lines are short and rarely repeated, and would just fill the cache directory.
+static bool parse_and_run(JS::Interpreter& interpreter, StringView const& source, JS::Bytecode::Cache const* bytecode_cache = nullptr)
+{
+    Optional<JS::Bytecode::Executable> cached_unit;
+    if (bytecode_cache && !s_dump_ast)
+        cached_unit = bytecode_cache->load(source);
 
-            if (s_dump_bytecode) {
-                for (auto& block : unit.basic_blocks)
-                    block.dump(unit);
-                if (!unit.string_table->is_empty()) {
-                    outln();
-                    unit.string_table->dump();
+    if (cached_unit.has_value()) {
+        run_bytecode(interpreter, *cached_unit);
+    } else {
+        auto parser = JS::Parser(JS::Lexer(source));
+        auto program = parser.parse_program();
+
+        if (s_dump_ast)
+            program->dump(0);
+
+        if (parser.has_errors()) {
+            auto error = parser.errors()[0];
+            auto hint = error.source_location_hint(source);
+            if (!hint.is_empty())
+                outln("{}", hint);
+            vm->throw_exception<JS::SyntaxError>(interpreter.global_object(), error.to_string());
+        } else {
+            if (s_dump_bytecode || s_run_bytecode) {
+                auto unit = JS::Bytecode::Generator::generate(*program);
+                if (s_opt_bytecode) {
+                    auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
+                    passes.perform(unit);
+                    dbgln("Optimisation passes took {}us", passes.elapsed());
                 }
-            }
 
-            if (s_run_bytecode) {
-                JS::Bytecode::Interpreter bytecode_interpreter(interpreter.global_object());
-                bytecode_interpreter.run(unit);
+                if (s_run_bytecode) {
+                    if (bytecode_cache)
+                        bytecode_cache->store(source, unit);
+                    run_bytecode(interpreter, unit);
+                } else {
+                    dump_bytecode(unit);
+                    return true;
+                }
             } else {
-                return true;
+                interpreter.run(interpreter.global_object(), *program);
             }
-        } else {
-            interpreter.run(interpreter.global_object(), *program);
         }
     }
 
@@ -848,6 +872,8 @@ int main(int argc, char** argv)
 {
     bool gc_on_every_allocation = false;
     bool disable_syntax_highlight = false;
+    bool jit = false;
+    char const* bytecode_cache_path = nullptr;
     Vector<String> script_paths;
 
     Core::ArgsParser args_parser;
@@ -856,6 +882,9 @@ int main(int argc, char** argv)
     args_parser.add_option(s_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
     args_parser.add_option(s_run_bytecode, "Run the bytecode", "run-bytecode", 'b');
     args_parser.add_option(s_opt_bytecode, "Optimize the bytecode", "optimize-bytecode", 'p');
+    args_parser.add_option(jit, "Compile the bytecode to native code (with -b)", "jit", 0);
+    args_parser.add_option(bytecode_cache_path, "Cache the bytecode of scripts in this directory (with -b)", "bytecode-cache", 0, "path");
+    args_parser.add_option(s_dump_optimization_statistics, "Dump statistics of the bytecode optimization passes on exit", "dump-optimization-statistics", 0);
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
@@ -864,6 +893,11 @@ int main(int argc, char** argv)
 
     bool syntax_highlight = !disable_syntax_highlight;
 
+    JS::Bytecode::Interpreter::set_jit_enabled(jit);
+
+    if (bytecode_cache_path && s_run_bytecode)
+        s_bytecode_cache = make<JS::Bytecode::Cache>(bytecode_cache_path, s_opt_bytecode);
+
     vm = JS::VM::create();
     // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
     // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
@@ -922,7 +956,7 @@ int main(int argc, char** argv)
             JS::Lexer lexer(line);
             bool indenters_starting_line = true;
             for (JS::Token token = lexer.next(); token.type() != JS::TokenType::Eof; token = lexer.next()) {
-                auto length = token.value().length();
+                auto length = token.original_value().length();
                 auto start = token.line_column() - 1;
                 auto end = start + length;
                 if (indenters_starting_line) {
@@ -1118,7 +1152,10 @@ int main(int argc, char** argv)
             builder.append(source);
         }
 
-        if (!parse_and_run(*interpreter, builder.to_string()))
+        bool success = parse_and_run(*interpreter, builder.to_string(), s_bytecode_cache.ptr());
+        if (s_dump_optimization_statistics)
+            JS::Bytecode::Interpreter::optimization_pipeline().dump_statistics(stdout);
+        if (!success)
             return 1;
     }
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <AK/String.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <stdio.h>
+#include <unistd.h>
+
+struct Entry {
+    String name;
+    JsonObject histogram;
+};
+
+// Returns the lower bound (in cycles) of the bucket that contains the given percentile.
+static u64 percentile_from_histogram(const JsonObject& histogram, u64 percentile)
+{
+    auto count = histogram.get("count").to_u64();
+    auto& buckets = histogram.get("log2_buckets").as_array();
+    u64 threshold = (count * percentile + 99) / 100;
+    u64 seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets.at(i).to_u64();
+        if (seen >= threshold)
+            return i == 0 ? 0 : 1llu << i;
+    }
+    return 0;
+}
+
+static void print_histogram(const JsonObject& histogram)
+{
+    auto& buckets = histogram.get("log2_buckets").as_array();
+    u64 max_bucket = 0;
+    for (auto& bucket : buckets.values())
+        max_bucket = max(max_bucket, bucket.to_u64());
+    if (max_bucket == 0)
+        return;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        auto value = buckets.at(i).to_u64();
+        if (value == 0)
+            continue;
+        auto bar_length = max<u64>(1, value * 40 / max_bucket);
+        outln("        >= 2^{:<2} cycles {:>10} {}", i, value, String::repeated('#', bar_length));
+    }
+}
+
+static void print_entries(const char* title, const JsonObject& object, bool show_histograms)
+{
+    Vector<Entry> entries;
+    object.for_each_member([&](auto& name, auto& value) {
+        entries.append({ name, value.as_object() });
+    });
+    if (entries.is_empty())
+        return;
+
+    quick_sort(entries, [](auto& a, auto& b) {
+        return a.histogram.get("total_cycles").to_u64() > b.histogram.get("total_cycles").to_u64();
+    });
+
+    outln("    {:<20} {:>10} {:>14} {:>14} {:>14} {:>14}", title, "count", "total cycles", "avg cycles", "p99 cycles", "max cycles");
+    for (auto& entry : entries) {
+        auto count = entry.histogram.get("count").to_u64();
+        auto total = entry.histogram.get("total_cycles").to_u64();
+        outln("    {:<20} {:>10} {:>14} {:>14} {:>14} {:>14}",
+            entry.name,
+            count,
+            total,
+            count ? total / count : 0,
+            percentile_from_histogram(entry.histogram, 99),
+            entry.histogram.get("max_cycles").to_u64());
+        if (show_histograms)
+            print_histogram(entry.histogram);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (pledge("stdio rpath", nullptr) < 0) {
+        perror("pledge");
+        return 1;
+    }
+
+    if (unveil("/proc", "r") < 0) {
+        perror("unveil");
+        return 1;
+    }
+
+    unveil(nullptr, nullptr);
+
+    const char* pid;
+    int tid = -1;
+    bool show_histograms = false;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Show syscall, page fault and blocking latency statistics for a process.");
+    args_parser.add_option(show_histograms, "Show latency histograms", "histograms", 'H');
+    args_parser.add_option(tid, "Only show statistics for this thread", "tid", 't', "tid");
+    args_parser.add_positional_argument(pid, "PID", "PID", Core::ArgsParser::Required::Yes);
+    args_parser.parse(argc, argv);
+
+    auto file = Core::File::construct(String::formatted("/proc/{}/latency", pid));
+    if (!file->open(Core::OpenMode::ReadOnly)) {
+        warnln("Failed to open {}: {}", file->name(), file->error_string());
+        return 1;
+    }
+
+    auto file_contents = file->read_all();
+    auto json = JsonValue::from_string(file_contents);
+    if (!json.has_value() || !json.value().is_array()) {
+        warnln("Failed to parse {}", file->name());
+        return 1;
+    }
+
+    for (auto& value : json.value().as_array().values()) {
+        auto& thread = value.as_object();
+        if (tid != -1 && thread.get("tid").to_int() != tid)
+            continue;
+
+        outln("Thread {} ({}):", thread.get("tid").to_int(), thread.get("name").to_string());
+        if (!thread.has("syscalls")) {
+            outln("    No statistics collected yet.");
+            continue;
+        }
+        print_entries("Syscall", thread.get("syscalls").as_object(), show_histograms);
+        print_entries("Page fault", thread.get("page_faults").as_object(), show_histograms);
+        print_entries("Blocked on", thread.get("blockers").as_object(), show_histograms);
+        outln();
+    }
+
+    return 0;
+}